@@ -0,0 +1,103 @@
+#pragma once
+
+#include <Hakool/Utils/hkUtilitiesUtilities.h>
+
+namespace hk
+{
+  namespace cooker
+  {
+    /**
+     * State of a source asset when it was last cooked.
+     */
+    struct CookRecord
+    {
+      CookRecord();
+
+      /**
+       * Size of the source file in bytes.
+       */
+      uint64
+      sourceSize;
+
+      /**
+       * Last write time of the source file, in file clock ticks.
+       */
+      int64
+      sourceTime;
+
+      /**
+       * Hash of the content of the source file and of its dependencies.
+       */
+      uint64
+      sourceHash;
+
+      /**
+       * Files the importer read besides the source, like the buffers of a
+       * glTF file or the materials of an OBJ file, relative to the source
+       * directory.
+       */
+      Vector<String>
+      dependencies;
+
+      /**
+       * Hash of the sizes and last write times of the dependencies.
+       */
+      uint64
+      dependenciesStamp;
+
+      /**
+       * Hash of the cook settings used.
+       */
+      uint64
+      settingsHash;
+    };
+
+    /**
+     * Dependency database of the cooker. Remembers, for every source asset,
+     * the content hash and the settings it was cooked with, so only the
+     * changed assets are cooked again.
+     * <p>
+     * It is stored as a text file, a line per source:
+     * "sourceSize sourceTime sourceHash settingsHash dependenciesStamp
+     * dependenciesSize relativePath", followed by a line per dependency with
+     * its path.
+     */
+    class CookDatabase
+    {
+    public:
+
+      CookDatabase();
+
+      ~CookDatabase();
+
+      /**
+       * Loads the database. A missing file is an empty database.
+       */
+      eRESULT
+      load(const String& path);
+
+      eRESULT
+      save(const String& path) const;
+
+      /**
+       * Gets the record of a source, nullptr if it was never cooked.
+       */
+      const CookRecord*
+      find(const String& relativePath) const;
+
+      void
+      set(const String& relativePath, const CookRecord& record);
+
+      void
+      remove(const String& relativePath);
+
+      const Map<String, CookRecord>&
+      getRecords() const;
+
+    private:
+
+      Map<String, CookRecord>
+      _m_records;
+    };
+  }
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <Hakool/Utils/hkUtilitiesUtilities.h>
+#include "cookDatabase.h"
+
+namespace hk
+{
+  namespace cooker
+  {
+    struct CookerConfiguration
+    {
+      CookerConfiguration();
+
+      /**
+       * Directory with the source assets, walked recursively.
+       */
+      String
+      sourcePath;
+
+      /**
+       * Directory of the cooked files and the dependency database.
+       */
+      String
+      cachePath;
+
+      /**
+       * Number of assets cooked in parallel. Zero uses the number of hardware
+       * threads.
+       */
+      uint32
+      threadsSize;
+
+      /**
+       * Cook every asset, even the ones that didn't change.
+       */
+      bool
+      force;
+
+      /**
+       * Optimization passes run on every imported mesh.
+       */
+      MeshImportConfiguration
+      importConfiguration;
+    };
+
+    /**
+     * Offline asset cooker. Imports the mesh assets of a directory with
+     * MeshLoaderGltf, which hands the non GLB formats to Assimp, runs the
+     * optimization passes and writes them as engine native mesh files (see
+     * MeshFileWriter).
+     * <p>
+     * The cook is incremental: the assets whose content and settings didn't
+     * change since the last cook are skipped.
+     */
+    class Cooker
+    {
+    public:
+
+      explicit Cooker(const CookerConfiguration& configuration);
+
+      ~Cooker();
+
+      /**
+       * Cooks the changed assets and removes the cooked files of the deleted
+       * ones. The assets are cooked on several threads, which log through
+       * Logger, so the logger must be thread safe (see CookerLogger).
+       *
+       * @return kSuccess if every asset was cooked.
+       */
+      eRESULT
+      cook();
+
+      /**
+       * Checks if a file is a mesh asset that can be cooked.
+       */
+      static bool
+      IsMeshAsset(const String& path);
+
+      /**
+       * Gets the path of the cooked file of a source asset.
+       */
+      String
+      getCookedPath(const String& relativePath) const;
+
+    private:
+
+      /**
+       * Hash of the settings that change the cooked files.
+       */
+      uint64
+      getSettingsHash() const;
+
+      /**
+       * Hash of the sizes and last write times of the dependencies of an
+       * asset. Missing dependencies are hashed too, so removing one changes
+       * the stamp.
+       */
+      uint64
+      getDependenciesStamp(const Vector<String>& dependencies) const;
+
+      /**
+       * Add the content of the dependencies of an asset to its hash.
+       */
+      uint64
+      hashDependencies(const Vector<String>& dependencies, uint64 hash) const;
+
+      /**
+       * Cooks a source asset.
+       *
+       * @param relativePath Path of the asset relative to the source path.
+       * @param record Input with the size and time of the source, output with
+       * its hash and its dependencies.
+       * @param pPrevious Record of the previous cook, nullptr if none.
+       * @param cooked Output, false if the content didn't change.
+       */
+      eRESULT
+      cookAsset
+      (
+        const String& relativePath,
+        CookRecord& record,
+        const CookRecord* pPrevious,
+        bool& cooked
+      );
+
+      CookerConfiguration
+      _m_configuration;
+
+      CookDatabase
+      _m_database;
+    };
+  }
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <mutex>
+
+#include <Hakool/Utils/hkLoggerConsole.h>
+
+namespace hk
+{
+  namespace cooker
+  {
+    /**
+     * Console logger that writes one message at a time. The assets are
+     * cooked on worker threads, and the loaders and passes log through
+     * Logger from them.
+     */
+    class CookerLogger :
+      public LoggerConsole
+    {
+    public:
+
+      CookerLogger() = default;
+
+      virtual
+      ~CookerLogger() = default;
+
+      void
+      log(const String& _msg) override;
+
+      void
+      log(const String& _msg, const String& _filename) override;
+
+      void
+      warning(const String& _msg) override;
+
+      void
+      warning(const String& _msg, const String& _filename) override;
+
+      void
+      error(const String& _msg) override;
+
+      void
+      error(const String& _msg, const String& _filename) override;
+
+    private:
+
+      std::mutex
+      _m_mutex;
+    };
+  }
+}
\ No newline at end of file
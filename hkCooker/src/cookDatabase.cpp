@@ -0,0 +1,154 @@
+#include "cookDatabase.h"
+
+#include <sstream>
+
+#include <Hakool/Utils/hkLogger.h>
+
+namespace hk
+{
+  namespace cooker
+  {
+    CookRecord::CookRecord() :
+      sourceSize(0),
+      sourceTime(0),
+      sourceHash(0),
+      dependencies(),
+      dependenciesStamp(0),
+      settingsHash(0)
+    { }
+
+    CookDatabase::CookDatabase() :
+      _m_records()
+    { }
+
+    CookDatabase::~CookDatabase()
+    { }
+
+    eRESULT
+    CookDatabase::load(const String& path)
+    {
+      _m_records.clear();
+
+      std::ifstream file(path);
+      if (!file.is_open())
+      {
+        return eRESULT::kSuccess;
+      }
+
+      String line;
+      while (std::getline(file, line))
+      {
+        std::istringstream stream(line);
+
+        CookRecord record;
+        String relativePath;
+        uint32 dependenciesSize = 0;
+        stream >> record.sourceSize >> record.sourceTime >> record.sourceHash >> record.settingsHash;
+        stream >> record.dependenciesStamp >> dependenciesSize;
+        stream >> std::ws;
+        std::getline(stream, relativePath);
+
+        if (stream.fail() || relativePath.empty())
+        {
+          Logger::Error("| CookDatabase | Malformed line: " + line);
+          _m_records.clear();
+          return eRESULT::kFail;
+        }
+
+        for (uint32 i = 0; i < dependenciesSize; ++i)
+        {
+          String dependency;
+          if (!std::getline(file, dependency) || dependency.empty())
+          {
+            Logger::Error("| CookDatabase | Missing dependencies of: " + relativePath);
+            _m_records.clear();
+            return eRESULT::kFail;
+          }
+          record.dependencies.push_back(dependency);
+        }
+
+        _m_records[relativePath] = record;
+      }
+
+      return eRESULT::kSuccess;
+    }
+
+    eRESULT
+    CookDatabase::save(const String& path) const
+    {
+      // Write a temporary file first, so an interrupted cook keeps the
+      // previous database.
+      String temporaryPath = path + ".tmp";
+      {
+        std::ofstream file(temporaryPath, std::ios::trunc);
+        if (!file.is_open())
+        {
+          Logger::Error("| CookDatabase | Couldn't write the database: " + path);
+          return eRESULT::kFail;
+        }
+
+        for (const auto& entry : _m_records)
+        {
+          const CookRecord& record = entry.second;
+          file << record.sourceSize << ' '
+               << record.sourceTime << ' '
+               << record.sourceHash << ' '
+               << record.settingsHash << ' '
+               << record.dependenciesStamp << ' '
+               << record.dependencies.size() << ' '
+               << entry.first << '\n';
+
+          for (const String& dependency : record.dependencies)
+          {
+            file << dependency << '\n';
+          }
+        }
+
+        if (!file.good())
+        {
+          Logger::Error("| CookDatabase | Couldn't write the database: " + path);
+          return eRESULT::kFail;
+        }
+      }
+
+      std::remove(path.c_str());
+      if (0 != std::rename(temporaryPath.c_str(), path.c_str()))
+      {
+        Logger::Error("| CookDatabase | Couldn't replace the database: " + path);
+        return eRESULT::kFail;
+      }
+
+      return eRESULT::kSuccess;
+    }
+
+    const CookRecord*
+    CookDatabase::find(const String& relativePath) const
+    {
+      auto it = _m_records.find(relativePath);
+      if (it == _m_records.end())
+      {
+        return nullptr;
+      }
+
+      return &(it->second);
+    }
+
+    void
+    CookDatabase::set(const String& relativePath, const CookRecord& record)
+    {
+      _m_records[relativePath] = record;
+    }
+
+    void
+    CookDatabase::remove(const String& relativePath)
+    {
+      _m_records.erase(relativePath);
+    }
+
+    const Map<String, CookRecord>&
+    CookDatabase::getRecords() const
+    {
+      return _m_records;
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,423 @@
+#include "cooker.h"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <set>
+#include <thread>
+
+#include <Hakool/Utils/hkLogger.h>
+#include <Hakool/Utils/hkHash.h>
+#include <Hakool/Utils/hkMeshFile.h>
+#include <Hakool/Utils/hkMeshFileWriter.h>
+#include <Hakool/Utils/hkMeshLoaderGltf.h>
+#include <Hakool/Utils/hkMultiMesh.h>
+
+namespace fs = std::filesystem;
+
+namespace hk
+{
+  namespace cooker
+  {
+    namespace
+    {
+      /**
+       * Extension of the cooked mesh files.
+       */
+      const String kCOOKED_EXTENSION = ".hkmesh";
+
+      /**
+       * Name of the dependency database in the cache directory.
+       */
+      const String kDATABASE_NAME = "cook.db";
+
+      /**
+       * An asset to cook.
+       */
+      struct CookJob
+      {
+        String relativePath;
+
+        CookRecord record;
+
+        const CookRecord* pPrevious;
+
+        eRESULT result;
+
+        bool cooked;
+      };
+    }
+
+    CookerConfiguration::CookerConfiguration() :
+      sourcePath(),
+      cachePath(),
+      threadsSize(0),
+      force(false),
+      importConfiguration()
+    { }
+
+    Cooker::Cooker(const CookerConfiguration& configuration) :
+      _m_configuration(configuration),
+      _m_database()
+    { }
+
+    Cooker::~Cooker()
+    { }
+
+    eRESULT
+    Cooker::cook()
+    {
+      auto startTime = std::chrono::steady_clock::now();
+
+      std::error_code error;
+      fs::path sourcePath(_m_configuration.sourcePath);
+      fs::path cachePath(_m_configuration.cachePath);
+      if (!fs::is_directory(sourcePath, error))
+      {
+        Logger::Error("| Cooker | Source directory not found: " + _m_configuration.sourcePath);
+        return eRESULT::kFail;
+      }
+
+      fs::create_directories(cachePath, error);
+      if (error)
+      {
+        Logger::Error("| Cooker | Couldn't create the cache directory: " + _m_configuration.cachePath);
+        return eRESULT::kFail;
+      }
+
+      String databasePath = (cachePath / kDATABASE_NAME).string();
+      if (_m_configuration.force || eRESULT::kSuccess != _m_database.load(databasePath))
+      {
+        _m_database = CookDatabase();
+      }
+
+      // Find the assets whose size, time or settings changed. The others are
+      // skipped without reading them.
+      const uint64 settingsHash = getSettingsHash();
+      Vector<CookJob> jobs;
+      std::set<String> sources;
+      uint32 upToDateSize = 0;
+      std::error_code walkError;
+      for (fs::recursive_directory_iterator it(sourcePath, walkError), end; it != end; it.increment(walkError))
+      {
+        if (walkError)
+        {
+          break;
+        }
+
+        if (!it->is_regular_file(error) || !IsMeshAsset(it->path().string()))
+        {
+          continue;
+        }
+
+        String relativePath = fs::relative(it->path(), sourcePath, error).generic_string();
+        sources.insert(relativePath);
+
+        CookJob job;
+        job.relativePath = relativePath;
+        job.record.sourceSize = static_cast<uint64>(it->file_size(error));
+        job.record.sourceTime = static_cast<int64>(it->last_write_time(error).time_since_epoch().count());
+        job.record.settingsHash = settingsHash;
+        job.pPrevious = _m_database.find(relativePath);
+        job.result = eRESULT::kFail;
+        job.cooked = false;
+
+        const CookRecord* pPrevious = job.pPrevious;
+        if (nullptr != pPrevious
+            && pPrevious->sourceSize == job.record.sourceSize
+            && pPrevious->sourceTime == job.record.sourceTime
+            && pPrevious->settingsHash == settingsHash
+            && pPrevious->dependenciesStamp == getDependenciesStamp(pPrevious->dependencies)
+            && fs::exists(getCookedPath(relativePath), error))
+        {
+          ++upToDateSize;
+          continue;
+        }
+
+        jobs.push_back(job);
+      }
+
+      if (walkError)
+      {
+        Logger::Error("| Cooker | Couldn't walk the source directory: " + walkError.message());
+        return eRESULT::kFail;
+      }
+
+      // Cook the assets on every core. Every worker takes the next job.
+      uint32 threadsSize = _m_configuration.threadsSize;
+      if (0 == threadsSize)
+      {
+        threadsSize = Math::Max(1u, std::thread::hardware_concurrency());
+      }
+      threadsSize = Math::Min(threadsSize, Math::Max(1u, static_cast<uint32>(jobs.size())));
+
+      std::atomic<uint32> nextJob(0);
+      auto cookJobs = [&]()
+      {
+        for (uint32 i = nextJob++; i < jobs.size(); i = nextJob++)
+        {
+          CookJob& job = jobs[i];
+          job.result = cookAsset(job.relativePath, job.record, job.pPrevious, job.cooked);
+        }
+      };
+
+      Vector<std::thread> threads;
+      for (uint32 i = 1; i < threadsSize; ++i)
+      {
+        threads.push_back(std::thread(cookJobs));
+      }
+
+      cookJobs();
+
+      for (std::thread& thread : threads)
+      {
+        thread.join();
+      }
+
+      // Update the database. Failed assets are removed, so they are retried
+      // by the next cook.
+      uint32 cookedSize = 0;
+      uint32 failedSize = 0;
+      for (const CookJob& job : jobs)
+      {
+        if (eRESULT::kSuccess != job.result)
+        {
+          _m_database.remove(job.relativePath);
+          ++failedSize;
+          continue;
+        }
+
+        _m_database.set(job.relativePath, job.record);
+        if (job.cooked)
+        {
+          ++cookedSize;
+        }
+        else
+        {
+          ++upToDateSize;
+        }
+      }
+
+      // Remove the cooked files of the deleted sources.
+      Vector<String> deletedSources;
+      for (const auto& entry : _m_database.getRecords())
+      {
+        if (sources.end() == sources.find(entry.first))
+        {
+          deletedSources.push_back(entry.first);
+        }
+      }
+
+      for (const String& relativePath : deletedSources)
+      {
+        fs::remove(getCookedPath(relativePath), error);
+        _m_database.remove(relativePath);
+      }
+
+      eRESULT result = _m_database.save(databasePath);
+
+      auto elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime);
+      Logger::Log
+      (
+        "| Cooker | Cooked " + std::to_string(cookedSize)
+        + ", up to date " + std::to_string(upToDateSize)
+        + ", removed " + std::to_string(deletedSources.size())
+        + ", failed " + std::to_string(failedSize)
+        + " in " + std::to_string(elapsed.count()) + " s."
+      );
+
+      if (0 != failedSize)
+      {
+        return eRESULT::kFail;
+      }
+
+      return result;
+    }
+
+    bool
+    Cooker::IsMeshAsset(const String& path)
+    {
+      static const std::set<String> extensions =
+      {
+        ".fbx", ".obj", ".dae", ".gltf", ".glb", ".3ds", ".blend", ".ply", ".stl"
+      };
+
+      String extension = fs::path(path).extension().string();
+      for (char& character : extension)
+      {
+        character = static_cast<char>(std::tolower(static_cast<unsigned char>(character)));
+      }
+
+      return extensions.end() != extensions.find(extension);
+    }
+
+    String
+    Cooker::getCookedPath(const String& relativePath) const
+    {
+      fs::path cookedPath = fs::path(_m_configuration.cachePath) / relativePath;
+      return cookedPath.string() + kCOOKED_EXTENSION;
+    }
+
+    uint64
+    Cooker::getSettingsHash() const
+    {
+      const MeshImportConfiguration& importConfiguration = _m_configuration.importConfiguration;
+
+      // The format version is hashed, so a new format cooks everything again.
+      uint64 hash = Hash::Fnv1a(&MeshFileHeader::VERSION, sizeof(uint32));
+      hash = Hash::Fnv1a
+      (
+        importConfiguration.lodRatios.data(),
+        sizeof(float) * importConfiguration.lodRatios.size(),
+        hash
+      );
+
+      uint8 flags[3] =
+      {
+        importConfiguration.quantizeVertices,
+        importConfiguration.deduplicateMeshes,
+        importConfiguration.staticBatching
+      };
+
+      return Hash::Fnv1a(flags, sizeof(flags), hash);
+    }
+
+    uint64
+    Cooker::getDependenciesStamp(const Vector<String>& dependencies) const
+    {
+      uint64 hash = Hash::FNV_OFFSET_BASIS;
+      for (const String& dependency : dependencies)
+      {
+        std::error_code error;
+        fs::path dependencyPath = fs::path(_m_configuration.sourcePath) / dependency;
+
+        uint64 stamp[2] = { 0, 0 };
+        stamp[0] = static_cast<uint64>(fs::file_size(dependencyPath, error));
+        if (!error)
+        {
+          stamp[1] = static_cast<uint64>(fs::last_write_time(dependencyPath, error).time_since_epoch().count());
+        }
+        if (error)
+        {
+          stamp[0] = static_cast<uint64>(-1);
+          stamp[1] = 0;
+        }
+
+        hash = Hash::Fnv1a(dependency.data(), dependency.size(), hash);
+        hash = Hash::Fnv1a(stamp, sizeof(stamp), hash);
+      }
+
+      return hash;
+    }
+
+    uint64
+    Cooker::hashDependencies(const Vector<String>& dependencies, uint64 hash) const
+    {
+      for (const String& dependency : dependencies)
+      {
+        fs::path dependencyPath = fs::path(_m_configuration.sourcePath) / dependency;
+        std::ifstream file(dependencyPath.string(), std::ios::binary);
+        Vector<char> data
+        (
+          (std::istreambuf_iterator<char>(file)),
+          std::istreambuf_iterator<char>()
+        );
+
+        // A missing dependency hashes differently than an empty one.
+        uint8 found = file.is_open() ? 1 : 0;
+        hash = Hash::Fnv1a(dependency.data(), dependency.size(), hash);
+        hash = Hash::Fnv1a(&found, sizeof(found), hash);
+        hash = Hash::Fnv1a(data.data(), data.size(), hash);
+      }
+
+      return hash;
+    }
+
+    eRESULT
+    Cooker::cookAsset
+    (
+      const String& relativePath,
+      CookRecord& record,
+      const CookRecord* pPrevious,
+      bool& cooked
+    )
+    {
+      cooked = false;
+      fs::path sourcePath = fs::path(_m_configuration.sourcePath) / relativePath;
+      String cookedPath = getCookedPath(relativePath);
+
+      std::ifstream file(sourcePath.string(), std::ios::binary);
+      Vector<char> data
+      (
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>()
+      );
+      if (!file.is_open() || file.bad())
+      {
+        Logger::Error("| Cooker | Couldn't read: " + relativePath);
+        return eRESULT::kFail;
+      }
+
+      uint64 sourceHash = Hash::Fnv1a(data.data(), data.size());
+
+      // Touched but not modified. The dependencies can only change with the
+      // source, so the previous ones are checked.
+      std::error_code error;
+      if (nullptr != pPrevious
+          && pPrevious->sourceHash == hashDependencies(pPrevious->dependencies, sourceHash)
+          && pPrevious->settingsHash == record.settingsHash
+          && fs::exists(cookedPath, error))
+      {
+        record.sourceHash = pPrevious->sourceHash;
+        record.dependencies = pPrevious->dependencies;
+        record.dependenciesStamp = getDependenciesStamp(record.dependencies);
+        return eRESULT::kSuccess;
+      }
+
+      MultiMesh* pMultiMesh = nullptr;
+      try
+      {
+        MeshLoaderGltf meshLoader(_m_configuration.importConfiguration);
+        pMultiMesh = meshLoader.load(sourcePath.string());
+
+        // Relative to the source directory, like the assets.
+        record.dependencies.clear();
+        for (const String& dependency : meshLoader.getDependencies())
+        {
+          fs::path relativeDependency = fs::path(dependency).lexically_proximate(_m_configuration.sourcePath);
+          record.dependencies.push_back(relativeDependency.generic_string());
+        }
+      }
+      catch (const std::exception& exception)
+      {
+        Logger::Error("| Cooker | Couldn't import " + relativePath + ": " + exception.what());
+        return eRESULT::kFail;
+      }
+
+      if (nullptr == pMultiMesh)
+      {
+        Logger::Error("| Cooker | No meshes in: " + relativePath);
+        return eRESULT::kFail;
+      }
+
+      fs::create_directories(fs::path(cookedPath).parent_path(), error);
+
+      MeshFileWriter writer;
+      eRESULT result = writer.write(pMultiMesh, cookedPath);
+      delete pMultiMesh;
+
+      if (eRESULT::kSuccess != result)
+      {
+        Logger::Error("| Cooker | Couldn't write: " + cookedPath);
+        return eRESULT::kFail;
+      }
+
+      record.sourceHash = hashDependencies(record.dependencies, sourceHash);
+      record.dependenciesStamp = getDependenciesStamp(record.dependencies);
+
+      cooked = true;
+      Logger::Log("| Cooker | Cooked: " + relativePath);
+      return eRESULT::kSuccess;
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#include "cookerLogger.h"
+
+namespace hk
+{
+  namespace cooker
+  {
+    void
+    CookerLogger::log(const String& _msg)
+    {
+      std::lock_guard<std::mutex> lock(_m_mutex);
+      LoggerConsole::log(_msg);
+    }
+
+    void
+    CookerLogger::log(const String& _msg, const String& _filename)
+    {
+      std::lock_guard<std::mutex> lock(_m_mutex);
+      LoggerConsole::log(_msg, _filename);
+    }
+
+    void
+    CookerLogger::warning(const String& _msg)
+    {
+      std::lock_guard<std::mutex> lock(_m_mutex);
+      LoggerConsole::warning(_msg);
+    }
+
+    void
+    CookerLogger::warning(const String& _msg, const String& _filename)
+    {
+      std::lock_guard<std::mutex> lock(_m_mutex);
+      LoggerConsole::warning(_msg, _filename);
+    }
+
+    void
+    CookerLogger::error(const String& _msg)
+    {
+      std::lock_guard<std::mutex> lock(_m_mutex);
+      LoggerConsole::error(_msg);
+    }
+
+    void
+    CookerLogger::error(const String& _msg, const String& _filename)
+    {
+      std::lock_guard<std::mutex> lock(_m_mutex);
+      LoggerConsole::error(_msg, _filename);
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "cooker.h"
+#include "cookerLogger.h"
+
+using hk::String;
+using hk::Logger;
+using hk::cooker::Cooker;
+using hk::cooker::CookerConfiguration;
+using hk::cooker::CookerLogger;
+
+namespace
+{
+  void
+  PrintUsage()
+  {
+    Logger::Log
+    (
+      "Usage: hkCooker <source directory> <cache directory> [options]\n"
+      "  -j <threads>     Assets cooked in parallel, all the cores by default.\n"
+      "  --force          Cook every asset, even the unchanged ones.\n"
+      "  --lods <ratios>  Comma separated triangle ratios of the LODs.\n"
+      "  --quantize       Store quantized vertices.\n"
+      "  --deduplicate    Share the meshes with the same content.\n"
+      "  --batch          Merge the static meshes by material."
+    );
+  }
+
+  bool
+  ParseLodRatios(const String& text, hk::Vector<float>& ratios)
+  {
+    ratios.clear();
+
+    size_t start = 0;
+    while (start <= text.size())
+    {
+      size_t end = text.find(',', start);
+      if (String::npos == end)
+      {
+        end = text.size();
+      }
+
+      try
+      {
+        ratios.push_back(std::stof(text.substr(start, end - start)));
+      }
+      catch (const std::exception&)
+      {
+        return false;
+      }
+
+      start = end + 1;
+    }
+
+    return !ratios.empty();
+  }
+}
+
+/**
+ * Offline asset cooker.
+ */
+int main(int argc, char* argv[])
+{
+  Logger::Prepare(new CookerLogger());
+
+  if (argc < 3)
+  {
+    PrintUsage();
+    Logger::Shutdown();
+    return 1;
+  }
+
+  CookerConfiguration configuration;
+  configuration.sourcePath = argv[1];
+  configuration.cachePath = argv[2];
+
+  for (int i = 3; i < argc; ++i)
+  {
+    String option = argv[i];
+    if ("-j" == option && i + 1 < argc)
+    {
+      configuration.threadsSize = static_cast<hk::uint32>(std::strtoul(argv[++i], nullptr, 10));
+    }
+    else if ("--force" == option)
+    {
+      configuration.force = true;
+    }
+    else if ("--lods" == option && i + 1 < argc
+             && ParseLodRatios(argv[++i], configuration.importConfiguration.lodRatios))
+    {
+      continue;
+    }
+    else if ("--quantize" == option)
+    {
+      configuration.importConfiguration.quantizeVertices = true;
+    }
+    else if ("--deduplicate" == option)
+    {
+      configuration.importConfiguration.deduplicateMeshes = true;
+    }
+    else if ("--batch" == option)
+    {
+      configuration.importConfiguration.staticBatching = true;
+    }
+    else
+    {
+      Logger::Error("Invalid option: " + option);
+      PrintUsage();
+      Logger::Shutdown();
+      return 1;
+    }
+  }
+
+  Cooker cooker(configuration);
+  int exitCode = hk::eRESULT::kSuccess == cooker.cook() ? 0 : 1;
+
+  Logger::Shutdown();
+  return exitCode;
+}
\ No newline at end of file
@@ -9,6 +9,8 @@
 #include <Hakool\Core\hkSceneManager.h>
 #include <Hakool\Core\hkResourceManager.h>
 #include <Hakool\Core\hkCameraManager.h>
+#include <Hakool\Core\hkRenderQueue.h>
+#include <Hakool\Core\hkRenderThread.h>
 
 namespace hk
 {
@@ -74,19 +76,22 @@ namespace hk
     postUpdate();
 
     /**
-     * Clears the viewport.
+     * Clears the viewport. With a render thread, the render thread clears
+     * each frame instead.
      */
     void
     clear();
 
     /**
-     * Draws the scene.
+     * Draws the scene. With a render thread, records the frame packet the
+     * render thread draws after present.
      */
     eRESULT
     draw();
 
     /**
-     * Presents the drawed scene in the viewport.
+     * Presents the drawed scene in the viewport. With a render thread,
+     * submits the frame packet and returns without waiting for it.
      */
     void
     present();
@@ -139,6 +144,22 @@ namespace hk
     CameraManager&
     getCameraManager();
 
+    /**
+    * Run a task that uses the graphic context, like creating or destroying
+    * graphic resources. With a render thread it runs there, between frames,
+    * and the call waits for it.
+    * 
+    * @param task The task.
+    */
+    void
+    executeGraphicsTask(const std::function<void()>& task);
+
+    /**
+    * Get the counters of the render thread, empty if there is none.
+    */
+    RenderThreadStats
+    getRenderThreadStats() const;
+
   private:
 
     /**
@@ -228,6 +249,26 @@ namespace hk
     ResourceManager
     _m_resourceManager;
 
+    /**
+    * Draws of the current frame.
+    */
+    RenderQueue
+    _m_renderQueue;
+
+    /**
+    * Draws the frames when renderQueueDepth is set. Started by the first
+    * draw, so the resources created while setting up the scene use the
+    * context on the main thread.
+    */
+    RenderThread
+    _m_renderThread;
+
+    /**
+    * See HakoolConfiguration::renderQueueDepth.
+    */
+    uint32
+    _m_renderQueueDepth;
+
     /**
     * Indicates if the engine has been initialized.
     */
@@ -32,6 +32,14 @@ namespace hk
     */
     ~Camera();
 
+    /**
+     * Copy the properties of another camera, keeping the id of this one.
+     * 
+     * @param _copy The camera to copy.
+     */
+    void
+    copyFrom(const Camera& _copy);
+
     /**
     * Set the camera's near value.
     * 
@@ -30,7 +30,7 @@ namespace hk
     update() override;
 
     virtual void
-    draw(GraphicComponent* pGraphicComponent) override;
+    draw(CommandBuffer& commands) override;
 
     virtual void
     destroy() override;
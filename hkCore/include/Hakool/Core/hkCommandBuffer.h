@@ -0,0 +1,85 @@
+#pragma once
+
+#include <Hakool\Utils\hkUtilitiesUtilities.h>
+#include <Hakool\Utils\hkMatrix4.h>
+#include <Hakool\Utils\hkVector3.h>
+#include <Hakool\Core\hkCorePrerequisites.h>
+#include <Hakool\Core\hkCoreUtilities.h>
+#include <Hakool\Core\hkRenderPacket.h>
+
+namespace hk
+{
+  class IMesh;
+
+  /**
+  * Draws recorded by one thread, independent of the graphic interface.
+  *
+  * The scene is split in chunks and each chunk is recorded into its own
+  * CommandBuffer, so the buffers can be filled in parallel. The RenderQueue
+  * merges them and sorts the result, and the GraphicComponent replays it on
+  * the thread that owns the graphic context.
+  *
+  * Nothing here touches the graphic interface, the recorded commands can be
+  * read back without a GPU.
+  */
+  class HK_CORE_EXPORT CommandBuffer
+  {
+  public:
+
+    /**
+    * Constructor.
+    */
+    CommandBuffer();
+
+    /**
+    * Remove the recorded commands and start a new recording. The memory is
+    * kept.
+    * 
+    * @param viewPosition The position the depth of the draws is measured
+    * from.
+    */
+    void
+    begin(const Vector3f& viewPosition);
+
+    /**
+    * Record a draw. Meshes that are not resident yet are skipped.
+    * 
+    * @param pMesh The mesh to draw.
+    * @param modelMatrix The model space matrix.
+    * @param position The position used for the depth of the draw.
+    * @param material Index of the material.
+    * @param pass The render pass.
+    */
+    void
+    draw
+    (
+      IMesh* pMesh,
+      const Matrix4& modelMatrix,
+      const Vector3f& position,
+      const uint32& material = 0,
+      const eRENDER_PASS& pass = eRENDER_PASS::kOpaque
+    );
+
+    /**
+    * Get the count of recorded commands.
+    */
+    uint32
+    getSize() const;
+
+    /**
+    * Get a command, in recording order.
+    * 
+    * @param index Index of the command.
+    */
+    const RenderPacket&
+    getCommand(const uint32& index) const;
+
+  private:
+
+    Vector<RenderPacket>
+    _m_commands;
+
+    Vector3f
+    _m_viewPosition;
+  };
+}
\ No newline at end of file
@@ -50,7 +50,47 @@ namespace hk
     uchar
   {
     kUndefined,
-    kOpenGL
+    kOpenGL,
+    kNull,
+    kSoftware
+  };
+
+  /**
+  * Enumerates the render passes, in the order they are drawn.
+  */
+  enum class HK_CORE_EXPORT eRENDER_PASS :
+    uchar
+  {
+    kOpaque,
+    kTransparent
+  };
+
+  /**
+  * Enumerates the layouts of the vertices given to a mesh.
+  */
+  enum class HK_CORE_EXPORT eVERTEX_FORMAT :
+    uchar
+  {
+    /**
+    * Three floats per vertex, the position.
+    */
+    kPosition,
+
+    /**
+    * QuantizedVertex, decoded by the vertex shader.
+    */
+    kQuantized
+  };
+
+  /**
+  * Enumerates the types of the indices stored by a mesh.
+  */
+  enum class HK_CORE_EXPORT eINDEX_TYPE :
+    uchar
+  {
+    kNone,
+    kUInt16,
+    kUInt32
   };
 
   /**
@@ -78,7 +118,11 @@ namespace hk
 
     GraphicsConfiguration() :
       graphicInterface(eGRAPHIC_INTERFACE::kUndefined),
-      backgroundColor()
+      backgroundColor(),
+      useIndirectDraws(true),
+      meshUploadBudget(2 * 1024 * 1024),
+      programCacheDirectory(),
+      rasterizerThreads(0)
     {
       return;
     }
@@ -95,6 +139,34 @@ namespace hk
     */
     Color
     backgroundColor;
+
+    /**
+    * Draw the batches of a material with a single multi draw indirect call,
+    * when the graphic API supports it. Otherwise each batch is a draw call.
+    */
+    bool
+    useIndirectDraws;
+
+    /**
+    * Bytes of queued mesh data uploaded each frame. Bigger meshes are
+    * uploaded over several frames. Zero uploads all the queue at once.
+    */
+    uint32
+    meshUploadBudget;
+
+    /**
+    * Directory where the linked programs are cached, so the next launches
+    * load them instead of compiling their shaders. Empty disables the cache.
+    */
+    String
+    programCacheDirectory;
+
+    /**
+    * Threads the software graphic component rasterizes with, including the
+    * render thread. Zero uses one per hardware thread.
+    */
+    uint32
+    rasterizerThreads;
   };
 
   /**
@@ -110,7 +182,8 @@ namespace hk
     */
     HakoolConfiguration() :
       graphicsConfiguration(),
-      windowConfiguration()
+      windowConfiguration(),
+      renderQueueDepth(0)
     {
       return;
     }
@@ -128,6 +201,14 @@ namespace hk
     */
     WindowConfiguration
     windowConfiguration;
+
+    /**
+    * Frame packets in flight with a dedicated render thread: the one the
+    * main thread fills and the ones queued or being drawn. Zero draws and
+    * presents on the main thread, without a render thread.
+    */
+    uint32
+    renderQueueDepth;
   };  
 }
 
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <Hakool\Core\hkCorePrerequisites.h>
+#include <Hakool\Core\hkRenderQueue.h>
+#include <Hakool\Core\hkCamera.h>
+
+namespace hk
+{
+  /**
+  * Everything the render thread needs to draw a frame, copied out of the
+  * scene by the main thread. Once submitted it is only read by the render
+  * thread, so the main thread can change the scene while it is drawn.
+  */
+  struct FramePacket
+  {
+  public:
+
+    FramePacket() :
+      queue(),
+      camera(0),
+      hasCamera(false),
+      frameIndex(0),
+      submitMicroseconds(0)
+    {
+      return;
+    }
+
+    /**
+    * The sorted draws of the visible objects, with their model matrices.
+    */
+    RenderQueue
+    queue;
+
+    /**
+    * Copy of the active camera.
+    */
+    Camera
+    camera;
+
+    /**
+    * False if there was no active camera, the frame is only cleared.
+    */
+    bool
+    hasCamera;
+
+    /**
+    * Count of frames submitted before this one.
+    */
+    uint64
+    frameIndex;
+
+    /**
+    * Time of the submission, in the clock of the RenderThread.
+    */
+    uint64
+    submitMicroseconds;
+  };
+}
\ No newline at end of file
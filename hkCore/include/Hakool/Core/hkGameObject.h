@@ -12,7 +12,8 @@
 namespace hk
 {
   class Scene;
-  class GraphicComponent;
+  class CommandBuffer;
+  class JobPool;
 
   /**
   * Base class for any entity in scene.
@@ -60,10 +61,37 @@ namespace hk
     update();
 
     /**
-     * TODO
+     * Record the draws of this object and its children.
+     * 
+     * @param commands The CommandBuffer of the scene chunk.
      */
     void
-    draw(GraphicComponent* pGraphicComponet);
+    draw(CommandBuffer& commands);
+
+    /**
+     * Record the draws of this object and its children, with the children
+     * split in chunks recorded by the threads of a pool. Scenes with few
+     * objects use a single chunk.
+     * 
+     * @param commandBuffers Receives a buffer per chunk, in the order of the
+     * children. The draws of this object's components are in the first one.
+     * @param viewPosition The position the depth of the draws is measured
+     * from.
+     * @param jobPool The threads recording the chunks, one chunk per thread.
+     */
+    void
+    drawParallel
+    (
+      Vector<CommandBuffer>& commandBuffers,
+      const Vector3f& viewPosition,
+      JobPool& jobPool
+    );
+
+    /**
+     * Get the model matrix computed by the last draw.
+     */
+    const Matrix4&
+    getModelMatrix() const;
 
     /**
     * Add a new component to this game object.
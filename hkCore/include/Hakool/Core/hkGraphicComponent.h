@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Hakool\Utils\hkMatrix4.h>
+#include <Hakool\Utils\hkVector3.h>
 #include <Hakool\Utils\hkWindowObserver.h>
 #include <Hakool\Core\hkCorePrerequisites.h>
 #include <Hakool\Core\hkEngineComponent.h>
@@ -17,6 +18,8 @@ namespace hk
   class Color;
   class IMesh;
   class Camera;
+  class RenderQueue;
+  struct RenderStats;
 
   struct WindowConfiguration;
 
@@ -65,12 +68,35 @@ namespace hk
     virtual void
     prepareToDraw(Camera* pCamera) = 0;
 
+    /**
+    * Upload the meshes queued in the MeshUploadQueue of the resource
+    * manager, up to the upload budget of a frame. Called once per frame on
+    * the thread that owns the graphic context, before clear.
+    */
+    virtual void
+    uploadMeshes() = 0;
+
     /**
      * Draw the given scene in the screen.
      */
     virtual void
     drawScene(Scene* pScene) = 0;
 
+    /**
+    * Draw the packets of a sorted RenderQueue, skipping the binds and state
+    * changes that are already set.
+    * 
+    * @param queue The sorted queue.
+    */
+    virtual void
+    drawQueue(const RenderQueue& queue) = 0;
+
+    /**
+    * Get the counters of the last drawQueue call.
+    */
+    virtual const RenderStats&
+    getRenderStats() = 0;
+
     /*
     * Set the model space matrix. Usually used before drawing the Meshes of the
     * Model.
@@ -80,6 +106,17 @@ namespace hk
     virtual void
     setModelMatrix(const Matrix4& modelMatrix) = 0;
 
+    /**
+    * Set the transformation that decodes the quantized positions of the next
+    * Meshes: position = offset + scale * quantizedPosition. Meshes with float
+    * positions use a zero offset and a unit scale.
+    * 
+    * @param offset Position offset.
+    * @param scale Position scale.
+    */
+    virtual void
+    setPositionDequantization(const Vector3f& offset, const Vector3f& scale) = 0;
+
     /**
      * Create a Mesh.
      * 
@@ -88,6 +125,16 @@ namespace hk
     virtual IMesh*
     createMesh() = 0;
 
+    /**
+    * Destroy a Mesh given by createMesh, with the part of its data being
+    * uploaded. Called on the thread that owns the graphic context, once no
+    * frame draws the mesh, and after its queued uploads are cancelled.
+    * 
+    * @param pMesh The mesh, deleted by the call.
+    */
+    virtual void
+    destroyMesh(IMesh* pMesh) = 0;
+
     /**
     * Get a pointer to a new vertex shader.
     * 
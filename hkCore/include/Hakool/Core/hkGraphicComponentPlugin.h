@@ -0,0 +1,99 @@
+#pragma once
+
+#include <Hakool\Utils\hkIPlugin.h>
+#include <Hakool\Core\hkCorePrerequisites.h>
+
+namespace hk
+{
+  /**
+  * Provides connection from a PluginManager to a DLL services.
+  *
+  * Creates and provides access to a GraphicComponent instance, also it
+  * delete and free its memory when the plug-in is about to close. Note that
+  * this object doesn't initialize the GraphicComponent. Each graphics
+  * plug-in exports the functions that create and destroy its own.
+  */
+  template<class C>
+  class GraphicComponentPlugin :
+    public IPlugin
+  {
+  public:
+
+    GraphicComponentPlugin();
+
+    ~GraphicComponentPlugin();
+
+    /**
+     * Creates a GraphicComponent instance.
+     */
+    virtual void
+    onConnect() override;
+
+    /**
+    * Delete and free the memory utilized by the GraphicComponent.
+    */
+    virtual void
+    onClose() override;
+
+    /**
+    * Get a pointer to the GraphicComponent instance.
+    *
+    * @return Pointer to the GraphicComponent instance.
+    */
+    virtual void*
+    getData() override;
+
+  private:
+
+    /**
+    * Pointer to the Graphic Component.
+    */
+    C*
+    _m_pGraphicComponent;
+  };
+
+  template<class C>
+  inline GraphicComponentPlugin<C>::GraphicComponentPlugin() :
+    _m_pGraphicComponent(nullptr)
+  {
+    return;
+  }
+
+  template<class C>
+  inline GraphicComponentPlugin<C>::~GraphicComponentPlugin()
+  {
+    return;
+  }
+
+  template<class C>
+  inline void
+  GraphicComponentPlugin<C>::onConnect()
+  {
+    if (_m_pGraphicComponent == nullptr)
+    {
+      _m_pGraphicComponent = new C();
+    }
+
+    return;
+  }
+
+  template<class C>
+  inline void
+  GraphicComponentPlugin<C>::onClose()
+  {
+    if (_m_pGraphicComponent != nullptr)
+    {
+      delete _m_pGraphicComponent;
+      _m_pGraphicComponent = nullptr;
+    }
+
+    return;
+  }
+
+  template<class C>
+  inline void*
+  GraphicComponentPlugin<C>::getData()
+  {
+    return reinterpret_cast<void*>(_m_pGraphicComponent);
+  }
+}
\ No newline at end of file
@@ -6,7 +6,7 @@
 namespace hk
 {
   class GameObject;
-  class GraphicComponent;
+  class CommandBuffer;
 
   /**
   * Encapsulates a piece of logic that defines part of the behavior of the GameObject
@@ -34,10 +34,13 @@ namespace hk
     update() = 0;
 
     /**
-     *
+     * Record the draws of this component. It may run on a recording thread,
+     * in parallel with the components of other GameObjects.
+     * 
+     * @param commands The CommandBuffer of the scene chunk.
      */
     virtual void
-    draw(GraphicComponent* pGraphicComponent) = 0;
+    draw(CommandBuffer& commands) = 0;
 
     /**
     * Called when the GameObject is being destroyed.
@@ -2,6 +2,7 @@
 
 #include <Hakool/Core/hkCorePrerequisites.h>
 #include <Hakool/Core/hkIResource.h>
+#include <Hakool/Core/hkMeshDescription.h>
 
 namespace hk
 {
@@ -18,13 +19,23 @@ namespace hk
     virtual ~IMesh() = default;
 
     /**
-     * Initialize the mesh with vertices data.
+     * Initialize the mesh. Indexed meshes store their indices with the
+     * smallest type able to address their vertices.
      * 
-     * @param aVertexes Array of vertexes.
-     * @param size Total count of vertexes.
+     * @param description Vertices, their format and the optional indices.
      */
     virtual void
-    init(float* aVertexes, const uint32& size) = 0;
+    init(const MeshDescription& description) = 0;
+
+    /**
+    * Check if the mesh data is on the GPU and the mesh can be drawn. Meshes
+    * given to the MeshUploadQueue are not resident until the GraphicComponent
+    * has uploaded all of their data. May be called from any thread.
+    * 
+    * @return True if the mesh can be drawn.
+    */
+    virtual bool
+    isResident() = 0;
 
     /**
      * Transfer the mesh data to the graphic component to be drawn properly.
@@ -49,5 +60,14 @@ namespace hk
     */
     virtual float*
     getVertexesArray() = 0;
+
+    /**
+    * Get an id that identifies this mesh among the meshes of its
+    * GraphicComponent. Used to group the draws of a RenderQueue.
+    * 
+    * @return The id of the mesh.
+    */
+    virtual uint32
+    getId() = 0;
   };
 }
\ No newline at end of file
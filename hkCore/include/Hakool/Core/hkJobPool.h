@@ -0,0 +1,132 @@
+#pragma once
+
+#include <Hakool\Utils\hkUtilitiesUtilities.h>
+#include <Hakool\Core\hkCorePrerequisites.h>
+#include <Hakool\Core\hkCoreUtilities.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace hk
+{
+  /**
+  * Threads kept alive between frames to run the jobs of a frame, so no
+  * thread is created or joined while the frame is produced.
+  *
+  * run splits the work in jobs taken by the pool threads and the calling
+  * one. A job is only given its index, so the result of jobs that write
+  * to their own outputs doesn't depend on which thread ran them.
+  *
+  * Only call run from one thread at a time.
+  */
+  class HK_CORE_EXPORT JobPool
+  {
+  public:
+
+    /**
+    * Constructor. The pool has no thread until init.
+    */
+    JobPool();
+
+    /**
+    * Destructor. Stops the threads.
+    */
+    ~JobPool();
+
+    /**
+    * Start the threads, stopping the previous ones.
+    *
+    * @param threadsSize Threads that run the jobs, including the calling
+    * one. 0 uses one per hardware thread.
+    */
+    void
+    init(const uint32& threadsSize);
+
+    /**
+    * Stop the threads. The jobs given to run are then run by the calling
+    * thread.
+    */
+    void
+    destroy();
+
+    /**
+    * Get the count of threads that run the jobs, including the calling one.
+    */
+    uint32
+    getThreadsSize() const;
+
+    /**
+    * Run a job for every index, and wait for all of them.
+    *
+    * @param jobsSize Count of jobs.
+    * @param job Called with the index of each job, from any of the threads.
+    */
+    void
+    run(const uint32& jobsSize, const std::function<void(uint32)>& job);
+
+  private:
+
+    /**
+    * Loop of the threads other than the calling one.
+    */
+    void
+    _run();
+
+    /**
+    * Take and run jobs until there is none left.
+    */
+    void
+    _runJobs();
+
+    Vector<std::thread>
+    _m_threads;
+
+    /**
+    * Job of the current run.
+    */
+    const std::function<void(uint32)>*
+    _m_pJob;
+
+    uint32
+    _m_jobsSize;
+
+    /**
+    * Index of the next job to take.
+    */
+    std::atomic<uint32>
+    _m_nextJob;
+
+    /**
+    * Incremented for each run, a thread takes jobs when it changes.
+    */
+    uint64
+    _m_runIndex;
+
+    /**
+    * Threads still taking jobs of the current run.
+    */
+    uint32
+    _m_busyThreads;
+
+    bool
+    _m_stopRequested;
+
+    std::mutex
+    _m_mutex;
+
+    /**
+    * Signaled when a run or the stop request is given.
+    */
+    std::condition_variable
+    _m_runQueued;
+
+    /**
+    * Signaled when the last thread finishes its jobs.
+    */
+    std::condition_variable
+    _m_runDone;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <Hakool\Utils\hkQuantizedVertex.h>
+#include <Hakool\Core\hkCorePrerequisites.h>
+#include <Hakool\Core\hkCoreUtilities.h>
+
+namespace hk
+{
+  /**
+  * The data a mesh is created from. The arrays are only read during
+  * IMesh::init.
+  */
+  struct MeshDescription
+  {
+  public:
+
+    MeshDescription() :
+      vertexFormat(eVERTEX_FORMAT::kPosition),
+      pVertices(nullptr),
+      verticesSize(0),
+      pIndices(nullptr),
+      indicesSize(0),
+      quantization()
+    {
+      return;
+    }
+
+    /**
+    * Get the smallest index type able to address the vertices.
+    *
+    * @return kNone if the mesh has no indices.
+    */
+    eINDEX_TYPE
+    getIndexType() const
+    {
+      if (pIndices == nullptr || 0 == indicesSize)
+      {
+        return eINDEX_TYPE::kNone;
+      }
+
+      return verticesSize <= 0x10000 ? eINDEX_TYPE::kUInt16 : eINDEX_TYPE::kUInt32;
+    }
+
+    /**
+    * Get the bytes of a vertex in the layout of the vertex format.
+    */
+    uint32
+    getVertexSize() const
+    {
+      return vertexFormat == eVERTEX_FORMAT::kQuantized
+        ? static_cast<uint32>(sizeof(QuantizedVertex))
+        : static_cast<uint32>(sizeof(float) * 3);
+    }
+
+    /**
+    * Layout of the vertices.
+    */
+    eVERTEX_FORMAT
+    vertexFormat;
+
+    /**
+    * Vertices, in the layout of the vertex format.
+    */
+    const void*
+    pVertices;
+
+    uint32
+    verticesSize;
+
+    /**
+    * Triangle list indices, or nullptr to draw the vertices in order.
+    */
+    const uint32*
+    pIndices;
+
+    uint32
+    indicesSize;
+
+    /**
+    * Parameters to decode kQuantized vertices.
+    */
+    VertexQuantization
+    quantization;
+  };
+}
\ No newline at end of file
@@ -3,10 +3,13 @@
 #include "hkCorePrerequisites.h"
 #include "hkIMesh.h"
 #include "hkResourceGroup.h"
+#include "hkMeshUploadQueue.h"
 
 namespace hk
 {
   class GraphicComponent;
+  class RenderThread;
+  class MultiMesh;
 
   class HK_CORE_EXPORT MeshResourceGroup : public ResourceGroup<IMesh>
   {
@@ -17,22 +20,71 @@ namespace hk
     virtual ~MeshResourceGroup();
 
     /**
-     * TODO
+     * Initialize the group.
+     *
+     * @param pGraphicComponent The component creating the meshes.
+     * @param pRenderThread The thread the meshes are destroyed on once the
+     * frames that draw them are presented.
      */
     void
-    init(GraphicComponent* pGraphicComponent);
+    init(GraphicComponent* pGraphicComponent, RenderThread* pRenderThread);
 
     /**
      * Gets the cube mesh.
      * <p>
      * The cube mesh is created only once in the life of the application, so the
-     * same mesh is returned by this function each time it is called.
+     * same mesh is returned by this function each time it is called. Its data
+     * goes through the upload queue like the other meshes.
      * 
      * @return Mesh of the cube.
      */
     IMesh*
     getCube();
 
+    /**
+     * Gets the mesh of a mesh of a multimesh.
+     * <p>
+     * Meshes are shared by their content hash, so identical meshes of
+     * different nodes or files are created only once. Meshes with the same
+     * hash are compared byte to byte before sharing them, and meshes without
+     * a hash are never shared. The quantized vertices are used if the
+     * multimesh has them.
+     * <p>
+     * The data of the mesh is copied to the upload queue, the mesh is drawn
+     * once the GraphicComponent has uploaded it.
+     *
+     * @param pMultiMesh Multimesh with the mesh.
+     * @param meshIndex Index of the mesh in the multimesh.
+     *
+     * @return The shared mesh.
+     */
+    IMesh*
+    getMesh(MultiMesh* pMultiMesh, const uint32& meshIndex);
+
+    /**
+     * Gets the meshes waiting for their data to be uploaded.
+     */
+    MeshUploadQueue&
+    getUploadQueue();
+
+    /**
+     * Remove a mesh and destroy it on the render thread, once the frames
+     * that may draw it are presented.
+     *
+     * @param _key The identifier of the mesh.
+     *
+     * @return Operation result.
+     */
+    eRESULT
+    removeAndDestroy(const String& _key);
+
+    /**
+     * Drop the queued uploads, then remove and destroy all the meshes. The
+     * render thread must be stopped.
+     */
+    void
+    clear();
+
   protected:
 
     /**
@@ -40,5 +92,24 @@ namespace hk
      */
     GraphicComponent* 
     _m_pGraphicComponent;
+
+    RenderThread*
+    _m_pRenderThread;
+
+    MeshUploadQueue
+    _m_uploadQueue;
+
+    /**
+     * Content of the shared meshes, by their key, compared with the meshes
+     * of the same hash.
+     */
+    Map<String, Vector<uint8>>
+    _m_sharedContents;
+
+    /**
+     * Count of the meshes without a content hash, to give them a key.
+     */
+    uint32
+    _m_unsharedMeshesSize;
   };
 }
\ No newline at end of file
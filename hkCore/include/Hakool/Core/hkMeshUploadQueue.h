@@ -0,0 +1,135 @@
+#pragma once
+
+#include <Hakool\Utils\hkUtilitiesUtilities.h>
+#include <Hakool\Core\hkCorePrerequisites.h>
+#include <Hakool\Core\hkCoreUtilities.h>
+#include <Hakool\Core\hkMeshDescription.h>
+
+#include <deque>
+#include <mutex>
+
+namespace hk
+{
+  class IMesh;
+
+  /**
+  * Copy of the data of a mesh waiting to be uploaded.
+  */
+  struct HK_CORE_EXPORT MeshUpload
+  {
+  public:
+
+    MeshUpload();
+
+    /**
+    * Get the description of the mesh, pointing to the arrays of this upload.
+    */
+    MeshDescription
+    getDescription() const;
+
+    /**
+    * Get the bytes of the vertices and of the indices.
+    */
+    hkSize
+    getSize() const;
+
+    /**
+    * The mesh the data is uploaded to.
+    */
+    IMesh*
+    pMesh;
+
+    eVERTEX_FORMAT
+    vertexFormat;
+
+    uint32
+    verticesSize;
+
+    /**
+    * Vertices, in the layout of the vertex format.
+    */
+    Vector<uint8>
+    vertices;
+
+    /**
+    * Triangle list indices, empty to draw the vertices in order.
+    */
+    Vector<uint32>
+    indices;
+
+    VertexQuantization
+    quantization;
+  };
+
+  /**
+  * Meshes waiting for their data to be uploaded to the GPU.
+  *
+  * Loader threads enqueue the CPU data of the meshes they create, and the
+  * GraphicComponent uploads them a few at a time on the thread that owns the
+  * graphic context, so loading a model never stalls a frame. A mesh is not
+  * resident, and isn't drawn, until all of its data is uploaded.
+  *
+  * Every method is thread safe.
+  */
+  class HK_CORE_EXPORT MeshUploadQueue
+  {
+  public:
+
+    MeshUploadQueue();
+
+    /**
+    * Copy the data of a mesh and queue its upload.
+    *
+    * @param pMesh The mesh, not initialized. It must not be destroyed while
+    * its upload is queued, MeshResourceGroup::removeAndDestroy cancels it.
+    * @param description The data of the mesh, only read during the call.
+    */
+    void
+    enqueue(IMesh* pMesh, const MeshDescription& description);
+
+    /**
+    * Take the oldest upload.
+    *
+    * @param upload Receives the upload.
+    *
+    * @return False if the queue is empty.
+    */
+    bool
+    pop(MeshUpload& upload);
+
+    /**
+    * Remove the queued uploads of a mesh, before destroying it.
+    */
+    void
+    cancel(IMesh* pMesh);
+
+    /**
+    * Remove every queued upload.
+    */
+    void
+    clear();
+
+    /**
+    * Get the count of queued uploads.
+    */
+    uint32
+    getSize() const;
+
+    /**
+    * Get the bytes of the queued uploads.
+    */
+    hkSize
+    getPendingBytes() const;
+
+  private:
+
+    mutable std::mutex
+    _m_mutex;
+
+    std::deque<MeshUpload>
+    _m_uploads;
+
+    hkSize
+    _m_pendingBytes;
+  };
+}
\ No newline at end of file
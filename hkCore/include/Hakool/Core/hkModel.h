@@ -1,12 +1,14 @@
 #pragma once
 
 #include <Hakool/Utils/hkUtilitiesUtilities.h>
+#include <Hakool/Utils/hkMatrix4.h>
+#include <Hakool/Utils/hkVector3.h>
 #include <Hakool/Core/hkCorePrerequisites.h>
 
 namespace hk
 {
   class IMesh;
-  class GraphicComponent;
+  class CommandBuffer;
 
   /**
   * TODO
@@ -38,8 +40,15 @@ namespace hk
     void
     setMesh(IMesh* pMesh);
 
+    /**
+    * Record the draw of the mesh.
+    * 
+    * @param commands The CommandBuffer of the scene chunk.
+    * @param modelMatrix The model space matrix.
+    * @param position The position of the model, used to sort the draws.
+    */
     void
-    draw(GraphicComponent* pGraphicComponent);
+    draw(CommandBuffer& commands, const Matrix4& modelMatrix, const Vector3f& position);
 
   private:
 
@@ -30,7 +30,7 @@ namespace hk
     update();
 
     void
-    draw(GraphicComponent* pGraphicComponent);
+    draw(CommandBuffer& commands);
 
     void
     destroy();
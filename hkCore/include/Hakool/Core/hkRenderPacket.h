@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Hakool\Utils\hkMatrix4.h>
+#include <Hakool\Core\hkCorePrerequisites.h>
+
+namespace hk
+{
+  class IMesh;
+
+  /**
+  * A draw recorded in a RenderQueue.
+  */
+  struct RenderPacket
+  {
+  public:
+
+    RenderPacket() :
+      sortKey(0),
+      pMesh(nullptr),
+      modelMatrix()
+    {
+      return;
+    }
+
+    /**
+    * Key the packets are sorted by. See RenderQueue::MakeSortKey.
+    */
+    uint64
+    sortKey;
+
+    /**
+    * Mesh to draw.
+    */
+    IMesh*
+    pMesh;
+
+    /**
+    * Model space matrix, as uploaded to the program.
+    */
+    Matrix4
+    modelMatrix;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <Hakool\Utils\hkUtilitiesUtilities.h>
+#include <Hakool\Utils\hkMatrix4.h>
+#include <Hakool\Utils\hkVector3.h>
+#include <Hakool\Core\hkCorePrerequisites.h>
+#include <Hakool\Core\hkCoreUtilities.h>
+#include <Hakool\Core\hkRenderPacket.h>
+
+namespace hk
+{
+  class IMesh;
+  class CommandBuffer;
+
+  /**
+  * Collects the draws of a frame as RenderPackets and sorts them by a 64 bit
+  * key, so the GraphicComponent can execute them with the fewest binds and
+  * state changes.
+  *
+  * The key holds, from the most significant bits: pass, program, material,
+  * mesh and depth. Opaque packets are sorted front to back and transparent
+  * ones back to front.
+  */
+  class HK_CORE_EXPORT RenderQueue
+  {
+  public:
+
+    /**
+    * Constructor.
+    */
+    RenderQueue();
+
+    /**
+    * Build a sort key. Each field is truncated to its bits.
+    * 
+    * @param pass Render pass.
+    * @param program Id of the program.
+    * @param material Index of the material.
+    * @param mesh Id of the mesh.
+    * @param depth Distance to the viewer, non-negative.
+    * 
+    * @return The sort key.
+    */
+    static uint64
+    MakeSortKey
+    (
+      const eRENDER_PASS& pass,
+      const uint32& program,
+      const uint32& material,
+      const uint32& mesh,
+      const float& depth
+    );
+
+    /**
+    * Get the part of a sort key above the depth. Consecutive packets with the
+    * same batch key only differ by their depth and model matrix, so they can
+    * be drawn as instances of a single draw call.
+    * 
+    * @param sortKey The sort key.
+    * 
+    * @return The batch key.
+    */
+    static uint64
+    GetBatchKey(const uint64& sortKey);
+
+    /**
+    * Get the part of a sort key above the mesh. Consecutive packets with the
+    * same material key use the same pass, program and material, so their
+    * batches can be submitted with a single multi draw call.
+    * 
+    * @param sortKey The sort key.
+    * 
+    * @return The material key.
+    */
+    static uint64
+    GetMaterialKey(const uint64& sortKey);
+
+    /**
+    * Set the position the depth of the packets is measured from.
+    * 
+    * @param position The viewer position.
+    */
+    void
+    setViewPosition(const Vector3f& position);
+
+    const Vector3f&
+    getViewPosition() const;
+
+    /**
+    * Add a draw. Meshes that are not resident yet are skipped.
+    * 
+    * @param pMesh The mesh to draw.
+    * @param modelMatrix The model space matrix.
+    * @param position The position used for the depth of the packet.
+    * @param material Index of the material.
+    * @param pass The render pass.
+    */
+    void
+    push
+    (
+      IMesh* pMesh,
+      const Matrix4& modelMatrix,
+      const Vector3f& position,
+      const uint32& material = 0,
+      const eRENDER_PASS& pass = eRENDER_PASS::kOpaque
+    );
+
+    /**
+    * Sort the packets by their key with a radix sort. Packets with the same
+    * key keep their submission order.
+    */
+    void
+    sort();
+
+    /**
+    * Replace the packets by the commands of several CommandBuffers, sorted
+    * with sort. Commands with the same key keep the order of their buffers,
+    * so the result doesn't depend on how the recording was scheduled.
+    * 
+    * @param commandBuffers The command buffers, in scene order.
+    */
+    void
+    merge(const Vector<CommandBuffer>& commandBuffers);
+
+    /**
+    * Remove all the packets. The memory is kept for the next frame.
+    */
+    void
+    clear();
+
+    /**
+    * Get the count of packets.
+    */
+    uint32
+    getSize() const;
+
+    /**
+    * Get a packet, in sorted order once sort has been called.
+    * 
+    * @param index Index of the packet.
+    */
+    const RenderPacket&
+    getPacket(const uint32& index) const;
+
+    static const uint32 PASS_BITS = 4;
+    static const uint32 PROGRAM_BITS = 12;
+    static const uint32 MATERIAL_BITS = 12;
+    static const uint32 MESH_BITS = 20;
+    static const uint32 DEPTH_BITS = 16;
+
+  private:
+
+    /**
+    * Key and packet index sorted in place of the packets.
+    */
+    struct SortEntry
+    {
+      uint64 key;
+      uint32 index;
+    };
+
+    Vector<RenderPacket>
+    _m_packets;
+
+    /**
+    * Packets order.
+    */
+    Vector<SortEntry>
+    _m_order;
+
+    /**
+    * Radix sort buffer.
+    */
+    Vector<SortEntry>
+    _m_scratch;
+
+    Vector3f
+    _m_viewPosition;
+  };
+}
\ No newline at end of file
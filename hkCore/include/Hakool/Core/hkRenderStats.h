@@ -0,0 +1,132 @@
+#pragma once
+
+#include <Hakool\Core\hkCorePrerequisites.h>
+
+namespace hk
+{
+  /**
+  * Counters of a RenderQueue execution. The skipped counters are the binds
+  * and state changes that drawing each packet on its own would have issued.
+  */
+  struct RenderStats
+  {
+  public:
+
+    RenderStats() :
+      packets(0),
+      drawCalls(0),
+      indirectDraws(0),
+      meshBinds(0),
+      skippedMeshBinds(0),
+      uniformSets(0),
+      skippedUniformSets(0),
+      stateSets(0),
+      skippedStateSets(0),
+      stateCalls(0),
+      filteredStateCalls(0),
+      streamStalls(0),
+      uploadedBytes(0),
+      movedBytes(0),
+      pendingUploads(0)
+    {
+      return;
+    }
+
+    /**
+    * Get the binds and state changes saved by the sorting.
+    */
+    uint32
+    getSavedStateChanges() const
+    {
+      return skippedMeshBinds + skippedUniformSets + skippedStateSets;
+    }
+
+    /**
+    * Packets drawn.
+    */
+    uint32
+    packets;
+
+    /**
+    * Draw calls issued. Packets of a batch are drawn with one instanced call.
+    */
+    uint32
+    drawCalls;
+
+    /**
+    * Batches drawn from an indirect command buffer. A multi draw call
+    * executes several of them and counts as one draw call.
+    */
+    uint32
+    indirectDraws;
+
+    /**
+    * Vertex buffer and attribute layout binds.
+    */
+    uint32
+    meshBinds;
+
+    uint32
+    skippedMeshBinds;
+
+    /**
+    * Model matrix uploads. Instanced packets stream their matrices in a
+    * buffer instead. The uploads that drawing each packet on its own would
+    * have issued, where the matrix differs from the one of the previous
+    * packet of the same program, count as skipped.
+    */
+    uint32
+    uniformSets;
+
+    uint32
+    skippedUniformSets;
+
+    /**
+    * Depth state changes issued before the draw calls. Each draw call sets
+    * the state, the sets that wouldn't change it are skipped.
+    */
+    uint32
+    stateSets;
+
+    uint32
+    skippedStateSets;
+
+    /**
+    * Graphics API state calls of the frame that reached the driver.
+    */
+    uint32
+    stateCalls;
+
+    /**
+    * Redundant state calls of the frame dropped by the backend before
+    * reaching the driver.
+    */
+    uint32
+    filteredStateCalls;
+
+    /**
+    * Waits for the GPU to release the streaming memory of an older frame.
+    */
+    uint32
+    streamStalls;
+
+    /**
+    * Mesh data uploaded from the MeshUploadQueue during the frame, in bytes.
+    */
+    uint32
+    uploadedBytes;
+
+    /**
+    * Geometry copied by the GPU during the frame to grow or compact the
+    * arena, in bytes. It shares the upload budget with uploadedBytes.
+    */
+    uint32
+    movedBytes;
+
+    /**
+    * Meshes still waiting in the MeshUploadQueue, or being uploaded.
+    */
+    uint32
+    pendingUploads;
+  };
+}
\ No newline at end of file
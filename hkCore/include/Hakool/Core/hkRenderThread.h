@@ -0,0 +1,283 @@
+#pragma once
+
+#include <Hakool\Utils\hkUtilitiesUtilities.h>
+#include <Hakool\Utils\hkClock.h>
+#include <Hakool\Core\hkCorePrerequisites.h>
+#include <Hakool\Core\hkCoreUtilities.h>
+#include <Hakool\Core\hkFramePacket.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace hk
+{
+  class GraphicComponent;
+
+  /**
+  * Counters of a RenderThread since it started.
+  */
+  struct RenderThreadStats
+  {
+  public:
+
+    RenderThreadStats() :
+      framesSubmitted(0),
+      framesPresented(0),
+      submitStalls(0),
+      submitStallMicroseconds(0),
+      renderMicroseconds(0),
+      idleMicroseconds(0),
+      latencyMicroseconds(0),
+      lastLatencyMicroseconds(0),
+      maxLatencyMicroseconds(0)
+    {
+      return;
+    }
+
+    /**
+    * Get the mean time from the submission of a frame to its present.
+    */
+    uint64
+    getAverageLatencyMicroseconds() const
+    {
+      return framesPresented > 0 ? latencyMicroseconds / framesPresented : 0;
+    }
+
+    uint64
+    framesSubmitted;
+
+    uint64
+    framesPresented;
+
+    /**
+    * Times the main thread waited for a free frame packet, because the
+    * render thread was a whole queue behind.
+    */
+    uint64
+    submitStalls;
+
+    uint64
+    submitStallMicroseconds;
+
+    /**
+    * Time the render thread spent drawing and presenting.
+    */
+    uint64
+    renderMicroseconds;
+
+    /**
+    * Time the render thread spent waiting for a frame.
+    */
+    uint64
+    idleMicroseconds;
+
+    /**
+    * Sum of the submission to present times of every frame.
+    */
+    uint64
+    latencyMicroseconds;
+
+    uint64
+    lastLatencyMicroseconds;
+
+    uint64
+    maxLatencyMicroseconds;
+  };
+
+  /**
+  * A thread that owns the graphic context and draws the frames produced by
+  * the main thread.
+  *
+  * The main thread acquires a FramePacket, fills it and submits it, then
+  * goes on with the next frame while the render thread clears, draws and
+  * presents the submitted one. The queue depth is the count of packets in
+  * flight: the one being filled and the ones queued or being drawn.
+  *
+  * Graphic resources must not be created or destroyed by the main thread
+  * while the render thread runs: create them with execute or through the
+  * MeshUploadQueue, and destroy them with retire.
+  */
+  class HK_CORE_EXPORT RenderThread
+  {
+  public:
+
+    /**
+    * Constructor.
+    */
+    RenderThread();
+
+    /**
+    * Destructor. Stops the thread.
+    */
+    ~RenderThread();
+
+    /**
+    * Release the graphic context of the calling thread and start the render
+    * thread, which makes it current.
+    *
+    * @param pGraphicComponent The component drawing the frames.
+    * @param queueDepth Packets in flight, at least 1. With 1 the main thread
+    * waits for each frame to be presented before filling the next one.
+    *
+    * @return Operation result.
+    */
+    eRESULT
+    start(GraphicComponent* pGraphicComponent, const uint32& queueDepth);
+
+    /**
+    * Get the packet of the next frame, waiting if every packet is still
+    * queued or being drawn. The packet keeps the data of an older frame.
+    */
+    FramePacket&
+    acquireFrame();
+
+    /**
+    * Queue the packet given by acquireFrame to be drawn and presented.
+    */
+    void
+    submitFrame();
+
+    /**
+    * Run a task on the render thread, between two frames, and wait for it.
+    * Runs it on the calling thread if the render thread isn't running.
+    *
+    * @param task The task, free to use the graphic context.
+    */
+    void
+    execute(const std::function<void()>& task);
+
+    /**
+    * Run a task on the render thread once every frame that may reference a
+    * resource is presented: the submitted ones and the one being filled.
+    * Used to destroy the resources the queued packets point to. Runs it on
+    * the calling thread if the render thread isn't running.
+    *
+    * @param task The task, free to use the graphic context.
+    */
+    void
+    retire(const std::function<void()>& task);
+
+    /**
+    * Wait until every submitted frame is presented.
+    */
+    void
+    waitIdle();
+
+    /**
+    * Present the submitted frames, stop the thread and make the graphic
+    * context current on the calling thread again.
+    */
+    void
+    stop();
+
+    bool
+    isRunning() const;
+
+    /**
+    * Get a copy of the counters.
+    */
+    RenderThreadStats
+    getStats() const;
+
+  private:
+
+    /**
+    * Body of the render thread.
+    */
+    void
+    _run();
+
+    /**
+    * Clear, draw and present a frame.
+    */
+    void
+    _drawFrame(FramePacket& packet);
+
+    /**
+    * Run the retired tasks whose frames are presented. Called with the mutex
+    * locked, it unlocks it while a task runs.
+    *
+    * @param lock Lock of the mutex.
+    */
+    void
+    _runRetiredTasks(std::unique_lock<std::mutex>& lock);
+
+    GraphicComponent*
+    _m_pGraphicComponent;
+
+    /**
+    * queueDepth packets, used in ring order: the one being filled and the
+    * submitted ones. Allocated one by one, a FramePacket can't be copied.
+    */
+    Vector<FramePacket*>
+    _m_packets;
+
+    /**
+    * Packet filled by the main thread.
+    */
+    uint32
+    _m_writeIndex;
+
+    /**
+    * Packet drawn by the render thread.
+    */
+    uint32
+    _m_readIndex;
+
+    /**
+    * Packets submitted and not presented yet.
+    */
+    uint32
+    _m_submittedSize;
+
+    /**
+    * Task given to execute, run before the next frame.
+    */
+    const std::function<void()>*
+    _m_pTask;
+
+    /**
+    * Tasks given to retire, with the index of the last frame that may
+    * reference their resources, in the order they were retired.
+    */
+    std::deque<std::pair<uint64, std::function<void()>>>
+    _m_retiredTasks;
+
+    bool
+    _m_stopRequested;
+
+    bool
+    _m_isRunning;
+
+    /**
+    * Measures the latencies, shared by both threads.
+    */
+    Clock*
+    _m_pClock;
+
+    RenderThreadStats
+    _m_stats;
+
+    mutable std::mutex
+    _m_mutex;
+
+    /**
+    * Signaled when a frame, a task or the stop request is queued.
+    */
+    std::condition_variable
+    _m_workQueued;
+
+    /**
+    * Signaled when a frame is presented or a task is done.
+    */
+    std::condition_variable
+    _m_workDone;
+
+    std::thread
+    _m_thread;
+  };
+}
\ No newline at end of file
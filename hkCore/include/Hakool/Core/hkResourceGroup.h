@@ -64,6 +64,18 @@ namespace hk
     bool
     has(const String& _key);
 
+    /**
+    * Remove an asset without destroying it, its memory management goes back
+    * to the caller.
+    * 
+    * @param _key The identifier of the asset.
+    * 
+    * @return The pointer to the asset. Returns a null pointer if the asset was
+    * not found.
+    */
+    C*
+    remove(const String& _key);
+
     /**
     * Removes and destroy an asset.
     * 
@@ -165,14 +177,26 @@ namespace hk
   }
 
   template<class C>
-  inline eRESULT 
-  ResourceGroup<C>::removeAndDestroy(const String& _key)
+  inline C*
+  ResourceGroup<C>::remove(const String& _key)
   {
-    IResource* pResource = reinterpret_cast<IResource*>(get(_key));
+    auto itResource = _m_hResources.find(_key);
+    if (itResource == _m_hResources.end())
+    {
+      return nullptr;
+    }
 
-    _m_hResources.erase(_key);
+    IResource* pResource = itResource->second;
+    _m_hResources.erase(itResource);
+    return reinterpret_cast<C*>(pResource);
+  }
 
-    if (pResource != nullptr)
+  template<class C>
+  inline eRESULT 
+  ResourceGroup<C>::removeAndDestroy(const String& _key)
+  {
+    IResource* pResource = reinterpret_cast<IResource*>(remove(_key));
+    if (pResource == nullptr)
     {
       return eRESULT::kObjectNotFound;
     }
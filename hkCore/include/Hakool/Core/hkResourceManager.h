@@ -10,6 +10,7 @@ namespace hk
   class Shader;
   class IMesh;
   class GraphicComponent;
+  class RenderThread;
 
   /**
   * Manage all type of resources in the engine.
@@ -31,10 +32,12 @@ namespace hk
     /**
     * Initialize the resource manager.
     * 
-    * @return Operation result.
+    * @param pGraphicComponent The component creating the graphic resources.
+    * @param pRenderThread The thread destroying them, see
+    * MeshResourceGroup::init.
     */
     void
-    init(GraphicComponent* pGraphicComponent);
+    init(GraphicComponent* pGraphicComponent, RenderThread* pRenderThread);
 
     /**
     * Gets the Shader group.
@@ -2,12 +2,13 @@
 
 #include <Hakool\Core\hkCorePrerequisites.h>
 #include <Hakool\Core\hkGameObject.h>
+#include <Hakool\Core\hkCommandBuffer.h>
 
 namespace hk
 {
   class Hakool;
   class SceneManager;
-  class GraphicComponent;
+  class RenderQueue;
 
   /**
   * Base class that provides an interface which can be extended for custom
@@ -149,12 +150,13 @@ namespace hk
     _update();
 
     /**
-     * Draws elements in the scene.
+     * Records the draws of the elements in the scene, in parallel chunks, and
+     * merges them in the frame queue.
      * 
-     * @param Pointer to the GraphicComponent.
+     * @param queue The RenderQueue of the frame.
      */
     void
-    _draw(GraphicComponent* pGraphicComponent);
+    _draw(RenderQueue& queue);
 
     /**
     * Called by the engine when the scene is about to be deactivated.
@@ -180,6 +182,12 @@ namespace hk
     GameObject
     _m_root;
 
+    /**
+    * A buffer per recorded chunk, kept between frames.
+    */
+    Vector<CommandBuffer>
+    _m_commandBuffers;
+
     friend SceneManager;
   };
 }
\ No newline at end of file
@@ -2,12 +2,13 @@
 
 #include <Hakool\Core\hkCorePrerequisites.h>
 #include <Hakool\Core\hkCoreUtilities.h>
+#include <Hakool\Core\hkJobPool.h>
 
 namespace hk
 {
   class Hakool;
   class Scene;
-  class GraphicComponent;
+  class RenderQueue;
 
   /**
   * Create, process and updates all the scenes of the application.
@@ -128,12 +129,29 @@ namespace hk
     hasActiveScene();
 
     /**
-     * Draw method.
+     * Adds the draws of the active scene to the frame queue.
      * 
-     * @param pGraphicComponent GraphicComponent.
+     * @param queue The RenderQueue of the frame.
      */
     void
-    draw(GraphicComponent* pGraphicComponent);
+    draw(RenderQueue& queue);
+
+    /**
+     * Set the number of threads recording the draws of the scene. Zero uses
+     * the number of hardware threads.
+     */
+    void
+    setRecordingThreadsSize(const uint32& threadsSize);
+
+    const uint32&
+    getRecordingThreadsSize() const;
+
+    /**
+     * Get the threads recording the draws of the scene. They are started by
+     * init and kept until destroy.
+     */
+    JobPool&
+    getRecordingPool();
 
     /**
     * Remove and delete all the registered scenes in this scene manager.
@@ -190,5 +208,14 @@ namespace hk
     */
     Scene*
     _m_pNextScene;
+
+    /**
+    * Threads recording the draws, zero for the hardware threads.
+    */
+    uint32
+    _m_recordingThreadsSize;
+
+    JobPool
+    _m_recordingPool;
   };
 }
\ No newline at end of file
@@ -61,59 +61,81 @@ namespace hk
     Logger::Prepare(_pLogger);
     eRESULT result;   
 
-    if (_config.graphicsConfiguration.graphicInterface == eGRAPHIC_INTERFACE::kOpenGL)
+    String graphicsLibrary;
+    String createFunction;
+    String destroyFunction;
+
+    switch (_config.graphicsConfiguration.graphicInterface)
     {
-      result = _m_pluginManager.connectPlugin
-      (
-        "GraphicsDLL",
-        "hkGraphicsOpenGL" + String(HK_DYN_LIB_SUFIX),
-        "createGraphicComponentOpenGLPlugin",
-        "destroyGraphicComponentOpenGLPlugin"
-      );
+    case eGRAPHIC_INTERFACE::kOpenGL:
+      graphicsLibrary = "hkGraphicsOpenGL";
+      createFunction = "createGraphicComponentOpenGLPlugin";
+      destroyFunction = "destroyGraphicComponentOpenGLPlugin";
+      break;
+
+    case eGRAPHIC_INTERFACE::kNull:
+      graphicsLibrary = "hkGraphicsNull";
+      createFunction = "createGraphicComponentNullPlugin";
+      destroyFunction = "destroyGraphicComponentNullPlugin";
+      break;
+
+    case eGRAPHIC_INTERFACE::kSoftware:
+      graphicsLibrary = "hkGraphicsSoftware";
+      createFunction = "createGraphicComponentSoftwarePlugin";
+      destroyFunction = "destroyGraphicComponentSoftwarePlugin";
+      break;
+
+    default:
+      Logger::Error("Graphic API not implemented yet.");
+      clean();
 
-      if (result != eRESULT::kSuccess)
-      {
-        Logger::Error("Couldn't connect to the graphics library.");
-        clean();
+      return eRESULT::kFail;
+    }
 
-        return result;
-      }
+    result = _m_pluginManager.connectPlugin
+    (
+      "GraphicsDLL",
+      graphicsLibrary + String(HK_DYN_LIB_SUFIX),
+      createFunction,
+      destroyFunction
+    );
 
-      if (_m_pluginManager.hasPlugin("GraphicsDLL"))
-      {
-        IPlugin* plugin = _m_pluginManager.getPlugin("GraphicsDLL");
-        _m_pGraphicComponent = reinterpret_cast<GraphicComponent*>(plugin->getData());
+    if (result != eRESULT::kSuccess)
+    {
+      Logger::Error("Couldn't connect to the graphics library.");
+      clean();
 
-        result = _m_pGraphicComponent->init(
-          _config.graphicsConfiguration,
-          _config.windowConfiguration,
-          _m_resourceManager);
+      return result;
+    }
 
-        if (result != eRESULT::kSuccess)
-        {
-          Logger::Error("Couldn't initialize the graphics.");
-          clean();
+    if (_m_pluginManager.hasPlugin("GraphicsDLL"))
+    {
+      IPlugin* plugin = _m_pluginManager.getPlugin("GraphicsDLL");
+      _m_pGraphicComponent = reinterpret_cast<GraphicComponent*>(plugin->getData());
 
-          return result;
-        }
-      }
-      else
+      result = _m_pGraphicComponent->init(
+        _config.graphicsConfiguration,
+        _config.windowConfiguration,
+        _m_resourceManager);
+
+      if (result != eRESULT::kSuccess)
       {
-        Logger::Error("Couldn't find the graphics plug-in.");
+        Logger::Error("Couldn't initialize the graphics.");
         clean();
 
-        return eRESULT::kFail;
+        return result;
       }
     }
     else
     {
-      Logger::Error("Graphic API not implemented yet.");
+      Logger::Error("Couldn't find the graphics plug-in.");
       clean();
 
       return eRESULT::kFail;
     }
 
-    _m_resourceManager.init(_m_pGraphicComponent);
+    _m_renderQueueDepth = _config.renderQueueDepth;
+    _m_resourceManager.init(_m_pGraphicComponent, &_m_renderThread);
     _m_sceneManager.init(this);
     _m_cameraManager.init();
 
@@ -142,6 +164,13 @@ namespace hk
   void
   Hakool::clear()
   {
+    if (_m_renderQueueDepth > 0)
+    {
+      return;
+    }
+
+    _m_pGraphicComponent->uploadMeshes();
+
     Camera* pCamera = _m_cameraManager.getActiveCamera();
     _m_pGraphicComponent->clear
     (
@@ -152,20 +181,63 @@ namespace hk
   eRESULT 
   Hakool::draw()
   { 
-    _m_pGraphicComponent->prepareToDraw(_m_cameraManager.getActiveCamera());
-    _m_sceneManager.draw(_m_pGraphicComponent);
+    Camera* pCamera = _m_cameraManager.getActiveCamera();
+
+    if (_m_renderQueueDepth > 0)
+    {
+      if (!_m_renderThread.isRunning()
+          && _m_renderThread.start(_m_pGraphicComponent, _m_renderQueueDepth) != eRESULT::kSuccess)
+      {
+        Logger::Error("Couldn't start the render thread, drawing on the main thread.");
+        _m_renderQueueDepth = 0;
+      }
+      else
+      {
+        // Everything the render thread reads is copied in the packet.
+        FramePacket& packet = _m_renderThread.acquireFrame();
+        packet.queue.clear();
+        packet.hasCamera = pCamera != nullptr;
+        if (pCamera != nullptr)
+        {
+          packet.queue.setViewPosition(pCamera->getPosition());
+          packet.camera.copyFrom(*pCamera);
+        }
+        _m_sceneManager.draw(packet.queue);
+        return eRESULT::kSuccess;
+      }
+    }
+
+    _m_renderQueue.clear();
+    if (pCamera != nullptr)
+    {
+      _m_renderQueue.setViewPosition(pCamera->getPosition());
+    }
+    // The scene merges and sorts its command buffers, the queue is in order.
+    _m_sceneManager.draw(_m_renderQueue);
+
+    _m_pGraphicComponent->prepareToDraw(pCamera);
+    _m_pGraphicComponent->drawQueue(_m_renderQueue);
     return eRESULT::kSuccess;
   }
 
   void 
   Hakool::present()
   {
+    if (_m_renderThread.isRunning())
+    {
+      _m_renderThread.submitFrame();
+      return;
+    }
+
     _m_pGraphicComponent->getWindow()->present();
   }
 
   void 
   Hakool::clean()
   {
+    // Presents the queued frames and gives the context back.
+    _m_renderThread.stop();
+
     _m_sceneManager.clear();
 
     if (_m_pGraphicComponent != nullptr)
@@ -215,6 +287,18 @@ namespace hk
     return _m_cameraManager;
   }
 
+  void
+  Hakool::executeGraphicsTask(const std::function<void()>& task)
+  {
+    _m_renderThread.execute(task);
+  }
+
+  RenderThreadStats
+  Hakool::getRenderThreadStats() const
+  {
+    return _m_renderThread.getStats();
+  }
+
   Hakool::Hakool():
     _m_isInitialized(false),
     _m_isRunning(false),
@@ -223,6 +307,9 @@ namespace hk
     _m_sceneManager(),
     _m_resourceManager(),
     _m_cameraManager(),
+    _m_renderQueue(),
+    _m_renderThread(),
+    _m_renderQueueDepth(0),
     _m_pClock(Clock::Create()),
     _m_deltaTime()
   {
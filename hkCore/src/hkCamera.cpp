@@ -39,6 +39,24 @@ namespace hk
   Camera::~Camera()
   { }
 
+  void
+  Camera::copyFrom(const Camera& _copy)
+  {
+    _m_fov = _copy._m_fov;
+    _m_aspect = _copy._m_aspect;
+    _m_near = _copy._m_near;
+    _m_far = _copy._m_far;
+    _m_up = _copy._m_up;
+    _m_position = _copy._m_position;
+    _m_target = _copy._m_target;
+    _m_projectionType = _copy._m_projectionType;
+    _m_view = _copy._m_view;
+    _m_projection = _copy._m_projection;
+    _m_clearColor = _copy._m_clearColor;
+    _m_isDirtyProjection = _copy._m_isDirtyProjection;
+    _m_isDirtyView = _copy._m_isDirtyView;
+  }
+
   void
   Camera::setNear(const float& _near)
   {
@@ -57,7 +57,7 @@ namespace hk
   { }
 
   void 
-  CameraComponent::draw(GraphicComponent* pGraphicComponent)
+  CameraComponent::draw(CommandBuffer& commands)
   { }
 
   void 
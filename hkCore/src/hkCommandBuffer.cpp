@@ -0,0 +1,63 @@
+#include <Hakool\Core\hkCommandBuffer.h>
+#include <Hakool\Core\hkIMesh.h>
+#include <Hakool\Core\hkRenderQueue.h>
+
+namespace hk
+{
+  CommandBuffer::CommandBuffer() :
+    _m_commands(),
+    _m_viewPosition(0.0f, 0.0f, 0.0f)
+  {
+    return;
+  }
+
+  void
+  CommandBuffer::begin(const Vector3f& viewPosition)
+  {
+    _m_commands.clear();
+    _m_viewPosition = viewPosition;
+  }
+
+  void
+  CommandBuffer::draw
+  (
+    IMesh* pMesh,
+    const Matrix4& modelMatrix,
+    const Vector3f& position,
+    const uint32& material,
+    const eRENDER_PASS& pass
+  )
+  {
+    // Drawn once the upload queue has made it resident.
+    if (!pMesh->isResident())
+    {
+      return;
+    }
+
+    RenderPacket command;
+    command.pMesh = pMesh;
+    command.modelMatrix = modelMatrix;
+    command.sortKey = RenderQueue::MakeSortKey
+    (
+      pass,
+      0,
+      material,
+      pMesh->getId(),
+      (position - _m_viewPosition).magnitude()
+    );
+
+    _m_commands.push_back(command);
+  }
+
+  uint32
+  CommandBuffer::getSize() const
+  {
+    return static_cast<uint32>(_m_commands.size());
+  }
+
+  const RenderPacket&
+  CommandBuffer::getCommand(const uint32& index) const
+  {
+    return _m_commands[index];
+  }
+}
\ No newline at end of file
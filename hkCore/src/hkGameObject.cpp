@@ -1,12 +1,22 @@
 #include <Hakool\Utils\guid.hpp>
 
 #include <Hakool\Core\hkGameObject.h>
-#include <Hakool\Core\hkGraphicComponent.h>
+#include <Hakool\Core\hkCommandBuffer.h>
+#include <Hakool\Core\hkJobPool.h>
 
 using std::pair;
 
 namespace hk
 {
+  namespace
+  {
+    /**
+    * Children recorded by each thread at least, smaller chunks cost more to
+    * schedule than to record.
+    */
+    const uint32 kMinChunkObjects = 64;
+  }
+
   GameObject::GameObject(const String& _name) :
     Node<GameObject>(_name),
     _m_toDestroy(false),
@@ -78,20 +88,74 @@ namespace hk
   }
 
   void
-  GameObject::draw(GraphicComponent* pGraphicComponent)
+  GameObject::draw(CommandBuffer& commands)
   {
     _m_modelMatrix = Matrix4::GetTranslation(_m_localPosition).transpose();
-    pGraphicComponent->setModelMatrix(_m_modelMatrix);
 
     for (pair<const eCOMPONENT, IGameObjectComponent*> item : _m_hComponents)
     {
-      item.second->draw(pGraphicComponent);
+      item.second->draw(commands);
+    }
+
+    for (pair <String, GameObject*> item : _m_hChildren)
+    {
+      item.second->draw(commands);
     }
+  }
 
+  void
+  GameObject::drawParallel
+  (
+    Vector<CommandBuffer>& commandBuffers,
+    const Vector3f& viewPosition,
+    JobPool& jobPool
+  )
+  {
+    _m_modelMatrix = Matrix4::GetTranslation(_m_localPosition).transpose();
+
+    Vector<GameObject*> children;
+    children.reserve(_m_hChildren.size());
     for (pair <String, GameObject*> item : _m_hChildren)
     {
-      item.second->draw(pGraphicComponent);
+      children.push_back(item.second);
+    }
+
+    uint32 chunksSize = jobPool.getThreadsSize();
+    uint32 childrenSize = static_cast<uint32>(children.size());
+    chunksSize = Math::Min(chunksSize, Math::Max(1u, childrenSize / kMinChunkObjects));
+
+    commandBuffers.resize(chunksSize);
+    for (CommandBuffer& commandBuffer : commandBuffers)
+    {
+      commandBuffer.begin(viewPosition);
     }
+
+    for (pair<const eCOMPONENT, IGameObjectComponent*> item : _m_hComponents)
+    {
+      item.second->draw(commandBuffers[0]);
+    }
+
+    // Contiguous ranges of children, so the buffers hold the draws in the
+    // order of a serial recording, whichever thread records each chunk.
+    jobPool.run
+    (
+      chunksSize,
+      [&](uint32 chunk)
+      {
+        uint32 first = static_cast<uint32>(static_cast<uint64>(childrenSize) * chunk / chunksSize);
+        uint32 end = static_cast<uint32>(static_cast<uint64>(childrenSize) * (chunk + 1) / chunksSize);
+        for (uint32 i = first; i < end; ++i)
+        {
+          children[i]->draw(commandBuffers[chunk]);
+        }
+      }
+    );
+  }
+
+  const Matrix4&
+  GameObject::getModelMatrix() const
+  {
+    return _m_modelMatrix;
   }
 
   void
@@ -0,0 +1,151 @@
+#include <Hakool\Core\hkJobPool.h>
+
+namespace hk
+{
+  JobPool::JobPool() :
+    _m_threads(),
+    _m_pJob(nullptr),
+    _m_jobsSize(0),
+    _m_nextJob(0),
+    _m_runIndex(0),
+    _m_busyThreads(0),
+    _m_stopRequested(false),
+    _m_mutex(),
+    _m_runQueued(),
+    _m_runDone()
+  {
+    return;
+  }
+
+  JobPool::~JobPool()
+  {
+    destroy();
+  }
+
+  void
+  JobPool::init(const uint32& threadsSize)
+  {
+    destroy();
+
+    uint32 size = threadsSize;
+    if (0 == size)
+    {
+      size = Math::Max(1u, std::thread::hardware_concurrency());
+    }
+
+    _m_stopRequested = false;
+    _m_runIndex = 0;
+    for (uint32 i = 1; i < size; ++i)
+    {
+      _m_threads.push_back(std::thread(&JobPool::_run, this));
+    }
+  }
+
+  void
+  JobPool::destroy()
+  {
+    {
+      std::lock_guard<std::mutex> lock(_m_mutex);
+      _m_stopRequested = true;
+    }
+    _m_runQueued.notify_all();
+
+    for (std::thread& thread : _m_threads)
+    {
+      thread.join();
+    }
+    _m_threads.clear();
+  }
+
+  uint32
+  JobPool::getThreadsSize() const
+  {
+    return static_cast<uint32>(_m_threads.size()) + 1;
+  }
+
+  void
+  JobPool::run(const uint32& jobsSize, const std::function<void(uint32)>& job)
+  {
+    // Waking the threads costs more than a single job.
+    if (_m_threads.empty() || jobsSize < 2)
+    {
+      for (uint32 i = 0; i < jobsSize; ++i)
+      {
+        job(i);
+      }
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(_m_mutex);
+      _m_pJob = &job;
+      _m_jobsSize = jobsSize;
+      _m_nextJob.store(0);
+      _m_busyThreads = static_cast<uint32>(_m_threads.size());
+      ++_m_runIndex;
+    }
+    _m_runQueued.notify_all();
+
+    _runJobs();
+
+    std::unique_lock<std::mutex> lock(_m_mutex);
+    _m_runDone.wait
+    (
+      lock,
+      [this]()
+      {
+        return 0 == _m_busyThreads;
+      }
+    );
+    _m_pJob = nullptr;
+  }
+
+  void
+  JobPool::_run()
+  {
+    uint64 runIndex = 0;
+    while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock(_m_mutex);
+        _m_runQueued.wait
+        (
+          lock,
+          [this, runIndex]()
+          {
+            return _m_stopRequested || _m_runIndex != runIndex;
+          }
+        );
+
+        if (_m_stopRequested)
+        {
+          return;
+        }
+        runIndex = _m_runIndex;
+      }
+
+      _runJobs();
+
+      bool isLast;
+      {
+        std::lock_guard<std::mutex> lock(_m_mutex);
+        isLast = 0 == --_m_busyThreads;
+      }
+      if (isLast)
+      {
+        _m_runDone.notify_one();
+      }
+    }
+  }
+
+  void
+  JobPool::_runJobs()
+  {
+    uint32 job = _m_nextJob.fetch_add(1);
+    while (job < _m_jobsSize)
+    {
+      (*_m_pJob)(job);
+      job = _m_nextJob.fetch_add(1);
+    }
+  }
+}
\ No newline at end of file
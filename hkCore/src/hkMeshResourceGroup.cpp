@@ -1,20 +1,65 @@
 #include <Hakool/Core/hkMeshResourceGroup.h>
 #include <Hakool/Core/hkGraphicComponent.h>
+#include <Hakool/Core/hkRenderThread.h>
+#include <Hakool/Utils/hkVertex.h>
+#include <Hakool/Utils/hkQuantizedVertex.h>
+#include <Hakool/Utils/hkMultiMesh.h>
+#include <Hakool/Utils/hkMultiMeshMesh.h>
+
+#include <cstring>
 
 namespace hk
 {
+  namespace
+  {
+    /**
+    * Get the bytes a mesh is drawn from: its vertices, its indices and its
+    * dequantization.
+    */
+    Vector<uint8>
+    GetContent(const MeshDescription& _description)
+    {
+      hkSize verticesBytes = static_cast<hkSize>(_description.getVertexSize()) * _description.verticesSize;
+      hkSize indicesBytes = sizeof(uint32) * static_cast<hkSize>(_description.indicesSize);
+
+      Vector<uint8> content(verticesBytes + indicesBytes + sizeof(float) * 6);
+      uint8* pContent = content.data();
+      if (verticesBytes > 0)
+      {
+        std::memcpy(pContent, _description.pVertices, verticesBytes);
+        pContent += verticesBytes;
+      }
+      if (indicesBytes > 0)
+      {
+        std::memcpy(pContent, _description.pIndices, indicesBytes);
+        pContent += indicesBytes;
+      }
+
+      const Vector3f& offset = _description.quantization.positionOffset;
+      const Vector3f& scale = _description.quantization.positionScale;
+      const float aDequantization[6] = { offset.x, offset.y, offset.z, scale.x, scale.y, scale.z };
+      std::memcpy(pContent, aDequantization, sizeof(aDequantization));
+      return content;
+    }
+  }
+
   MeshResourceGroup::MeshResourceGroup() :
     ResourceGroup<IMesh>(),
-    _m_pGraphicComponent(nullptr)
+    _m_pGraphicComponent(nullptr),
+    _m_pRenderThread(nullptr),
+    _m_uploadQueue(),
+    _m_sharedContents(),
+    _m_unsharedMeshesSize(0)
   { }
 
   MeshResourceGroup::~MeshResourceGroup()
   { }
 
   void 
-  MeshResourceGroup::init(GraphicComponent * pGraphicComponent)
+  MeshResourceGroup::init(GraphicComponent * pGraphicComponent, RenderThread* pRenderThread)
   {
     _m_pGraphicComponent = pGraphicComponent;
+    _m_pRenderThread = pRenderThread;
     return;
   }
 
@@ -26,25 +71,150 @@ namespace hk
     {
       return get(cubeKey);
     }
-    float* pVertexes = new float[108] {
-       -1.0f,  1.0f, -1.0f, -1.0f, -1.0f, -1.0f,  1.0f, -1.0f, -1.0f,
-        1.0f, -1.0f, -1.0f,  1.0f,  1.0f, -1.0f, -1.0f,  1.0f, -1.0f,
-        1.0f, -1.0f, -1.0f,  1.0f, -1.0f,  1.0f,  1.0f,  1.0f, -1.0f,
-        1.0f, -1.0f,  1.0f,  1.0f,  1.0f,  1.0f,  1.0f,  1.0f, -1.0f,
-        1.0f, -1.0f,  1.0f, -1.0f, -1.0f,  1.0f,  1.0f,  1.0f,  1.0f,
-       -1.0f, -1.0f,  1.0f, -1.0f,  1.0f,  1.0f,  1.0f,  1.0f,  1.0f,
-       -1.0f, -1.0f,  1.0f, -1.0f, -1.0f, -1.0f, -1.0f,  1.0f,  1.0f,
-       -1.0f, -1.0f, -1.0f, -1.0f,  1.0f, -1.0f, -1.0f,  1.0f,  1.0f,
-       -1.0f, -1.0f,  1.0f,  1.0f, -1.0f,  1.0f,  1.0f, -1.0f, -1.0f,
-        1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f,  1.0f,
-       -1.0f,  1.0f, -1.0f,  1.0f,  1.0f, -1.0f,  1.0f,  1.0f,  1.0f,
-        1.0f,  1.0f,  1.0f, -1.0f,  1.0f,  1.0f, -1.0f,  1.0f, -1.0f,
+    const float aVertexes[24] = {
+      -1.0f, -1.0f, -1.0f,  1.0f, -1.0f, -1.0f,  1.0f,  1.0f, -1.0f, -1.0f,  1.0f, -1.0f,
+      -1.0f, -1.0f,  1.0f,  1.0f, -1.0f,  1.0f,  1.0f,  1.0f,  1.0f, -1.0f,  1.0f,  1.0f,
+    };
+    const uint32 aIndices[36] = {
+      3, 0, 1, 1, 2, 3,
+      1, 5, 2, 5, 6, 2,
+      5, 4, 6, 4, 7, 6,
+      4, 0, 7, 0, 3, 7,
+      4, 5, 1, 1, 0, 4,
+      3, 2, 6, 6, 7, 3,
     };
 
+    MeshDescription description;
+    description.vertexFormat = eVERTEX_FORMAT::kPosition;
+    description.pVertices = aVertexes;
+    description.verticesSize = 8;
+    description.pIndices = aIndices;
+    description.indicesSize = 36;
+
+    // The thread that owns the graphic context uploads it.
     IMesh* pCubeMesh = _m_pGraphicComponent->createMesh();
-    pCubeMesh->init(pVertexes, (uint32)36);
+    _m_uploadQueue.enqueue(pCubeMesh, description);
 
     add(cubeKey, pCubeMesh);
     return pCubeMesh;
   }
+
+  IMesh*
+  MeshResourceGroup::getMesh(MultiMesh* pMultiMesh, const uint32& meshIndex)
+  {
+    const MultiMeshMesh& mesh = pMultiMesh->getMeshesPtr()[meshIndex];
+
+    MeshDescription description;
+    description.verticesSize = mesh.verticesSize;
+    description.pIndices = pMultiMesh->getIndicesPtr() + mesh.firstIndexIndex;
+    description.indicesSize = mesh.indicesSize;
+
+    // Only the positions are used by the default program.
+    Vector<float> positions;
+    const QuantizedVertex* quantizedVertices = pMultiMesh->getQuantizedVerticesPtr();
+    if (nullptr != quantizedVertices)
+    {
+      description.vertexFormat = eVERTEX_FORMAT::kQuantized;
+      description.pVertices = quantizedVertices + mesh.firstVertexIndex;
+      description.quantization = mesh.quantization;
+    }
+    else
+    {
+      const Vertex* vertices = pMultiMesh->getVerticesPtr() + mesh.firstVertexIndex;
+
+      positions.resize(static_cast<hkSize>(mesh.verticesSize) * 3);
+      for (uint32 i = 0; i < mesh.verticesSize; ++i)
+      {
+        const Vertex& vertex = vertices[i];
+        positions[i * 3] = vertex.x;
+        positions[i * 3 + 1] = vertex.y;
+        positions[i * 3 + 2] = vertex.z;
+      }
+
+      description.vertexFormat = eVERTEX_FORMAT::kPosition;
+      description.pVertices = positions.data();
+    }
+
+    String meshKey;
+    if (0 == mesh.contentHash)
+    {
+      // The loader didn't hash the mesh, so it isn't shared.
+      meshKey = "_HAKOOL_MESH_UNSHARED_" + std::to_string(++_m_unsharedMeshesSize);
+    }
+    else
+    {
+      // Meshes with the same hash are compared byte to byte, so a collision
+      // takes the next key instead of returning a different mesh.
+      Vector<uint8> content = GetContent(description);
+      String hashKey = "_HAKOOL_MESH_"
+                     + std::to_string(static_cast<uint32>(description.vertexFormat))
+                     + "_" + std::to_string(mesh.contentHash) + "_";
+      for (uint32 i = 0; ; ++i)
+      {
+        meshKey = hashKey + std::to_string(i);
+        auto itContent = _m_sharedContents.find(meshKey);
+        if (itContent == _m_sharedContents.end())
+        {
+          _m_sharedContents.insert(std::make_pair(meshKey, std::move(content)));
+          break;
+        }
+
+        if (itContent->second == content)
+        {
+          return get(meshKey);
+        }
+      }
+    }
+
+    IMesh* pMesh = _m_pGraphicComponent->createMesh();
+    _m_uploadQueue.enqueue(pMesh, description);
+
+    add(meshKey, pMesh);
+    return pMesh;
+  }
+
+  MeshUploadQueue&
+  MeshResourceGroup::getUploadQueue()
+  {
+    return _m_uploadQueue;
+  }
+
+  eRESULT
+  MeshResourceGroup::removeAndDestroy(const String& _key)
+  {
+    IMesh* pMesh = remove(_key);
+    if (pMesh == nullptr)
+    {
+      return eRESULT::kObjectNotFound;
+    }
+    _m_sharedContents.erase(_key);
+    _m_uploadQueue.cancel(pMesh);
+
+    // The queued frames may still draw the mesh, and its geometry is freed
+    // on the thread that uploads the others, which also drops the upload it
+    // may have started.
+    GraphicComponent* pGraphicComponent = _m_pGraphicComponent;
+    auto destroyMesh = [pGraphicComponent, pMesh]()
+    {
+      pGraphicComponent->destroyMesh(pMesh);
+    };
+    if (_m_pRenderThread != nullptr)
+    {
+      _m_pRenderThread->retire(destroyMesh);
+    }
+    else
+    {
+      destroyMesh();
+    }
+    return eRESULT::kSuccess;
+  }
+
+  void
+  MeshResourceGroup::clear()
+  {
+    // The queue points to the meshes.
+    _m_uploadQueue.clear();
+    _m_sharedContents.clear();
+    ResourceGroup<IMesh>::clear();
+  }
 }
\ No newline at end of file
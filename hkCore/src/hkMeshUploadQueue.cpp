@@ -0,0 +1,135 @@
+#include <Hakool\Core\hkMeshUploadQueue.h>
+
+#include <algorithm>
+
+namespace hk
+{
+  MeshUpload::MeshUpload() :
+    pMesh(nullptr),
+    vertexFormat(eVERTEX_FORMAT::kPosition),
+    verticesSize(0),
+    vertices(),
+    indices(),
+    quantization()
+  {
+    return;
+  }
+
+  MeshDescription
+  MeshUpload::getDescription() const
+  {
+    MeshDescription description;
+    description.vertexFormat = vertexFormat;
+    description.pVertices = vertices.empty() ? nullptr : vertices.data();
+    description.verticesSize = verticesSize;
+    description.pIndices = indices.empty() ? nullptr : indices.data();
+    description.indicesSize = static_cast<uint32>(indices.size());
+    description.quantization = quantization;
+    return description;
+  }
+
+  hkSize
+  MeshUpload::getSize() const
+  {
+    return vertices.size() + sizeof(uint32) * indices.size();
+  }
+
+  MeshUploadQueue::MeshUploadQueue() :
+    _m_mutex(),
+    _m_uploads(),
+    _m_pendingBytes(0)
+  {
+    return;
+  }
+
+  void
+  MeshUploadQueue::enqueue(IMesh* pMesh, const MeshDescription& description)
+  {
+    // The copies are made before locking, loader threads don't wait on them.
+    MeshUpload upload;
+    upload.pMesh = pMesh;
+    upload.vertexFormat = description.vertexFormat;
+    upload.verticesSize = description.verticesSize;
+    upload.quantization = description.quantization;
+
+    const uint8* pVertices = static_cast<const uint8*>(description.pVertices);
+    upload.vertices.assign
+    (
+      pVertices,
+      pVertices + static_cast<hkSize>(description.getVertexSize()) * description.verticesSize
+    );
+
+    if (description.getIndexType() != eINDEX_TYPE::kNone)
+    {
+      upload.indices.assign(description.pIndices, description.pIndices + description.indicesSize);
+    }
+
+    std::lock_guard<std::mutex> lock(_m_mutex);
+    _m_pendingBytes += upload.getSize();
+    _m_uploads.push_back(std::move(upload));
+  }
+
+  bool
+  MeshUploadQueue::pop(MeshUpload& upload)
+  {
+    std::lock_guard<std::mutex> lock(_m_mutex);
+    if (_m_uploads.empty())
+    {
+      return false;
+    }
+
+    upload = std::move(_m_uploads.front());
+    _m_uploads.pop_front();
+    _m_pendingBytes -= upload.getSize();
+    return true;
+  }
+
+  void
+  MeshUploadQueue::cancel(IMesh* pMesh)
+  {
+    std::lock_guard<std::mutex> lock(_m_mutex);
+    for (const MeshUpload& upload : _m_uploads)
+    {
+      if (upload.pMesh == pMesh)
+      {
+        _m_pendingBytes -= upload.getSize();
+      }
+    }
+
+    _m_uploads.erase
+    (
+      std::remove_if
+      (
+        _m_uploads.begin(),
+        _m_uploads.end(),
+        [pMesh](const MeshUpload& _upload)
+        {
+          return _upload.pMesh == pMesh;
+        }
+      ),
+      _m_uploads.end()
+    );
+  }
+
+  void
+  MeshUploadQueue::clear()
+  {
+    std::lock_guard<std::mutex> lock(_m_mutex);
+    _m_uploads.clear();
+    _m_pendingBytes = 0;
+  }
+
+  uint32
+  MeshUploadQueue::getSize() const
+  {
+    std::lock_guard<std::mutex> lock(_m_mutex);
+    return static_cast<uint32>(_m_uploads.size());
+  }
+
+  hkSize
+  MeshUploadQueue::getPendingBytes() const
+  {
+    std::lock_guard<std::mutex> lock(_m_mutex);
+    return _m_pendingBytes;
+  }
+}
\ No newline at end of file
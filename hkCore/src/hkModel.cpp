@@ -1,5 +1,6 @@
 #include <Hakool/Core/hkModel.h>
 #include <Hakool/Core/hkIMesh.h>
+#include <Hakool/Core/hkCommandBuffer.h>
 
 namespace hk
 {
@@ -26,9 +27,12 @@ namespace hk
   }
 
   void 
-  Model::draw(GraphicComponent* pGraphicComponent)
+  Model::draw(CommandBuffer& commands, const Matrix4& modelMatrix, const Vector3f& position)
   {
-    _m_mesh->draw(pGraphicComponent);
+    if (_m_mesh != nullptr)
+    {
+      commands.draw(_m_mesh, modelMatrix, position);
+    }
     return;
   }
 }
\ No newline at end of file
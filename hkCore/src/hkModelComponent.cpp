@@ -2,6 +2,7 @@
 
 #include <Hakool\Utils\hkLogger.h>
 #include <Hakool\Core\hkResourceManager.h>
+#include <Hakool\Core\hkGameObject.h>
 
 namespace hk
 {
@@ -30,9 +31,14 @@ namespace hk
   }
 
   void
-  ModelComponent::draw(GraphicComponent* pGraphicComponent)
+  ModelComponent::draw(CommandBuffer& commands)
   { 
-    _m_model.draw(pGraphicComponent);
+    _m_model.draw
+    (
+      commands,
+      _m_pGameObject->getModelMatrix(),
+      _m_pGameObject->getLocalPosition()
+    );
     return;
   }
 
@@ -56,7 +62,7 @@ namespace hk
   eRESULT 
   ModelComponent::setMesh(const String& meshKey)
   {
-     MeshResourceGroup meshGroup = _m_resourceManager.getMeshes();
+     MeshResourceGroup& meshGroup = _m_resourceManager.getMeshes();
      if (!meshGroup.has(meshKey))
      {
        Logger::Error("Mesh was not found: " + meshKey);
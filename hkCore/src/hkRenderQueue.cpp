@@ -0,0 +1,206 @@
+#include <Hakool\Core\hkRenderQueue.h>
+#include <Hakool\Core\hkIMesh.h>
+#include <Hakool\Core\hkCommandBuffer.h>
+
+namespace hk
+{
+  RenderQueue::RenderQueue() :
+    _m_packets(),
+    _m_order(),
+    _m_scratch(),
+    _m_viewPosition(0.0f, 0.0f, 0.0f)
+  {
+    return;
+  }
+
+  uint64
+  RenderQueue::MakeSortKey
+  (
+    const eRENDER_PASS& pass,
+    const uint32& program,
+    const uint32& material,
+    const uint32& mesh,
+    const float& depth
+  )
+  {
+    // The bits of a non-negative float grow with its value, so the high bits
+    // are a logarithmic depth.
+    float clampedDepth = Math::Max(0.0f, depth);
+    uint32 depthBits;
+    std::memcpy(&depthBits, &clampedDepth, sizeof(float));
+    uint64 depthKey = depthBits >> (32 - DEPTH_BITS);
+
+    if (pass == eRENDER_PASS::kTransparent)
+    {
+      depthKey = ~depthKey;
+    }
+
+    uint64 key = static_cast<uint64>(pass) & ((1 << PASS_BITS) - 1);
+    key = (key << PROGRAM_BITS) | (program & ((1 << PROGRAM_BITS) - 1));
+    key = (key << MATERIAL_BITS) | (material & ((1 << MATERIAL_BITS) - 1));
+    key = (key << MESH_BITS) | (mesh & ((1 << MESH_BITS) - 1));
+    key = (key << DEPTH_BITS) | (depthKey & ((1 << DEPTH_BITS) - 1));
+    return key;
+  }
+
+  uint64
+  RenderQueue::GetBatchKey(const uint64& sortKey)
+  {
+    return sortKey >> DEPTH_BITS;
+  }
+
+  uint64
+  RenderQueue::GetMaterialKey(const uint64& sortKey)
+  {
+    return sortKey >> (MESH_BITS + DEPTH_BITS);
+  }
+
+  void
+  RenderQueue::setViewPosition(const Vector3f& position)
+  {
+    _m_viewPosition = position;
+  }
+
+  const Vector3f&
+  RenderQueue::getViewPosition() const
+  {
+    return _m_viewPosition;
+  }
+
+  void
+  RenderQueue::push
+  (
+    IMesh* pMesh,
+    const Matrix4& modelMatrix,
+    const Vector3f& position,
+    const uint32& material,
+    const eRENDER_PASS& pass
+  )
+  {
+    if (!pMesh->isResident())
+    {
+      return;
+    }
+
+    RenderPacket packet;
+    packet.pMesh = pMesh;
+    packet.modelMatrix = modelMatrix;
+    packet.sortKey = MakeSortKey
+    (
+      pass,
+      0,
+      material,
+      pMesh->getId(),
+      (position - _m_viewPosition).magnitude()
+    );
+
+    SortEntry entry;
+    entry.key = packet.sortKey;
+    entry.index = static_cast<uint32>(_m_packets.size());
+
+    _m_packets.push_back(packet);
+    _m_order.push_back(entry);
+  }
+
+  void
+  RenderQueue::sort()
+  {
+    const uint32 size = static_cast<uint32>(_m_order.size());
+    if (size < 2)
+    {
+      return;
+    }
+
+    _m_scratch.resize(size);
+    SortEntry* pSource = _m_order.data();
+    SortEntry* pDestination = _m_scratch.data();
+
+    // Least significant digit first, one byte per pass.
+    for (uint32 shift = 0; shift < 64; shift += 8)
+    {
+      uint32 histogram[256] = {};
+      for (uint32 i = 0; i < size; ++i)
+      {
+        ++histogram[(pSource[i].key >> shift) & 0xFF];
+      }
+
+      // Every key has the same digit, the pass wouldn't move anything.
+      if (histogram[(pSource[0].key >> shift) & 0xFF] == size)
+      {
+        continue;
+      }
+
+      uint32 offset = 0;
+      for (uint32 digit = 0; digit < 256; ++digit)
+      {
+        uint32 count = histogram[digit];
+        histogram[digit] = offset;
+        offset += count;
+      }
+
+      for (uint32 i = 0; i < size; ++i)
+      {
+        pDestination[histogram[(pSource[i].key >> shift) & 0xFF]++] = pSource[i];
+      }
+
+      std::swap(pSource, pDestination);
+    }
+
+    if (pSource != _m_order.data())
+    {
+      _m_order.swap(_m_scratch);
+    }
+  }
+
+  void
+  RenderQueue::merge(const Vector<CommandBuffer>& commandBuffers)
+  {
+    clear();
+
+    hkSize size = 0;
+    for (const CommandBuffer& commandBuffer : commandBuffers)
+    {
+      size += commandBuffer.getSize();
+    }
+    _m_packets.reserve(size);
+    _m_order.reserve(size);
+
+    // Appended in buffer order, the stable radix sort keeps that order for
+    // the commands with the same key.
+    for (const CommandBuffer& commandBuffer : commandBuffers)
+    {
+      for (uint32 i = 0; i < commandBuffer.getSize(); ++i)
+      {
+        const RenderPacket& packet = commandBuffer.getCommand(i);
+
+        SortEntry entry;
+        entry.key = packet.sortKey;
+        entry.index = static_cast<uint32>(_m_packets.size());
+
+        _m_packets.push_back(packet);
+        _m_order.push_back(entry);
+      }
+    }
+
+    sort();
+  }
+
+  void
+  RenderQueue::clear()
+  {
+    _m_packets.clear();
+    _m_order.clear();
+  }
+
+  uint32
+  RenderQueue::getSize() const
+  {
+    return static_cast<uint32>(_m_order.size());
+  }
+
+  const RenderPacket&
+  RenderQueue::getPacket(const uint32& index) const
+  {
+    return _m_packets[_m_order[index].index];
+  }
+}
\ No newline at end of file
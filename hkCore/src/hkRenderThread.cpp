@@ -0,0 +1,306 @@
+#include <Hakool\Core\hkRenderThread.h>
+
+#include <Hakool\Utils\hkLogger.h>
+#include <Hakool\Utils\hkIWindow.h>
+#include <Hakool\Core\hkGraphicComponent.h>
+
+namespace hk
+{
+  RenderThread::RenderThread() :
+    _m_pGraphicComponent(nullptr),
+    _m_packets(),
+    _m_writeIndex(0),
+    _m_readIndex(0),
+    _m_submittedSize(0),
+    _m_pTask(nullptr),
+    _m_retiredTasks(),
+    _m_stopRequested(false),
+    _m_isRunning(false),
+    _m_pClock(nullptr),
+    _m_stats(),
+    _m_mutex(),
+    _m_workQueued(),
+    _m_workDone(),
+    _m_thread()
+  {
+    return;
+  }
+
+  RenderThread::~RenderThread()
+  {
+    stop();
+  }
+
+  eRESULT
+  RenderThread::start(GraphicComponent* pGraphicComponent, const uint32& queueDepth)
+  {
+    if (_m_isRunning)
+    {
+      Logger::Error("| RenderThread | The render thread is already running.");
+      return eRESULT::kFail;
+    }
+
+    if (pGraphicComponent == nullptr || pGraphicComponent->getWindow() == nullptr)
+    {
+      Logger::Error("| RenderThread | Cannot start without a graphic component.");
+      return eRESULT::kFail;
+    }
+
+    _m_pGraphicComponent = pGraphicComponent;
+    for (uint32 i = 0; i < Math::Max(1u, queueDepth); ++i)
+    {
+      _m_packets.push_back(new FramePacket());
+    }
+    _m_writeIndex = 0;
+    _m_readIndex = 0;
+    _m_submittedSize = 0;
+    _m_pTask = nullptr;
+    _m_stopRequested = false;
+    _m_stats = RenderThreadStats();
+    _m_pClock = Clock::Create();
+
+    // A context is current on one thread at a time.
+    _m_pGraphicComponent->getWindow()->releaseContext();
+    _m_thread = std::thread(&RenderThread::_run, this);
+    _m_isRunning = true;
+    return eRESULT::kSuccess;
+  }
+
+  FramePacket&
+  RenderThread::acquireFrame()
+  {
+    std::unique_lock<std::mutex> lock(_m_mutex);
+    if (_m_submittedSize == _m_packets.size())
+    {
+      uint64 waitStart = _m_pClock->getElapsedTime().asMicroseconds();
+      _m_workDone.wait
+      (
+        lock,
+        [this]()
+        {
+          return _m_submittedSize < _m_packets.size();
+        }
+      );
+
+      ++_m_stats.submitStalls;
+      _m_stats.submitStallMicroseconds += _m_pClock->getElapsedTime().asMicroseconds() - waitStart;
+    }
+
+    return *_m_packets[_m_writeIndex];
+  }
+
+  void
+  RenderThread::submitFrame()
+  {
+    {
+      std::lock_guard<std::mutex> lock(_m_mutex);
+      FramePacket& packet = *_m_packets[_m_writeIndex];
+      packet.frameIndex = _m_stats.framesSubmitted++;
+      packet.submitMicroseconds = _m_pClock->getElapsedTime().asMicroseconds();
+
+      _m_writeIndex = (_m_writeIndex + 1) % static_cast<uint32>(_m_packets.size());
+      ++_m_submittedSize;
+    }
+    _m_workQueued.notify_one();
+  }
+
+  void
+  RenderThread::execute(const std::function<void()>& task)
+  {
+    if (!_m_isRunning)
+    {
+      task();
+      return;
+    }
+
+    std::unique_lock<std::mutex> lock(_m_mutex);
+    _m_pTask = &task;
+    _m_workQueued.notify_one();
+    _m_workDone.wait
+    (
+      lock,
+      [this]()
+      {
+        return _m_pTask == nullptr;
+      }
+    );
+  }
+
+  void
+  RenderThread::retire(const std::function<void()>& task)
+  {
+    if (!_m_isRunning)
+    {
+      task();
+      return;
+    }
+
+    // The packet being filled gets the index of the next submission.
+    std::lock_guard<std::mutex> lock(_m_mutex);
+    _m_retiredTasks.push_back(std::make_pair(_m_stats.framesSubmitted, task));
+  }
+
+  void
+  RenderThread::waitIdle()
+  {
+    if (!_m_isRunning)
+    {
+      return;
+    }
+
+    std::unique_lock<std::mutex> lock(_m_mutex);
+    _m_workDone.wait
+    (
+      lock,
+      [this]()
+      {
+        return 0 == _m_submittedSize;
+      }
+    );
+  }
+
+  void
+  RenderThread::stop()
+  {
+    if (!_m_isRunning)
+    {
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(_m_mutex);
+      _m_stopRequested = true;
+    }
+    _m_workQueued.notify_one();
+    _m_thread.join();
+
+    _m_pGraphicComponent->getWindow()->makeContextCurrent();
+
+    // No packet references the resources anymore.
+    for (auto& retiredTask : _m_retiredTasks)
+    {
+      retiredTask.second();
+    }
+    _m_retiredTasks.clear();
+
+    for (FramePacket* pPacket : _m_packets)
+    {
+      delete pPacket;
+    }
+    _m_packets.clear();
+
+    delete _m_pClock;
+    _m_pClock = nullptr;
+    _m_pGraphicComponent = nullptr;
+    _m_isRunning = false;
+  }
+
+  bool
+  RenderThread::isRunning() const
+  {
+    return _m_isRunning;
+  }
+
+  RenderThreadStats
+  RenderThread::getStats() const
+  {
+    std::lock_guard<std::mutex> lock(_m_mutex);
+    return _m_stats;
+  }
+
+  void
+  RenderThread::_run()
+  {
+    _m_pGraphicComponent->getWindow()->makeContextCurrent();
+
+    std::unique_lock<std::mutex> lock(_m_mutex);
+    while (true)
+    {
+      uint64 idleStart = _m_pClock->getElapsedTime().asMicroseconds();
+      _m_workQueued.wait
+      (
+        lock,
+        [this]()
+        {
+          return _m_stopRequested || _m_submittedSize > 0 || _m_pTask != nullptr;
+        }
+      );
+      _m_stats.idleMicroseconds += _m_pClock->getElapsedTime().asMicroseconds() - idleStart;
+
+      if (_m_pTask != nullptr)
+      {
+        const std::function<void()>* pTask = _m_pTask;
+        lock.unlock();
+        (*pTask)();
+        lock.lock();
+
+        _m_pTask = nullptr;
+        _m_workDone.notify_all();
+        continue;
+      }
+
+      // The queued frames are presented before stopping.
+      if (0 == _m_submittedSize)
+      {
+        break;
+      }
+
+      FramePacket& packet = *_m_packets[_m_readIndex];
+      lock.unlock();
+
+      uint64 renderStart = _m_pClock->getElapsedTime().asMicroseconds();
+      _drawFrame(packet);
+      uint64 presentTime = _m_pClock->getElapsedTime().asMicroseconds();
+
+      lock.lock();
+      uint64 latency = presentTime - packet.submitMicroseconds;
+      ++_m_stats.framesPresented;
+      _m_stats.renderMicroseconds += presentTime - renderStart;
+      _m_stats.latencyMicroseconds += latency;
+      _m_stats.lastLatencyMicroseconds = latency;
+      _m_stats.maxLatencyMicroseconds = Math::Max(_m_stats.maxLatencyMicroseconds, latency);
+
+      _m_readIndex = (_m_readIndex + 1) % static_cast<uint32>(_m_packets.size());
+      --_m_submittedSize;
+      _m_workDone.notify_all();
+
+      _runRetiredTasks(lock);
+    }
+    lock.unlock();
+
+    _m_pGraphicComponent->getWindow()->releaseContext();
+  }
+
+  void
+  RenderThread::_drawFrame(FramePacket& packet)
+  {
+    _m_pGraphicComponent->uploadMeshes();
+
+    _m_pGraphicComponent->clear
+    (
+      packet.hasCamera ? packet.camera.getClearColor() : Color::BLACK
+    );
+
+    if (packet.hasCamera)
+    {
+      _m_pGraphicComponent->prepareToDraw(&packet.camera);
+      _m_pGraphicComponent->drawQueue(packet.queue);
+    }
+
+    _m_pGraphicComponent->getWindow()->present();
+  }
+  void
+  RenderThread::_runRetiredTasks(std::unique_lock<std::mutex>& lock)
+  {
+    while (!_m_retiredTasks.empty()
+           && _m_retiredTasks.front().first < _m_stats.framesPresented)
+    {
+      std::function<void()> task = std::move(_m_retiredTasks.front().second);
+      _m_retiredTasks.pop_front();
+
+      lock.unlock();
+      task();
+      lock.lock();
+    }
+  }
+}
\ No newline at end of file
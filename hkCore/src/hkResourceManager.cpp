@@ -14,9 +14,9 @@ namespace hk
   }
 
   void 
-  ResourceManager::init(GraphicComponent* pGraphicComponent)
+  ResourceManager::init(GraphicComponent* pGraphicComponent, RenderThread* pRenderThread)
   {
-    _m_meshes.init(pGraphicComponent);
+    _m_meshes.init(pGraphicComponent, pRenderThread);
     return;
   }
 
@@ -1,5 +1,6 @@
 #include <Hakool\Core\hkScene.h>
 #include <Hakool\Core\hakool.h>
+#include <Hakool\Core\hkRenderQueue.h>
 
 namespace hk
 {
@@ -112,7 +113,8 @@ namespace hk
 
   Scene::Scene() :
     _m_pSceneManager(nullptr),
-    _m_root("__root")
+    _m_root("__root"),
+    _m_commandBuffers()
   {
     _m_root._m_pScene = this;
     return;
@@ -148,9 +150,15 @@ namespace hk
   }
 
   void 
-  Scene::_draw(GraphicComponent* pGraphicComponent)
-  {
-    _m_root.draw(pGraphicComponent);
+  Scene::_draw(RenderQueue& queue)
+  {
+    _m_root.drawParallel
+    (
+      _m_commandBuffers,
+      queue.getViewPosition(),
+      _m_pSceneManager->getRecordingPool()
+    );
+    queue.merge(_m_commandBuffers);
     draw();
   }
 
@@ -12,7 +12,9 @@ namespace hk
     _m_isUpdating(false),
     _m_transitionRequested(false),
     _m_isInitialized(false),
-    _m_hScenes()
+    _m_hScenes(),
+    _m_recordingThreadsSize(0),
+    _m_recordingPool()
   {
     return;
   }
@@ -40,6 +42,8 @@ namespace hk
       pScene->start();
     }
 
+    _m_recordingPool.init(_m_recordingThreadsSize);
+
     _m_isInitialized = !_m_isInitialized;
 
     return;
@@ -186,15 +190,37 @@ namespace hk
   }
 
   void 
-  SceneManager::draw(GraphicComponent* pGraphicComponent)
+  SceneManager::draw(RenderQueue& queue)
   {
     if (_m_pActiveScene != nullptr)
     {
-      _m_pActiveScene->_draw(pGraphicComponent);
+      _m_pActiveScene->_draw(queue);
     }
     return;
   }
 
+  void
+  SceneManager::setRecordingThreadsSize(const uint32& threadsSize)
+  {
+    _m_recordingThreadsSize = threadsSize;
+    if (_m_isInitialized)
+    {
+      _m_recordingPool.init(_m_recordingThreadsSize);
+    }
+  }
+
+  const uint32&
+  SceneManager::getRecordingThreadsSize() const
+  {
+    return _m_recordingThreadsSize;
+  }
+
+  JobPool&
+  SceneManager::getRecordingPool()
+  {
+    return _m_recordingPool;
+  }
+
   void
   SceneManager::clear()
   {
@@ -214,6 +240,7 @@ namespace hk
   SceneManager::destroy()
   {
     clear();
+    _m_recordingPool.destroy();
 
     _m_isInitialized = false;
     _m_pHakool = nullptr;
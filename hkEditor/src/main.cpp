@@ -4,9 +4,10 @@
 #include <Hakool/Core/hkModelComponent.h>
 #include <Hakool/Core/hkCameraComponent.h>
 #include <Hakool/Core/hkGraphicComponent.h>
+#include <Hakool/Core/hkRenderStats.h>
 #include <Hakool/Utils/hkIWindow.h>
 #include <Hakool/GraphicsOpenGL/hkWindowOpenGL.h>
-#include <Hakool/Utils/hkMeshLoaderAssimp.h>
+#include <Hakool/Utils/hkMeshLoaderGltf.h>
 #include <imgui_impl_opengl3.h>
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
@@ -27,7 +28,7 @@ using hk::CameraManager;
 using hk::CameraComponent;
 using hk::GraphicComponent;
 using hk::WindowOpenGL;
-using hk::MeshLoaderAssimp;
+using hk::MeshLoaderGltf;
 using hk::editor::CameraComponentView;
 using hk::editor::GameObjectView;
 
@@ -42,6 +43,7 @@ int main(int argc, char* argv[])
   HakoolConfiguration engineConfig;
   engineConfig.graphicsConfiguration.graphicInterface = hk::eGRAPHIC_INTERFACE::kOpenGL;
   engineConfig.graphicsConfiguration.backgroundColor = hk::Color::BLACK;
+  engineConfig.graphicsConfiguration.programCacheDirectory = "ProgramCache";
   engineConfig.windowConfiguration.width = 1200;
   engineConfig.windowConfiguration.height = 800;
   engineConfig.windowConfiguration.title = "Hakool Editor";
@@ -54,7 +56,7 @@ int main(int argc, char* argv[])
     return 0;
   }
 
-  MeshLoaderAssimp meshLoader;
+  MeshLoaderGltf meshLoader;
   meshLoader.load("F:/3D Objects/zero-two/source/02_pose1.fbx");
 
   SceneManager& sceneManager = pEngine->getSceneManager();
@@ -97,6 +99,15 @@ int main(int argc, char* argv[])
 
     ImGui::Begin("Engine Status");
     ImGui::Text("FPS %.1f", ImGui::GetIO().Framerate);
+    const hk::RenderStats& renderStats = pGraphicComponent->getRenderStats();
+    ImGui::Text("Packets %u", renderStats.packets);
+    ImGui::Text("Draw calls %u", renderStats.drawCalls);
+    ImGui::Text("Indirect draws %u", renderStats.indirectDraws);
+    ImGui::Text("State changes saved %u", renderStats.getSavedStateChanges());
+    ImGui::Text("State calls %u (%u filtered)", renderStats.stateCalls, renderStats.filteredStateCalls);
+    ImGui::Text("Stream stalls %u", renderStats.streamStalls);
+    ImGui::Text("Mesh uploads %u KB (%u pending)", renderStats.uploadedBytes / 1024, renderStats.pendingUploads);
+    ImGui::Text("Arena moves %u KB", renderStats.movedBytes / 1024);
     ImGui::End();
     
     float dt = pEngine->getDeltaTime().asSeconds();
@@ -0,0 +1,29 @@
+#pragma once
+
+#if HK_PLATFORM == HK_PLATFORM_WIN32
+# if HK_COMPILER == HK_COMPILER_MSVC
+#   if defined(HK_STATIC_LIB)
+#     define HK_GRAPHICS_NULL_EXPORT
+#   else
+#     if defined(HK_GRAPHICS_NULL_EXPORTS)
+#       define HK_GRAPHICS_NULL_EXPORT  __declspec(dllexport)
+#     else
+#       define HK_GRAPHICS_NULL_EXPORT  __declspec(dllimport)
+#     endif
+#   endif
+# else //Any other compiler
+#   if defined( HK_STATIC_LIB )
+#     define HK_GRAPHICS_NULL_EXPORT
+#   else
+#     if defined( HK_GRAPHICS_NULL_EXPORTS)
+#       define HK_GRAPHICS_NULL_EXPORT __attribute__((dllexport))
+#     else
+#       define HK_GRAPHICS_NULL_EXPORT  __attribute__ ((dllimport))
+#     endif
+#   endif
+# endif
+# define HK_GRAPHICS_NULL_HIDDEN
+#else // Linux / Mac settings
+# define HK_GRAPHICS_NULL_EXPORT __attribute__ ((visibility("default")))
+# define HK_GRAPHICS_NULL_HIDDEN __attribute__ ((visibility("hidden")))
+#endif
\ No newline at end of file
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <Hakool\Utils\hkColor.h>
+#include <Hakool\Utils\hkMatrix4.h>
+#include <Hakool\Utils\hkVector3.h>
+#include <Hakool\GraphicsNull\hkGraphicsNullPrerequisites.h>
+#include <Hakool\GraphicsNull\hkRecordedCommand.h>
+#include <Hakool\Core\hkGraphicComponent.h>
+#include <Hakool\Core\hkRenderStats.h>
+
+namespace hk
+{
+  class IWindow;
+  class WindowNull;
+  class ProgramNull;
+
+  /**
+  * GraphicComponent that does no GPU work. Every call is recorded into a 
+  * command stream and counted, so the frame submission can be tested and
+  * benchmarked on machines without a GPU or a display.
+  */
+  class HK_GRAPHICS_NULL_EXPORT GraphicComponentNull :
+    public GraphicComponent
+  {
+  public:
+
+    /**
+    * Constructor.
+    */
+    GraphicComponentNull();
+
+    /**
+    * Destructor.
+    */
+    virtual
+    ~GraphicComponentNull();
+
+    virtual eRESULT
+    init(
+      const GraphicsConfiguration& _graphicConfiguration,
+      const WindowConfiguration& windowConfig,
+      ResourceManager& resourceManager) override;
+
+    virtual void
+    clear(const Color& _clearColor) override;
+
+    virtual void
+    prepareToDraw(Camera* pCamera) override;
+
+    /**
+    * Initialize whole queued meshes until the upload budget is reached.
+    */
+    virtual void
+    uploadMeshes() override;
+
+    virtual void
+    drawScene(Scene* pScene) override;
+
+    virtual void
+    drawQueue(const RenderQueue& queue) override;
+
+    virtual const RenderStats&
+    getRenderStats() override;
+
+    virtual IMesh*
+    createMesh() override;
+
+    virtual void
+    destroyMesh(IMesh* pMesh) override;
+
+    virtual void
+    setModelMatrix(const Matrix4& modelMatrix) override;
+
+    virtual void
+    setPositionDequantization(const Vector3f& offset, const Vector3f& scale) override;
+
+    virtual IShader*
+    createVertexShader() override;
+
+    virtual IShader*
+    createFragmentShader() override;
+
+    virtual IProgram*
+    createProgram() override;
+
+    virtual IWindow*
+    getWindow() override;
+
+    virtual void
+    destroy() override;
+
+    virtual eGRAPHIC_INTERFACE
+    getGraphicInterfaceId() override;
+
+    virtual void
+    onWindowSizeChanged(
+      const uint32& width, 
+      const uint32& height, 
+      IWindow* pWindow) override;
+
+    /**
+    * Record a draw call of a mesh.
+    * 
+    * @param meshId Id of the mesh.
+    * @param verticesSize Count of vertices drawn.
+    * @param instancesSize Count of instances drawn.
+    */
+    void
+    recordDraw
+    (
+      const uint32& meshId,
+      const uint32& verticesSize,
+      const uint32& instancesSize = 1
+    );
+
+    /**
+    * Record the depth state set before a draw.
+    */
+    void
+    recordDepthState();
+
+    /**
+    * Record the upload of the vertices of a mesh.
+    * 
+    * @param bytes Size of the vertex data.
+    */
+    void
+    recordUpload(const uint64& bytes);
+
+    /**
+    * Record the end of a frame.
+    */
+    void
+    recordPresent();
+
+    /**
+    * Enable or disable the recording of the command stream. The counters are
+    * always updated; disable the stream to run long benchmarks without it
+    * growing every frame.
+    * 
+    * @param enabled True to record the commands.
+    */
+    void
+    setCommandsRecording(const bool& enabled);
+
+    /**
+    * Get the commands recorded since the last reset.
+    */
+    const Vector<RecordedCommand>&
+    getCommands() const;
+
+    /**
+    * Get the counters since the last reset.
+    */
+    const RecordedCounters&
+    getCounters() const;
+
+    /**
+    * Clear the recorded commands and the counters.
+    */
+    void
+    resetRecording();
+
+  private:
+
+    /**
+    * Release the default shaders and program.
+    */
+    void
+    _releaseResources(ResourceManager& resourceManager);
+
+    /**
+    * Record a matrix uniform set on the bound program.
+    */
+    void
+    _recordUniform(const char* pName, const Matrix4& value);
+
+    /**
+    * Record a vector uniform set on the bound program. Sets with the current
+    * value are counted as redundant.
+    */
+    void
+    _recordUniform(const char* pName, const Vector3f& value, Vector3f& current);
+
+    /**
+    * Add a command to the stream if recording is enabled.
+    */
+    void
+    _record(const RecordedCommand& command);
+
+    /**
+    * Get an id for a new mesh, shader or program. Zero is never used.
+    */
+    uint32
+    _nextObjectId();
+
+    Vector<RecordedCommand>
+    _m_commands;
+
+    RecordedCounters
+    _m_counters;
+
+    bool
+    _m_isRecordingCommands;
+
+    /**
+    * The default program.
+    */
+    ProgramNull*
+    _m_pProgramNull;
+
+    /**
+     * The id of the current program.
+     */
+    uint32
+    _m_activeProgramId;
+
+    /**
+    * Last value set of the position dequantization uniforms.
+    */
+    Vector3f
+    _m_positionOffset;
+
+    Vector3f
+    _m_positionScale;
+
+    uint32
+    _m_lastObjectId;
+
+    /**
+    * Counters of the last drawQueue call.
+    */
+    RenderStats
+    _m_renderStats;
+
+    /**
+    * Bytes of queued mesh data uploaded each frame, 0 for no limit.
+    */
+    uint32
+    _m_meshUploadBudget;
+
+    /**
+    * Bytes uploaded from the queue by the last uploadMeshes call.
+    */
+    uint32
+    _m_uploadedBytes;
+
+    ResourceManager*
+    _m_pResourceManager;
+
+    WindowNull*
+    _m_pWindow;
+
+    bool
+    _m_isReady;
+  };
+}
\ No newline at end of file
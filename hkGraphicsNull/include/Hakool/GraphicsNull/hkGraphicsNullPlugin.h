@@ -0,0 +1,19 @@
+#pragma once
+
+#include <Hakool\GraphicsNull\hkGraphicsNullPrerequisites.h>
+#include <Hakool\GraphicsNull\hkGraphicComponentNull.h>
+#include <Hakool\Core\hkGraphicComponentPlugin.h>
+
+namespace hk
+{
+  extern "C"
+  {
+    HK_GRAPHICS_NULL_EXPORT IPlugin* createGraphicComponentNullPlugin();
+    HK_GRAPHICS_NULL_EXPORT void destroyGraphicComponentNullPlugin();
+  }
+
+  /**
+  * Creates and provides access to a GraphicComponentNull instance.
+  */
+  typedef GraphicComponentPlugin<GraphicComponentNull> GraphicsNullPlugin;
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <Hakool\Core\hkIMesh.h>
+#include <Hakool\GraphicsNull\hkGraphicsNullPrerequisites.h>
+
+#include <atomic>
+
+namespace hk
+{
+  class GraphicComponentNull;
+
+  /**
+  * Mesh that keeps no vertex data. Its draws are recorded by the
+  * GraphicComponentNull that created it.
+  */
+  class HK_GRAPHICS_NULL_EXPORT MeshNull : public IMesh
+  {
+  public:
+
+    MeshNull(GraphicComponentNull* pGraphicComponent, const uint32& id);
+
+    virtual 
+    ~MeshNull();
+
+    /**
+    * Record the upload of the vertices and of the indices, with the index
+    * type an indexed mesh would use.
+    */
+    virtual void
+    init(const MeshDescription& description) override;
+
+    /**
+    * Resident from init to destroy.
+    */
+    virtual bool
+    isResident() override;
+
+    virtual void
+    draw(GraphicComponent* pGraphicComponent) override;
+
+    virtual uint32
+    getVertexesSize() override;
+
+    virtual float*
+    getVertexesArray() override;
+
+    /**
+    * Get the id used in the recorded commands.
+    */
+    virtual uint32
+    getId() override;
+
+    virtual void
+    destroy() override;
+
+    /**
+    * Set the dequantization of this mesh.
+    * 
+    * @param pGraphicComponent Pointer to the GraphicComponent.
+    */
+    void
+    bind(GraphicComponent* pGraphicComponent);
+
+    /**
+    * Record the draw of the vertices.
+    */
+    void
+    drawBound();
+
+    /**
+    * Record an instanced draw of the vertices.
+    * 
+    * @param instancesSize Count of instances.
+    */
+    void
+    drawBoundInstanced(const uint32& instancesSize);
+
+  private:
+
+    GraphicComponentNull*
+    _m_pGraphicComponent;
+
+    uint32
+    _m_id;
+
+    uint32
+    _m_size;
+
+    /**
+    * Count of indices, 0 if the mesh isn't indexed.
+    */
+    uint32
+    _m_indicesSize;
+
+    bool
+    _m_isQuantized;
+
+    VertexQuantization
+    _m_quantization;
+
+    std::atomic<bool>
+    _m_isResident;
+  };
+}
\ No newline at end of file
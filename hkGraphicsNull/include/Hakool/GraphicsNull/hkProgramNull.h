@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Hakool\Core\hkIProgram.h>
+#include <Hakool\GraphicsNull\hkGraphicsNullPrerequisites.h>
+
+namespace hk
+{
+  /**
+  * Program that isn't linked. It only validates its shaders.
+  */
+  class HK_GRAPHICS_NULL_EXPORT ProgramNull :
+    public IProgram
+  {
+  public:
+
+    /**
+    * Constructor.
+    * 
+    * @param id The id of the program.
+    */
+    explicit ProgramNull(const uint32& id);
+
+    /**
+    * Destructor.
+    */
+    virtual ~ProgramNull();
+
+    virtual eRESULT
+    init(GraphicComponent* _pGraphicComponent) override;
+
+    virtual eRESULT
+    create
+    (
+      const String& _fragment,
+      const String& _vertex,
+      ResourceManager* _pResourceManager
+    ) override;
+
+    /**
+    * Get the pointer to the program id.
+    */
+    virtual void*
+    getProgramPtr() override;
+
+    virtual bool
+    isReady() override;    
+
+    virtual void
+    destroy() override;
+
+  private:
+
+    /**
+    * Indicates if the program is ready to be used.
+    */
+    bool
+    _m_isReady;
+
+    /**
+    * The id of this program, zero when it is not ready.
+    */
+    uint32
+    _m_programId;
+
+    /**
+    * The id given at construction.
+    */
+    uint32
+    _m_id;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <Hakool\Utils\hkColor.h>
+#include <Hakool\Utils\hkMatrix4.h>
+#include <Hakool\Utils\hkVector3.h>
+#include <Hakool\GraphicsNull\hkGraphicsNullPrerequisites.h>
+
+namespace hk
+{
+  /**
+  * Enumerates the calls recorded by the GraphicComponentNull.
+  */
+  enum class eRECORDED_COMMAND :
+    uchar
+  {
+    kUndefined,
+    kClear,
+    kBindProgram,
+    kSetUniformMatrix,
+    kSetUniformVector,
+    kDraw,
+    kSetDepthState,
+    kSetViewport,
+    kPresent
+  };
+
+  /**
+  * A call received by the GraphicComponentNull. Only the fields relevant to
+  * the command type are filled.
+  */
+  struct HK_GRAPHICS_NULL_EXPORT RecordedCommand
+  {
+  public:
+
+    RecordedCommand() :
+      type(eRECORDED_COMMAND::kUndefined),
+      objectId(0),
+      count(0),
+      instances(0),
+      width(0),
+      height(0),
+      pUniformName(nullptr),
+      matrix(),
+      vector(0.0f, 0.0f, 0.0f),
+      color()
+    {
+      return;
+    }
+
+    /**
+    * The recorded call.
+    */
+    eRECORDED_COMMAND
+    type;
+
+    /**
+    * Id of the program bound or of the mesh drawn.
+    */
+    uint32
+    objectId;
+
+    /**
+    * Vertices or indices drawn.
+    */
+    uint32
+    count;
+
+    /**
+    * Instances drawn.
+    */
+    uint32
+    instances;
+
+    /**
+    * Size of the viewport set.
+    */
+    uint32
+    width;
+
+    uint32
+    height;
+
+    /**
+    * Name of the uniform set. Points to a string literal.
+    */
+    const char*
+    pUniformName;
+
+    /**
+    * Value of a matrix uniform.
+    */
+    Matrix4
+    matrix;
+
+    /**
+    * Value of a vector uniform.
+    */
+    Vector3f
+    vector;
+
+    /**
+    * Clear color.
+    */
+    Color
+    color;
+  };
+
+  /**
+  * Counters of the calls received by the GraphicComponentNull. They are
+  * updated even when the commands aren't recorded.
+  */
+  struct HK_GRAPHICS_NULL_EXPORT RecordedCounters
+  {
+  public:
+
+    RecordedCounters() :
+      frames(0),
+      clears(0),
+      programBinds(0),
+      uniformSets(0),
+      redundantUniformSets(0),
+      draws(0),
+      drawnVertices(0),
+      drawnInstances(0),
+      depthStateSets(0),
+      viewportChanges(0),
+      meshesCreated(0),
+      uploadedBytes(0),
+      shadersCreated(0),
+      programsCreated(0)
+    {
+      return;
+    }
+
+    uint64
+    frames;
+
+    uint64
+    clears;
+
+    uint64
+    programBinds;
+
+    uint64
+    uniformSets;
+
+    /**
+    * Uniform sets with the value the uniform already had.
+    */
+    uint64
+    redundantUniformSets;
+
+    uint64
+    draws;
+
+    uint64
+    drawnVertices;
+
+    uint64
+    drawnInstances;
+
+    uint64
+    depthStateSets;
+
+    uint64
+    viewportChanges;
+
+    uint64
+    meshesCreated;
+
+    /**
+    * Bytes of vertex and index data the meshes would have uploaded.
+    */
+    uint64
+    uploadedBytes;
+
+    uint64
+    shadersCreated;
+
+    uint64
+    programsCreated;
+  };
+}
\ No newline at end of file
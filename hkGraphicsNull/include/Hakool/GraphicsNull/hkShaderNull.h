@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Hakool\Core\hkShader.h>
+#include <Hakool\GraphicsNull\hkGraphicsNullPrerequisites.h>
+
+namespace hk
+{
+  /**
+  * Shader that isn't compiled. It only validates its type.
+  */
+  class HK_GRAPHICS_NULL_EXPORT ShaderNull :
+    public IShader
+  {
+  public:
+
+    /**
+    * Constructor.
+    * 
+    * @param id The id of the shader.
+    */
+    explicit ShaderNull(const uint32& id);
+
+    /**
+    * Destructor.
+    */
+    ~ShaderNull();
+
+    /**
+    * Get the pointer to the shader id.
+    */
+    virtual void*
+    getShaderPtr() override;
+
+    virtual eRESULT
+    init(GraphicComponent*) override;
+
+    virtual eRESULT
+    create(const char* _pSource, const eSHADER_TYPE& _type) override;
+
+    virtual bool
+    isReady() override;
+
+    virtual void
+    destroy() override;
+
+    virtual eSHADER_TYPE
+    getType() override;
+
+  private:
+
+    /**
+    * Indicates the type of this shader.
+    */
+    eSHADER_TYPE
+    _m_type;
+
+    /**
+    * The id of this shader, zero when it is not ready.
+    */
+    uint32
+    _m_shaderId;
+
+    /**
+    * The id given at construction.
+    */
+    uint32
+    _m_id;
+
+    /**
+    * Indicates if the shader is ready to be used.
+    */
+    bool
+    _m_isReady;
+  };
+}
\ No newline at end of file
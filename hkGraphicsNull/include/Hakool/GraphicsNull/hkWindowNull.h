@@ -0,0 +1,110 @@
+#pragma once
+
+#include <Hakool/Utils/hkUtilitiesUtilities.h>
+#include <Hakool/Utils/hkIWindow.h>
+#include <Hakool/GraphicsNull/hkGraphicsNullPrerequisites.h>
+
+namespace hk
+{
+  class GraphicComponentNull;
+
+  /**
+  * Window without a surface. It stays open until it is closed or destroyed,
+  * and reports every present to the GraphicComponentNull. The software
+  * backend uses it too, without a GraphicComponentNull.
+  */
+  class HK_GRAPHICS_NULL_EXPORT WindowNull : public IWindow
+  {
+  public:
+
+    /**
+    * Constructor.
+    *
+    * @param pGraphicComponent The component the presents are reported to,
+    * nullptr to report none.
+    */
+    explicit WindowNull(GraphicComponentNull* pGraphicComponent);
+
+    virtual ~WindowNull();
+
+    virtual eRESULT
+    init(const WindowConfiguration& _config) override;
+
+    virtual void
+    setSize(const uint32& _width, const uint32& _height) override;
+
+    virtual void
+    setSize(const Vector2u& _v2) override;
+
+    virtual void
+    setTitle(const String& _title) override;
+
+    virtual bool
+    isOpen() override;
+
+    virtual void
+    pollEvents() override;
+
+    virtual void
+    update() override;
+
+    virtual void
+    postUpdate() override;
+
+    virtual void
+    present() override;
+
+    virtual void
+    makeContextCurrent() override;
+
+    virtual void
+    releaseContext() override;
+
+    virtual HANDLER
+    getWindowHandler() override;
+
+    virtual void
+    destroy() override;
+
+    virtual void
+    addObserver(WindowObserver* pObserver) override;
+
+    virtual Vector2u
+    getSize() override;
+
+    virtual uint32
+    getWidth() override;
+
+    virtual uint32
+    getHeight() override;
+
+    virtual String
+    getTitle() override;
+
+    /**
+    * Close the window, ending the application loop.
+    */
+    void
+    close();
+
+  private:
+
+    GraphicComponentNull*
+    _m_pGraphicComponent;
+
+    Vector<WindowObserver*> 
+    _m_observers;
+
+    String
+    _m_title;
+
+    uint32
+    _m_width;
+
+    uint32
+    _m_height;
+
+    bool
+    _m_isOpen;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,476 @@
+#include <Hakool\GraphicsNull\hkGraphicComponentNull.h>
+
+#include <Hakool\Utils\hkLogger.h>
+#include <Hakool\Utils\hkIWindow.h>
+#include <Hakool\Core\hkCamera.h>
+#include <Hakool\Core\hkResourceManager.h>
+#include <Hakool\Core\hkRenderQueue.h>
+#include <Hakool\GraphicsNull\hkShaderNull.h>
+#include <Hakool\GraphicsNull\hkProgramNull.h>
+#include <Hakool\GraphicsNull\hkMeshNull.h>
+#include <Hakool\GraphicsNull\hkWindowNull.h>
+
+namespace hk
+{
+  GraphicComponentNull::GraphicComponentNull() :
+    _m_commands(),
+    _m_counters(),
+    _m_isRecordingCommands(true),
+    _m_pProgramNull(nullptr),
+    _m_activeProgramId(0),
+    _m_positionOffset(0.0f, 0.0f, 0.0f),
+    _m_positionScale(1.0f, 1.0f, 1.0f),
+    _m_lastObjectId(0),
+    _m_renderStats(),
+    _m_meshUploadBudget(0),
+    _m_uploadedBytes(0),
+    _m_pResourceManager(nullptr),
+    _m_pWindow(nullptr),
+    _m_isReady(false)
+  { }
+
+  GraphicComponentNull::~GraphicComponentNull()
+  {
+    destroy();
+  }
+
+  eRESULT
+  GraphicComponentNull::init(
+    const GraphicsConfiguration& _graphicConfiguration,
+    const WindowConfiguration& windowConfig,
+    ResourceManager& resourceManager)
+  {
+    if (_m_isReady)
+    {
+      Logger::GetReference().warning("Null GraphicComponent already created.");
+      return eRESULT::kFail;
+    }
+
+    _m_pResourceManager = &resourceManager;
+    _m_meshUploadBudget = _graphicConfiguration.meshUploadBudget;
+    _m_pWindow = new WindowNull(this);
+    _m_pWindow->init(windowConfig);
+
+    // Default shaders, under the same keys as the other graphic components.
+    ResourceGroup<Shader>& shaders = resourceManager.getShaders();
+    const char* aKeys[2] = { "__vertex_default", "__fragment_default" };
+    const eSHADER_TYPE aTypes[2] = { eSHADER_TYPE::kVertex, eSHADER_TYPE::kFragment };
+
+    for (uint32 i = 0; i < 2; ++i)
+    {
+      IShader* pShader = aTypes[i] == eSHADER_TYPE::kVertex
+        ? createVertexShader()
+        : createFragmentShader();
+      eRESULT result = pShader->create("", aTypes[i]);
+      if (result == eRESULT::kSuccess)
+      {
+        result = shaders.add(aKeys[i], reinterpret_cast<Shader*>(pShader));
+      }
+      else
+      {
+        delete static_cast<ShaderNull*>(pShader);
+      }
+
+      if (result != eRESULT::kSuccess)
+      {
+        Logger::Error("| GraphicComponentNull | Cannot initialize the component.");
+        _releaseResources(resourceManager);
+        return eRESULT::kFail;
+      }
+    }
+
+    // Create default program.
+    _m_pProgramNull = static_cast<ProgramNull*>(createProgram());
+    if (_m_pProgramNull->create("__fragment_default", "__vertex_default", &resourceManager)
+        != eRESULT::kSuccess)
+    {
+      Logger::Error("| GraphicComponentNull | Cannot initialize the component.");
+      _releaseResources(resourceManager);
+      return eRESULT::kFail;
+    }
+
+    _m_positionOffset = Vector3f(0.0f, 0.0f, 0.0f);
+    _m_positionScale = Vector3f(1.0f, 1.0f, 1.0f);
+
+    _m_pWindow->addObserver(this);
+    _m_isReady = !_m_isReady;
+    return eRESULT::kSuccess;
+  }
+
+  void
+  GraphicComponentNull::clear(const Color& _clearColor)
+  {
+    ++_m_counters.clears;
+
+    RecordedCommand command;
+    command.type = eRECORDED_COMMAND::kClear;
+    command.color = _clearColor;
+    _record(command);
+  }
+
+  void 
+  GraphicComponentNull::prepareToDraw(Camera* _camera)
+  {
+    _m_activeProgramId = *(reinterpret_cast<uint32*>(_m_pProgramNull->getProgramPtr()));
+    ++_m_counters.programBinds;
+
+    RecordedCommand command;
+    command.type = eRECORDED_COMMAND::kBindProgram;
+    command.objectId = _m_activeProgramId;
+    _record(command);
+
+    if (_camera == nullptr)
+    {
+      return;
+    }
+
+    if (_m_pWindow->getHeight() > 0)
+    {
+      _camera->setAspectRatio((float)_m_pWindow->getWidth() / (float)_m_pWindow->getHeight());
+    }
+    Matrix4 projViewMatrix = (_camera->getProjectionMatrix() * Matrix4::GetTranslation(_camera->getPosition())).transpose();
+    _recordUniform("proj_view_matrix", projViewMatrix);
+  }
+
+  void
+  GraphicComponentNull::uploadMeshes()
+  {
+    _m_uploadedBytes = 0;
+
+    MeshUploadQueue& queue = _m_pResourceManager->getMeshes().getUploadQueue();
+    MeshUpload upload;
+    while ((0 == _m_meshUploadBudget || _m_uploadedBytes < _m_meshUploadBudget)
+           && queue.pop(upload))
+    {
+      upload.pMesh->init(upload.getDescription());
+      _m_uploadedBytes += static_cast<uint32>(upload.getSize());
+    }
+  }
+
+  void 
+  GraphicComponentNull::drawScene(Scene* pScene)
+  {
+    return;
+  }
+
+  void
+  GraphicComponentNull::drawQueue(const RenderQueue& queue)
+  {
+    _m_renderStats = RenderStats();
+    _m_renderStats.packets = queue.getSize();
+    _m_renderStats.uploadedBytes = _m_uploadedBytes;
+    _m_renderStats.pendingUploads = _m_pResourceManager->getMeshes().getUploadQueue().getSize();
+    if (0 == _m_renderStats.packets)
+    {
+      return;
+    }
+
+    // Every draw uses the same depth state, only the first one sets it.
+    bool isDepthStateSet = false;
+    MeshNull* pBoundMesh = nullptr;
+
+    uint32 first = 0;
+    while (first < _m_renderStats.packets)
+    {
+      const RenderPacket& packet = queue.getPacket(first);
+      uint64 batchKey = RenderQueue::GetBatchKey(packet.sortKey);
+
+      uint32 end = first + 1;
+      while (end < _m_renderStats.packets
+             && queue.getPacket(end).pMesh == packet.pMesh
+             && RenderQueue::GetBatchKey(queue.getPacket(end).sortKey) == batchKey)
+      {
+        ++end;
+      }
+
+      MeshNull* pMesh = static_cast<MeshNull*>(packet.pMesh);
+      if (pMesh != pBoundMesh)
+      {
+        pMesh->bind(this);
+        pBoundMesh = pMesh;
+        ++_m_renderStats.meshBinds;
+        _m_renderStats.skippedMeshBinds += end - first - 1;
+      }
+      else
+      {
+        _m_renderStats.skippedMeshBinds += end - first;
+      }
+
+      if (isDepthStateSet)
+      {
+        ++_m_renderStats.skippedStateSets;
+      }
+      else
+      {
+        recordDepthState();
+        isDepthStateSet = true;
+        ++_m_renderStats.stateSets;
+      }
+
+      // The model matrix of each instance of the batch.
+      for (uint32 i = first; i < end; ++i)
+      {
+        setModelMatrix(queue.getPacket(i).modelMatrix);
+        ++_m_renderStats.uniformSets;
+      }
+
+      pMesh->drawBoundInstanced(end - first);
+      ++_m_renderStats.drawCalls;
+      first = end;
+    }
+  }
+
+  const RenderStats&
+  GraphicComponentNull::getRenderStats()
+  {
+    return _m_renderStats;
+  }
+
+  IMesh*
+  GraphicComponentNull::createMesh()
+  {
+    ++_m_counters.meshesCreated;
+    return new MeshNull(this, _nextObjectId());
+  }
+
+  void
+  GraphicComponentNull::destroyMesh(IMesh* pMesh)
+  {
+    // The uploads are done as soon as they are taken from the queue.
+    pMesh->destroy();
+    delete pMesh;
+  }
+
+  void 
+  GraphicComponentNull::setModelMatrix(const Matrix4& modelMatrix)
+  {
+    _recordUniform("model_matrix", modelMatrix);
+  }
+
+  void
+  GraphicComponentNull::setPositionDequantization
+  (
+    const Vector3f& offset,
+    const Vector3f& scale
+  )
+  {
+    _recordUniform("position_offset", offset, _m_positionOffset);
+    _recordUniform("position_scale", scale, _m_positionScale);
+  }
+
+  IShader* 
+  GraphicComponentNull::createVertexShader()
+  {
+    ++_m_counters.shadersCreated;
+    return new ShaderNull(_nextObjectId());
+  }
+
+  IShader* 
+  GraphicComponentNull::createFragmentShader()
+  {
+    ++_m_counters.shadersCreated;
+    return new ShaderNull(_nextObjectId());
+  }
+
+  IProgram* 
+  GraphicComponentNull::createProgram()
+  {
+    ++_m_counters.programsCreated;
+    return new ProgramNull(_nextObjectId());
+  }
+
+  IWindow* 
+  GraphicComponentNull::getWindow()
+  {
+    return _m_pWindow;
+  }
+
+  void
+  GraphicComponentNull::destroy()
+  {
+    if (!_m_isReady)
+    {
+      return;
+    }
+
+    if (_m_pResourceManager != nullptr)
+    {
+      _releaseResources(*_m_pResourceManager);
+    }
+
+    _m_isReady = !_m_isReady;
+    return;
+  }
+
+  eGRAPHIC_INTERFACE 
+  GraphicComponentNull::getGraphicInterfaceId()
+  {
+    return eGRAPHIC_INTERFACE::kNull;
+  }
+
+  void 
+  GraphicComponentNull::onWindowSizeChanged(
+    const uint32& width, 
+    const uint32& height, 
+    IWindow* pWindow)
+  {
+    ++_m_counters.viewportChanges;
+
+    RecordedCommand command;
+    command.type = eRECORDED_COMMAND::kSetViewport;
+    command.width = width;
+    command.height = height;
+    _record(command);
+  }
+
+  void
+  GraphicComponentNull::recordDraw
+  (
+    const uint32& meshId,
+    const uint32& verticesSize,
+    const uint32& instancesSize
+  )
+  {
+    ++_m_counters.draws;
+    _m_counters.drawnVertices += static_cast<uint64>(verticesSize) * instancesSize;
+    _m_counters.drawnInstances += instancesSize;
+
+    RecordedCommand command;
+    command.type = eRECORDED_COMMAND::kDraw;
+    command.objectId = meshId;
+    command.count = verticesSize;
+    command.instances = instancesSize;
+    _record(command);
+  }
+
+  void
+  GraphicComponentNull::recordDepthState()
+  {
+    ++_m_counters.depthStateSets;
+
+    RecordedCommand command;
+    command.type = eRECORDED_COMMAND::kSetDepthState;
+    _record(command);
+  }
+
+  void
+  GraphicComponentNull::recordUpload(const uint64& bytes)
+  {
+    _m_counters.uploadedBytes += bytes;
+  }
+
+  void
+  GraphicComponentNull::recordPresent()
+  {
+    ++_m_counters.frames;
+
+    RecordedCommand command;
+    command.type = eRECORDED_COMMAND::kPresent;
+    _record(command);
+  }
+
+  void
+  GraphicComponentNull::setCommandsRecording(const bool& enabled)
+  {
+    _m_isRecordingCommands = enabled;
+  }
+
+  const Vector<RecordedCommand>&
+  GraphicComponentNull::getCommands() const
+  {
+    return _m_commands;
+  }
+
+  const RecordedCounters&
+  GraphicComponentNull::getCounters() const
+  {
+    return _m_counters;
+  }
+
+  void
+  GraphicComponentNull::resetRecording()
+  {
+    _m_commands.clear();
+    _m_counters = RecordedCounters();
+  }
+
+  void 
+  GraphicComponentNull::_releaseResources(ResourceManager& resourceManager)
+  {
+    if (_m_pProgramNull != nullptr)
+    {
+      _m_pProgramNull->destroy();
+      delete _m_pProgramNull;
+      _m_pProgramNull = nullptr;
+    }
+
+    ResourceGroup<Shader>& shaders = resourceManager.getShaders();    
+    if (shaders.has("__fragment_default"))
+    {
+      shaders.removeAndDestroy("__fragment_default");
+    }
+    if (shaders.has("__vertex_default"))
+    {
+      shaders.removeAndDestroy("__vertex_default");
+    }
+
+    if (_m_pWindow != nullptr)
+    {
+      delete _m_pWindow;
+      _m_pWindow = nullptr;
+    }
+
+    return;
+  }
+
+  void
+  GraphicComponentNull::_recordUniform(const char* pName, const Matrix4& value)
+  {
+    ++_m_counters.uniformSets;
+
+    RecordedCommand command;
+    command.type = eRECORDED_COMMAND::kSetUniformMatrix;
+    command.objectId = _m_activeProgramId;
+    command.pUniformName = pName;
+    command.matrix = value;
+    _record(command);
+  }
+
+  void
+  GraphicComponentNull::_recordUniform
+  (
+    const char* pName,
+    const Vector3f& value,
+    Vector3f& current
+  )
+  {
+    ++_m_counters.uniformSets;
+    if (value.x == current.x && value.y == current.y && value.z == current.z)
+    {
+      ++_m_counters.redundantUniformSets;
+    }
+    current = value;
+
+    RecordedCommand command;
+    command.type = eRECORDED_COMMAND::kSetUniformVector;
+    command.objectId = _m_activeProgramId;
+    command.pUniformName = pName;
+    command.vector = value;
+    _record(command);
+  }
+
+  void
+  GraphicComponentNull::_record(const RecordedCommand& command)
+  {
+    if (_m_isRecordingCommands)
+    {
+      _m_commands.push_back(command);
+    }
+  }
+
+  uint32
+  GraphicComponentNull::_nextObjectId()
+  {
+    return ++_m_lastObjectId;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#include <Hakool\GraphicsNull\hkGraphicsNullPlugin.h>
+
+namespace hk
+{
+  HK_GRAPHICS_NULL_EXPORT IPlugin* 
+  createGraphicComponentNullPlugin()
+  {
+    return new GraphicsNullPlugin();
+  }
+
+  HK_GRAPHICS_NULL_EXPORT void 
+  destroyGraphicComponentNullPlugin()
+  {
+    return;
+  }
+}
\ No newline at end of file
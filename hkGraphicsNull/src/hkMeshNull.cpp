@@ -0,0 +1,122 @@
+#include <Hakool/GraphicsNull/hkMeshNull.h>
+#include <Hakool/GraphicsNull/hkGraphicComponentNull.h>
+
+namespace hk
+{
+  MeshNull::MeshNull(GraphicComponentNull* pGraphicComponent, const uint32& id) :
+    IMesh(),
+    _m_pGraphicComponent(pGraphicComponent),
+    _m_id(id),
+    _m_size(0),
+    _m_indicesSize(0),
+    _m_isQuantized(false),
+    _m_quantization(),
+    _m_isResident(false)
+  { }
+
+  MeshNull::~MeshNull()
+  {
+    destroy();
+  }
+
+  void 
+  MeshNull::init(const MeshDescription& description)
+  {
+    _m_size = description.verticesSize;
+    _m_isQuantized = description.vertexFormat == eVERTEX_FORMAT::kQuantized;
+    _m_quantization = description.quantization;
+
+    uint64 vertexSize = _m_isQuantized ? sizeof(QuantizedVertex) : sizeof(float) * 3;
+    _m_pGraphicComponent->recordUpload(vertexSize * _m_size);
+
+    _m_indicesSize = 0;
+    eINDEX_TYPE indexType = description.getIndexType();
+    if (indexType != eINDEX_TYPE::kNone)
+    {
+      _m_indicesSize = description.indicesSize;
+
+      uint64 indexSize = indexType == eINDEX_TYPE::kUInt16 ? sizeof(uint16) : sizeof(uint32);
+      _m_pGraphicComponent->recordUpload(indexSize * _m_indicesSize);
+    }
+
+    _m_isResident.store(true, std::memory_order_release);
+  }
+
+  bool
+  MeshNull::isResident()
+  {
+    return _m_isResident.load(std::memory_order_acquire);
+  }
+
+  void 
+  MeshNull::draw(GraphicComponent* pGraphicComponent)
+  {
+    bind(pGraphicComponent);
+    _m_pGraphicComponent->recordDepthState();
+    drawBound();
+  }
+
+  void
+  MeshNull::bind(GraphicComponent* pGraphicComponent)
+  {
+    if (_m_isQuantized)
+    {
+      pGraphicComponent->setPositionDequantization
+      (
+        _m_quantization.positionOffset,
+        _m_quantization.positionScale
+      );
+    }
+    else
+    {
+      pGraphicComponent->setPositionDequantization
+      (
+        Vector3f(0.0f, 0.0f, 0.0f),
+        Vector3f(1.0f, 1.0f, 1.0f)
+      );
+    }
+  }
+
+  void
+  MeshNull::drawBound()
+  {
+    _m_pGraphicComponent->recordDraw(_m_id, _m_indicesSize > 0 ? _m_indicesSize : _m_size);
+  }
+
+  void
+  MeshNull::drawBoundInstanced(const uint32& instancesSize)
+  {
+    _m_pGraphicComponent->recordDraw
+    (
+      _m_id,
+      _m_indicesSize > 0 ? _m_indicesSize : _m_size,
+      instancesSize
+    );
+  }
+
+  uint32 
+  MeshNull::getVertexesSize()
+  {
+    return _m_size;
+  }
+
+  float*
+  MeshNull::getVertexesArray()
+  {
+    return nullptr;
+  }
+
+  void 
+  MeshNull::destroy()
+  {
+    _m_isResident.store(false, std::memory_order_release);
+    _m_size = 0;
+    _m_indicesSize = 0;
+  }
+
+  uint32
+  MeshNull::getId()
+  {
+    return _m_id;
+  }
+}
\ No newline at end of file
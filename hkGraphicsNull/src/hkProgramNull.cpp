@@ -0,0 +1,110 @@
+#include <Hakool\Utils\hkLogger.h>
+
+#include <Hakool\Core\hkResourceManager.h>
+#include <Hakool\GraphicsNull\hkProgramNull.h>
+#include <Hakool\GraphicsNull\hkShaderNull.h>
+
+namespace hk
+{
+  ProgramNull::ProgramNull(const uint32& id) :
+    _m_isReady(false),
+    _m_programId(0),
+    _m_id(id)
+  {
+    // Intentionally blank.
+    return;
+  }
+
+  ProgramNull::~ProgramNull()
+  {
+    destroy();
+    return;
+  }
+
+  eRESULT 
+  ProgramNull::init(GraphicComponent* _pGraphicComponent)
+  {
+    // Intentionally blank
+    return eRESULT::kSuccess;
+  }
+
+  eRESULT 
+  ProgramNull::create
+  (
+    const String& _fragment, 
+    const String& _vertex, 
+    ResourceManager* _pResourceManager
+  )
+  {
+    if (_m_isReady)
+    {
+      Logger::Error("| ProgramNull | Program is already created.");
+
+      return eRESULT::kFail;
+    }
+
+    ResourceGroup<Shader>& shaders = _pResourceManager->getShaders();
+    
+    if (!shaders.has(_fragment))
+    {
+      Logger::Error("| ProgramNull | Shader : " + _fragment + " was not found.");
+
+      return eRESULT::kFail;
+    }
+
+    ShaderNull* pFragment 
+       = reinterpret_cast<ShaderNull*>(shaders.get(_fragment));
+    if (pFragment->getType() != eSHADER_TYPE::kFragment)
+    {
+      Logger::Error("| ProgramNull | The shader : " + _fragment + " is not a fragment shader");
+
+      return eRESULT::kFail;
+    }
+
+    if (!shaders.has(_vertex))
+    {
+      Logger::Error("| ProgramNull | Shader : " + _vertex + " was not found.");
+
+      return eRESULT::kFail;
+    }
+
+    ShaderNull* pVertex
+      = reinterpret_cast<ShaderNull*>(shaders.get(_vertex));
+    if (pVertex->getType() != eSHADER_TYPE::kVertex)
+    {
+      Logger::Error("| ProgramNull | The shader : " + _vertex + " is not a vertex shader");
+
+      return eRESULT::kFail;
+    }
+
+    _m_programId = _m_id;
+    _m_isReady = !_m_isReady;
+
+    return eRESULT::kSuccess;
+  }
+
+  void* 
+  ProgramNull::getProgramPtr()
+  {
+    return reinterpret_cast<void*>(&_m_programId);
+  }
+
+  bool 
+  ProgramNull::isReady()
+  {
+    return _m_isReady;
+  }
+
+  void 
+  ProgramNull::destroy()
+  {
+    if (_m_isReady)
+    {
+      _m_isReady = !_m_isReady;
+    }
+
+    _m_programId = 0;
+
+    return;
+  }
+}
\ No newline at end of file
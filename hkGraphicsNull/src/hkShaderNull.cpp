@@ -0,0 +1,90 @@
+#include <Hakool\GraphicsNull\hkShaderNull.h>
+
+#include <Hakool\Utils\hkLogger.h>
+
+namespace hk
+{
+  ShaderNull::ShaderNull(const uint32& id) :
+    _m_type(eSHADER_TYPE::kUndefined),
+    _m_shaderId(0),
+    _m_id(id),
+    _m_isReady(false)
+  {
+    // Intentionally blank
+    return;
+  }
+
+  ShaderNull::~ShaderNull()
+  {
+    destroy();
+    return;
+  }
+
+  void* 
+  ShaderNull::getShaderPtr()
+  {
+    return static_cast<void*>(&_m_shaderId);
+  }
+
+  eRESULT 
+  ShaderNull::init(GraphicComponent*)
+  {
+    // Intentionally blank
+    return eRESULT::kSuccess;
+  }
+
+  eRESULT 
+  ShaderNull::create(const char* _pSource, const eSHADER_TYPE& _type)
+  {
+    if (_m_isReady) 
+    {
+      Logger::Error("| ShaderNull | Shader is already created.");
+
+      return eRESULT::kFail;
+    }
+
+    if (_type != eSHADER_TYPE::kFragment && _type != eSHADER_TYPE::kVertex)
+    {
+      Logger::Error("| ShaderNull | Not supported shader type.");   
+      return eRESULT::kFail;
+    }
+
+    if (_pSource == nullptr)
+    {
+      Logger::Error("| ShaderNull | Invalid shader source.");
+      return eRESULT::kFail;
+    }
+
+    _m_shaderId = _m_id;
+    _m_isReady = !_m_isReady;
+    _m_type = _type;
+
+    return eRESULT::kSuccess;
+  }
+
+  bool 
+  ShaderNull::isReady()
+  {
+    return _m_isReady;
+  }
+
+  void
+  ShaderNull::destroy()
+  {
+    if (_m_isReady)
+    {
+      _m_isReady = !_m_isReady;
+    }
+
+    _m_shaderId = 0;
+    _m_type = eSHADER_TYPE::kUndefined;
+
+    return;
+  }
+
+  eSHADER_TYPE 
+  ShaderNull::getType()
+  {
+    return _m_type;
+  }
+}
\ No newline at end of file
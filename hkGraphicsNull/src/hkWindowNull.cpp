@@ -0,0 +1,151 @@
+#include <Hakool/GraphicsNull/hkWindowNull.h>
+#include <Hakool/GraphicsNull/hkGraphicComponentNull.h>
+#include <Hakool/Utils/hkWindowObserver.h>
+
+namespace hk
+{
+  WindowNull::WindowNull(GraphicComponentNull* pGraphicComponent) :
+    _m_pGraphicComponent(pGraphicComponent),
+    _m_observers(),
+    _m_title(""),
+    _m_width(0),
+    _m_height(0),
+    _m_isOpen(false)
+  { }
+
+  WindowNull::~WindowNull()
+  {
+    destroy();
+  }
+
+  eRESULT 
+  WindowNull::init(const WindowConfiguration& _config)
+  {
+    if (_m_isOpen)
+    {
+      throw std::logic_error("WindowNull is already initialized.");
+    }
+
+    _m_width = _config.width;
+    _m_height = _config.height;
+    _m_title = _config.title;
+    _m_isOpen = true;
+    return eRESULT::kSuccess;
+  }
+
+  void 
+  WindowNull::setSize(const uint32& _width, const uint32& _height)
+  {
+    if (_m_isOpen)
+    {
+      _m_width = _width;
+      _m_height = _height;
+      for (auto pObserver : _m_observers)
+      {
+        pObserver->onWindowSizeChanged(_width, _height, this);
+      }
+    }
+  }
+
+  void 
+  WindowNull::setSize(const Vector2u& _v2)
+  {
+    setSize(_v2.x, _v2.y);
+  }
+
+  void 
+  WindowNull::setTitle(const String& _title)
+  {
+    if (_m_isOpen)
+    {
+      _m_title = _title;
+    }
+  }
+
+  HANDLER 
+  WindowNull::getWindowHandler()
+  {
+    return NULL;
+  }
+
+  bool 
+  WindowNull::isOpen()
+  {
+    return _m_isOpen;
+  }
+
+  void 
+  WindowNull::pollEvents()
+  { }
+
+  void 
+  WindowNull::update()
+  { }
+
+  void 
+  WindowNull::postUpdate()
+  { }
+
+  void 
+  WindowNull::present()
+  {
+    if (_m_isOpen && _m_pGraphicComponent != nullptr)
+    {
+      _m_pGraphicComponent->recordPresent();
+    }
+  }
+
+  void
+  WindowNull::makeContextCurrent()
+  { }
+
+  void
+  WindowNull::releaseContext()
+  { }
+
+  void 
+  WindowNull::destroy()
+  {
+    _m_title = "";
+    _m_width = 0;
+    _m_height = 0;
+    _m_isOpen = false;
+    _m_observers.clear();
+  }
+
+  void 
+  WindowNull::addObserver(WindowObserver* pObserver)
+  {
+    _m_observers.push_back(pObserver);
+  }
+
+  Vector2u 
+  WindowNull::getSize()
+  {
+    return Vector2u(_m_width, _m_height);
+  }
+
+  uint32 
+  WindowNull::getWidth()
+  {
+    return _m_width;
+  }
+
+  uint32 
+  WindowNull::getHeight()
+  {
+    return _m_height;
+  }
+
+  String 
+  WindowNull::getTitle()
+  {
+    return _m_title;
+  }
+
+  void
+  WindowNull::close()
+  {
+    _m_isOpen = false;
+  }
+}
\ No newline at end of file
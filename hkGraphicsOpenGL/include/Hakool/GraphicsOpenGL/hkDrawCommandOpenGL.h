@@ -0,0 +1,34 @@
+#pragma once
+
+#include <Hakool\GraphicsOpenGL\hkGraphicsOpenGLPrerequisites.h>
+
+namespace hk
+{
+  /**
+  * A command of glMultiDrawElementsIndirect. The layout is set by OpenGL.
+  */
+  struct DrawElementsCommandOpenGL
+  {
+    uint32 count;
+    uint32 instanceCount;
+
+    /**
+    * First index, in indices of the index type.
+    */
+    uint32 firstIndex;
+
+    int32 baseVertex;
+    uint32 baseInstance;
+  };
+
+  /**
+  * A command of glMultiDrawArraysIndirect. The layout is set by OpenGL.
+  */
+  struct DrawArraysCommandOpenGL
+  {
+    uint32 count;
+    uint32 instanceCount;
+    uint32 first;
+    uint32 baseInstance;
+  };
+}
\ No newline at end of file
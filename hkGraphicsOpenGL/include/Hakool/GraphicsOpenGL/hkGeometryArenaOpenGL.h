@@ -0,0 +1,400 @@
+#pragma once
+
+#include <Hakool\Utils\hkRangeAllocator.h>
+#include <Hakool\Core\hkCoreUtilities.h>
+#include <Hakool\Core\hkMeshDescription.h>
+#include <Hakool\GraphicsOpenGL\hkGraphicsOpenGLPrerequisites.h>
+#include <GL/glew.h>
+
+namespace hk
+{
+  class StateCacheOpenGL;
+
+  /**
+  * Place of a mesh in the geometry arena.
+  */
+  struct GeometryAllocationOpenGL
+  {
+    eVERTEX_FORMAT vertexFormat;
+
+    /**
+    * Base vertex of the mesh in the vertex buffer of its format.
+    */
+    uint32 firstVertex;
+
+    uint32 verticesSize;
+
+    /**
+    * Offset of the indices in the index buffer, in 4 bytes words.
+    */
+    uint32 firstIndexWord;
+
+    uint32 indexWordsSize;
+
+    uint32 indicesSize;
+
+    /**
+    * GL_UNSIGNED_SHORT or GL_UNSIGNED_INT, 0 if the mesh isn't indexed.
+    */
+    GLenum indexType;
+
+    bool isUsed;
+  };
+
+  /**
+  * A range of one of the buffers of the arena.
+  */
+  struct GeometryRangeOpenGL
+  {
+    GLuint buffer;
+
+    /**
+    * Offset of the range in the buffer, in bytes.
+    */
+    GLintptr offset;
+
+    /**
+    * Bytes of the range.
+    */
+    GLsizeiptr size;
+  };
+
+  /**
+  * Stores the static geometry of all the meshes in one vertex buffer per
+  * vertex format and one shared index buffer.
+  *
+  * Meshes are ranges of those buffers, drawn with a base vertex and an index
+  * offset, so drawing meshes of the same format needs no bind. The buffers
+  * grow when full, and are compacted when freeing meshes leaves their space
+  * fragmented. Both copy the meshes to a new buffer a few at a time (see
+  * moveBuffers), the draws read the old buffer until the copy ends.
+  */
+  class GeometryArenaOpenGL
+  {
+  public:
+
+    /**
+    * Handle returned when an allocation fails.
+    */
+    static const uint32 INVALID_HANDLE = 0xffffffff;
+
+    /**
+    * Maximum allocations alive at the same time. The id of a mesh packs its
+    * handle and its vertex format in the mesh bits of the sort keys.
+    */
+    static const uint32 MAX_HANDLES = 1 << 19;
+
+    /**
+    * First attribute location of the instance mat4, one per column.
+    */
+    static const GLuint INSTANCE_MATRIX_LOCATION = 4;
+
+    /**
+    * Vertex buffer binding index the instance data is read from.
+    */
+    static const GLuint INSTANCE_BINDING = 1;
+
+    /**
+    * Constructor.
+    */
+    GeometryArenaOpenGL();
+
+    /**
+    * Destructor.
+    */
+    ~GeometryArenaOpenGL();
+
+    /**
+    * Create the buffers and a vertex array object per vertex format.
+    *
+    * @param stateCache Binds of the arena, it must outlive it.
+    * @param verticesCapacity Initial vertices of each vertex buffer.
+    * @param indexWordsCapacity Initial 4 bytes words of the index buffer.
+    *
+    * @return Operation result.
+    */
+    eRESULT
+    init
+    (
+      StateCacheOpenGL& stateCache,
+      const uint32& verticesCapacity,
+      const uint32& indexWordsCapacity
+    );
+
+    /**
+    * Place and upload the geometry of a mesh.
+    *
+    * @param description The vertices and indices of the mesh.
+    *
+    * @return The handle of the allocation, or INVALID_HANDLE.
+    */
+    uint32
+    allocate(const MeshDescription& description);
+
+    /**
+    * Place the geometry of a mesh without uploading it. The data is written
+    * later to the ranges of the allocation. The moves in progress are
+    * finished first.
+    *
+    * A full buffer starts growing, and the ranges of the allocation must not
+    * be written until isMoving is false.
+    *
+    * @param description The sizes and formats of the mesh. The arrays are
+    * not read.
+    *
+    * @return The handle of the allocation, or INVALID_HANDLE when the
+    * arena already holds MAX_HANDLES allocations.
+    */
+    uint32
+    reserve(const MeshDescription& description);
+
+    /**
+    * Get the current range of the vertices of an allocation. It changes when
+    * a move of its buffer ends.
+    */
+    GeometryRangeOpenGL
+    getVertexRange(const uint32& handle);
+
+    /**
+    * Get the current range of the indices of an allocation, in the layout of
+    * its index type, without the padding of 16 bits indices.
+    */
+    GeometryRangeOpenGL
+    getIndexRange(const uint32& handle);
+
+    /**
+    * Release the geometry of a mesh. Does nothing once the arena is
+    * destroyed.
+    *
+    * @param handle The handle given by allocate.
+    */
+    void
+    free(const uint32& handle);
+
+    /**
+    * Get the current place of a mesh. It changes when a compaction of its
+    * buffers ends.
+    */
+    const GeometryAllocationOpenGL&
+    getAllocation(const uint32& handle) const;
+
+    /**
+    * Bind the vertex array object of a vertex format, unless it is already
+    * bound.
+    */
+    void
+    bind(const eVERTEX_FORMAT& vertexFormat);
+
+    /**
+    * Read the instance attributes of every vertex format from a buffer.
+    *
+    * @param buffer The buffer with the instance data.
+    * @param stride Bytes of each instance.
+    */
+    void
+    setInstanceBuffer(const uint32& buffer, const hkSize& stride);
+
+    /**
+    * Check if the free space of a buffer that isn't moving is fragmented
+    * enough to compact it.
+    */
+    bool
+    isFragmented() const;
+
+    /**
+    * Start moving the meshes of the fragmented buffers to the start of new
+    * buffers, leaving the free space in one range. The meshes are copied by
+    * moveBuffers.
+    */
+    void
+    defragment();
+
+    /**
+    * Copy the meshes of the growing and compacted buffers, up to a number of
+    * bytes. The draws switch to a new buffer once all of its meshes are
+    * copied, and the old one is deleted when the GPU no longer reads it.
+    *
+    * @param budget Bytes the GPU may copy.
+    *
+    * @return The bytes copied.
+    */
+    hkSize
+    moveBuffers(const hkSize& budget);
+
+    /**
+    * Check if a buffer is growing or being compacted.
+    */
+    bool
+    isMoving() const;
+
+    /**
+    * Delete the buffers. The allocations are forgotten.
+    */
+    void
+    destroy();
+
+  private:
+
+    /**
+    * Copy of the range of an allocation from the old buffer of a move to the
+    * new one, in elements of the buffer.
+    */
+    struct RangeCopy
+    {
+      uint32 handle;
+      uint32 source;
+      uint32 destination;
+      uint32 size;
+    };
+
+    /**
+    * Growth or compaction of a buffer into a new one.
+    */
+    struct BufferMove
+    {
+      /**
+      * The new buffer, 0 when the buffer isn't moving.
+      */
+      GLuint buffer;
+
+      uint32 capacity;
+
+      /**
+      * The allocations are packed at the start of the new buffer, their
+      * offsets change when the move ends.
+      */
+      bool compact;
+
+      Vector<RangeCopy> copies;
+
+      uint32 nextCopy;
+
+      /**
+      * Elements of the next copy already copied.
+      */
+      uint32 copiedSize;
+    };
+
+    /**
+    * A buffer of the arena and its allocator, in elements of elementSize
+    * bytes: the vertices of a pool or the 4 bytes words of the indices.
+    */
+    struct ArenaBuffer
+    {
+      GLuint buffer;
+      GLsizeiptr elementSize;
+      RangeAllocator allocator;
+      BufferMove move;
+    };
+
+    /**
+    * A replaced buffer, deleted once the GPU has passed its fence.
+    */
+    struct RetiredBuffer
+    {
+      GLsync fence;
+      GLuint buffer;
+    };
+
+    /**
+    * Index of the index buffer in _m_buffers, after the vertex pools.
+    */
+    static const uint32 INDEX_BUFFER = 2;
+
+    /**
+    * Create the vertex array object of a format and its attribute layout.
+    */
+    void
+    _initPool(const eVERTEX_FORMAT& vertexFormat, const uint32& capacity);
+
+    /**
+    * Create the new buffer of a move and list the ranges to copy to it.
+    * Growing keeps the offsets of the allocations.
+    *
+    * @param bufferIndex Index of the buffer in _m_buffers.
+    * @param capacity Elements of the new buffer.
+    * @param compact True to pack the allocations at the start of the new
+    * buffer.
+    */
+    void
+    _startMove(const uint32& bufferIndex, const uint32& capacity, const bool& compact);
+
+    /**
+    * Copy the next ranges of a move, and end it once they are all copied.
+    *
+    * @return The bytes copied.
+    */
+    hkSize
+    _stepMove(const uint32& bufferIndex, const hkSize& budget);
+
+    /**
+    * Switch the allocations and the vertex array objects to the new buffer
+    * of a move, and retire the old one.
+    */
+    void
+    _endMove(const uint32& bufferIndex);
+
+    /**
+    * Copy everything left of the moves in progress.
+    */
+    void
+    _finishMoves();
+
+    /**
+    * Delete the retired buffers the GPU is done with.
+    */
+    void
+    _releaseRetiredBuffers();
+
+    static uint32
+    _GetPoolIndex(const eVERTEX_FORMAT& vertexFormat);
+
+    /**
+    * Check if an allocation has a range in a buffer of the arena.
+    */
+    static bool
+    _IsInBuffer(const GeometryAllocationOpenGL& allocation, const uint32& bufferIndex);
+
+    /**
+    * First element of the range of an allocation in a buffer of the arena.
+    */
+    static uint32&
+    _GetFirst(GeometryAllocationOpenGL& allocation, const uint32& bufferIndex);
+
+    /**
+    * Elements of the range of an allocation in a buffer of the arena.
+    */
+    static uint32
+    _GetSize(const GeometryAllocationOpenGL& allocation, const uint32& bufferIndex);
+
+    /**
+    * Vertex pools indexed by eVERTEX_FORMAT, then the index buffer.
+    */
+    ArenaBuffer
+    _m_buffers[3];
+
+    /**
+    * Vertex array object of each vertex pool.
+    */
+    GLuint
+    _m_vaos[2];
+
+    Vector<RetiredBuffer>
+    _m_retiredBuffers;
+
+    Vector<GeometryAllocationOpenGL>
+    _m_allocations;
+
+    /**
+    * Released handles, reused by the next allocations.
+    */
+    Vector<uint32>
+    _m_freeHandles;
+
+    StateCacheOpenGL*
+    _m_pStateCache;
+
+    bool
+    _m_isReady;
+  };
+}
\ No newline at end of file
@@ -2,8 +2,18 @@
 
 #include <Hakool\Utils\hkColor.h>
 #include <Hakool\Utils\hkMatrix4.h>
+#include <Hakool\Utils\hkVector3.h>
 #include <Hakool\GraphicsOpenGL\hkGraphicsOpenGLPrerequisites.h>
 #include <Hakool\Core\hkGraphicComponent.h>
+#include <Hakool\Core\hkRenderStats.h>
+#include <Hakool\Core\hkMeshUploadQueue.h>
+#include <Hakool\GraphicsOpenGL\hkStateCacheOpenGL.h>
+#include <Hakool\GraphicsOpenGL\hkProgramBinaryCacheOpenGL.h>
+#include <Hakool\GraphicsOpenGL\hkShaderCompilerOpenGL.h>
+#include <Hakool\GraphicsOpenGL\hkShaderLibraryOpenGL.h>
+#include <Hakool\GraphicsOpenGL\hkRingBufferOpenGL.h>
+#include <Hakool\GraphicsOpenGL\hkGeometryArenaOpenGL.h>
+#include <Hakool\GraphicsOpenGL\hkDrawCommandOpenGL.h>
 
 namespace hk
 {
@@ -43,15 +53,45 @@ namespace hk
     virtual void
     prepareToDraw(Camera* pCamera) override;
 
+    /**
+    * Copy queued meshes to the geometry arena, in slices, through a staging
+    * ring buffer. A mesh bigger than the budget is uploaded over several
+    * frames and becomes resident with its last slice. The copies of a
+    * growing or compacting arena are charged to the same budget.
+    */
+    virtual void
+    uploadMeshes() override;
+
     virtual void
     drawScene(Scene* pScene) override;
 
+    virtual void
+    drawQueue(const RenderQueue& queue) override;
+
+    virtual const RenderStats&
+    getRenderStats() override;
+
     virtual IMesh*
     createMesh() override;
 
+    virtual void
+    destroyMesh(IMesh* pMesh) override;
+
     virtual void
     setModelMatrix(const Matrix4& modelMatrix) override;
 
+    virtual void
+    setPositionDequantization(const Vector3f& offset, const Vector3f& scale) override;
+
+    /**
+    * Use the variant of the default program that reads a vertex format.
+    *
+    * @return kFail if the variant failed to compile or link, the active
+    * program doesn't change.
+    */
+    eRESULT
+    useDefaultProgram(const eVERTEX_FORMAT& format);
+
     virtual IShader*
     createVertexShader() override;
 
@@ -74,7 +114,33 @@ namespace hk
     onWindowSizeChanged(
       const uint32& width, 
       const uint32& height, 
-      IWindow* pWindow) const override;
+      IWindow* pWindow) override;
+
+    /**
+    * Get the cache the GL state of the component goes through.
+    */
+    StateCacheOpenGL&
+    getStateCache();
+
+    /**
+    * Get the cache of the program binaries, disabled unless the graphics
+    * configuration names its directory.
+    */
+    ProgramBinaryCacheOpenGL&
+    getProgramCache();
+
+    /**
+    * Get the batch compiler of the programs. The programs submitted to it
+    * become ready in prepareToDraw, once the driver finished them.
+    */
+    ShaderCompilerOpenGL&
+    getShaderCompiler();
+
+    /**
+    * Get the shader library, it holds the variants of the default program.
+    */
+    ShaderLibraryOpenGL&
+    getShaderLibrary();
     
 
   private:
@@ -85,10 +151,86 @@ namespace hk
     _releaseResources(ResourceManager& resourceManager);
 
     /**
-    * Array of vertex array objects.
+    * Write the model matrices of the queue, in sorted order. They go to the
+    * ring buffer, or to the fallback instance buffer if it is not available
+    * or full.
+    *
+    * @param queue The sorted render queue.
+    *
+    * @return Instance index of the first matrix.
+    */
+    uint32
+    _streamInstances(const RenderQueue& queue);
+
+    /**
+    * Set the depth state of the draws through the state cache, counting the
+    * calls it issues and the ones it drops in the render stats.
+    */
+    void
+    _setDepthState();
+
+    /**
+    * Upload the next slice of the current mesh upload: vertices first, then
+    * whole indices.
+    *
+    * @param budget Bytes the slice may take.
+    *
+    * @return Bytes uploaded, 0 if nothing could be.
     */
-    uint32 
-    _m_aVAO[1];
+    hkSize
+    _uploadSlice(const hkSize& budget);
+
+    /**
+    * Write data to a buffer of the arena, through the staging buffer when
+    * there is one.
+    *
+    * @return False if the staging buffer of the frame is full.
+    */
+    bool
+    _writeGeometry
+    (
+      const GLuint& buffer,
+      const GLintptr& offset,
+      const void* pData,
+      const hkSize& size
+    );
+
+    /**
+    * Draw each batch of a range of packets with its own draw call. The
+    * meshes of the range must be bound.
+    *
+    * @param queue The sorted render queue.
+    * @param first Index of the first packet.
+    * @param end Index past the last packet.
+    * @param baseInstance Instance index of the first packet of the queue.
+    */
+    void
+    _drawBatches
+    (
+      const RenderQueue& queue,
+      const uint32& first,
+      const uint32& end,
+      const uint32& baseInstance
+    );
+
+    /**
+    * Draw the batches of a range of packets with a single multi draw
+    * indirect call. The meshes of the range must share their bind state and
+    * be bound. Falls back to _drawBatches if the ring buffer is full.
+    *
+    * @param queue The sorted render queue.
+    * @param first Index of the first packet.
+    * @param end Index past the last packet.
+    * @param baseInstance Instance index of the first packet of the queue.
+    */
+    void
+    _drawBatchesIndirect
+    (
+      const RenderQueue& queue,
+      const uint32& first,
+      const uint32& end,
+      const uint32& baseInstance
+    );
 
     /**
      * The ID of the current program.
@@ -97,7 +239,7 @@ namespace hk
     _m_activeProgramId;
 
     /**
-    * Pointer to the program.
+    * Pointer to the active program, a variant of the default source.
     */
     ProgramOpenGL*
     _m_pProgramOpenGL;
@@ -111,6 +253,136 @@ namespace hk
     Matrix4
     _m_modelViewMat;
 
+    /**
+    * Declared before the arena and the ring buffer, which use it until they
+    * are destroyed.
+    */
+    StateCacheOpenGL
+    _m_stateCache;
+
+    ProgramBinaryCacheOpenGL
+    _m_programCache;
+
+    ShaderCompilerOpenGL
+    _m_shaderCompiler;
+
+    /**
+    * Declared after the compiler, its pending variants are in the compiler.
+    */
+    ShaderLibraryOpenGL
+    _m_shaderLibrary;
+
+    uint32
+    _m_defaultSource;
+
+    /**
+    * Mask of the QUANTIZED keyword of the default source.
+    */
+    uint32
+    _m_quantizedKeyword;
+
+    /**
+    * Vertices and indices of every mesh created by this component.
+    */
+    GeometryArenaOpenGL
+    _m_geometryArena;
+
+    /**
+    * Streaming memory of the per frame data.
+    */
+    RingBufferOpenGL
+    _m_ringBuffer;
+
+    /**
+    * Staging memory of the mesh uploads, one budget per frame in flight.
+    */
+    RingBufferOpenGL
+    _m_stagingBuffer;
+
+    /**
+    * Bytes of mesh data uploaded each frame, 0 for no limit.
+    */
+    uint32
+    _m_meshUploadBudget;
+
+    /**
+    * Bytes uploaded by the last uploadMeshes call.
+    */
+    uint32
+    _m_uploadedBytes;
+
+    /**
+    * Bytes copied by the arena during the last uploadMeshes call.
+    */
+    uint32
+    _m_movedBytes;
+
+    /**
+    * Mesh being uploaded, its pMesh is nullptr between uploads.
+    */
+    MeshUpload
+    _m_upload;
+
+    /**
+    * Allocation of the mesh being uploaded in the arena.
+    */
+    uint32
+    _m_uploadHandle;
+
+    hkSize
+    _m_uploadedVertexBytes;
+
+    uint32
+    _m_uploadedIndices;
+
+    /**
+    * Slice of 16 bits indices being uploaded.
+    */
+    Vector<uint16>
+    _m_uploadIndices;
+
+    /**
+    * Fallback buffer of the per instance model matrices, orphaned every
+    * frame.
+    */
+    uint32
+    _m_instanceBuffer;
+
+    /**
+    * Capacity of the instance buffer, in bytes.
+    */
+    hkSize
+    _m_instanceBufferSize;
+
+    /**
+    * Model matrices of the frame, in sorted packet order, for the fallback
+    * buffer.
+    */
+    Vector<float>
+    _m_instanceData;
+
+    /**
+    * Commands of the multi draw call being built, reused every frame.
+    */
+    Vector<DrawElementsCommandOpenGL>
+    _m_drawElementsCommands;
+
+    Vector<DrawArraysCommandOpenGL>
+    _m_drawArraysCommands;
+
+    /**
+    * Multi draw indirect is requested, supported, and the ring buffer is
+    * there to hold the commands.
+    */
+    bool
+    _m_useIndirectDraws;
+
+    /**
+    * Counters of the last drawQueue call.
+    */
+    RenderStats
+    _m_renderStats;
+
     WindowOpenGL*
     _m_pWindow;
 
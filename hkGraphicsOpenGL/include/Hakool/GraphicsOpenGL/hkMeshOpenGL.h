@@ -3,21 +3,54 @@
 #include <Hakool\Core\hkIContext.h>
 #include <Hakool\Core\hkIMesh.h>
 #include <Hakool\GraphicsOpenGL\hkGraphicsOpenGLPrerequisites.h>
+#include <Hakool\GraphicsOpenGL\hkDrawCommandOpenGL.h>
 #include <GL/glew.h>
 
+#include <atomic>
+
 namespace hk
 {
+  class GeometryArenaOpenGL;
+
+  /**
+  * A mesh stored in the geometry arena of its GraphicComponentOpenGL.
+  */
   class MeshOpenGL : public IMesh
   {
   public:
 
-    MeshOpenGL();
+    /**
+    * Constructor.
+    *
+    * @param pGeometryArena The arena that stores the vertices and indices.
+    */
+    MeshOpenGL(GeometryArenaOpenGL* pGeometryArena);
 
     virtual 
     ~MeshOpenGL();
 
+    /**
+    * Upload the vertices and indices to the geometry arena.
+    */
     virtual void
-    init(float* _aVertexes, const uint32& _size) override;
+    init(const MeshDescription& description) override;
+
+    /**
+    * Resident once its geometry is in the arena, until destroy.
+    */
+    virtual bool
+    isResident() override;
+
+    /**
+    * Use geometry uploaded to the arena by the GraphicComponentOpenGL. The
+    * previous geometry is released, and the mesh is resident from now on.
+    *
+    * @param handle The allocation of the geometry in the arena.
+    * @param description The formats of the uploaded data. The arrays are not
+    * read.
+    */
+    void
+    setGeometry(const uint32& handle, const MeshDescription& description);
 
     virtual void
     draw(GraphicComponent* pGraphicComponent) override;
@@ -28,15 +61,109 @@ namespace hk
     virtual float*
     getVertexesArray() override;
 
+    /**
+    * Get the id of the mesh. Meshes of the same vertex format have near ids,
+    * so sorting by id also groups the vertex array object binds.
+    */
+    virtual uint32
+    getId() override;
+
     virtual void
     destroy() override;
 
+    /**
+    * Bind the vertex array object of the vertex format, its instance
+    * attributes and the dequantization of the vertices.
+    * 
+    * @param pGraphicComponent Pointer to the GraphicComponent.
+    *
+    * @return kFail if the program of the vertex format isn't available, the
+    * mesh must not be drawn.
+    */
+    eRESULT
+    bind(GraphicComponent* pGraphicComponent);
+
+    /**
+    * Draw the vertices. The mesh must be bound and the depth state set.
+    */
+    void
+    drawBound();
+
+    /**
+    * Draw several instances of the vertices. The mesh must be bound and the
+    * depth state set.
+    * 
+    * @param instancesSize Count of instances.
+    * @param firstInstance Index of the first instance in the instance
+    * attributes.
+    */
+    void
+    drawBoundInstanced(const uint32& instancesSize, const uint32& firstInstance);
+
+    /**
+    * Check if a mesh can be drawn with the binds of this one, in the same
+    * multi draw call: same vertex format, same index type and, for
+    * quantized meshes, same dequantization.
+    *
+    * @param other The other mesh.
+    */
+    bool
+    sharesBindState(const MeshOpenGL& other) const;
+
+    /**
+    * Get the index type of the mesh, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT,
+    * 0 if the mesh isn't indexed.
+    */
+    GLenum
+    getIndexType() const;
+
+    /**
+    * Get the indirect command drawing instances of an indexed mesh.
+    *
+    * @param instancesSize Count of instances.
+    * @param firstInstance Index of the first instance in the instance
+    * attributes.
+    */
+    DrawElementsCommandOpenGL
+    getDrawElementsCommand(const uint32& instancesSize, const uint32& firstInstance) const;
+
+    /**
+    * Get the indirect command drawing instances of a mesh without indices.
+    *
+    * @param instancesSize Count of instances.
+    * @param firstInstance Index of the first instance in the instance
+    * attributes.
+    */
+    DrawArraysCommandOpenGL
+    getDrawArraysCommand(const uint32& instancesSize, const uint32& firstInstance) const;
+
   private:
 
-    GLuint 
-    _m_vbo;
+    GeometryArenaOpenGL*
+    _m_pGeometryArena;
 
+    /**
+    * Handle of the geometry in the arena.
+    */
+    uint32
+    _m_handle;
+
+    /**
+    * Count of vertices.
+    */
     uint32
     _m_size;
+
+    bool
+    _m_isQuantized;
+
+    VertexQuantization
+    _m_quantization;
+
+    /**
+    * Set after the other members, read by the threads recording the draws.
+    */
+    std::atomic<bool>
+    _m_isResident;
   };
 }
\ No newline at end of file
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <Hakool\Utils\hkUtilitiesUtilities.h>
+#include <Hakool\GraphicsOpenGL\hkGraphicsOpenGLPrerequisites.h>
+#include <GL/glew.h>
+
+namespace hk
+{
+  /**
+  * Stores the binaries of the linked programs in a directory, one file per
+  * program, so the next launches load them with glProgramBinary instead of
+  * compiling and linking their shaders.
+  *
+  * A binary is only valid for the driver that produced it. The keys mix the
+  * hash of the sources with the vendor, renderer and version strings of the
+  * context, so updating the driver or changing a source only misses the
+  * cache. A binary the driver rejects is deleted and the program is linked
+  * from its sources again.
+  *
+  * Only use it on the thread that owns the context.
+  */
+  class ProgramBinaryCacheOpenGL
+  {
+  public:
+
+    ProgramBinaryCacheOpenGL();
+
+    /**
+    * Enable the cache, if the context can retrieve program binaries.
+    *
+    * @param directory The directory of the binaries, created if it doesn't
+    * exist. Empty leaves the cache disabled.
+    *
+    * @return Operation result. The cache stays disabled on failure.
+    */
+    eRESULT
+    init(const String& directory);
+
+    /**
+    * Disable the cache. The stored binaries are kept.
+    */
+    void
+    destroy();
+
+    bool
+    isEnabled() const;
+
+    /**
+    * Get the key of a program.
+    *
+    * @param vertexHash The hash of the vertex shader source.
+    * @param fragmentHash The hash of the fragment shader source.
+    */
+    uint64
+    getKey(const uint64& vertexHash, const uint64& fragmentHash) const;
+
+    /**
+    * Load the binary of a program.
+    *
+    * @param key The key of the program.
+    * @param program A program object without shaders.
+    *
+    * @return True if the program is linked. Otherwise the program must be
+    * linked from its sources.
+    */
+    bool
+    load(const uint64& key, const GLuint& program);
+
+    /**
+    * Store the binary of a linked program, replacing the previous one.
+    *
+    * @param key The key of the program.
+    * @param program The program, linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT.
+    */
+    void
+    store(const uint64& key, const GLuint& program);
+
+    /**
+    * Get the count of programs loaded from the cache.
+    */
+    uint32
+    getHits() const;
+
+    /**
+    * Get the count of programs linked from their sources.
+    */
+    uint32
+    getMisses() const;
+
+  private:
+
+    String
+    _getPath(const uint64& key) const;
+
+    String
+    _m_directory;
+
+    /**
+    * Hash of the strings that identify the driver.
+    */
+    uint64
+    _m_driverHash;
+
+    bool
+    _m_isEnabled;
+
+    uint32
+    _m_hits;
+
+    uint32
+    _m_misses;
+  };
+}
\ No newline at end of file
@@ -1,10 +1,45 @@
 #pragma once
 
+#include <vector>
+
+#include <Hakool\Utils\hkMatrix4.h>
+#include <Hakool\Utils\hkVector3.h>
 #include <Hakool\Core\hkIProgram.h>
 #include <Hakool\GraphicsOpenGL\hkGraphicsOpenGLPrerequisites.h>
 
 namespace hk
 {
+  class ProgramBinaryCacheOpenGL;
+  class ShaderOpenGL;
+
+  /**
+  * Active uniform of a linked program, with a shadow of its last uploaded
+  * value.
+  */
+  struct UniformSlotOpenGL
+  {
+    /**
+    * Hashed name, see ProgramOpenGL::UniformId.
+    */
+    uint64 id;
+
+    int32 location;
+
+    /**
+    * GLenum type of the uniform.
+    */
+    uint32 type;
+
+    /**
+    * Number of floats in the shadow, 0 if the type is not shadowed.
+    */
+    uint32 floatsSize;
+
+    bool hasValue;
+
+    float value[16];
+  };
+
   /**
   * Provides a common interface for extended programs.
   */
@@ -24,7 +59,8 @@ namespace hk
     virtual ~ProgramOpenGL();
 
     /**
-    * Initialize the program.
+    * Initialize the program. Programs initialized with the OpenGL component
+    * are loaded from its program binary cache when they can.
     *
     * @param _graphicComponent Reference to the graphic component.
     *
@@ -34,7 +70,8 @@ namespace hk
     init(GraphicComponent* _pGraphicComponent) override;
 
     /**
-     * Create the program with the given shader.
+     * Create the program with the given shader. The shaders are only
+     * compiled if the program isn't in the binary cache.
      *
      * @param _fragment The key of the fragment shader.
      * @param _vertex The key of the vertex shader.
@@ -50,6 +87,61 @@ namespace hk
       ResourceManager* _pResourceManager
     ) override;
 
+    /**
+    * Start creating the program, without waiting for the driver to compile
+    * and link it. The program isn't ready until finish succeeds.
+    *
+    * The shaders must outlive the call to finish.
+    *
+    * @param _fragment The key of the fragment shader.
+    * @param _vertex The key of the vertex shader.
+    * @param _pResourceManager The pointer to the resource manager.
+    *
+    * @return Operation result. On success the program is either ready,
+    * loaded from the binary cache, or pending.
+    */
+    eRESULT
+    submit
+    (
+      const String& _fragment,
+      const String& _vertex,
+      ResourceManager* _pResourceManager
+    );
+
+    /**
+    * Start creating the program from shaders that aren't in the resource
+    * manager, see submit.
+    *
+    * @param _pFragment The fragment shader, created.
+    * @param _pVertex The vertex shader, created.
+    *
+    * @return Operation result.
+    */
+    eRESULT
+    submit(ShaderOpenGL* _pFragment, ShaderOpenGL* _pVertex);
+
+    /**
+    * Check if the program was submitted and isn't finished.
+    */
+    bool
+    isPending() const;
+
+    /**
+    * Check, without blocking, if the driver finished linking a pending
+    * program. Always true when the driver can't report it, finish then
+    * waits.
+    */
+    bool
+    isLinkComplete() const;
+
+    /**
+    * Wait for a pending program and check its result.
+    *
+    * @return Operation result. The program is ready on success.
+    */
+    eRESULT
+    finish();
+
     /**
     * Get the pointer to the wrapped API's shader.
     *
@@ -72,8 +164,93 @@ namespace hk
     virtual void
     destroy() override;
 
+    /**
+    * Get the identifier of a uniform name, so lookups do not compare strings.
+    *
+    * @param _name The name of the uniform, without the "[0]" of arrays.
+    *
+    * @return The identifier.
+    */
+    static uint64
+    UniformId(const String& _name);
+
+    /**
+    * Get the location of an active uniform.
+    *
+    * @param _id The identifier of the uniform name.
+    *
+    * @return The location, or -1 if the program has no such active uniform.
+    */
+    int32
+    getUniformLocation(const uint64& _id) const;
+
+    /**
+    * Upload a mat4 uniform unless it already has this value.
+    *
+    * @param _id The identifier of the uniform name.
+    * @param _value The value.
+    *
+    * @return True if the value was uploaded.
+    */
+    bool
+    setUniform(const uint64& _id, const Matrix4& _value);
+
+    /**
+    * Upload a vec3 uniform unless it already has this value.
+    *
+    * @param _id The identifier of the uniform name.
+    * @param _value The value.
+    *
+    * @return True if the value was uploaded.
+    */
+    bool
+    setUniform(const uint64& _id, const Vector3f& _value);
+
   private:
 
+    /**
+    * Submit the compile of the shaders and the link of a new program, their
+    * results are checked by finish.
+    *
+    * @param _pFragment The fragment shader.
+    * @param _pVertex The vertex shader.
+    * @param _isRetrievable Keep the binary retrievable, to cache it.
+    *
+    * @return The program, or 0 on failure.
+    */
+    static uint32
+    _submitLink(ShaderOpenGL* _pFragment, ShaderOpenGL* _pVertex, const bool& _isRetrievable);
+
+    /**
+    * Fill the uniform table from the active uniforms of the linked program.
+    */
+    void
+    _reflectUniforms();
+
+    /**
+    * Find a uniform slot.
+    *
+    * @param _id The identifier of the uniform name.
+    *
+    * @return The slot, or nullptr if the uniform is not active.
+    */
+    UniformSlotOpenGL*
+    _findUniform(const uint64& _id);
+
+    /**
+    * Compare the shadowed value of a slot and update it.
+    *
+    * @return True if the value changed.
+    */
+    static bool
+    _updateShadow(UniformSlotOpenGL& _slot, const float* _value, const uint32& _floatsSize);
+
+    /**
+    * Active uniforms, sorted by identifier.
+    */
+    std::vector<UniformSlotOpenGL>
+    _m_uniforms;
+
     /**
     * Indicates if the program is ready to be used.
     */
@@ -86,5 +263,29 @@ namespace hk
     uint32
     _m_programId;
 
+    /**
+    * Cache of the program binaries, nullptr if the program isn't cached.
+    */
+    ProgramBinaryCacheOpenGL*
+    _m_pBinaryCache;
+
+    /**
+    * Indicates if the program is linking, see submit.
+    */
+    bool
+    _m_isPending;
+
+    ShaderOpenGL*
+    _m_pPendingFragment;
+
+    ShaderOpenGL*
+    _m_pPendingVertex;
+
+    /**
+    * Binary cache key of the pending program.
+    */
+    uint64
+    _m_pendingKey;
+
   };
 }
\ No newline at end of file
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <Hakool\Utils\hkClock.h>
+#include <Hakool\Core\hkCoreUtilities.h>
+#include <Hakool\GraphicsOpenGL\hkGraphicsOpenGLPrerequisites.h>
+#include <GL/glew.h>
+
+namespace hk
+{
+  class StateCacheOpenGL;
+
+  /**
+  * A range of the ring buffer written by the CPU during the current frame.
+  */
+  struct RingAllocationOpenGL
+  {
+    /**
+    * Mapped address of the range, nullptr if the allocation failed.
+    */
+    void* pData;
+
+    /**
+    * Offset of the range in the buffer, for glBindBufferRange or attribute
+    * pointers.
+    */
+    hkSize offset;
+
+    hkSize size;
+  };
+
+  /**
+  * Counters of the ring buffer since its creation.
+  */
+  struct RingBufferStatsOpenGL
+  {
+  public:
+
+    RingBufferStatsOpenGL() :
+      frames(0),
+      stalls(0),
+      stallMicroseconds(0),
+      overflows(0),
+      allocatedBytes(0),
+      peakAllocatedBytes(0)
+    {
+      return;
+    }
+
+    uint64
+    frames;
+
+    /**
+    * Frames that had to wait for the GPU to release their region.
+    */
+    uint64
+    stalls;
+
+    uint64
+    stallMicroseconds;
+
+    /**
+    * Allocations that didn't fit in the region of their frame.
+    */
+    uint64
+    overflows;
+
+    /**
+    * Bytes allocated during the last frame.
+    */
+    hkSize
+    allocatedBytes;
+
+    hkSize
+    peakAllocatedBytes;
+  };
+
+  /**
+  * Streaming buffer for the data written every frame: uniform blocks,
+  * instance data and transient vertices.
+  *
+  * The buffer is persistently and coherently mapped and split in one region
+  * per frame in flight. A fence is inserted when a frame ends, and the region
+  * is only reused once the GPU has passed it, so writing never synchronizes
+  * with the driver.
+  */
+  class RingBufferOpenGL
+  {
+  public:
+
+    /**
+    * Constructor.
+    */
+    RingBufferOpenGL();
+
+    /**
+    * Destructor.
+    */
+    ~RingBufferOpenGL();
+
+    /**
+    * Create and map the buffer. Requires GL_ARB_buffer_storage.
+    *
+    * @param stateCache Binds of the buffer, it must outlive it.
+    * @param regionSize Bytes available to each frame.
+    * @param regionsSize Count of frames in flight.
+    *
+    * @return Operation result.
+    */
+    eRESULT
+    init
+    (
+      StateCacheOpenGL& stateCache,
+      const hkSize& regionSize,
+      const uint32& regionsSize = 3
+    );
+
+    /**
+    * Start writing the region of the next frame, waiting for the GPU to
+    * release it if needed.
+    */
+    void
+    beginFrame();
+
+    /**
+    * Fence the commands that read the region of the current frame.
+    */
+    void
+    endFrame();
+
+    /**
+    * Allocate a range of the region of the current frame.
+    *
+    * @param size Bytes of the range.
+    * @param alignment Alignment of the offset of the range, a power of two.
+    *
+    * @return The allocation, with pData nullptr if the region is full.
+    */
+    RingAllocationOpenGL
+    allocate(const hkSize& size, const hkSize& alignment);
+
+    /**
+    * Allocate a range usable as a uniform block.
+    *
+    * @param size Bytes of the block.
+    *
+    * @return The allocation, with pData nullptr if the region is full.
+    */
+    RingAllocationOpenGL
+    allocateUniforms(const hkSize& size);
+
+    /**
+    * Get the OpenGL buffer.
+    */
+    uint32
+    getBuffer() const;
+
+    const RingBufferStatsOpenGL&
+    getStats() const;
+
+    bool
+    isReady() const;
+
+    /**
+    * Unmap and delete the buffer. Waits for the GPU to release it.
+    */
+    void
+    destroy();
+
+  private:
+
+    GLuint
+    _m_buffer;
+
+    /**
+    * Mapped address of the whole buffer.
+    */
+    uint8*
+    _m_pMapped;
+
+    hkSize
+    _m_regionSize;
+
+    uint32
+    _m_regionsSize;
+
+    /**
+    * Region of the current frame.
+    */
+    uint32
+    _m_region;
+
+    /**
+    * Offset of the next allocation, relative to the current region.
+    */
+    hkSize
+    _m_head;
+
+    hkSize
+    _m_uniformAlignment;
+
+    /**
+    * Fence of each region, nullptr once the region is released.
+    */
+    Vector<GLsync>
+    _m_fences;
+
+    /**
+    * Measures the stalls.
+    */
+    Clock*
+    _m_pClock;
+
+    RingBufferStatsOpenGL
+    _m_stats;
+
+    StateCacheOpenGL*
+    _m_pStateCache;
+  };
+}
\ No newline at end of file
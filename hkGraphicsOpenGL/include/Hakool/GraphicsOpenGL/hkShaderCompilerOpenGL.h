@@ -0,0 +1,116 @@
+#pragma once
+
+#include <Hakool\Utils\hkUtilitiesUtilities.h>
+#include <Hakool\GraphicsOpenGL\hkGraphicsOpenGLPrerequisites.h>
+
+namespace hk
+{
+  class ProgramOpenGL;
+  class ShaderOpenGL;
+  class ResourceManager;
+
+  /**
+  * Creates programs in batches. Every program is submitted first, so the
+  * driver compiles and links them together, and they are checked later,
+  * once the driver reports them complete.
+  *
+  * With GL_KHR_parallel_shader_compile the driver compiles on its own
+  * threads and update never blocks. Without it update waits for every
+  * pending program, which the driver was free to start since submit.
+  *
+  * Only use it on the thread that owns the context.
+  */
+  class ShaderCompilerOpenGL
+  {
+  public:
+
+    ShaderCompilerOpenGL();
+
+    /**
+    * Let the driver use all of its compiler threads, when it supports
+    * parallel compiles.
+    */
+    void
+    init();
+
+    /**
+    * Forget the pending programs, they are left pending.
+    */
+    void
+    destroy();
+
+    /**
+    * Check if the driver reports the compiles without blocking.
+    */
+    bool
+    isParallel() const;
+
+    /**
+    * Submit a program.
+    *
+    * @param pProgram The program, not created. It must not be destroyed while
+    * it is pending, see cancel.
+    * @param fragment The key of the fragment shader.
+    * @param vertex The key of the vertex shader.
+    * @param pResourceManager The pointer to the resource manager.
+    *
+    * @return Operation result. The program may already be ready, if it was
+    * loaded from the binary cache.
+    */
+    eRESULT
+    submit
+    (
+      ProgramOpenGL* pProgram,
+      const String& fragment,
+      const String& vertex,
+      ResourceManager* pResourceManager
+    );
+
+    /**
+    * Submit a program of shaders that aren't in the resource manager.
+    *
+    * @param pProgram The program, not created.
+    * @param pFragment The fragment shader, created.
+    * @param pVertex The vertex shader, created.
+    *
+    * @return Operation result.
+    */
+    eRESULT
+    submit(ProgramOpenGL* pProgram, ShaderOpenGL* pFragment, ShaderOpenGL* pVertex);
+
+    /**
+    * Finish the programs the driver completed. Failed programs are logged
+    * and dropped.
+    *
+    * @return The count of programs still pending.
+    */
+    uint32
+    update();
+
+    /**
+    * Wait for every pending program.
+    */
+    void
+    finish();
+
+    /**
+    * Stop tracking a pending program, before destroying it.
+    */
+    void
+    cancel(ProgramOpenGL* pProgram);
+
+    /**
+    * Get the count of pending programs.
+    */
+    uint32
+    getPendingSize() const;
+
+  private:
+
+    Vector<ProgramOpenGL*>
+    _m_pending;
+
+    bool
+    _m_isParallel;
+  };
+}
\ No newline at end of file
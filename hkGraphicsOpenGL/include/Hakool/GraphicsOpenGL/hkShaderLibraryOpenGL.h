@@ -0,0 +1,207 @@
+#pragma once
+
+#include <Hakool\Utils\hkUtilitiesUtilities.h>
+#include <Hakool\GraphicsOpenGL\hkGraphicsOpenGLPrerequisites.h>
+
+namespace hk
+{
+  class GraphicComponentOpenGL;
+  class ProgramOpenGL;
+  class ShaderOpenGL;
+
+  /**
+  * Sources of a program and the variants created from them.
+  */
+  struct ShaderSourceOpenGL
+  {
+    String
+    name;
+
+    String
+    vertex;
+
+    String
+    fragment;
+
+    /**
+    * Declared keywords, the bit of a keyword is its index.
+    */
+    Vector<String>
+    keywords;
+
+    /**
+    * Program of every keyword mask, nullptr until it is created. Variants
+    * that compile to the same shaders share their program.
+    */
+    Vector<ProgramOpenGL*>
+    variants;
+
+    /**
+    * Variants whose failure is logged, so it is logged once.
+    */
+    Vector<bool>
+    failedVariants;
+  };
+
+  /**
+  * Creates the variants of the shader sources of the backend.
+  *
+  * Each stage declares the feature keywords it tests in a pragma, after its
+  * #version line:
+  *
+  *   #pragma hk_keywords QUANTIZED SKINNING
+  *
+  * The keywords of a source are those of both stages, and a variant is
+  * selected with a mask of them. The stages of a variant have a #define of
+  * each keyword of the mask they declare in place of the pragma, so the
+  * features are resolved by the preprocessor instead of branching in the
+  * shader. Identical stages and programs are only compiled once.
+  *
+  * Variants are compiled when first used, or ahead of time by precompile.
+  * With the program binary cache, the variants of later launches are
+  * loaded without compiling.
+  *
+  * Only use it on the thread that owns the context.
+  */
+  class ShaderLibraryOpenGL
+  {
+  public:
+
+    /**
+    * Keywords of a source, its variants are 2^MAX_KEYWORDS at most.
+    */
+    static const uint32 MAX_KEYWORDS = 8;
+
+    static const uint32 INVALID_SOURCE = 0xFFFFFFFF;
+
+    ShaderLibraryOpenGL();
+
+    ~ShaderLibraryOpenGL();
+
+    /**
+    * @param pComponent The component, its binary cache and compiler are
+    * used for the variants.
+    */
+    void
+    init(GraphicComponentOpenGL* pComponent);
+
+    /**
+    * Destroy every variant and forget the sources.
+    */
+    void
+    destroy();
+
+    /**
+    * Add a source.
+    *
+    * @param name The unique name of the source.
+    * @param vertex The vertex stage.
+    * @param fragment The fragment stage.
+    *
+    * @return The identifier of the source, INVALID_SOURCE on failure.
+    */
+    uint32
+    addSource(const String& name, const String& vertex, const String& fragment);
+
+    /**
+    * Get the identifier of a source, to look up its variants without names.
+    *
+    * @return The identifier, INVALID_SOURCE if there is no such source.
+    */
+    uint32
+    getSourceId(const String& name) const;
+
+    /**
+    * Get the mask of a keyword of a source.
+    *
+    * @return The mask, 0 if the source doesn't declare the keyword.
+    */
+    uint32
+    getKeywordMask(const uint32& sourceId, const String& keyword) const;
+
+    /**
+    * Get a variant, compiling it if it isn't ready.
+    *
+    * @param sourceId The identifier of the source.
+    * @param keywords The mask of the keywords. Undeclared bits are ignored.
+    *
+    * @return The program, nullptr if it failed to compile or to link. The
+    * first failure of a variant is logged.
+    */
+    ProgramOpenGL*
+    getProgram(const uint32& sourceId, const uint32& keywords);
+
+    /**
+    * Submit every variant of a source to the compiler of the component, they
+    * are ready once the driver finishes them.
+    */
+    void
+    precompile(const uint32& sourceId);
+
+    /**
+    * Get the count of distinct programs created.
+    */
+    uint32
+    getProgramsSize() const;
+
+    /**
+    * Get the count of distinct shaders created.
+    */
+    uint32
+    getShadersSize() const;
+
+  private:
+
+    /**
+    * Submit the program of a variant to the compiler, or find the one with
+    * the same stages.
+    */
+    ProgramOpenGL*
+    _createVariant(ShaderSourceOpenGL& source, const uint32& keywords);
+
+    /**
+    * Find or create the shader of a stage of a variant.
+    */
+    ShaderOpenGL*
+    _getShader
+    (
+      const String& stage,
+      const Vector<String>& keywords,
+      const uint32& mask,
+      const bool& isVertex
+    );
+
+    /**
+    * Read the keywords of the pragma of a stage.
+    *
+    * @return False if the pragma is malformed.
+    */
+    static bool
+    ParseKeywords(const String& stage, Vector<String>& keywords);
+
+    /**
+    * Get the text of a stage, with the pragma replaced by the defines of the
+    * keywords of the mask the stage declares.
+    */
+    static String
+    ExpandStage(const String& stage, const Vector<String>& keywords, const uint32& mask);
+
+    Vector<ShaderSourceOpenGL>
+    _m_sources;
+
+    /**
+    * Shaders by hash of their type and text.
+    */
+    Map<uint64, ShaderOpenGL*>
+    _m_shaders;
+
+    /**
+    * Programs by hash of the texts of their stages.
+    */
+    Map<uint64, ProgramOpenGL*>
+    _m_programs;
+
+    GraphicComponentOpenGL*
+    _m_pComponent;
+  };
+}
\ No newline at end of file
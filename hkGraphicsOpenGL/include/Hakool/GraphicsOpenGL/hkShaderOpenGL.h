@@ -26,7 +26,8 @@ namespace hk
     ~ShaderOpenGL();
 
     /**
-    * Get the pointer to the wrapped API's shader.
+    * Get the pointer to the wrapped API's shader. The shader is 0 until it
+    * is compiled.
     *
     * @return The pointer to the wrapped API's shader.
     */
@@ -42,7 +43,9 @@ namespace hk
     init(GraphicComponent*) override;
 
     /**
-    * Create the shader from a source.
+    * Create the shader from a source. The source is kept and only compiled
+    * when a program needs it, a program loaded from the binary cache never
+    * compiles its shaders.
     *
     * @param _pSource The shader's source.
     *
@@ -51,6 +54,50 @@ namespace hk
     virtual eRESULT
     create(const char* _pSource, const eSHADER_TYPE& _type) override;
 
+    /**
+    * Compile the source, if it isn't compiled yet, and wait for the result.
+    *
+    * @return Operation result.
+    */
+    eRESULT
+    compile();
+
+    /**
+    * Start compiling the source, without waiting for the driver. Does
+    * nothing if the source is compiled or being compiled.
+    *
+    * @return Operation result.
+    */
+    eRESULT
+    submitCompile();
+
+    /**
+    * Check, without blocking, if the driver finished a submitted compile.
+    * Always true when the driver can't report it, finishCompile then waits.
+    */
+    bool
+    isCompileComplete() const;
+
+    /**
+    * Wait for a submitted compile and check its result.
+    *
+    * @return Operation result. The shader is deleted on failure.
+    */
+    eRESULT
+    finishCompile();
+
+    /**
+    * Check if the source is compiled.
+    */
+    bool
+    isCompiled() const;
+
+    /**
+    * Get the hash of the source, see Hash::Fnv1a.
+    */
+    uint64
+    getSourceHash() const;
+
     /**
     * Check if this shader is ready to be used.
     *
@@ -80,7 +127,16 @@ namespace hk
     _m_type;
 
     /**
-    * The Shader's id gave by the OpenGL API.
+    * The source, compiled on demand.
+    */
+    String
+    _m_source;
+
+    uint64
+    _m_sourceHash;
+
+    /**
+    * The Shader's id gave by the OpenGL API, 0 until it is compiled.
     */
     uint32
     _m_shaderId;
@@ -91,6 +147,12 @@ namespace hk
     bool
     _m_isReady;
 
+    /**
+    * Indicates if the compile was submitted and its result isn't checked.
+    */
+    bool
+    _m_isCompilePending;
+
     friend GraphicComponentOpenGL;
   };
 }
\ No newline at end of file
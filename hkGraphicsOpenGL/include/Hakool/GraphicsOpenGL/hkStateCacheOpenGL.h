@@ -0,0 +1,103 @@
+#pragma once
+
+#include <Hakool\GraphicsOpenGL\hkGraphicsOpenGLPrerequisites.h>
+#include <Hakool\GraphicsOpenGL\hkStateTrackerOpenGL.h>
+#include <GL/glew.h>
+
+namespace hk
+{
+  /**
+  * Issues the GL state calls of the backend, dropping the ones that would
+  * not change the state. Every bind and state change of the component, its
+  * meshes and its buffers goes through here, so the tracked state matches
+  * the context. The set methods return true if the call was issued.
+  *
+  * Only use it on the thread that owns the context. Call invalidate after
+  * GL calls made around it.
+  */
+  class StateCacheOpenGL
+  {
+  public:
+
+    StateCacheOpenGL();
+
+    /**
+    * Forget the tracked state, the next calls are all issued.
+    */
+    void
+    invalidate();
+
+    bool
+    useProgram(const GLuint& program);
+
+    bool
+    bindVertexArray(const GLuint& vertexArray);
+
+    bool
+    bindBuffer(const GLenum& target, const GLuint& buffer);
+
+    bool
+    enable(const GLenum& capability);
+
+    bool
+    disable(const GLenum& capability);
+
+    bool
+    depthFunc(const GLenum& function);
+
+    bool
+    depthMask(const bool& enabled);
+
+    bool
+    blendFunc(const GLenum& source, const GLenum& destination);
+
+    bool
+    cullFace(const GLenum& face);
+
+    bool
+    viewport(const int32& x, const int32& y, const int32& width, const int32& height);
+
+    bool
+    clearColor(const float& r, const float& g, const float& b, const float& a);
+
+    /**
+    * Enable an attribute array of the bound vertex array object.
+    */
+    bool
+    enableVertexAttribArray(const GLuint& index);
+
+    /**
+    * Disable an attribute array of the bound vertex array object.
+    */
+    bool
+    disableVertexAttribArray(const GLuint& index);
+
+    /**
+    * Delete a buffer and forget its bindings.
+    *
+    * @param buffer The buffer, set to 0.
+    */
+    void
+    deleteBuffer(GLuint& buffer);
+
+    /**
+    * Delete a vertex array object and forget its state.
+    *
+    * @param vertexArray The vertex array object, set to 0.
+    */
+    void
+    deleteVertexArray(GLuint& vertexArray);
+
+    /**
+    * Get the filtering of the calls. Its counters are the calls issued and
+    * filtered since they were reset.
+    */
+    StateTrackerOpenGL&
+    getTracker();
+
+  private:
+
+    StateTrackerOpenGL
+    _m_tracker;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <Hakool\Core\hkCoreUtilities.h>
+#include <Hakool\GraphicsOpenGL\hkGraphicsOpenGLPrerequisites.h>
+#include <GL/glew.h>
+
+namespace hk
+{
+  /**
+  * Mirror of the OpenGL state set by the engine. Only the bookkeeping is done
+  * here, no GL function is called: each set method records the new value and
+  * tells if the call changes the state and has to reach the driver.
+  *
+  * State that was never set, or changed behind the tracker's back, is
+  * unknown, and the next call to set it is always issued.
+  */
+  class HK_GRAPHICS_OPENGL_EXPORT StateTrackerOpenGL
+  {
+  public:
+
+    /**
+    * Constructor. Every state starts unknown.
+    */
+    StateTrackerOpenGL();
+
+    /**
+    * Forget every state, like after GL calls made outside of the tracker.
+    */
+    void
+    invalidate();
+
+    /**
+    * @return True if the call must be issued.
+    */
+    bool
+    useProgram(const GLuint& program);
+
+    /**
+    * Binding a vertex array object also changes the element array buffer
+    * binding, which is part of its state.
+    *
+    * @return True if the call must be issued.
+    */
+    bool
+    bindVertexArray(const GLuint& vertexArray);
+
+    /**
+    * Targets other than the array, element array, copy, indirect and uniform
+    * buffers are not tracked and always issued.
+    *
+    * @return True if the call must be issued.
+    */
+    bool
+    bindBuffer(const GLenum& target, const GLuint& buffer);
+
+    /**
+    * Depth test, blend, face culling and scissor test are tracked, other
+    * capabilities are always issued.
+    *
+    * @return True if the glEnable or glDisable call must be issued.
+    */
+    bool
+    setCapability(const GLenum& capability, const bool& enabled);
+
+    /**
+    * @return True if the call must be issued.
+    */
+    bool
+    setDepthFunc(const GLenum& function);
+
+    /**
+    * @return True if the call must be issued.
+    */
+    bool
+    setDepthMask(const bool& enabled);
+
+    /**
+    * @return True if the call must be issued.
+    */
+    bool
+    setBlendFunc(const GLenum& source, const GLenum& destination);
+
+    /**
+    * @return True if the call must be issued.
+    */
+    bool
+    setCullFace(const GLenum& face);
+
+    /**
+    * @return True if the call must be issued.
+    */
+    bool
+    setViewport
+    (
+      const int32& x,
+      const int32& y,
+      const int32& width,
+      const int32& height
+    );
+
+    /**
+    * @return True if the call must be issued.
+    */
+    bool
+    setClearColor(const float& r, const float& g, const float& b, const float& a);
+
+    /**
+    * Enabled arrays are part of the state of the bound vertex array object,
+    * they are tracked for each one. Always issued while the bound object is
+    * unknown.
+    *
+    * @return True if the glEnableVertexAttribArray or
+    * glDisableVertexAttribArray call must be issued.
+    */
+    bool
+    setVertexAttribArray(const GLuint& index, const bool& enabled);
+
+    /**
+    * Deleting a buffer unbinds it from every target.
+    */
+    void
+    onBufferDeleted(const GLuint& buffer);
+
+    /**
+    * Deleting the bound vertex array object binds the default one.
+    */
+    void
+    onVertexArrayDeleted(const GLuint& vertexArray);
+
+    /**
+    * Calls that changed the state since the last resetCounters.
+    */
+    uint32
+    getIssuedCalls() const;
+
+    /**
+    * Redundant calls filtered since the last resetCounters.
+    */
+    uint32
+    getFilteredCalls() const;
+
+    void
+    resetCounters();
+
+  private:
+
+    /**
+    * Enabled vertex attribute arrays of a vertex array object, one bit per
+    * attribute index.
+    */
+    struct VertexArrayState
+    {
+      uint32 knownMask;
+      uint32 enabledMask;
+    };
+
+    /**
+    * Count a call.
+    *
+    * @param isRedundant True if the state already has the value.
+    *
+    * @return True if the call must be issued.
+    */
+    bool
+    _count(const bool& isRedundant);
+
+    /**
+    * Get the slot of a tracked buffer target, or -1.
+    */
+    static int32
+    BufferSlot(const GLenum& target);
+
+    /**
+    * Get the slot of a tracked capability, or -1.
+    */
+    static int32
+    CapabilitySlot(const GLenum& capability);
+
+    GLuint
+    _m_program;
+
+    bool
+    _m_isProgramKnown;
+
+    GLuint
+    _m_vertexArray;
+
+    bool
+    _m_isVertexArrayKnown;
+
+    GLuint
+    _m_buffers[6];
+
+    bool
+    _m_areBuffersKnown[6];
+
+    /**
+    * -1 unknown, 0 disabled, 1 enabled.
+    */
+    int8
+    _m_capabilities[4];
+
+    GLenum
+    _m_depthFunc;
+
+    int8
+    _m_depthMask;
+
+    GLenum
+    _m_blendSource;
+
+    GLenum
+    _m_blendDestination;
+
+    GLenum
+    _m_cullFace;
+
+    int32
+    _m_viewport[4];
+
+    bool
+    _m_isViewportKnown;
+
+    float
+    _m_clearColor[4];
+
+    bool
+    _m_isClearColorKnown;
+
+    /**
+    * Attribute arrays of the vertex array objects bound so far.
+    */
+    Map<GLuint, VertexArrayState>
+    _m_vertexArrays;
+
+    uint32
+    _m_issuedCalls;
+
+    uint32
+    _m_filteredCalls;
+  };
+}
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include <Hakool/Utils/hkIWindow.h>
 #include <Hakool/GraphicsOpenGL/hkGraphicsOpenGLPrerequisites.h>
 
+#include <atomic>
+
 struct GLFWwindow;
 
 namespace hk
@@ -43,6 +45,12 @@ namespace hk
     virtual void
     present() override;
 
+    virtual void
+    makeContextCurrent() override;
+
+    virtual void
+    releaseContext() override;
+
     virtual HANDLER
     getWindowHandler() override;
 
@@ -50,7 +58,7 @@ namespace hk
     destroy() override;
 
     virtual void
-    addObserver(const WindowObserver* pObserver) override;
+    addObserver(WindowObserver* pObserver) override;
 
     virtual Vector2u
     getSize() override;
@@ -69,13 +77,29 @@ namespace hk
 
   private:
 
+    /**
+    * Read the framebuffer size, on the main thread.
+    */
+    void
+    _updateFramebufferSize();
+
     GLFWwindow*
     _m_pWindow;
 
-    Vector<const WindowObserver*> 
+    Vector<WindowObserver*> 
     _m_observers;
 
     String
     _m_title;
+
+    /**
+    * Size of the framebuffer, read by GLFW on the main thread when polling
+    * the events. The render thread reads it from here.
+    */
+    std::atomic<uint32>
+    _m_framebufferWidth;
+
+    std::atomic<uint32>
+    _m_framebufferHeight;
   };
 }
\ No newline at end of file
@@ -0,0 +1,645 @@
+#include <Hakool\GraphicsOpenGL\hkGeometryArenaOpenGL.h>
+
+#include <algorithm>
+#include <limits>
+
+#include <Hakool\Utils\hkLogger.h>
+#include <Hakool\GraphicsOpenGL\hkStateCacheOpenGL.h>
+
+namespace hk
+{
+  namespace
+  {
+    GLsizei
+    VertexStride(const eVERTEX_FORMAT& vertexFormat)
+    {
+      return vertexFormat == eVERTEX_FORMAT::kQuantized
+        ? static_cast<GLsizei>(sizeof(QuantizedVertex))
+        : static_cast<GLsizei>(sizeof(float) * 3);
+    }
+
+    /**
+    * Create an uninitialized buffer, left bound to GL_COPY_WRITE_BUFFER.
+    */
+    GLuint
+    CreateBuffer(StateCacheOpenGL& stateCache, const GLsizeiptr& size)
+    {
+      GLuint buffer = 0;
+      glGenBuffers(1, &buffer);
+      stateCache.bindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+      glBufferData(GL_COPY_WRITE_BUFFER, size, nullptr, GL_STATIC_DRAW);
+      return buffer;
+    }
+  }
+
+  GeometryArenaOpenGL::GeometryArenaOpenGL() :
+    _m_buffers(),
+    _m_vaos(),
+    _m_retiredBuffers(),
+    _m_allocations(),
+    _m_freeHandles(),
+    _m_pStateCache(nullptr),
+    _m_isReady(false)
+  { }
+
+  GeometryArenaOpenGL::~GeometryArenaOpenGL()
+  {
+    destroy();
+  }
+
+  eRESULT
+  GeometryArenaOpenGL::init
+  (
+    StateCacheOpenGL& stateCache,
+    const uint32& verticesCapacity,
+    const uint32& indexWordsCapacity
+  )
+  {
+    if (_m_isReady)
+    {
+      Logger::Error("| GeometryArenaOpenGL | The arena is already created.");
+      return eRESULT::kFail;
+    }
+
+    _m_pStateCache = &stateCache;
+    ArenaBuffer& indexBuffer = _m_buffers[INDEX_BUFFER];
+    indexBuffer.elementSize = sizeof(uint32);
+    indexBuffer.buffer = CreateBuffer(stateCache, indexBuffer.elementSize * indexWordsCapacity);
+    indexBuffer.allocator.reset(indexWordsCapacity);
+    indexBuffer.move = BufferMove();
+
+    _initPool(eVERTEX_FORMAT::kPosition, verticesCapacity);
+    _initPool(eVERTEX_FORMAT::kQuantized, verticesCapacity);
+
+    stateCache.bindVertexArray(0);
+    _m_isReady = true;
+    return eRESULT::kSuccess;
+  }
+
+  uint32
+  GeometryArenaOpenGL::allocate(const MeshDescription& description)
+  {
+    uint32 handle = reserve(description);
+    if (handle == INVALID_HANDLE)
+    {
+      return INVALID_HANDLE;
+    }
+
+    // Written right away, after the copies of a growth the mesh started.
+    _finishMoves();
+
+    GeometryRangeOpenGL vertexRange = getVertexRange(handle);
+    _m_pStateCache->bindBuffer(GL_COPY_WRITE_BUFFER, vertexRange.buffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, vertexRange.offset, vertexRange.size, description.pVertices);
+
+    // Indices, 16 bits ones are padded to a whole word.
+    const GeometryAllocationOpenGL& allocation = _m_allocations[handle];
+    if (allocation.indicesSize > 0)
+    {
+      GeometryRangeOpenGL indexRange = getIndexRange(handle);
+      _m_pStateCache->bindBuffer(GL_COPY_WRITE_BUFFER, indexRange.buffer);
+      if (allocation.indexType == GL_UNSIGNED_SHORT)
+      {
+        Vector<uint16> indices(allocation.indexWordsSize * 2, 0);
+        for (uint32 i = 0; i < description.indicesSize; ++i)
+        {
+          indices[i] = static_cast<uint16>(description.pIndices[i]);
+        }
+        glBufferSubData(GL_COPY_WRITE_BUFFER, indexRange.offset, sizeof(uint16) * indices.size(), indices.data());
+      }
+      else
+      {
+        glBufferSubData(GL_COPY_WRITE_BUFFER, indexRange.offset, indexRange.size, description.pIndices);
+      }
+    }
+
+    return handle;
+  }
+
+  uint32
+  GeometryArenaOpenGL::reserve(const MeshDescription& description)
+  {
+    if (!_m_isReady || 0 == description.verticesSize)
+    {
+      Logger::Error("| GeometryArenaOpenGL | Cannot allocate an empty mesh.");
+      return INVALID_HANDLE;
+    }
+
+    if (_m_freeHandles.empty() && _m_allocations.size() >= MAX_HANDLES)
+    {
+      Logger::Error("| GeometryArenaOpenGL | The arena is out of mesh handles.");
+      return INVALID_HANDLE;
+    }
+
+    // The allocations are placed in the final layout of the buffers, and the
+    // handles freed during a compaction are only reused after it.
+    _finishMoves();
+
+    GeometryAllocationOpenGL allocation;
+    allocation.vertexFormat = description.vertexFormat;
+    allocation.verticesSize = description.verticesSize;
+    allocation.firstIndexWord = 0;
+    allocation.indexWordsSize = 0;
+    allocation.indicesSize = 0;
+    allocation.indexType = 0;
+    allocation.isUsed = true;
+
+    // Vertices. A grown buffer keeps the offsets, and its new part is free.
+    uint32 poolIndex = _GetPoolIndex(description.vertexFormat);
+    RangeAllocator& vertexAllocator = _m_buffers[poolIndex].allocator;
+    allocation.firstVertex = vertexAllocator.allocate(description.verticesSize);
+    if (allocation.firstVertex == RangeAllocator::INVALID_OFFSET)
+    {
+      uint32 capacity = vertexAllocator.getCapacity();
+      _startMove(poolIndex, Math::Max(capacity * 2, capacity + description.verticesSize), false);
+      allocation.firstVertex = vertexAllocator.allocate(description.verticesSize);
+    }
+
+    // Indices, 16 bits ones are padded to a whole word.
+    eINDEX_TYPE indexType = description.getIndexType();
+    if (indexType != eINDEX_TYPE::kNone)
+    {
+      allocation.indicesSize = description.indicesSize;
+      allocation.indexType = indexType == eINDEX_TYPE::kUInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+      allocation.indexWordsSize = indexType == eINDEX_TYPE::kUInt16
+        ? (description.indicesSize + 1) / 2
+        : description.indicesSize;
+
+      uint32 bufferIndex = INDEX_BUFFER;
+      RangeAllocator& indexAllocator = _m_buffers[bufferIndex].allocator;
+      allocation.firstIndexWord = indexAllocator.allocate(allocation.indexWordsSize);
+      if (allocation.firstIndexWord == RangeAllocator::INVALID_OFFSET)
+      {
+        uint32 capacity = indexAllocator.getCapacity();
+        _startMove(bufferIndex, Math::Max(capacity * 2, capacity + allocation.indexWordsSize), false);
+        allocation.firstIndexWord = indexAllocator.allocate(allocation.indexWordsSize);
+      }
+    }
+
+    uint32 handle;
+    if (!_m_freeHandles.empty())
+    {
+      handle = _m_freeHandles.back();
+      _m_freeHandles.pop_back();
+      _m_allocations[handle] = allocation;
+    }
+    else
+    {
+      handle = static_cast<uint32>(_m_allocations.size());
+      _m_allocations.push_back(allocation);
+    }
+
+    return handle;
+  }
+
+  GeometryRangeOpenGL
+  GeometryArenaOpenGL::getVertexRange(const uint32& handle)
+  {
+    const GeometryAllocationOpenGL& allocation = _m_allocations[handle];
+    const ArenaBuffer& pool = _m_buffers[_GetPoolIndex(allocation.vertexFormat)];
+
+    GeometryRangeOpenGL range;
+    range.buffer = pool.buffer;
+    range.offset = pool.elementSize * allocation.firstVertex;
+    range.size = pool.elementSize * allocation.verticesSize;
+    return range;
+  }
+
+  GeometryRangeOpenGL
+  GeometryArenaOpenGL::getIndexRange(const uint32& handle)
+  {
+    const GeometryAllocationOpenGL& allocation = _m_allocations[handle];
+    GLsizeiptr indexSize = allocation.indexType == GL_UNSIGNED_SHORT ? sizeof(uint16) : sizeof(uint32);
+
+    GeometryRangeOpenGL range;
+    range.buffer = _m_buffers[INDEX_BUFFER].buffer;
+    range.offset = static_cast<GLintptr>(sizeof(uint32)) * allocation.firstIndexWord;
+    range.size = indexSize * allocation.indicesSize;
+    return range;
+  }
+
+  void
+  GeometryArenaOpenGL::free(const uint32& handle)
+  {
+    if (!_m_isReady || handle >= _m_allocations.size() || !_m_allocations[handle].isUsed)
+    {
+      return;
+    }
+
+    // A buffer being compacted rebuilds its allocator when the move ends.
+    GeometryAllocationOpenGL& allocation = _m_allocations[handle];
+    _m_buffers[_GetPoolIndex(allocation.vertexFormat)].allocator.free
+    (
+      allocation.firstVertex,
+      allocation.verticesSize
+    );
+    _m_buffers[INDEX_BUFFER].allocator.free(allocation.firstIndexWord, allocation.indexWordsSize);
+
+    allocation.isUsed = false;
+    _m_freeHandles.push_back(handle);
+  }
+
+  const GeometryAllocationOpenGL&
+  GeometryArenaOpenGL::getAllocation(const uint32& handle) const
+  {
+    return _m_allocations[handle];
+  }
+
+  void
+  GeometryArenaOpenGL::bind(const eVERTEX_FORMAT& vertexFormat)
+  {
+    _m_pStateCache->bindVertexArray(_m_vaos[_GetPoolIndex(vertexFormat)]);
+  }
+
+  void
+  GeometryArenaOpenGL::setInstanceBuffer(const uint32& buffer, const hkSize& stride)
+  {
+    for (GLuint vao : _m_vaos)
+    {
+      _m_pStateCache->bindVertexArray(vao);
+      glBindVertexBuffer(INSTANCE_BINDING, buffer, 0, static_cast<GLsizei>(stride));
+    }
+  }
+
+  bool
+  GeometryArenaOpenGL::isFragmented() const
+  {
+    for (const ArenaBuffer& buffer : _m_buffers)
+    {
+      if (buffer.move.buffer == 0 && buffer.allocator.isFragmented())
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void
+  GeometryArenaOpenGL::defragment()
+  {
+    if (!_m_isReady)
+    {
+      return;
+    }
+
+    for (uint32 i = 0; i < 3; ++i)
+    {
+      ArenaBuffer& buffer = _m_buffers[i];
+      if (buffer.move.buffer == 0 && buffer.allocator.isFragmented())
+      {
+        _startMove(i, buffer.allocator.getCapacity(), true);
+      }
+    }
+  }
+
+  hkSize
+  GeometryArenaOpenGL::moveBuffers(const hkSize& budget)
+  {
+    if (!_m_isReady)
+    {
+      return 0;
+    }
+
+    _releaseRetiredBuffers();
+
+    hkSize bytes = 0;
+    for (uint32 i = 0; i < 3 && bytes < budget; ++i)
+    {
+      if (_m_buffers[i].move.buffer != 0)
+      {
+        bytes += _stepMove(i, budget - bytes);
+      }
+    }
+    return bytes;
+  }
+
+  bool
+  GeometryArenaOpenGL::isMoving() const
+  {
+    for (const ArenaBuffer& buffer : _m_buffers)
+    {
+      if (buffer.move.buffer != 0)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void
+  GeometryArenaOpenGL::destroy()
+  {
+    if (!_m_isReady)
+    {
+      return;
+    }
+
+    for (GLuint& vao : _m_vaos)
+    {
+      _m_pStateCache->deleteVertexArray(vao);
+      vao = 0;
+    }
+
+    // The driver keeps the storage of a deleted buffer until the GPU is done
+    // with it.
+    for (ArenaBuffer& buffer : _m_buffers)
+    {
+      _m_pStateCache->deleteBuffer(buffer.buffer);
+      if (buffer.move.buffer != 0)
+      {
+        _m_pStateCache->deleteBuffer(buffer.move.buffer);
+      }
+      buffer.move = BufferMove();
+      buffer.allocator.reset(0);
+    }
+
+    for (RetiredBuffer& retired : _m_retiredBuffers)
+    {
+      glDeleteSync(retired.fence);
+      _m_pStateCache->deleteBuffer(retired.buffer);
+    }
+    _m_retiredBuffers.clear();
+
+    _m_allocations.clear();
+    _m_freeHandles.clear();
+    _m_isReady = false;
+  }
+
+  void
+  GeometryArenaOpenGL::_initPool(const eVERTEX_FORMAT& vertexFormat, const uint32& capacity)
+  {
+    uint32 poolIndex = _GetPoolIndex(vertexFormat);
+    ArenaBuffer& pool = _m_buffers[poolIndex];
+    pool.elementSize = VertexStride(vertexFormat);
+    pool.buffer = CreateBuffer(*_m_pStateCache, pool.elementSize * capacity);
+    pool.allocator.reset(capacity);
+    pool.move = BufferMove();
+
+    GLuint& vao = _m_vaos[poolIndex];
+    glGenVertexArrays(1, &vao);
+    _m_pStateCache->bindVertexArray(vao);
+
+    if (vertexFormat == eVERTEX_FORMAT::kQuantized)
+    {
+      // Decoded by the fixed function: unorm positions, snorm octahedral
+      // normals and tangents, half float texture coordinates.
+      glVertexAttribFormat(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, offsetof(QuantizedVertex, px));
+      glVertexAttribFormat(1, 2, GL_SHORT, GL_TRUE, offsetof(QuantizedVertex, nx));
+      glVertexAttribFormat(2, 2, GL_SHORT, GL_TRUE, offsetof(QuantizedVertex, tx));
+      glVertexAttribFormat(3, 2, GL_HALF_FLOAT, GL_FALSE, offsetof(QuantizedVertex, u));
+      for (GLuint i = 0; i < 4; ++i)
+      {
+        glVertexAttribBinding(i, 0);
+        _m_pStateCache->enableVertexAttribArray(i);
+      }
+    }
+    else
+    {
+      glVertexAttribFormat(0, 3, GL_FLOAT, GL_FALSE, 0);
+      glVertexAttribBinding(0, 0);
+      _m_pStateCache->enableVertexAttribArray(0);
+    }
+    glBindVertexBuffer(0, pool.buffer, 0, static_cast<GLsizei>(pool.elementSize));
+
+    // The instance buffer is given every frame by setInstanceBuffer.
+    for (GLuint i = 0; i < 4; ++i)
+    {
+      GLuint location = INSTANCE_MATRIX_LOCATION + i;
+      glVertexAttribFormat(location, 4, GL_FLOAT, GL_FALSE, sizeof(float) * 4 * i);
+      glVertexAttribBinding(location, INSTANCE_BINDING);
+      _m_pStateCache->enableVertexAttribArray(location);
+    }
+    glVertexBindingDivisor(INSTANCE_BINDING, 1);
+
+    _m_pStateCache->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _m_buffers[INDEX_BUFFER].buffer);
+  }
+
+  void
+  GeometryArenaOpenGL::_startMove
+  (
+    const uint32& bufferIndex,
+    const uint32& capacity,
+    const bool& compact
+  )
+  {
+    ArenaBuffer& buffer = _m_buffers[bufferIndex];
+    BufferMove& move = buffer.move;
+    move.buffer = CreateBuffer(*_m_pStateCache, buffer.elementSize * capacity);
+    move.capacity = capacity;
+    move.compact = compact;
+    move.copies.clear();
+    move.nextCopy = 0;
+    move.copiedSize = 0;
+
+    // Only the allocations are copied, in the order of the buffer.
+    for (uint32 i = 0; i < _m_allocations.size(); ++i)
+    {
+      GeometryAllocationOpenGL& allocation = _m_allocations[i];
+      if (_IsInBuffer(allocation, bufferIndex))
+      {
+        uint32 first = _GetFirst(allocation, bufferIndex);
+        move.copies.push_back({ i, first, first, _GetSize(allocation, bufferIndex) });
+      }
+    }
+    std::sort
+    (
+      move.copies.begin(),
+      move.copies.end(),
+      [](const RangeCopy& _a, const RangeCopy& _b)
+      {
+        return _a.source < _b.source;
+      }
+    );
+
+    if (compact)
+    {
+      uint32 destination = 0;
+      for (RangeCopy& copy : move.copies)
+      {
+        copy.destination = destination;
+        destination += copy.size;
+      }
+    }
+    else
+    {
+      buffer.allocator.grow(capacity);
+    }
+
+    if (move.copies.empty())
+    {
+      _endMove(bufferIndex);
+    }
+  }
+
+  hkSize
+  GeometryArenaOpenGL::_stepMove(const uint32& bufferIndex, const hkSize& budget)
+  {
+    ArenaBuffer& buffer = _m_buffers[bufferIndex];
+    BufferMove& move = buffer.move;
+    _m_pStateCache->bindBuffer(GL_COPY_READ_BUFFER, buffer.buffer);
+    _m_pStateCache->bindBuffer(GL_COPY_WRITE_BUFFER, move.buffer);
+
+    // Large allocations are copied over several frames, a step copies at
+    // least an element to always make progress.
+    hkSize bytes = 0;
+    hkSize elementSize = static_cast<hkSize>(buffer.elementSize);
+    while (move.nextCopy < move.copies.size())
+    {
+      hkSize elements = (budget - bytes) / elementSize;
+      if (0 == elements)
+      {
+        if (bytes > 0)
+        {
+          break;
+        }
+        elements = 1;
+      }
+
+      const RangeCopy& copy = move.copies[move.nextCopy];
+      uint32 size = static_cast<uint32>(Math::Min(static_cast<hkSize>(copy.size - move.copiedSize), elements));
+      glCopyBufferSubData
+      (
+        GL_COPY_READ_BUFFER,
+        GL_COPY_WRITE_BUFFER,
+        buffer.elementSize * (copy.source + move.copiedSize),
+        buffer.elementSize * (copy.destination + move.copiedSize),
+        buffer.elementSize * size
+      );
+      bytes += elementSize * size;
+
+      move.copiedSize += size;
+      if (move.copiedSize == copy.size)
+      {
+        ++move.nextCopy;
+        move.copiedSize = 0;
+      }
+    }
+
+    if (move.nextCopy == move.copies.size())
+    {
+      _endMove(bufferIndex);
+    }
+    return bytes;
+  }
+
+  void
+  GeometryArenaOpenGL::_endMove(const uint32& bufferIndex)
+  {
+    ArenaBuffer& buffer = _m_buffers[bufferIndex];
+    BufferMove& move = buffer.move;
+
+    // The allocations freed during the compaction leave holes in the packed
+    // ranges.
+    if (move.compact)
+    {
+      uint32 packedSize = 0;
+      for (const RangeCopy& copy : move.copies)
+      {
+        packedSize += copy.size;
+      }
+
+      buffer.allocator.reset(move.capacity);
+      if (packedSize > 0)
+      {
+        buffer.allocator.allocate(packedSize);
+      }
+
+      for (const RangeCopy& copy : move.copies)
+      {
+        GeometryAllocationOpenGL& allocation = _m_allocations[copy.handle];
+        if (_IsInBuffer(allocation, bufferIndex))
+        {
+          _GetFirst(allocation, bufferIndex) = copy.destination;
+        }
+        else
+        {
+          buffer.allocator.free(copy.destination, copy.size);
+        }
+      }
+    }
+
+    // The draws already submitted read the old buffer.
+    _m_retiredBuffers.push_back({ glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), buffer.buffer });
+    buffer.buffer = move.buffer;
+    move = BufferMove();
+
+    if (bufferIndex == INDEX_BUFFER)
+    {
+      // The index buffer is part of the state of every vertex array object.
+      for (GLuint vao : _m_vaos)
+      {
+        _m_pStateCache->bindVertexArray(vao);
+        _m_pStateCache->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer.buffer);
+      }
+    }
+    else
+    {
+      _m_pStateCache->bindVertexArray(_m_vaos[bufferIndex]);
+      glBindVertexBuffer(0, buffer.buffer, 0, static_cast<GLsizei>(buffer.elementSize));
+    }
+  }
+
+  void
+  GeometryArenaOpenGL::_finishMoves()
+  {
+    for (uint32 i = 0; i < 3; ++i)
+    {
+      if (_m_buffers[i].move.buffer != 0)
+      {
+        _stepMove(i, std::numeric_limits<hkSize>::max());
+      }
+    }
+  }
+
+  void
+  GeometryArenaOpenGL::_releaseRetiredBuffers()
+  {
+    for (uint32 i = 0; i < _m_retiredBuffers.size();)
+    {
+      RetiredBuffer& retired = _m_retiredBuffers[i];
+      GLenum status = glClientWaitSync(retired.fence, 0, 0);
+      if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+      {
+        ++i;
+        continue;
+      }
+
+      glDeleteSync(retired.fence);
+      _m_pStateCache->deleteBuffer(retired.buffer);
+      _m_retiredBuffers.erase(_m_retiredBuffers.begin() + i);
+    }
+  }
+
+  uint32
+  GeometryArenaOpenGL::_GetPoolIndex(const eVERTEX_FORMAT& vertexFormat)
+  {
+    return vertexFormat == eVERTEX_FORMAT::kQuantized ? 1 : 0;
+  }
+
+  bool
+  GeometryArenaOpenGL::_IsInBuffer(const GeometryAllocationOpenGL& allocation, const uint32& bufferIndex)
+  {
+    if (!allocation.isUsed)
+    {
+      return false;
+    }
+
+    if (bufferIndex == INDEX_BUFFER)
+    {
+      return allocation.indexWordsSize > 0;
+    }
+    return _GetPoolIndex(allocation.vertexFormat) == bufferIndex;
+  }
+
+  uint32&
+  GeometryArenaOpenGL::_GetFirst(GeometryAllocationOpenGL& allocation, const uint32& bufferIndex)
+  {
+    return bufferIndex == INDEX_BUFFER ? allocation.firstIndexWord : allocation.firstVertex;
+  }
+
+  uint32
+  GeometryArenaOpenGL::_GetSize(const GeometryAllocationOpenGL& allocation, const uint32& bufferIndex)
+  {
+    return bufferIndex == INDEX_BUFFER ? allocation.indexWordsSize : allocation.verticesSize;
+  }
+}
\ No newline at end of file
@@ -3,11 +3,15 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
+#include <limits>
+
 #include <Hakool\Utils\hkLogger.h>
 #include <Hakool\Utils\hkIWindow.h>
 #include <Hakool\Core\hakool.h>
 #include <Hakool\Core\hkResourceManager.h>
 #include <Hakool\Core\hkScene.h>
+#include <Hakool\Core\hkRenderQueue.h>
+#include <Hakool\Core\hkMeshResourceGroup.h>
 #include <Hakool\GraphicsOpenGL\hkContextOpenGL.h>
 #include <Hakool\GraphicsOpenGL\hkShaderOpenGL.h>
 #include <Hakool\GraphicsOpenGL\hkProgramOpenGL.h>
@@ -16,12 +20,66 @@
 
 namespace hk
 {
+  namespace
+  {
+    const uint64 kProjViewMatrixId = ProgramOpenGL::UniformId("proj_view_matrix");
+    const uint64 kPositionOffsetId = ProgramOpenGL::UniformId("position_offset");
+    const uint64 kPositionScaleId = ProgramOpenGL::UniformId("position_scale");
+
+    /**
+    * Bytes of streaming memory of each frame in flight.
+    */
+    const hkSize kRingRegionSize = 4 * 1024 * 1024;
+
+    const hkSize kInstanceSize = sizeof(float) * 16;
+
+    /**
+    * Initial capacity of the geometry arena, it grows on demand.
+    */
+    const uint32 kArenaVerticesCapacity = 1 << 16;
+    const uint32 kArenaIndexWordsCapacity = 1 << 18;
+
+    /**
+    * Smallest upload budget, a slice must hold at least an index.
+    */
+    const uint32 kMinMeshUploadBudget = 1024;
+
+    /**
+    * Extra staging bytes of a frame, for the alignment of the slices.
+    */
+    const hkSize kStagingSlack = 1024;
+  }
+
   GraphicComponentOpenGL::GraphicComponentOpenGL() :
-    _m_aVAO(),
+    _m_activeProgramId(0),
     _m_pProgramOpenGL(nullptr),
     _m_pResourceManager(nullptr),
     _m_projViewMatrix(),
     _m_modelViewMat(),
+    _m_stateCache(),
+    _m_programCache(),
+    _m_shaderCompiler(),
+    _m_shaderLibrary(),
+    _m_defaultSource(ShaderLibraryOpenGL::INVALID_SOURCE),
+    _m_quantizedKeyword(0),
+    _m_geometryArena(),
+    _m_ringBuffer(),
+    _m_stagingBuffer(),
+    _m_meshUploadBudget(0),
+    _m_uploadedBytes(0),
+    _m_movedBytes(0),
+    _m_upload(),
+    _m_uploadHandle(GeometryArenaOpenGL::INVALID_HANDLE),
+    _m_uploadedVertexBytes(0),
+    _m_uploadedIndices(0),
+    _m_uploadIndices(),
+    _m_instanceBuffer(0),
+    _m_instanceBufferSize(0),
+    _m_instanceData(),
+    _m_drawElementsCommands(),
+    _m_drawArraysCommands(),
+    _m_useIndirectDraws(false),
+    _m_renderStats(),
     _m_pWindow(nullptr),
     _m_pContextOpenGL(nullptr),
     _m_isReady(false)
@@ -71,61 +129,55 @@ namespace hk
 
     glfwSwapInterval(1);
 
-    // Default vertex shader.
+    // Nothing is known of the state of the new context.
+    _m_stateCache.invalidate();
+
+    // Without the cache the programs are linked from their sources.
+    _m_programCache.init(_graphicConfiguration.programCacheDirectory);
+    _m_shaderCompiler.init();
+
+    // Default vertex shader. Float positions are drawn as they are, the
+    // QUANTIZED variant decodes QuantizedVertex positions.
     const char* pVertexSource =
       "#version 430 \n"
+      "#pragma hk_keywords QUANTIZED\n"
       "layout (location=0) in vec3 position;\n"
+      "layout (location=4) in mat4 instance_matrix;\n"
       "uniform mat4 proj_view_matrix;\n"
-      "uniform mat4 model_matrix;\n"
+      "#ifdef QUANTIZED\n"
+      "uniform vec3 position_offset;\n"
+      "uniform vec3 position_scale;\n"
+      "#endif\n"
       "out vec4 varyingColor;\n"
       "void main(void) \n"
       "{\n"
-      " gl_Position = proj_view_matrix * model_matrix * vec4(position,1.0);\n"
-      " varyingColor = vec4(position, 1.0) * 0.5 + vec4(0.5, 0.5, 0.5, 0.5);\n"
+      "#ifdef QUANTIZED\n"
+      " vec3 localPosition = position_offset + position * position_scale;\n"
+      "#else\n"
+      " vec3 localPosition = position;\n"
+      "#endif\n"
+      " gl_Position = proj_view_matrix * instance_matrix * vec4(localPosition,1.0);\n"
+      " varyingColor = vec4(localPosition, 1.0) * 0.5 + vec4(0.5, 0.5, 0.5, 0.5);\n"
       "}";
 
-    eRESULT result(eRESULT::kFail);
-    ShaderOpenGL vertexShader;
-    result = vertexShader.create(pVertexSource, eSHADER_TYPE::kVertex);
-
-    if (result != eRESULT::kSuccess)
-    {
-      Logger::Error("| GraphicComponentOpenGL | Cannot initialize the component.");
-      _releaseResources(resourceManager);
-      glfwTerminate();
-      return eRESULT::kFail;
-    }
-
-    // Add vertex shader to the resource manager.
-    ResourceGroup<Shader>& shaders = resourceManager.getShaders();
-    result = shaders.add
-    (
-      "__vertex_default", 
-      reinterpret_cast<Shader*>(&vertexShader)
-    );
-
-    if (result != eRESULT::kSuccess)
-    {
-      Logger::Error("| GraphicComponentOpenGL | Cannot initialize the component.");
-      _releaseResources(resourceManager);
-      glfwTerminate();
-      return eRESULT::kFail;
-    }
-
-    // Create default fragment shader
+    // Default fragment shader.
     const char* pFragmentSource =
       "#version 430 \n"
       "in vec4 varyingColor;\n"
       "out vec4 color; \n"
       "uniform mat4 proj_view_matrix;\n"
-      "uniform mat4 model_matrix;\n"
       "void main(void) \n"
       "{ color = varyingColor; }";    
 
-    ShaderOpenGL fragShader;
-    result = fragShader.create(pFragmentSource, eSHADER_TYPE::kFragment);
+    _m_shaderLibrary.init(this);
+    _m_defaultSource = _m_shaderLibrary.addSource("__default", pVertexSource, pFragmentSource);
+    _m_quantizedKeyword = _m_shaderLibrary.getKeywordMask(_m_defaultSource, "QUANTIZED");
 
-    if (result != eRESULT::kSuccess)
+    // Every variant is submitted before waiting on the first one, the driver
+    // compiles them together.
+    _m_shaderLibrary.precompile(_m_defaultSource);
+    _m_pProgramOpenGL = _m_shaderLibrary.getProgram(_m_defaultSource, 0);
+    if (_m_pProgramOpenGL == nullptr)
     {
       Logger::Error("| GraphicComponentOpenGL | Cannot initialize the component.");
       _releaseResources(resourceManager);
@@ -133,42 +185,36 @@ namespace hk
       return eRESULT::kFail;
     }
 
-    // Add fragment shader to the resource manager.
-
-    result = shaders.add
-    (
-      "__fragment_default", 
-      reinterpret_cast<Shader*>(&fragShader)
-    );
-
-    if (result != eRESULT::kSuccess)
+    if (_m_geometryArena.init(_m_stateCache, kArenaVerticesCapacity, kArenaIndexWordsCapacity)
+        != eRESULT::kSuccess)
     {
-      Logger::Error("| GraphicComponentOpenGL | Cannot initialize the component.");
+      Logger::Error("| GraphicComponentOpenGL | Cannot initialize the geometry arena.");
       _releaseResources(resourceManager);
       glfwTerminate();
       return eRESULT::kFail;
     }
 
-    // Create default program.
-
-    _m_pProgramOpenGL = new ProgramOpenGL();
-    result = _m_pProgramOpenGL->create
-    (
-      "__fragment_default",
-      "__vertex_default",
-      &resourceManager
-    );
+    if (_m_ringBuffer.init(_m_stateCache, kRingRegionSize) != eRESULT::kSuccess)
+    {
+      Logger::Warning("| GraphicComponentOpenGL | No ring buffer, instance data will be orphaned.");
+    }
 
-    if (result != eRESULT::kSuccess)
+    _m_meshUploadBudget = _graphicConfiguration.meshUploadBudget;
+    if (_m_meshUploadBudget > 0)
     {
-      Logger::Error("| GraphicComponentOpenGL | Cannot initialize the component.");
-      _releaseResources(resourceManager);
-      glfwTerminate();
-      return eRESULT::kFail;
+      _m_meshUploadBudget = Math::Max(_m_meshUploadBudget, kMinMeshUploadBudget);
+      if (_m_stagingBuffer.init(_m_stateCache, _m_meshUploadBudget + kStagingSlack) != eRESULT::kSuccess)
+      {
+        Logger::Warning("| GraphicComponentOpenGL | No staging buffer, meshes will be uploaded directly.");
+      }
     }
+    glGenBuffers(1, &_m_instanceBuffer);
+    _m_instanceBufferSize = 0;
 
-    glGenVertexArrays(1, _m_aVAO);
-    glBindVertexArray(_m_aVAO[0]);
+    // The indirect commands are streamed like the instances.
+    _m_useIndirectDraws = _graphicConfiguration.useIndirectDraws
+      && (GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect)
+      && _m_ringBuffer.isReady();
 
     _m_pWindow->addObserver(this);
     _m_isReady = !_m_isReady;
@@ -178,28 +224,139 @@ namespace hk
   void
   GraphicComponentOpenGL::clear(const Color& _clearColor)
   {
-    glClearColor
+    // A frame starts here, the state counters of the stats cover all of it.
+    _m_stateCache.getTracker().resetCounters();
+
+    _m_stateCache.clearColor
     (
       _clearColor.r,
       _clearColor.g,
       _clearColor.b,
       _clearColor.a
     );
-    glClear(GL_COLOR_BUFFER_BIT);
-    glClear(GL_DEPTH_BUFFER_BIT);
+
+    // The depth clear is masked by the depth writes.
+    _m_stateCache.depthMask(true);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
   }
 
   void 
   GraphicComponentOpenGL::prepareToDraw(Camera* _camera)
   {
     _m_activeProgramId = *(reinterpret_cast<uint32*>(_m_pProgramOpenGL->getProgramPtr()));
-    glUseProgram(static_cast<GLuint>(_m_activeProgramId));
+    _m_stateCache.useProgram(static_cast<GLuint>(_m_activeProgramId));
 
-    GLuint projViewMatLoc = glGetUniformLocation(_m_activeProgramId, "proj_view_matrix");
+    _m_stateCache.viewport
+    (
+      0,
+      0,
+      static_cast<int32>(_m_pWindow->getWidth()),
+      static_cast<int32>(_m_pWindow->getHeight())
+    );
     _camera->setAspectRatio((float)_m_pWindow->getWidth() / (float)_m_pWindow->getHeight());
     _m_projViewMatrix = (_camera->getProjectionMatrix() * Matrix4::GetTranslation(_camera->getPosition())).transpose();
 
-    glUniformMatrix4fv(projViewMatLoc, 1, GL_FALSE, _m_projViewMatrix.getMatrixPtr());
+    _m_pProgramOpenGL->setUniform(kProjViewMatrixId, _m_projViewMatrix);
+
+    // The meshes are copied within the upload budget of the next frames, the
+    // draws read the old buffers until then.
+    if (_m_geometryArena.isFragmented())
+    {
+      _m_geometryArena.defragment();
+    }
+
+    // Programs the driver finished linking become ready, without waiting on
+    // the others.
+    if (_m_shaderCompiler.getPendingSize() > 0)
+    {
+      _m_shaderCompiler.update();
+    }
+  }
+
+  void
+  GraphicComponentOpenGL::uploadMeshes()
+  {
+    _m_uploadedBytes = 0;
+    _m_movedBytes = 0;
+
+    hkSize budget = _m_meshUploadBudget > 0
+      ? static_cast<hkSize>(_m_meshUploadBudget)
+      : std::numeric_limits<hkSize>::max();
+
+    // The copies growing or compacting the arena take the budget first, the
+    // slices wait for them since they would write the ranges being moved.
+    hkSize movedBytes = _m_geometryArena.moveBuffers(budget);
+    hkSize uploadedBytes = movedBytes;
+
+    MeshUploadQueue& queue = _m_pResourceManager->getMeshes().getUploadQueue();
+    if (_m_upload.pMesh == nullptr && 0 == queue.getSize())
+    {
+      _m_movedBytes = static_cast<uint32>(Math::Min(movedBytes, static_cast<hkSize>(0xffffffff)));
+      return;
+    }
+
+    if (_m_stagingBuffer.isReady())
+    {
+      _m_stagingBuffer.beginFrame();
+    }
+
+    while (uploadedBytes < budget && !_m_geometryArena.isMoving())
+    {
+      if (_m_upload.pMesh == nullptr)
+      {
+        if (!queue.pop(_m_upload))
+        {
+          break;
+        }
+
+        _m_uploadHandle = _m_geometryArena.reserve(_m_upload.getDescription());
+        if (_m_uploadHandle == GeometryArenaOpenGL::INVALID_HANDLE)
+        {
+          Logger::Error("| GraphicComponentOpenGL | Cannot place a queued mesh.");
+          _m_upload = MeshUpload();
+          continue;
+        }
+        _m_uploadedVertexBytes = 0;
+        _m_uploadedIndices = 0;
+
+        // A full arena grows before the mesh is written.
+        if (_m_geometryArena.isMoving())
+        {
+          hkSize bytes = _m_geometryArena.moveBuffers(budget - uploadedBytes);
+          movedBytes += bytes;
+          uploadedBytes += bytes;
+          continue;
+        }
+      }
+
+      hkSize bytes = _uploadSlice(budget - uploadedBytes);
+      if (0 == bytes)
+      {
+        break;
+      }
+      uploadedBytes += bytes;
+
+      // The copies are ordered before the draws, the mesh can be drawn as
+      // soon as the last one is issued.
+      if (_m_uploadedVertexBytes == _m_upload.vertices.size()
+          && _m_uploadedIndices == _m_upload.indices.size())
+      {
+        static_cast<MeshOpenGL*>(_m_upload.pMesh)->setGeometry
+        (
+          _m_uploadHandle,
+          _m_upload.getDescription()
+        );
+        _m_upload = MeshUpload();
+        _m_uploadHandle = GeometryArenaOpenGL::INVALID_HANDLE;
+      }
+    }
+
+    if (_m_stagingBuffer.isReady())
+    {
+      _m_stagingBuffer.endFrame();
+    }
+    _m_uploadedBytes = static_cast<uint32>(Math::Min(uploadedBytes - movedBytes, static_cast<hkSize>(0xffffffff)));
+    _m_movedBytes = static_cast<uint32>(Math::Min(movedBytes, static_cast<hkSize>(0xffffffff)));
   }
 
   void 
@@ -208,17 +365,181 @@ namespace hk
     return;
   }
 
+  void
+  GraphicComponentOpenGL::drawQueue(const RenderQueue& queue)
+  {
+    _m_renderStats = RenderStats();
+    _m_renderStats.packets = queue.getSize();
+    _m_renderStats.uploadedBytes = _m_uploadedBytes;
+    _m_renderStats.movedBytes = _m_movedBytes;
+    _m_renderStats.pendingUploads = _m_pResourceManager->getMeshes().getUploadQueue().getSize()
+      + (_m_upload.pMesh != nullptr ? 1 : 0);
+    if (0 == _m_renderStats.packets)
+    {
+      _m_renderStats.stateCalls = _m_stateCache.getTracker().getIssuedCalls();
+      _m_renderStats.filteredStateCalls = _m_stateCache.getTracker().getFilteredCalls();
+      return;
+    }
+
+    uint64 stalls = _m_ringBuffer.getStats().stalls;
+    if (_m_ringBuffer.isReady())
+    {
+      _m_ringBuffer.beginFrame();
+    }
+
+    // The model matrices are streamed in sorted order, so a batch is a
+    // contiguous range of instances.
+    uint32 baseInstance = _streamInstances(queue);
+    _m_renderStats.streamStalls = static_cast<uint32>(_m_ringBuffer.getStats().stalls - stalls);
+
+    const ProgramOpenGL* pPreviousProgram = nullptr;
+    const Matrix4* pPreviousMatrix = nullptr;
+
+    // A group is a run of batches of the same material whose meshes share
+    // their bind state, one multi draw call draws all of it.
+    uint32 first = 0;
+    while (first < _m_renderStats.packets)
+    {
+      const RenderPacket& packet = queue.getPacket(first);
+      uint64 materialKey = RenderQueue::GetMaterialKey(packet.sortKey);
+
+      // Meshes are created by this component.
+      MeshOpenGL* pMesh = static_cast<MeshOpenGL*>(packet.pMesh);
+
+      uint32 end = first + 1;
+      while (end < _m_renderStats.packets)
+      {
+        const RenderPacket& next = queue.getPacket(end);
+        if (RenderQueue::GetMaterialKey(next.sortKey) != materialKey
+            || !pMesh->sharesBindState(*static_cast<MeshOpenGL*>(next.pMesh)))
+        {
+          break;
+        }
+        ++end;
+      }
+
+      // Without its program the group would be drawn with the wrong vertex
+      // decoding.
+      if (pMesh->bind(this) != eRESULT::kSuccess)
+      {
+        first = end;
+        continue;
+      }
+      ++_m_renderStats.meshBinds;
+      _m_renderStats.skippedMeshBinds += end - first - 1;
+
+      // Drawn one by one, the shadowed model matrix of the program would
+      // only be uploaded when it differs from the one of the previous packet.
+      if (_m_pProgramOpenGL != pPreviousProgram)
+      {
+        pPreviousProgram = _m_pProgramOpenGL;
+        pPreviousMatrix = nullptr;
+      }
+      for (uint32 i = first; i < end; ++i)
+      {
+        const Matrix4& modelMatrix = queue.getPacket(i).modelMatrix;
+        if (pPreviousMatrix == nullptr
+            || std::memcmp(pPreviousMatrix->a, modelMatrix.a, kInstanceSize) != 0)
+        {
+          ++_m_renderStats.skippedUniformSets;
+        }
+        pPreviousMatrix = &modelMatrix;
+      }
+
+      if (_m_useIndirectDraws)
+      {
+        _drawBatchesIndirect(queue, first, end, baseInstance);
+      }
+      else
+      {
+        _drawBatches(queue, first, end, baseInstance);
+      }
+      first = end;
+    }
+
+    if (_m_ringBuffer.isReady())
+    {
+      _m_ringBuffer.endFrame();
+    }
+
+    _m_renderStats.stateCalls = _m_stateCache.getTracker().getIssuedCalls();
+    _m_renderStats.filteredStateCalls = _m_stateCache.getTracker().getFilteredCalls();
+  }
+
+  const RenderStats&
+  GraphicComponentOpenGL::getRenderStats()
+  {
+    return _m_renderStats;
+  }
+
   IMesh*
   GraphicComponentOpenGL::createMesh()
   {
-    return new MeshOpenGL();
+    return new MeshOpenGL(&_m_geometryArena);
+  }
+
+  void
+  GraphicComponentOpenGL::destroyMesh(IMesh* pMesh)
+  {
+    // An unfinished upload would give its geometry to the deleted mesh. The
+    // space reserved for it has no mesh to free it.
+    if (_m_upload.pMesh == pMesh)
+    {
+      if (_m_uploadHandle != GeometryArenaOpenGL::INVALID_HANDLE)
+      {
+        _m_geometryArena.free(_m_uploadHandle);
+      }
+      _m_upload = MeshUpload();
+      _m_uploadHandle = GeometryArenaOpenGL::INVALID_HANDLE;
+    }
+
+    pMesh->destroy();
+    delete pMesh;
   }
 
   void 
   GraphicComponentOpenGL::setModelMatrix(const Matrix4& modelMatrix)
   {
-    GLuint modelMatLoc = glGetUniformLocation(_m_activeProgramId, "model_matrix");
-    glUniformMatrix4fv(modelMatLoc, 1, GL_FALSE, &modelMatrix.a[0]);
+    // Outside of drawQueue the instance matrix is a constant attribute.
+    for (GLuint i = 0; i < 4; ++i)
+    {
+      glVertexAttrib4fv(GeometryArenaOpenGL::INSTANCE_MATRIX_LOCATION + i, &modelMatrix.a[4 * i]);
+    }
+  }
+
+  eRESULT
+  GraphicComponentOpenGL::useDefaultProgram(const eVERTEX_FORMAT& format)
+  {
+    uint32 keywords = format == eVERTEX_FORMAT::kQuantized ? _m_quantizedKeyword : 0;
+    ProgramOpenGL* pProgram = _m_shaderLibrary.getProgram(_m_defaultSource, keywords);
+    if (pProgram == nullptr)
+    {
+      return eRESULT::kFail;
+    }
+
+    if (pProgram == _m_pProgramOpenGL)
+    {
+      return eRESULT::kSuccess;
+    }
+
+    _m_pProgramOpenGL = pProgram;
+    _m_activeProgramId = *(reinterpret_cast<uint32*>(pProgram->getProgramPtr()));
+    _m_stateCache.useProgram(static_cast<GLuint>(_m_activeProgramId));
+
+    // The uniforms are shadowed by each variant, only a new matrix uploads.
+    pProgram->setUniform(kProjViewMatrixId, _m_projViewMatrix);
+    return eRESULT::kSuccess;
+  }
+
+  void
+  GraphicComponentOpenGL::setPositionDequantization
+  (
+    const Vector3f& offset,
+    const Vector3f& scale
+  )
+  {
+    _m_pProgramOpenGL->setUniform(kPositionOffsetId, offset);
+    _m_pProgramOpenGL->setUniform(kPositionScaleId, scale);
   }
 
   IShader* 
@@ -236,7 +557,10 @@ namespace hk
   IProgram* 
   GraphicComponentOpenGL::createProgram()
   {
-      return new ProgramOpenGL();
+      // Initialized, so its binary is cached like the default program.
+      ProgramOpenGL* pProgram = new ProgramOpenGL();
+      pProgram->init(this);
+      return pProgram;
   }
 
   IWindow* 
@@ -273,32 +597,355 @@ namespace hk
   GraphicComponentOpenGL::onWindowSizeChanged(
     const uint32& width, 
     const uint32& height, 
-    IWindow* pWindow) const
+    IWindow* pWindow)
   {
-    glViewport(0, 0, width, height);
+    // Called from the event polling, which may not own the context. The
+    // viewport follows the window size in prepareToDraw.
+    return;
+  }
+
+  StateCacheOpenGL&
+  GraphicComponentOpenGL::getStateCache()
+  {
+    return _m_stateCache;
+  }
+
+  ProgramBinaryCacheOpenGL&
+  GraphicComponentOpenGL::getProgramCache()
+  {
+    return _m_programCache;
+  }
+
+  ShaderCompilerOpenGL&
+  GraphicComponentOpenGL::getShaderCompiler()
+  {
+    return _m_shaderCompiler;
+  }
+
+  ShaderLibraryOpenGL&
+  GraphicComponentOpenGL::getShaderLibrary()
+  {
+    return _m_shaderLibrary;
   }
 
   void 
   GraphicComponentOpenGL::_releaseResources(ResourceManager& resourceManager)
   {
-    if (_m_pProgramOpenGL != nullptr)
+    // The mesh of an unfinished upload is never made resident.
+    _m_upload = MeshUpload();
+    _m_uploadHandle = GeometryArenaOpenGL::INVALID_HANDLE;
+    _m_stagingBuffer.destroy();
+    _m_ringBuffer.destroy();
+    _m_geometryArena.destroy();
+
+    _m_stateCache.deleteBuffer(_m_instanceBuffer);
+    _m_instanceBufferSize = 0;
+
+    // The active program is a variant of the library.
+    _m_pProgramOpenGL = nullptr;
+    _m_shaderLibrary.destroy();
+    _m_defaultSource = ShaderLibraryOpenGL::INVALID_SOURCE;
+    _m_quantizedKeyword = 0;
+
+    _m_shaderCompiler.destroy();
+    _m_programCache.destroy();
+
+    delete _m_pContextOpenGL;
+    return;
+  }
+
+  uint32
+  GraphicComponentOpenGL::_streamInstances(const RenderQueue& queue)
+  {
+    uint32 packetsSize = queue.getSize();
+    hkSize bytes = kInstanceSize * packetsSize;
+
+    // Aligned to a matrix, the offset is a whole number of instances.
+    RingAllocationOpenGL allocation = _m_ringBuffer.allocate(bytes, kInstanceSize);
+    if (allocation.pData != nullptr)
     {
-      _m_pProgramOpenGL->destroy();
-      delete _m_pProgramOpenGL;
-      _m_pProgramOpenGL = nullptr;
+      uint8* pInstances = static_cast<uint8*>(allocation.pData);
+      for (uint32 i = 0; i < packetsSize; ++i)
+      {
+        std::memcpy(pInstances + kInstanceSize * i, queue.getPacket(i).modelMatrix.a, kInstanceSize);
+      }
+
+      _m_geometryArena.setInstanceBuffer(_m_ringBuffer.getBuffer(), kInstanceSize);
+      return static_cast<uint32>(allocation.offset / kInstanceSize);
     }
 
-    ResourceGroup<Shader>& shaders = resourceManager.getShaders();    
-    if (shaders.has("__fragment_default"))
+    _m_instanceData.resize(static_cast<hkSize>(packetsSize) * 16);
+    for (uint32 i = 0; i < packetsSize; ++i)
     {
-      shaders.removeAndDestroy("__fragment_default");
+      std::memcpy(&_m_instanceData[static_cast<hkSize>(i) * 16], queue.getPacket(i).modelMatrix.a, kInstanceSize);
     }
-    if (shaders.has("__vertex_default"))
+
+    _m_stateCache.bindBuffer(GL_ARRAY_BUFFER, _m_instanceBuffer);
+
+    // Orphan the storage of the previous frame, the driver may still read it.
+    if (bytes > _m_instanceBufferSize)
     {
-      shaders.removeAndDestroy("__vertex_default");
+      _m_instanceBufferSize = Math::Max(bytes, 2 * _m_instanceBufferSize);
     }
+    glBufferData(GL_ARRAY_BUFFER, _m_instanceBufferSize, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, _m_instanceData.data());
 
-    delete _m_pContextOpenGL;
-    return;
+    _m_geometryArena.setInstanceBuffer(_m_instanceBuffer, kInstanceSize);
+    return 0;
+  }
+
+  void
+  GraphicComponentOpenGL::_drawBatches
+  (
+    const RenderQueue& queue,
+    const uint32& first,
+    const uint32& end,
+    const uint32& baseInstance
+  )
+  {
+    uint32 batchFirst = first;
+    while (batchFirst < end)
+    {
+      const RenderPacket& packet = queue.getPacket(batchFirst);
+      uint64 batchKey = RenderQueue::GetBatchKey(packet.sortKey);
+
+      uint32 batchEnd = batchFirst + 1;
+      while (batchEnd < end
+             && queue.getPacket(batchEnd).pMesh == packet.pMesh
+             && RenderQueue::GetBatchKey(queue.getPacket(batchEnd).sortKey) == batchKey)
+      {
+        ++batchEnd;
+      }
+
+      MeshOpenGL* pMesh = static_cast<MeshOpenGL*>(packet.pMesh);
+      _setDepthState();
+      pMesh->drawBoundInstanced(batchEnd - batchFirst, baseInstance + batchFirst);
+      ++_m_renderStats.drawCalls;
+      batchFirst = batchEnd;
+    }
+  }
+
+  void
+  GraphicComponentOpenGL::_drawBatchesIndirect
+  (
+    const RenderQueue& queue,
+    const uint32& first,
+    const uint32& end,
+    const uint32& baseInstance
+  )
+  {
+    // Every mesh of the group has the same index type.
+    GLenum indexType = static_cast<MeshOpenGL*>(queue.getPacket(first).pMesh)->getIndexType();
+
+    _m_drawElementsCommands.clear();
+    _m_drawArraysCommands.clear();
+
+    uint32 batchFirst = first;
+    while (batchFirst < end)
+    {
+      const RenderPacket& packet = queue.getPacket(batchFirst);
+      uint64 batchKey = RenderQueue::GetBatchKey(packet.sortKey);
+
+      uint32 batchEnd = batchFirst + 1;
+      while (batchEnd < end
+             && queue.getPacket(batchEnd).pMesh == packet.pMesh
+             && RenderQueue::GetBatchKey(queue.getPacket(batchEnd).sortKey) == batchKey)
+      {
+        ++batchEnd;
+      }
+
+      // The base instance selects the model matrices of the batch.
+      const MeshOpenGL* pMesh = static_cast<const MeshOpenGL*>(packet.pMesh);
+      if (indexType != 0)
+      {
+        _m_drawElementsCommands.push_back
+        (
+          pMesh->getDrawElementsCommand(batchEnd - batchFirst, baseInstance + batchFirst)
+        );
+      }
+      else
+      {
+        _m_drawArraysCommands.push_back
+        (
+          pMesh->getDrawArraysCommand(batchEnd - batchFirst, baseInstance + batchFirst)
+        );
+      }
+      batchFirst = batchEnd;
+    }
+
+    const void* pCommands;
+    hkSize commandsSize;
+    hkSize bytes;
+    if (indexType != 0)
+    {
+      pCommands = _m_drawElementsCommands.data();
+      commandsSize = _m_drawElementsCommands.size();
+      bytes = sizeof(DrawElementsCommandOpenGL) * commandsSize;
+    }
+    else
+    {
+      pCommands = _m_drawArraysCommands.data();
+      commandsSize = _m_drawArraysCommands.size();
+      bytes = sizeof(DrawArraysCommandOpenGL) * commandsSize;
+    }
+
+    RingAllocationOpenGL allocation = _m_ringBuffer.allocate(bytes, sizeof(uint32));
+    if (allocation.pData == nullptr)
+    {
+      _drawBatches(queue, first, end, baseInstance);
+      return;
+    }
+    std::memcpy(allocation.pData, pCommands, bytes);
+
+    _m_stateCache.bindBuffer(GL_DRAW_INDIRECT_BUFFER, _m_ringBuffer.getBuffer());
+    _setDepthState();
+    if (indexType != 0)
+    {
+      glMultiDrawElementsIndirect
+      (
+        GL_TRIANGLES,
+        indexType,
+        reinterpret_cast<const void*>(allocation.offset),
+        static_cast<GLsizei>(commandsSize),
+        0
+      );
+    }
+    else
+    {
+      glMultiDrawArraysIndirect
+      (
+        GL_TRIANGLES,
+        reinterpret_cast<const void*>(allocation.offset),
+        static_cast<GLsizei>(commandsSize),
+        0
+      );
+    }
+
+    ++_m_renderStats.drawCalls;
+    _m_renderStats.indirectDraws += static_cast<uint32>(commandsSize);
+  }
+
+  void
+  GraphicComponentOpenGL::_setDepthState()
+  {
+    if (_m_stateCache.enable(GL_DEPTH_TEST))
+    {
+      ++_m_renderStats.stateSets;
+    }
+    else
+    {
+      ++_m_renderStats.skippedStateSets;
+    }
+
+    if (_m_stateCache.depthFunc(GL_LEQUAL))
+    {
+      ++_m_renderStats.stateSets;
+    }
+    else
+    {
+      ++_m_renderStats.skippedStateSets;
+    }
+  }
+
+  hkSize
+  GraphicComponentOpenGL::_uploadSlice(const hkSize& budget)
+  {
+    // Vertices, in slices of any size.
+    hkSize vertexBytes = _m_upload.vertices.size();
+    if (_m_uploadedVertexBytes < vertexBytes)
+    {
+      hkSize size = Math::Min(vertexBytes - _m_uploadedVertexBytes, budget);
+      GeometryRangeOpenGL range = _m_geometryArena.getVertexRange(_m_uploadHandle);
+      if (!_writeGeometry
+          (
+            range.buffer,
+            range.offset + static_cast<GLintptr>(_m_uploadedVertexBytes),
+            &_m_upload.vertices[_m_uploadedVertexBytes],
+            size
+          ))
+      {
+        return 0;
+      }
+
+      _m_uploadedVertexBytes += size;
+      return size;
+    }
+
+    // Then whole indices, in the index type of the allocation.
+    const GeometryAllocationOpenGL& allocation = _m_geometryArena.getAllocation(_m_uploadHandle);
+    hkSize indexSize = allocation.indexType == GL_UNSIGNED_SHORT ? sizeof(uint16) : sizeof(uint32);
+    uint32 count = static_cast<uint32>
+    (
+      Math::Min(static_cast<hkSize>(_m_upload.indices.size() - _m_uploadedIndices), budget / indexSize)
+    );
+    if (0 == count)
+    {
+      return 0;
+    }
+
+    const uint32* pIndices = &_m_upload.indices[_m_uploadedIndices];
+    const void* pData = pIndices;
+    if (allocation.indexType == GL_UNSIGNED_SHORT)
+    {
+      _m_uploadIndices.resize(count);
+      for (uint32 i = 0; i < count; ++i)
+      {
+        _m_uploadIndices[i] = static_cast<uint16>(pIndices[i]);
+      }
+      pData = _m_uploadIndices.data();
+    }
+
+    GeometryRangeOpenGL range = _m_geometryArena.getIndexRange(_m_uploadHandle);
+    if (!_writeGeometry
+        (
+          range.buffer,
+          range.offset + static_cast<GLintptr>(indexSize * _m_uploadedIndices),
+          pData,
+          indexSize * count
+        ))
+    {
+      return 0;
+    }
+
+    _m_uploadedIndices += count;
+    return indexSize * count;
+  }
+
+  bool
+  GraphicComponentOpenGL::_writeGeometry
+  (
+    const GLuint& buffer,
+    const GLintptr& offset,
+    const void* pData,
+    const hkSize& size
+  )
+  {
+    if (!_m_stagingBuffer.isReady())
+    {
+      _m_stateCache.bindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+      glBufferSubData(GL_COPY_WRITE_BUFFER, offset, static_cast<GLsizeiptr>(size), pData);
+      return true;
+    }
+
+    RingAllocationOpenGL allocation = _m_stagingBuffer.allocate(size, sizeof(uint32));
+    if (allocation.pData == nullptr)
+    {
+      return false;
+    }
+    std::memcpy(allocation.pData, pData, size);
+
+    // Copied by the GPU from the persistent mapping, the driver never waits
+    // for the CPU data.
+    _m_stateCache.bindBuffer(GL_COPY_READ_BUFFER, _m_stagingBuffer.getBuffer());
+    _m_stateCache.bindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glCopyBufferSubData
+    (
+      GL_COPY_READ_BUFFER,
+      GL_COPY_WRITE_BUFFER,
+      static_cast<GLintptr>(allocation.offset),
+      offset,
+      static_cast<GLsizeiptr>(size)
+    );
+    return true;
   }
 }
\ No newline at end of file
@@ -1,12 +1,18 @@
 #include <Hakool/GraphicsOpenGL/hkMeshOpenGL.h>
 #include <Hakool/GraphicsOpenGL/hkGraphicComponentOpenGL.h>
+#include <Hakool/GraphicsOpenGL/hkGeometryArenaOpenGL.h>
+#include <Hakool/Core/hkRenderQueue.h>
 
 namespace hk
 {
-  MeshOpenGL::MeshOpenGL() :
+  MeshOpenGL::MeshOpenGL(GeometryArenaOpenGL* pGeometryArena) :
     IMesh(),
-    _m_vbo(),
-    _m_size(0)
+    _m_pGeometryArena(pGeometryArena),
+    _m_handle(GeometryArenaOpenGL::INVALID_HANDLE),
+    _m_size(0),
+    _m_isQuantized(false),
+    _m_quantization(),
+    _m_isResident(false)
   { }
 
   MeshOpenGL::~MeshOpenGL()
@@ -14,24 +20,211 @@ namespace hk
     destroy();
   }
 
-  void 
-  MeshOpenGL::init(float* aVertexes, const uint32& size)
+  void
+  MeshOpenGL::init(const MeshDescription& description)
+  {
+    uint32 handle = _m_pGeometryArena->allocate(description);
+    if (handle == GeometryArenaOpenGL::INVALID_HANDLE)
+    {
+      destroy();
+      return;
+    }
+
+    setGeometry(handle, description);
+  }
+
+  bool
+  MeshOpenGL::isResident()
+  {
+    return _m_isResident.load(std::memory_order_acquire);
+  }
+
+  void
+  MeshOpenGL::setGeometry(const uint32& handle, const MeshDescription& description)
   {
-    _m_size = size;
-    glGenBuffers(1, &_m_vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, _m_vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * size * 3, aVertexes, GL_STATIC_DRAW);
+    destroy();
+
+    _m_handle = handle;
+    _m_size = description.verticesSize;
+    _m_isQuantized = description.vertexFormat == eVERTEX_FORMAT::kQuantized;
+    _m_quantization = description.quantization;
+    _m_isResident.store(true, std::memory_order_release);
   }
 
   void 
   MeshOpenGL::draw(GraphicComponent* pGraphicComponent)
   {
-    glBindBuffer(GL_ARRAY_BUFFER, _m_vbo);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0);
-    glEnableVertexAttribArray(0);
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LEQUAL);
-    glDrawArrays(GL_TRIANGLES, 0, _m_size);
+    if (_m_handle == GeometryArenaOpenGL::INVALID_HANDLE)
+    {
+      return;
+    }
+
+    if (bind(pGraphicComponent) != eRESULT::kSuccess)
+    {
+      return;
+    }
+
+    StateCacheOpenGL& stateCache = static_cast<GraphicComponentOpenGL*>(pGraphicComponent)->getStateCache();
+    stateCache.enable(GL_DEPTH_TEST);
+    stateCache.depthFunc(GL_LEQUAL);
+
+    // Outside of a RenderQueue the model matrix is a constant attribute. The
+    // arrays stay disabled until the next instanced bind.
+    for (GLuint i = 0; i < 4; ++i)
+    {
+      stateCache.disableVertexAttribArray(GeometryArenaOpenGL::INSTANCE_MATRIX_LOCATION + i);
+    }
+    drawBound();
+  }
+
+  eRESULT
+  MeshOpenGL::bind(GraphicComponent* pGraphicComponent)
+  {
+    _m_pGeometryArena->bind
+    (
+      _m_isQuantized ? eVERTEX_FORMAT::kQuantized : eVERTEX_FORMAT::kPosition
+    );
+
+    // Instanced draws read the model matrices from the instance buffer.
+    GraphicComponentOpenGL* pComponent = static_cast<GraphicComponentOpenGL*>(pGraphicComponent);
+    StateCacheOpenGL& stateCache = pComponent->getStateCache();
+    for (GLuint i = 0; i < 4; ++i)
+    {
+      stateCache.enableVertexAttribArray(GeometryArenaOpenGL::INSTANCE_MATRIX_LOCATION + i);
+    }
+
+    // Float positions use a variant without the decoding.
+    eRESULT result = pComponent->useDefaultProgram
+    (
+      _m_isQuantized ? eVERTEX_FORMAT::kQuantized : eVERTEX_FORMAT::kPosition
+    );
+    if (result != eRESULT::kSuccess)
+    {
+      return result;
+    }
+
+    if (_m_isQuantized)
+    {
+      pGraphicComponent->setPositionDequantization
+      (
+        _m_quantization.positionOffset,
+        _m_quantization.positionScale
+      );
+    }
+    return eRESULT::kSuccess;
+  }
+
+  void
+  MeshOpenGL::drawBound()
+  {
+    const GeometryAllocationOpenGL& allocation = _m_pGeometryArena->getAllocation(_m_handle);
+    if (allocation.indicesSize > 0)
+    {
+      glDrawElementsBaseVertex
+      (
+        GL_TRIANGLES,
+        allocation.indicesSize,
+        allocation.indexType,
+        reinterpret_cast<void*>(sizeof(uint32) * allocation.firstIndexWord),
+        allocation.firstVertex
+      );
+    }
+    else
+    {
+      glDrawArrays(GL_TRIANGLES, allocation.firstVertex, allocation.verticesSize);
+    }
+  }
+
+  void
+  MeshOpenGL::drawBoundInstanced(const uint32& instancesSize, const uint32& firstInstance)
+  {
+    const GeometryAllocationOpenGL& allocation = _m_pGeometryArena->getAllocation(_m_handle);
+    if (allocation.indicesSize > 0)
+    {
+      glDrawElementsInstancedBaseVertexBaseInstance
+      (
+        GL_TRIANGLES,
+        allocation.indicesSize,
+        allocation.indexType,
+        reinterpret_cast<void*>(sizeof(uint32) * allocation.firstIndexWord),
+        instancesSize,
+        allocation.firstVertex,
+        firstInstance
+      );
+    }
+    else
+    {
+      glDrawArraysInstancedBaseInstance
+      (
+        GL_TRIANGLES,
+        allocation.firstVertex,
+        allocation.verticesSize,
+        instancesSize,
+        firstInstance
+      );
+    }
+  }
+
+  bool
+  MeshOpenGL::sharesBindState(const MeshOpenGL& other) const
+  {
+    if (_m_isQuantized != other._m_isQuantized || getIndexType() != other.getIndexType())
+    {
+      return false;
+    }
+
+    if (!_m_isQuantized)
+    {
+      return true;
+    }
+
+    const Vector3f& offset = _m_quantization.positionOffset;
+    const Vector3f& scale = _m_quantization.positionScale;
+    const Vector3f& otherOffset = other._m_quantization.positionOffset;
+    const Vector3f& otherScale = other._m_quantization.positionScale;
+    return offset.x == otherOffset.x && offset.y == otherOffset.y && offset.z == otherOffset.z
+      && scale.x == otherScale.x && scale.y == otherScale.y && scale.z == otherScale.z;
+  }
+
+  GLenum
+  MeshOpenGL::getIndexType() const
+  {
+    if (_m_handle == GeometryArenaOpenGL::INVALID_HANDLE)
+    {
+      return 0;
+    }
+
+    return _m_pGeometryArena->getAllocation(_m_handle).indexType;
+  }
+
+  DrawElementsCommandOpenGL
+  MeshOpenGL::getDrawElementsCommand(const uint32& instancesSize, const uint32& firstInstance) const
+  {
+    const GeometryAllocationOpenGL& allocation = _m_pGeometryArena->getAllocation(_m_handle);
+
+    // The first index is counted in indices, not in bytes.
+    DrawElementsCommandOpenGL command;
+    command.count = allocation.indicesSize;
+    command.instanceCount = instancesSize;
+    command.firstIndex = allocation.indexType == GL_UNSIGNED_SHORT
+      ? 2 * allocation.firstIndexWord
+      : allocation.firstIndexWord;
+    command.baseVertex = static_cast<int32>(allocation.firstVertex);
+    command.baseInstance = firstInstance;
+    return command;
+  }
+
+  DrawArraysCommandOpenGL
+  MeshOpenGL::getDrawArraysCommand(const uint32& instancesSize, const uint32& firstInstance) const
+  {
+    const GeometryAllocationOpenGL& allocation = _m_pGeometryArena->getAllocation(_m_handle);
+
+    DrawArraysCommandOpenGL command;
+    command.count = allocation.verticesSize;
+    command.instanceCount = instancesSize;
+    command.first = allocation.firstVertex;
+    command.baseInstance = firstInstance;
+    return command;
   }
 
   uint32 
@@ -46,9 +239,31 @@ namespace hk
     return nullptr;
   }
 
+  uint32
+  MeshOpenGL::getId()
+  {
+    static_assert
+    (
+      2 * GeometryArenaOpenGL::MAX_HANDLES <= (1 << RenderQueue::MESH_BITS),
+      "The mesh ids must fit in the sort keys."
+    );
+
+    // The vertex format above the handle, which the arena keeps below
+    // MAX_HANDLES.
+    uint32 format = _m_isQuantized ? 1 : 0;
+    return format * GeometryArenaOpenGL::MAX_HANDLES + _m_handle;
+  }
+
   void 
   MeshOpenGL::destroy()
   {
-    // TODO
+    _m_isResident.store(false, std::memory_order_release);
+    if (_m_handle != GeometryArenaOpenGL::INVALID_HANDLE)
+    {
+      _m_pGeometryArena->free(_m_handle);
+      _m_handle = GeometryArenaOpenGL::INVALID_HANDLE;
+    }
+
+    _m_size = 0;
   }
 }
\ No newline at end of file
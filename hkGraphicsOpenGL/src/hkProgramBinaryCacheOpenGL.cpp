@@ -0,0 +1,289 @@
+#include <Hakool\GraphicsOpenGL\hkProgramBinaryCacheOpenGL.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+
+#if HK_PLATFORM == HK_PLATFORM_WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+#include <Hakool\Utils\hkLogger.h>
+#include <Hakool\Utils\hkHash.h>
+
+namespace hk
+{
+  namespace
+  {
+    /**
+    * "HKPB", first bytes of a binary file.
+    */
+    const uint32 kBinaryMagic = 0x42504B48;
+
+    /**
+    * Changes when the layout of the files changes.
+    */
+    const uint32 kBinaryVersion = 1;
+
+    struct ProgramBinaryHeader
+    {
+      uint32 magic;
+
+      uint32 version;
+
+      uint64 key;
+
+      /**
+      * GLenum format given by glGetProgramBinary.
+      */
+      uint32 format;
+
+      uint32 binarySize;
+    };
+
+    uint64
+    HashString(const GLenum& name, const uint64& seed)
+    {
+      const char* pString = reinterpret_cast<const char*>(glGetString(name));
+      if (pString == nullptr)
+      {
+        return seed;
+      }
+
+      String string(pString);
+      return Hash::Fnv1a(string.data(), string.size(), seed);
+    }
+
+    bool
+    MakeDirectory(const String& directory)
+    {
+#if HK_PLATFORM == HK_PLATFORM_WIN32
+      int32 result = _mkdir(directory.c_str());
+#else
+      int32 result = mkdir(directory.c_str(), 0755);
+#endif
+      return result == 0 || errno == EEXIST;
+    }
+  }
+
+  ProgramBinaryCacheOpenGL::ProgramBinaryCacheOpenGL() :
+    _m_directory(),
+    _m_driverHash(0),
+    _m_isEnabled(false),
+    _m_hits(0),
+    _m_misses(0)
+  { }
+
+  eRESULT
+  ProgramBinaryCacheOpenGL::init(const String& directory)
+  {
+    destroy();
+    if (directory.empty())
+    {
+      return eRESULT::kSuccess;
+    }
+
+    if (!GLEW_VERSION_4_1 && !GLEW_ARB_get_program_binary)
+    {
+      Logger::Warning("| ProgramBinaryCacheOpenGL | Program binaries aren't supported, the cache is disabled.");
+      return eRESULT::kFail;
+    }
+
+    GLint formatsSize = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatsSize);
+    if (formatsSize <= 0)
+    {
+      Logger::Warning("| ProgramBinaryCacheOpenGL | The driver has no program binary format, the cache is disabled.");
+      return eRESULT::kFail;
+    }
+
+    if (!MakeDirectory(directory))
+    {
+      Logger::Warning("| ProgramBinaryCacheOpenGL | Couldn't create the directory: " + directory);
+      return eRESULT::kFail;
+    }
+
+    uint64 driverHash = Hash::FNV_OFFSET_BASIS;
+    driverHash = HashString(GL_VENDOR, driverHash);
+    driverHash = HashString(GL_RENDERER, driverHash);
+    driverHash = HashString(GL_VERSION, driverHash);
+    driverHash = HashString(GL_SHADING_LANGUAGE_VERSION, driverHash);
+
+    _m_directory = directory;
+    _m_driverHash = driverHash;
+    _m_isEnabled = true;
+    return eRESULT::kSuccess;
+  }
+
+  void
+  ProgramBinaryCacheOpenGL::destroy()
+  {
+    _m_directory.clear();
+    _m_driverHash = 0;
+    _m_isEnabled = false;
+    _m_hits = 0;
+    _m_misses = 0;
+  }
+
+  bool
+  ProgramBinaryCacheOpenGL::isEnabled() const
+  {
+    return _m_isEnabled;
+  }
+
+  uint64
+  ProgramBinaryCacheOpenGL::getKey(const uint64& vertexHash, const uint64& fragmentHash) const
+  {
+    uint64 key = Hash::Fnv1a(&kBinaryVersion, sizeof(kBinaryVersion), _m_driverHash);
+    key = Hash::Fnv1a(&vertexHash, sizeof(vertexHash), key);
+    return Hash::Fnv1a(&fragmentHash, sizeof(fragmentHash), key);
+  }
+
+  bool
+  ProgramBinaryCacheOpenGL::load(const uint64& key, const GLuint& program)
+  {
+    if (!_m_isEnabled)
+    {
+      return false;
+    }
+
+    String path = _getPath(key);
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+      ++_m_misses;
+      return false;
+    }
+
+    std::streamoff fileSize = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    ProgramBinaryHeader header;
+    bool isValid = fileSize >= static_cast<std::streamoff>(sizeof(header))
+      && file.read(reinterpret_cast<char*>(&header), sizeof(header))
+      && header.magic == kBinaryMagic
+      && header.version == kBinaryVersion
+      && header.key == key
+      && header.binarySize > 0
+      && fileSize == static_cast<std::streamoff>(sizeof(header) + header.binarySize);
+
+    Vector<char> binary;
+    if (isValid)
+    {
+      binary.resize(header.binarySize);
+      isValid = static_cast<bool>(file.read(binary.data(), binary.size()));
+    }
+    file.close();
+
+    if (isValid)
+    {
+      glProgramBinary
+      (
+        program,
+        static_cast<GLenum>(header.format),
+        binary.data(),
+        static_cast<GLsizei>(binary.size())
+      );
+
+      GLint isLinked = 0;
+      glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+      isValid = isLinked == GL_TRUE;
+    }
+
+    if (!isValid)
+    {
+      // Truncated, or rejected by the driver. It is replaced once the program
+      // is linked from its sources.
+      std::remove(path.c_str());
+      ++_m_misses;
+      return false;
+    }
+
+    ++_m_hits;
+    return true;
+  }
+
+  void
+  ProgramBinaryCacheOpenGL::store(const uint64& key, const GLuint& program)
+  {
+    if (!_m_isEnabled)
+    {
+      return;
+    }
+
+    GLint binarySize = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+    if (binarySize <= 0)
+    {
+      return;
+    }
+
+    Vector<char> binary(static_cast<hkSize>(binarySize));
+    GLenum format = 0;
+    GLsizei writtenSize = 0;
+    glGetProgramBinary(program, binarySize, &writtenSize, &format, binary.data());
+    if (writtenSize <= 0)
+    {
+      return;
+    }
+
+    ProgramBinaryHeader header;
+    header.magic = kBinaryMagic;
+    header.version = kBinaryVersion;
+    header.key = key;
+    header.format = static_cast<uint32>(format);
+    header.binarySize = static_cast<uint32>(writtenSize);
+
+    // Write a temporary file first, so a launch that stops halfway never
+    // leaves a truncated binary.
+    String path = _getPath(key);
+    String temporaryPath = path + ".tmp";
+    {
+      std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+      if (!file.is_open())
+      {
+        Logger::Warning("| ProgramBinaryCacheOpenGL | Couldn't write the binary: " + path);
+        return;
+      }
+
+      file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      file.write(binary.data(), header.binarySize);
+      if (!file.good())
+      {
+        Logger::Warning("| ProgramBinaryCacheOpenGL | Couldn't write the binary: " + path);
+        file.close();
+        std::remove(temporaryPath.c_str());
+        return;
+      }
+    }
+
+    std::remove(path.c_str());
+    if (0 != std::rename(temporaryPath.c_str(), path.c_str()))
+    {
+      Logger::Warning("| ProgramBinaryCacheOpenGL | Couldn't replace the binary: " + path);
+      std::remove(temporaryPath.c_str());
+    }
+  }
+
+  uint32
+  ProgramBinaryCacheOpenGL::getHits() const
+  {
+    return _m_hits;
+  }
+
+  uint32
+  ProgramBinaryCacheOpenGL::getMisses() const
+  {
+    return _m_misses;
+  }
+
+  String
+  ProgramBinaryCacheOpenGL::_getPath(const uint64& key) const
+  {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return _m_directory + "/" + name;
+  }
+}
\ No newline at end of file
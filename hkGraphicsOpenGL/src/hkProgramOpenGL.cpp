@@ -1,17 +1,58 @@
+#include <algorithm>
+#include <cstring>
+
 #include <Hakool\Utils\hkLogger.h>
+#include <Hakool\Utils\hkHash.h>
 
 #include <Hakool\Core\hkResourceManager.h>
 #include <Hakool\GraphicsOpenGL\hkProgramOpenGL.h>
 #include <Hakool\GraphicsOpenGL\hkShaderOpenGL.h>
+#include <Hakool\GraphicsOpenGL\hkProgramBinaryCacheOpenGL.h>
+#include <Hakool\GraphicsOpenGL\hkGraphicComponentOpenGL.h>
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
 namespace hk
 {
+    namespace
+    {
+      bool
+      UniformSlotLess(const UniformSlotOpenGL& _slot, const uint64& _id)
+      {
+        return _slot.id < _id;
+      }
+
+      uint32
+      ShadowedFloatsSize(const GLenum& _type)
+      {
+        switch (_type)
+        {
+        case GL_FLOAT:
+          return 1;
+        case GL_FLOAT_VEC2:
+          return 2;
+        case GL_FLOAT_VEC3:
+          return 3;
+        case GL_FLOAT_VEC4:
+          return 4;
+        case GL_FLOAT_MAT4:
+          return 16;
+        default:
+          return 0;
+        }
+      }
+    }
+
     ProgramOpenGL::ProgramOpenGL() :
+      _m_uniforms(),
       _m_isReady(false),
-      _m_programId(0)
+      _m_programId(0),
+      _m_pBinaryCache(nullptr),
+      _m_isPending(false),
+      _m_pPendingFragment(nullptr),
+      _m_pPendingVertex(nullptr),
+      _m_pendingKey(0)
     {
       // Intentionally blank.
       return;
@@ -26,7 +67,9 @@ namespace hk
     eRESULT 
     ProgramOpenGL::init(GraphicComponent* _pGraphicComponent)
     {
-      // Intentionally blank
+      _m_pBinaryCache = _pGraphicComponent != nullptr
+        ? &static_cast<GraphicComponentOpenGL*>(_pGraphicComponent)->getProgramCache()
+        : nullptr;
       return eRESULT::kSuccess;
     }
 
@@ -38,7 +81,23 @@ namespace hk
       ResourceManager* _pResourceManager
     )
     {
-      if (_m_isReady)
+      if (submit(_fragment, _vertex, _pResourceManager) != eRESULT::kSuccess)
+      {
+        return eRESULT::kFail;
+      }
+
+      return finish();
+    }
+
+    eRESULT
+    ProgramOpenGL::submit
+    (
+      const String& _fragment, 
+      const String& _vertex, 
+      ResourceManager* _pResourceManager
+    )
+    {
+      if (_m_isReady || _m_isPending)
       {
         Logger::Error("| ProgramGL | Shader is already created.");
 
@@ -79,27 +138,102 @@ namespace hk
         return eRESULT::kFail;
       }
 
-      GLuint programID = glCreateProgram();
-      if (programID == 0)
+      return submit(pFragment, pVertex);
+    }
+
+    eRESULT
+    ProgramOpenGL::submit(ShaderOpenGL* _pFragment, ShaderOpenGL* _pVertex)
+    {
+      if (_m_isReady || _m_isPending)
       {
-        Logger::Error("| ProgramGL | An error occurs creating the program object.");
+        Logger::Error("| ProgramGL | Shader is already created.");
 
         return eRESULT::kFail;
       }
 
-      uint32 fragmentID = *(reinterpret_cast<uint32*>(pFragment->getShaderPtr()));
-      uint32 vertexID = *(reinterpret_cast<uint32*>(pVertex->getShaderPtr()));
-      
-      glAttachShader(programID, static_cast<GLuint>(fragmentID));
-      glAttachShader(programID, static_cast<GLuint>(vertexID));
+      bool isCached = _m_pBinaryCache != nullptr && _m_pBinaryCache->isEnabled();
+      uint64 key = isCached
+        ? _m_pBinaryCache->getKey(_pVertex->getSourceHash(), _pFragment->getSourceHash())
+        : 0;
 
-      glLinkProgram(programID);
+      if (isCached)
+      {
+        GLuint programID = glCreateProgram();
+        if (programID != 0 && _m_pBinaryCache->load(key, programID))
+        {
+          _m_programId = static_cast<uint32>(programID);
+          _reflectUniforms();
+          _m_isReady = !_m_isReady;
+
+          return eRESULT::kSuccess;
+        }
+
+        if (programID != 0)
+        {
+          glDeleteProgram(programID);
+        }
+      }
+
+      GLuint programID = _submitLink(_pFragment, _pVertex, isCached);
+      if (programID == 0)
+      {
+        return eRESULT::kFail;
+      }
+
+      _m_programId = static_cast<uint32>(programID);
+      _m_isPending = true;
+      _m_pPendingFragment = _pFragment;
+      _m_pPendingVertex = _pVertex;
+      _m_pendingKey = isCached ? key : 0;
+
+      return eRESULT::kSuccess;
+    }
+
+    bool
+    ProgramOpenGL::isPending() const
+    {
+      return _m_isPending;
+    }
+
+    bool
+    ProgramOpenGL::isLinkComplete() const
+    {
+      if (!_m_isPending
+          || (!GLEW_KHR_parallel_shader_compile && !GLEW_ARB_parallel_shader_compile))
+      {
+        return true;
+      }
+
+      GLint isComplete = GL_FALSE;
+      glGetProgramiv(_m_programId, GL_COMPLETION_STATUS_KHR, &isComplete);
+      return isComplete == GL_TRUE;
+    }
+
+    eRESULT
+    ProgramOpenGL::finish()
+    {
+      if (!_m_isPending)
+      {
+        return _m_isReady ? eRESULT::kSuccess : eRESULT::kFail;
+      }
+
+      _m_isPending = false;
+      GLuint programID = static_cast<GLuint>(_m_programId);
+      uint32 fragmentID = *(reinterpret_cast<uint32*>(_m_pPendingFragment->getShaderPtr()));
+      uint32 vertexID = *(reinterpret_cast<uint32*>(_m_pPendingVertex->getShaderPtr()));
 
       glGetError();
 
       GLint isLinked;
       glGetProgramiv(programID, GL_LINK_STATUS, &isLinked);
-      if (isLinked != 1)
+
+      // Both are checked, their logs explain most link failures.
+      bool isFragmentCompiled = _m_pPendingFragment->finishCompile() == eRESULT::kSuccess;
+      bool isVertexCompiled = _m_pPendingVertex->finishCompile() == eRESULT::kSuccess;
+      _m_pPendingFragment = nullptr;
+      _m_pPendingVertex = nullptr;
+
+      if (isLinked != 1 || !isFragmentCompiled || !isVertexCompiled)
       {
         Logger::Error("| ProgramGL | Failed to link program");
 
@@ -111,7 +245,7 @@ namespace hk
         {
           char* msg = (char*)malloc(length);
 
-          glGetShaderInfoLog(programID, length, &charWritten, msg);
+          glGetProgramInfoLog(programID, length, &charWritten, msg);
           if (msg != 0)
           {
             Logger::Error("| ProgramGL | Program Log: \n\n" + String(msg));
@@ -120,11 +254,21 @@ namespace hk
         }
 
         glDeleteProgram(programID);
+        _m_programId = 0;
 
         return eRESULT::kFail;
       }
 
-      _m_programId = static_cast<uint32>(programID);
+      // The linked program keeps its binary, the shaders can be detached.
+      glDetachShader(programID, static_cast<GLuint>(fragmentID));
+      glDetachShader(programID, static_cast<GLuint>(vertexID));
+
+      if (_m_pBinaryCache != nullptr && _m_pBinaryCache->isEnabled())
+      {
+        _m_pBinaryCache->store(_m_pendingKey, programID);
+      }
+
+      _reflectUniforms();
       _m_isReady = !_m_isReady;
 
       return eRESULT::kSuccess;
@@ -145,14 +289,226 @@ namespace hk
     void 
     ProgramOpenGL::destroy()
     {
-      if (_m_isReady)
+      if (_m_isReady || _m_isPending)
       {
         glDeleteProgram(_m_programId);
-        _m_isReady = !_m_isReady;
       }
 
+      _m_isReady = false;
+      _m_isPending = false;
+      _m_pPendingFragment = nullptr;
+      _m_pPendingVertex = nullptr;
       _m_programId = 0;
+      _m_uniforms.clear();
 
       return;
     }
+
+    uint32
+    ProgramOpenGL::_submitLink
+    (
+      ShaderOpenGL* _pFragment,
+      ShaderOpenGL* _pVertex,
+      const bool& _isRetrievable
+    )
+    {
+      if (_pFragment->submitCompile() != eRESULT::kSuccess
+          || _pVertex->submitCompile() != eRESULT::kSuccess)
+      {
+        Logger::Error("| ProgramGL | Failed to compile the shaders of the program.");
+
+        return 0;
+      }
+
+      GLuint programID = glCreateProgram();
+      if (programID == 0)
+      {
+        Logger::Error("| ProgramGL | An error occurs creating the program object.");
+
+        return 0;
+      }
+
+      uint32 fragmentID = *(reinterpret_cast<uint32*>(_pFragment->getShaderPtr()));
+      uint32 vertexID = *(reinterpret_cast<uint32*>(_pVertex->getShaderPtr()));
+      
+      glAttachShader(programID, static_cast<GLuint>(fragmentID));
+      glAttachShader(programID, static_cast<GLuint>(vertexID));
+
+      if (_isRetrievable)
+      {
+        glProgramParameteri(programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+      }
+
+      // The shaders may still be compiling, the driver links after them.
+      glLinkProgram(programID);
+
+      return static_cast<uint32>(programID);
+    }
+
+    uint64
+    ProgramOpenGL::UniformId(const String& _name)
+    {
+      return Hash::Fnv1a(_name.data(), _name.size());
+    }
+
+    int32
+    ProgramOpenGL::getUniformLocation(const uint64& _id) const
+    {
+      auto it = std::lower_bound
+      (
+        _m_uniforms.begin(),
+        _m_uniforms.end(),
+        _id,
+        UniformSlotLess
+      );
+
+      if (it == _m_uniforms.end() || it->id != _id)
+      {
+        return -1;
+      }
+
+      return it->location;
+    }
+
+    bool
+    ProgramOpenGL::setUniform(const uint64& _id, const Matrix4& _value)
+    {
+      UniformSlotOpenGL* pSlot = _findUniform(_id);
+      if (pSlot == nullptr || !_updateShadow(*pSlot, _value.a, 16))
+      {
+        return false;
+      }
+
+      glProgramUniformMatrix4fv(_m_programId, pSlot->location, 1, GL_FALSE, _value.a);
+      return true;
+    }
+
+    bool
+    ProgramOpenGL::setUniform(const uint64& _id, const Vector3f& _value)
+    {
+      float value[3] = { _value.x, _value.y, _value.z };
+
+      UniformSlotOpenGL* pSlot = _findUniform(_id);
+      if (pSlot == nullptr || !_updateShadow(*pSlot, value, 3))
+      {
+        return false;
+      }
+
+      glProgramUniform3fv(_m_programId, pSlot->location, 1, value);
+      return true;
+    }
+
+    void
+    ProgramOpenGL::_reflectUniforms()
+    {
+      _m_uniforms.clear();
+
+      GLint uniformsSize = 0;
+      GLint maxNameLength = 0;
+      glGetProgramiv(_m_programId, GL_ACTIVE_UNIFORMS, &uniformsSize);
+      glGetProgramiv(_m_programId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+      if (uniformsSize <= 0 || maxNameLength <= 0)
+      {
+        return;
+      }
+
+      String name(static_cast<hkSize>(maxNameLength), '\0');
+      _m_uniforms.reserve(static_cast<hkSize>(uniformsSize));
+
+      for (GLint i = 0; i < uniformsSize; ++i)
+      {
+        GLsizei nameLength = 0;
+        GLint arraySize = 0;
+        GLenum type = 0;
+        glGetActiveUniform
+        (
+          _m_programId,
+          static_cast<GLuint>(i),
+          maxNameLength,
+          &nameLength,
+          &arraySize,
+          &type,
+          &name[0]
+        );
+
+        String uniformName(name.data(), static_cast<hkSize>(nameLength));
+        GLint location = glGetUniformLocation(_m_programId, uniformName.c_str());
+
+        // Uniforms of blocks have no location.
+        if (location < 0)
+        {
+          continue;
+        }
+
+        // Arrays are reported as "name[0]", they are looked up by their name.
+        if (uniformName.size() > 3
+            && 0 == uniformName.compare(uniformName.size() - 3, 3, "[0]"))
+        {
+          uniformName.resize(uniformName.size() - 3);
+        }
+
+        UniformSlotOpenGL slot;
+        slot.id = UniformId(uniformName);
+        slot.location = static_cast<int32>(location);
+        slot.type = static_cast<uint32>(type);
+        slot.floatsSize = arraySize == 1 ? ShadowedFloatsSize(type) : 0;
+        slot.hasValue = false;
+        std::memset(slot.value, 0, sizeof(slot.value));
+        _m_uniforms.push_back(slot);
+      }
+
+      std::sort
+      (
+        _m_uniforms.begin(),
+        _m_uniforms.end(),
+        [](const UniformSlotOpenGL& _a, const UniformSlotOpenGL& _b)
+        {
+          return _a.id < _b.id;
+        }
+      );
+    }
+
+    UniformSlotOpenGL*
+    ProgramOpenGL::_findUniform(const uint64& _id)
+    {
+      auto it = std::lower_bound
+      (
+        _m_uniforms.begin(),
+        _m_uniforms.end(),
+        _id,
+        UniformSlotLess
+      );
+
+      if (it == _m_uniforms.end() || it->id != _id)
+      {
+        return nullptr;
+      }
+
+      return &(*it);
+    }
+
+    bool
+    ProgramOpenGL::_updateShadow
+    (
+      UniformSlotOpenGL& _slot,
+      const float* _value,
+      const uint32& _floatsSize
+    )
+    {
+      // Not shadowed, or uploaded with a different type: always upload.
+      if (_slot.floatsSize != _floatsSize)
+      {
+        return true;
+      }
+
+      hkSize bytes = sizeof(float) * _floatsSize;
+      if (_slot.hasValue && 0 == std::memcmp(_slot.value, _value, bytes))
+      {
+        return false;
+      }
+
+      std::memcpy(_slot.value, _value, bytes);
+      _slot.hasValue = true;
+      return true;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,232 @@
+#include <Hakool\GraphicsOpenGL\hkRingBufferOpenGL.h>
+
+#include <Hakool\Utils\hkLogger.h>
+#include <Hakool\GraphicsOpenGL\hkStateCacheOpenGL.h>
+
+namespace hk
+{
+  namespace
+  {
+    /**
+    * Timeout of each wait on a fence, in nanoseconds.
+    */
+    const GLuint64 kFenceWaitTimeout = 1000000;
+
+    hkSize
+    AlignUp(const hkSize& value, const hkSize& alignment)
+    {
+      return (value + alignment - 1) & ~(alignment - 1);
+    }
+  }
+
+  RingBufferOpenGL::RingBufferOpenGL() :
+    _m_buffer(0),
+    _m_pMapped(nullptr),
+    _m_regionSize(0),
+    _m_regionsSize(0),
+    _m_region(0),
+    _m_head(0),
+    _m_uniformAlignment(256),
+    _m_fences(),
+    _m_pClock(nullptr),
+    _m_stats(),
+    _m_pStateCache(nullptr)
+  { }
+
+  RingBufferOpenGL::~RingBufferOpenGL()
+  {
+    destroy();
+  }
+
+  eRESULT
+  RingBufferOpenGL::init
+  (
+    StateCacheOpenGL& stateCache,
+    const hkSize& regionSize,
+    const uint32& regionsSize
+  )
+  {
+    if (_m_pMapped != nullptr)
+    {
+      Logger::Error("| RingBufferOpenGL | The buffer is already created.");
+      return eRESULT::kFail;
+    }
+
+    if (!GLEW_ARB_buffer_storage)
+    {
+      Logger::Error("| RingBufferOpenGL | GL_ARB_buffer_storage is not supported.");
+      return eRESULT::kFail;
+    }
+
+    if (0 == regionSize || 0 == regionsSize)
+    {
+      Logger::Error("| RingBufferOpenGL | The buffer size must not be zero.");
+      return eRESULT::kFail;
+    }
+
+    GLint uniformAlignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+    if (uniformAlignment > 0)
+    {
+      _m_uniformAlignment = static_cast<hkSize>(uniformAlignment);
+    }
+
+    // Keep every region aligned for any allocation.
+    _m_regionSize = AlignUp(regionSize, _m_uniformAlignment);
+    _m_regionsSize = regionsSize;
+
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    GLsizeiptr totalSize = static_cast<GLsizeiptr>(_m_regionSize * _m_regionsSize);
+
+    _m_pStateCache = &stateCache;
+    glGenBuffers(1, &_m_buffer);
+    stateCache.bindBuffer(GL_COPY_WRITE_BUFFER, _m_buffer);
+    glBufferStorage(GL_COPY_WRITE_BUFFER, totalSize, nullptr, flags);
+    _m_pMapped = static_cast<uint8*>
+    (
+      glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, totalSize, flags)
+    );
+
+    if (_m_pMapped == nullptr)
+    {
+      Logger::Error("| RingBufferOpenGL | Cannot map the buffer.");
+      stateCache.deleteBuffer(_m_buffer);
+      return eRESULT::kFail;
+    }
+
+    _m_fences.assign(_m_regionsSize, nullptr);
+    _m_region = _m_regionsSize - 1;
+    _m_head = 0;
+    _m_pClock = Clock::Create();
+    _m_stats = RingBufferStatsOpenGL();
+    return eRESULT::kSuccess;
+  }
+
+  void
+  RingBufferOpenGL::beginFrame()
+  {
+    _m_region = (_m_region + 1) % _m_regionsSize;
+    _m_head = 0;
+    ++_m_stats.frames;
+
+    GLsync& fence = _m_fences[_m_region];
+    if (fence == nullptr)
+    {
+      return;
+    }
+
+    GLenum status = glClientWaitSync(fence, 0, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+    {
+      // The GPU is still reading this region, a frame too many is in flight.
+      ++_m_stats.stalls;
+      _m_pClock->restart();
+      do
+      {
+        status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, kFenceWaitTimeout);
+      }
+      while (status == GL_TIMEOUT_EXPIRED);
+      _m_stats.stallMicroseconds += _m_pClock->getElapsedTime().asMicroseconds();
+
+      if (status == GL_WAIT_FAILED)
+      {
+        Logger::Error("| RingBufferOpenGL | Failed to wait for a frame fence.");
+      }
+    }
+
+    glDeleteSync(fence);
+    fence = nullptr;
+  }
+
+  void
+  RingBufferOpenGL::endFrame()
+  {
+    GLsync& fence = _m_fences[_m_region];
+    if (fence != nullptr)
+    {
+      glDeleteSync(fence);
+    }
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    _m_stats.allocatedBytes = _m_head;
+    _m_stats.peakAllocatedBytes = Math::Max(_m_stats.peakAllocatedBytes, _m_head);
+  }
+
+  RingAllocationOpenGL
+  RingBufferOpenGL::allocate(const hkSize& size, const hkSize& alignment)
+  {
+    RingAllocationOpenGL allocation;
+    allocation.pData = nullptr;
+    allocation.offset = 0;
+    allocation.size = 0;
+
+    hkSize head = AlignUp(_m_head, alignment);
+    if (_m_pMapped == nullptr || head + size > _m_regionSize)
+    {
+      ++_m_stats.overflows;
+      return allocation;
+    }
+
+    allocation.offset = _m_region * _m_regionSize + head;
+    allocation.pData = _m_pMapped + allocation.offset;
+    allocation.size = size;
+    _m_head = head + size;
+    return allocation;
+  }
+
+  RingAllocationOpenGL
+  RingBufferOpenGL::allocateUniforms(const hkSize& size)
+  {
+    return allocate(size, _m_uniformAlignment);
+  }
+
+  uint32
+  RingBufferOpenGL::getBuffer() const
+  {
+    return _m_buffer;
+  }
+
+  const RingBufferStatsOpenGL&
+  RingBufferOpenGL::getStats() const
+  {
+    return _m_stats;
+  }
+
+  bool
+  RingBufferOpenGL::isReady() const
+  {
+    return _m_pMapped != nullptr;
+  }
+
+  void
+  RingBufferOpenGL::destroy()
+  {
+    for (GLsync& fence : _m_fences)
+    {
+      if (fence != nullptr)
+      {
+        glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        glDeleteSync(fence);
+        fence = nullptr;
+      }
+    }
+    _m_fences.clear();
+
+    if (_m_buffer != 0)
+    {
+      if (_m_pMapped != nullptr)
+      {
+        _m_pStateCache->bindBuffer(GL_COPY_WRITE_BUFFER, _m_buffer);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        _m_pMapped = nullptr;
+      }
+      _m_pStateCache->deleteBuffer(_m_buffer);
+    }
+
+    if (_m_pClock != nullptr)
+    {
+      delete _m_pClock;
+      _m_pClock = nullptr;
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include <Hakool\GraphicsOpenGL\hkShaderCompilerOpenGL.h>
+
+#include <algorithm>
+
+#include <Hakool\GraphicsOpenGL\hkProgramOpenGL.h>
+
+#include <GL/glew.h>
+
+namespace hk
+{
+  ShaderCompilerOpenGL::ShaderCompilerOpenGL() :
+    _m_pending(),
+    _m_isParallel(false)
+  { }
+
+  void
+  ShaderCompilerOpenGL::init()
+  {
+    // 0xFFFFFFFF lets the driver pick the count of threads.
+    if (GLEW_KHR_parallel_shader_compile)
+    {
+      glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+      _m_isParallel = true;
+    }
+    else if (GLEW_ARB_parallel_shader_compile)
+    {
+      glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+      _m_isParallel = true;
+    }
+    else
+    {
+      _m_isParallel = false;
+    }
+  }
+
+  void
+  ShaderCompilerOpenGL::destroy()
+  {
+    _m_pending.clear();
+    _m_isParallel = false;
+  }
+
+  bool
+  ShaderCompilerOpenGL::isParallel() const
+  {
+    return _m_isParallel;
+  }
+
+  eRESULT
+  ShaderCompilerOpenGL::submit
+  (
+    ProgramOpenGL* pProgram,
+    const String& fragment,
+    const String& vertex,
+    ResourceManager* pResourceManager
+  )
+  {
+    if (pProgram->submit(fragment, vertex, pResourceManager) != eRESULT::kSuccess)
+    {
+      return eRESULT::kFail;
+    }
+
+    if (pProgram->isPending())
+    {
+      _m_pending.push_back(pProgram);
+    }
+    return eRESULT::kSuccess;
+  }
+
+  eRESULT
+  ShaderCompilerOpenGL::submit(ProgramOpenGL* pProgram, ShaderOpenGL* pFragment, ShaderOpenGL* pVertex)
+  {
+    if (pProgram->submit(pFragment, pVertex) != eRESULT::kSuccess)
+    {
+      return eRESULT::kFail;
+    }
+
+    if (pProgram->isPending())
+    {
+      _m_pending.push_back(pProgram);
+    }
+    return eRESULT::kSuccess;
+  }
+
+  uint32
+  ShaderCompilerOpenGL::update()
+  {
+    // A failed program logs its errors and stays not ready.
+    _m_pending.erase
+    (
+      std::remove_if
+      (
+        _m_pending.begin(),
+        _m_pending.end(),
+        [](ProgramOpenGL* _pProgram)
+        {
+          if (!_pProgram->isLinkComplete())
+          {
+            return false;
+          }
+
+          _pProgram->finish();
+          return true;
+        }
+      ),
+      _m_pending.end()
+    );
+
+    return static_cast<uint32>(_m_pending.size());
+  }
+
+  void
+  ShaderCompilerOpenGL::finish()
+  {
+    for (ProgramOpenGL* pProgram : _m_pending)
+    {
+      pProgram->finish();
+    }
+    _m_pending.clear();
+  }
+
+  void
+  ShaderCompilerOpenGL::cancel(ProgramOpenGL* pProgram)
+  {
+    _m_pending.erase
+    (
+      std::remove(_m_pending.begin(), _m_pending.end(), pProgram),
+      _m_pending.end()
+    );
+  }
+
+  uint32
+  ShaderCompilerOpenGL::getPendingSize() const
+  {
+    return static_cast<uint32>(_m_pending.size());
+  }
+}
\ No newline at end of file
@@ -0,0 +1,359 @@
+#include <Hakool\GraphicsOpenGL\hkShaderLibraryOpenGL.h>
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+
+#include <Hakool\Utils\hkLogger.h>
+#include <Hakool\Utils\hkHash.h>
+
+#include <Hakool\GraphicsOpenGL\hkGraphicComponentOpenGL.h>
+#include <Hakool\GraphicsOpenGL\hkProgramOpenGL.h>
+#include <Hakool\GraphicsOpenGL\hkShaderOpenGL.h>
+
+namespace hk
+{
+  namespace
+  {
+    const String kKeywordsPragma = "#pragma hk_keywords";
+
+    /**
+    * Find the pragma of a stage.
+    *
+    * @param begin Receives the position of the pragma.
+    * @param end Receives the end of its line.
+    *
+    * @return False if the stage has no pragma.
+    */
+    bool
+    FindPragma(const String& stage, hkSize& begin, hkSize& end)
+    {
+      begin = stage.find(kKeywordsPragma);
+      if (begin == String::npos)
+      {
+        return false;
+      }
+
+      end = stage.find('\n', begin);
+      if (end == String::npos)
+      {
+        end = stage.size();
+      }
+      return true;
+    }
+  }
+
+  ShaderLibraryOpenGL::ShaderLibraryOpenGL() :
+    _m_sources(),
+    _m_shaders(),
+    _m_programs(),
+    _m_pComponent(nullptr)
+  { }
+
+  ShaderLibraryOpenGL::~ShaderLibraryOpenGL()
+  {
+    destroy();
+  }
+
+  void
+  ShaderLibraryOpenGL::init(GraphicComponentOpenGL* pComponent)
+  {
+    destroy();
+    _m_pComponent = pComponent;
+  }
+
+  void
+  ShaderLibraryOpenGL::destroy()
+  {
+    for (auto& entry : _m_programs)
+    {
+      ProgramOpenGL* pProgram = entry.second;
+      if (pProgram->isPending())
+      {
+        _m_pComponent->getShaderCompiler().cancel(pProgram);
+      }
+      pProgram->destroy();
+      delete pProgram;
+    }
+
+    // The programs are destroyed first, a pending program reads its shaders.
+    for (auto& entry : _m_shaders)
+    {
+      entry.second->destroy();
+      delete entry.second;
+    }
+
+    _m_programs.clear();
+    _m_shaders.clear();
+    _m_sources.clear();
+  }
+
+  uint32
+  ShaderLibraryOpenGL::addSource(const String& name, const String& vertex, const String& fragment)
+  {
+    if (getSourceId(name) != INVALID_SOURCE)
+    {
+      Logger::Error("| ShaderLibraryOpenGL | The source " + name + " already exists.");
+      return INVALID_SOURCE;
+    }
+
+    ShaderSourceOpenGL source;
+    if (!ParseKeywords(vertex, source.keywords) || !ParseKeywords(fragment, source.keywords))
+    {
+      Logger::Error("| ShaderLibraryOpenGL | Invalid keywords in the source " + name + ".");
+      return INVALID_SOURCE;
+    }
+
+    if (source.keywords.size() > MAX_KEYWORDS)
+    {
+      Logger::Error("| ShaderLibraryOpenGL | Too many keywords in the source " + name + ".");
+      return INVALID_SOURCE;
+    }
+
+    source.name = name;
+    source.vertex = vertex;
+    source.fragment = fragment;
+    source.variants.assign(static_cast<hkSize>(1) << source.keywords.size(), nullptr);
+    source.failedVariants.assign(source.variants.size(), false);
+
+    _m_sources.push_back(std::move(source));
+    return static_cast<uint32>(_m_sources.size() - 1);
+  }
+
+  uint32
+  ShaderLibraryOpenGL::getSourceId(const String& name) const
+  {
+    for (hkSize i = 0; i < _m_sources.size(); ++i)
+    {
+      if (_m_sources[i].name == name)
+      {
+        return static_cast<uint32>(i);
+      }
+    }
+    return INVALID_SOURCE;
+  }
+
+  uint32
+  ShaderLibraryOpenGL::getKeywordMask(const uint32& sourceId, const String& keyword) const
+  {
+    if (sourceId >= _m_sources.size())
+    {
+      return 0;
+    }
+
+    const Vector<String>& keywords = _m_sources[sourceId].keywords;
+    for (hkSize i = 0; i < keywords.size(); ++i)
+    {
+      if (keywords[i] == keyword)
+      {
+        return 1u << i;
+      }
+    }
+    return 0;
+  }
+
+  ProgramOpenGL*
+  ShaderLibraryOpenGL::getProgram(const uint32& sourceId, const uint32& keywords)
+  {
+    if (sourceId >= _m_sources.size())
+    {
+      return nullptr;
+    }
+
+    ShaderSourceOpenGL& source = _m_sources[sourceId];
+    uint32 mask = keywords & static_cast<uint32>(source.variants.size() - 1);
+
+    ProgramOpenGL* pProgram = source.variants[mask];
+    if (pProgram != nullptr && pProgram->isReady())
+    {
+      return pProgram;
+    }
+
+    if (pProgram == nullptr)
+    {
+      pProgram = _createVariant(source, mask);
+    }
+
+    // Needed now, it can't wait for the compiler.
+    if (pProgram != nullptr && pProgram->isPending())
+    {
+      _m_pComponent->getShaderCompiler().cancel(pProgram);
+      pProgram->finish();
+    }
+
+    if (pProgram != nullptr && pProgram->isReady())
+    {
+      return pProgram;
+    }
+
+    if (!source.failedVariants[mask])
+    {
+      source.failedVariants[mask] = true;
+      Logger::Error
+      (
+        "| ShaderLibraryOpenGL | The variant " + std::to_string(mask) + " of "
+        + source.name + " failed to compile or link."
+      );
+    }
+    return nullptr;
+  }
+
+  void
+  ShaderLibraryOpenGL::precompile(const uint32& sourceId)
+  {
+    if (sourceId >= _m_sources.size())
+    {
+      return;
+    }
+
+    ShaderSourceOpenGL& source = _m_sources[sourceId];
+    for (uint32 mask = 0; mask < source.variants.size(); ++mask)
+    {
+      if (source.variants[mask] == nullptr)
+      {
+        _createVariant(source, mask);
+      }
+    }
+  }
+
+  uint32
+  ShaderLibraryOpenGL::getProgramsSize() const
+  {
+    return static_cast<uint32>(_m_programs.size());
+  }
+
+  uint32
+  ShaderLibraryOpenGL::getShadersSize() const
+  {
+    return static_cast<uint32>(_m_shaders.size());
+  }
+
+  ProgramOpenGL*
+  ShaderLibraryOpenGL::_createVariant(ShaderSourceOpenGL& source, const uint32& keywords)
+  {
+    ShaderOpenGL* pVertex = _getShader(source.vertex, source.keywords, keywords, true);
+    ShaderOpenGL* pFragment = _getShader(source.fragment, source.keywords, keywords, false);
+    if (pVertex == nullptr || pFragment == nullptr)
+    {
+      Logger::Error("| ShaderLibraryOpenGL | Couldn't create a variant of " + source.name + ".");
+      return nullptr;
+    }
+
+    uint64 vertexHash = pVertex->getSourceHash();
+    uint64 fragmentHash = pFragment->getSourceHash();
+    uint64 key = Hash::Fnv1a(&fragmentHash, sizeof(fragmentHash), vertexHash);
+
+    auto it = _m_programs.find(key);
+    if (it != _m_programs.end())
+    {
+      source.variants[keywords] = it->second;
+      return it->second;
+    }
+
+    ProgramOpenGL* pProgram = new ProgramOpenGL();
+    pProgram->init(_m_pComponent);
+    _m_programs.insert(Map<uint64, ProgramOpenGL*>::value_type(key, pProgram));
+    source.variants[keywords] = pProgram;
+
+    // A failed program is kept, so it isn't compiled again every time.
+    _m_pComponent->getShaderCompiler().submit(pProgram, pFragment, pVertex);
+    return pProgram;
+  }
+
+  ShaderOpenGL*
+  ShaderLibraryOpenGL::_getShader
+  (
+    const String& stage,
+    const Vector<String>& keywords,
+    const uint32& mask,
+    const bool& isVertex
+  )
+  {
+    String text = ExpandStage(stage, keywords, mask);
+    uint64 hash = Hash::Fnv1a(&isVertex, sizeof(isVertex));
+    hash = Hash::Fnv1a(text.data(), text.size(), hash);
+
+    auto it = _m_shaders.find(hash);
+    if (it != _m_shaders.end())
+    {
+      return it->second;
+    }
+
+    ShaderOpenGL* pShader = new ShaderOpenGL();
+    eSHADER_TYPE type = isVertex ? eSHADER_TYPE::kVertex : eSHADER_TYPE::kFragment;
+    if (pShader->create(text.c_str(), type) != eRESULT::kSuccess)
+    {
+      delete pShader;
+      return nullptr;
+    }
+
+    _m_shaders.insert(Map<uint64, ShaderOpenGL*>::value_type(hash, pShader));
+    return pShader;
+  }
+
+  bool
+  ShaderLibraryOpenGL::ParseKeywords(const String& stage, Vector<String>& keywords)
+  {
+    hkSize begin;
+    hkSize end;
+    if (!FindPragma(stage, begin, end))
+    {
+      return true;
+    }
+
+    std::istringstream line(stage.substr(begin + kKeywordsPragma.size(), end - begin - kKeywordsPragma.size()));
+    String keyword;
+    while (line >> keyword)
+    {
+      for (char character : keyword)
+      {
+        if (!(std::isalnum(static_cast<uchar>(character)) || character == '_'))
+        {
+          return false;
+        }
+      }
+
+      // Both stages may declare the same keyword, it has a single bit.
+      if (std::find(keywords.begin(), keywords.end(), keyword) == keywords.end())
+      {
+        keywords.push_back(keyword);
+      }
+    }
+    return true;
+  }
+
+  String
+  ShaderLibraryOpenGL::ExpandStage(const String& stage, const Vector<String>& keywords, const uint32& mask)
+  {
+    hkSize begin;
+    hkSize end;
+    if (!FindPragma(stage, begin, end))
+    {
+      return stage;
+    }
+
+    // Only the keywords this stage declares, so variants that differ in the
+    // keywords of the other stage share it.
+    Vector<String> declared;
+    ParseKeywords(stage, declared);
+
+    String defines;
+    for (hkSize i = 0; i < keywords.size(); ++i)
+    {
+      if ((mask & (1u << i)) != 0
+          && std::find(declared.begin(), declared.end(), keywords[i]) != declared.end())
+      {
+        defines += "#define " + keywords[i] + " 1\n";
+      }
+    }
+
+    // The defines replace the pragma line, the line numbers of the errors
+    // after it shift by the count of defines.
+    String text = stage.substr(0, begin) + defines;
+    if (end < stage.size())
+    {
+      text += stage.substr(end + 1);
+    }
+    return text;
+  }
+}
\ No newline at end of file
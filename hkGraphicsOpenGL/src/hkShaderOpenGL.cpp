@@ -4,14 +4,18 @@
 #include <GLFW/glfw3.h>
 
 #include <Hakool\Utils\hkLogger.h>
+#include <Hakool\Utils\hkHash.h>
 #include <Hakool\GraphicsOpenGL\hkGraphicComponentOpenGL.h>
 
 namespace hk
 {
   ShaderOpenGL::ShaderOpenGL() :
     _m_type(eSHADER_TYPE::kUndefined),
+    _m_source(),
+    _m_sourceHash(0),
     _m_shaderId(0),
-    _m_isReady(false)
+    _m_isReady(false),
+    _m_isCompilePending(false)
   {
     // Intentionally blank
     return;
@@ -46,23 +50,57 @@ namespace hk
       return eRESULT::kFail;
     }
 
-    GLuint shaderID = 0;
+    if (_type != eSHADER_TYPE::kFragment && _type != eSHADER_TYPE::kVertex)
+    {
+      Logger::Error("| ShaderOpenGL | Not supported shader type.");
+      return eRESULT::kFail;
+    }
+
+    if (_pSource == nullptr)
+    {
+      Logger::Error("| ShaderOpenGL | Invalid shader source.");
+      return eRESULT::kFail;
+    }
+
+    _m_source = _pSource;
+    _m_sourceHash = Hash::Fnv1a(_m_source.data(), _m_source.size());
+    _m_isReady = !_m_isReady;
+    _m_type = _type;
+
+    return eRESULT::kSuccess;
+  }
 
-    switch (_type)
+  eRESULT
+  ShaderOpenGL::compile()
+  {
+    if (submitCompile() != eRESULT::kSuccess)
     {
-    case eSHADER_TYPE::kFragment:
-      shaderID = glCreateShader(GL_FRAGMENT_SHADER);
-      break;
+      return eRESULT::kFail;
+    }
 
-    case eSHADER_TYPE::kVertex:
-      shaderID = glCreateShader(GL_VERTEX_SHADER);
-      break;
+    return finishCompile();
+  }
+
+  eRESULT
+  ShaderOpenGL::submitCompile()
+  {
+    if (!_m_isReady)
+    {
+      Logger::Error("| ShaderOpenGL | Shader is not created.");
 
-    default:
-      Logger::Error("| ShaderOpenGL | Not supported shader type.");   
       return eRESULT::kFail;
     }
 
+    if (_m_shaderId != 0)
+    {
+      return eRESULT::kSuccess;
+    }
+
+    GLuint shaderID = glCreateShader
+    (
+      _m_type == eSHADER_TYPE::kFragment ? GL_FRAGMENT_SHADER : GL_VERTEX_SHADER
+    );
+
     if (shaderID == 0)
     {
       Logger::Error("| ShaderOpenGL | An error occurs creating the shader object.");
@@ -70,13 +108,46 @@ namespace hk
       return eRESULT::kFail;
     }   
 
-    glShaderSource(shaderID, 1, &_pSource, NULL);
+    // The status isn't queried here, the driver may compile in the
+    // background until finishCompile.
+    const char* pSource = _m_source.c_str();
+    glShaderSource(shaderID, 1, &pSource, NULL);
     glCompileShader(shaderID);
 
+    _m_shaderId = static_cast<uint32>(shaderID);
+    _m_isCompilePending = true;
+
+    return eRESULT::kSuccess;
+  }
+
+  bool
+  ShaderOpenGL::isCompileComplete() const
+  {
+    if (!_m_isCompilePending
+        || (!GLEW_KHR_parallel_shader_compile && !GLEW_ARB_parallel_shader_compile))
+    {
+      return true;
+    }
+
+    GLint isComplete = GL_FALSE;
+    glGetShaderiv(_m_shaderId, GL_COMPLETION_STATUS_KHR, &isComplete);
+    return isComplete == GL_TRUE;
+  }
+
+  eRESULT
+  ShaderOpenGL::finishCompile()
+  {
+    if (!_m_isCompilePending)
+    {
+      return _m_shaderId != 0 ? eRESULT::kSuccess : eRESULT::kFail;
+    }
+
+    _m_isCompilePending = false;
+
     glGetError();
 
     GLint isCompiled;
-    glGetShaderiv(shaderID, GL_COMPILE_STATUS, &isCompiled);
+    glGetShaderiv(_m_shaderId, GL_COMPILE_STATUS, &isCompiled);
 
     if (isCompiled != 1)
     {
@@ -85,12 +156,12 @@ namespace hk
       int32 length = 0;
       int32 charWritten = 0;
 
-      glGetShaderiv(shaderID, GL_INFO_LOG_LENGTH, &length);
+      glGetShaderiv(_m_shaderId, GL_INFO_LOG_LENGTH, &length);
       if (length > 0)
       {
         char* msg = (char*)malloc(length);
        
-        glGetShaderInfoLog(shaderID, length, &charWritten, msg);
+        glGetShaderInfoLog(_m_shaderId, length, &charWritten, msg);
         if (msg != 0)
         {
           Logger::Error("| ShaderOpenGL | Shader Log: \n\n" + String(msg));
@@ -98,17 +169,26 @@ namespace hk
         free(msg);
       }
 
-      glDeleteShader(shaderID);
+      glDeleteShader(_m_shaderId);
+      _m_shaderId = 0;
       return eRESULT::kFail;
     }
 
-    _m_shaderId = static_cast<uint32>(shaderID);
-    _m_isReady = !_m_isReady;
-    _m_type = _type;
-
     return eRESULT::kSuccess;
   }
 
+  bool
+  ShaderOpenGL::isCompiled() const
+  {
+    return _m_shaderId != 0 && !_m_isCompilePending;
+  }
+
+  uint64
+  ShaderOpenGL::getSourceHash() const
+  {
+    return _m_sourceHash;
+  }
+
   bool 
   ShaderOpenGL::isReady()
   {
@@ -118,14 +198,17 @@ namespace hk
   void
   ShaderOpenGL::destroy()
   {
-    if (_m_isReady)
+    if (_m_shaderId != 0)
     {
       glDeleteShader(_m_shaderId);
-      _m_isReady = !_m_isReady;
     }
 
+    _m_isReady = false;
+    _m_isCompilePending = false;
     _m_shaderId = 0;
     _m_type = eSHADER_TYPE::kUndefined;
+    _m_source.clear();
+    _m_sourceHash = 0;
 
     return;
   }
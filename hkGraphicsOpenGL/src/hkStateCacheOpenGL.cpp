@@ -0,0 +1,195 @@
+#include <Hakool\GraphicsOpenGL\hkStateCacheOpenGL.h>
+
+namespace hk
+{
+  StateCacheOpenGL::StateCacheOpenGL() :
+    _m_tracker()
+  { }
+
+  void
+  StateCacheOpenGL::invalidate()
+  {
+    _m_tracker.invalidate();
+  }
+
+  bool
+  StateCacheOpenGL::useProgram(const GLuint& program)
+  {
+    if (_m_tracker.useProgram(program))
+    {
+      glUseProgram(program);
+      return true;
+    }
+    return false;
+  }
+
+  bool
+  StateCacheOpenGL::bindVertexArray(const GLuint& vertexArray)
+  {
+    if (_m_tracker.bindVertexArray(vertexArray))
+    {
+      glBindVertexArray(vertexArray);
+      return true;
+    }
+    return false;
+  }
+
+  bool
+  StateCacheOpenGL::bindBuffer(const GLenum& target, const GLuint& buffer)
+  {
+    if (_m_tracker.bindBuffer(target, buffer))
+    {
+      glBindBuffer(target, buffer);
+      return true;
+    }
+    return false;
+  }
+
+  bool
+  StateCacheOpenGL::enable(const GLenum& capability)
+  {
+    if (_m_tracker.setCapability(capability, true))
+    {
+      glEnable(capability);
+      return true;
+    }
+    return false;
+  }
+
+  bool
+  StateCacheOpenGL::disable(const GLenum& capability)
+  {
+    if (_m_tracker.setCapability(capability, false))
+    {
+      glDisable(capability);
+      return true;
+    }
+    return false;
+  }
+
+  bool
+  StateCacheOpenGL::depthFunc(const GLenum& function)
+  {
+    if (_m_tracker.setDepthFunc(function))
+    {
+      glDepthFunc(function);
+      return true;
+    }
+    return false;
+  }
+
+  bool
+  StateCacheOpenGL::depthMask(const bool& enabled)
+  {
+    if (_m_tracker.setDepthMask(enabled))
+    {
+      glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+      return true;
+    }
+    return false;
+  }
+
+  bool
+  StateCacheOpenGL::blendFunc(const GLenum& source, const GLenum& destination)
+  {
+    if (_m_tracker.setBlendFunc(source, destination))
+    {
+      glBlendFunc(source, destination);
+      return true;
+    }
+    return false;
+  }
+
+  bool
+  StateCacheOpenGL::cullFace(const GLenum& face)
+  {
+    if (_m_tracker.setCullFace(face))
+    {
+      glCullFace(face);
+      return true;
+    }
+    return false;
+  }
+
+  bool
+  StateCacheOpenGL::viewport
+  (
+    const int32& x,
+    const int32& y,
+    const int32& width,
+    const int32& height
+  )
+  {
+    if (_m_tracker.setViewport(x, y, width, height))
+    {
+      glViewport(x, y, width, height);
+      return true;
+    }
+    return false;
+  }
+
+  bool
+  StateCacheOpenGL::clearColor(const float& r, const float& g, const float& b, const float& a)
+  {
+    if (_m_tracker.setClearColor(r, g, b, a))
+    {
+      glClearColor(r, g, b, a);
+      return true;
+    }
+    return false;
+  }
+
+  bool
+  StateCacheOpenGL::enableVertexAttribArray(const GLuint& index)
+  {
+    if (_m_tracker.setVertexAttribArray(index, true))
+    {
+      glEnableVertexAttribArray(index);
+      return true;
+    }
+    return false;
+  }
+
+  bool
+  StateCacheOpenGL::disableVertexAttribArray(const GLuint& index)
+  {
+    if (_m_tracker.setVertexAttribArray(index, false))
+    {
+      glDisableVertexAttribArray(index);
+      return true;
+    }
+    return false;
+  }
+
+  void
+  StateCacheOpenGL::deleteBuffer(GLuint& buffer)
+  {
+    if (0 == buffer)
+    {
+      return;
+    }
+
+    glDeleteBuffers(1, &buffer);
+    _m_tracker.onBufferDeleted(buffer);
+    buffer = 0;
+  }
+
+  void
+  StateCacheOpenGL::deleteVertexArray(GLuint& vertexArray)
+  {
+    if (0 == vertexArray)
+    {
+      return;
+    }
+
+    glDeleteVertexArrays(1, &vertexArray);
+    _m_tracker.onVertexArrayDeleted(vertexArray);
+    vertexArray = 0;
+  }
+
+  StateTrackerOpenGL&
+  StateCacheOpenGL::getTracker()
+  {
+    return _m_tracker;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,328 @@
+#include <Hakool\GraphicsOpenGL\hkStateTrackerOpenGL.h>
+
+namespace hk
+{
+  namespace
+  {
+    const uint32 kBufferSlotsSize = 6;
+
+    const uint32 kCapabilitySlotsSize = 4;
+
+    /**
+    * Slot of GL_ELEMENT_ARRAY_BUFFER, which follows the vertex array object.
+    */
+    const int32 kElementArraySlot = 1;
+  }
+
+  StateTrackerOpenGL::StateTrackerOpenGL() :
+    _m_program(0),
+    _m_isProgramKnown(false),
+    _m_vertexArray(0),
+    _m_isVertexArrayKnown(false),
+    _m_buffers(),
+    _m_areBuffersKnown(),
+    _m_capabilities(),
+    _m_depthFunc(0),
+    _m_depthMask(-1),
+    _m_blendSource(0),
+    _m_blendDestination(0),
+    _m_cullFace(0),
+    _m_viewport(),
+    _m_isViewportKnown(false),
+    _m_clearColor(),
+    _m_isClearColorKnown(false),
+    _m_vertexArrays(),
+    _m_issuedCalls(0),
+    _m_filteredCalls(0)
+  {
+    invalidate();
+  }
+
+  void
+  StateTrackerOpenGL::invalidate()
+  {
+    _m_isProgramKnown = false;
+    _m_isVertexArrayKnown = false;
+    for (uint32 i = 0; i < kBufferSlotsSize; ++i)
+    {
+      _m_areBuffersKnown[i] = false;
+    }
+    for (uint32 i = 0; i < kCapabilitySlotsSize; ++i)
+    {
+      _m_capabilities[i] = -1;
+    }
+
+    // Zero is never a valid value of these enums.
+    _m_depthFunc = 0;
+    _m_depthMask = -1;
+    _m_blendSource = 0;
+    _m_blendDestination = 0;
+    _m_cullFace = 0;
+    _m_isViewportKnown = false;
+    _m_isClearColorKnown = false;
+    _m_vertexArrays.clear();
+  }
+
+  bool
+  StateTrackerOpenGL::useProgram(const GLuint& program)
+  {
+    bool isRedundant = _m_isProgramKnown && _m_program == program;
+    _m_program = program;
+    _m_isProgramKnown = true;
+    return _count(isRedundant);
+  }
+
+  bool
+  StateTrackerOpenGL::bindVertexArray(const GLuint& vertexArray)
+  {
+    bool isRedundant = _m_isVertexArrayKnown && _m_vertexArray == vertexArray;
+    if (!isRedundant)
+    {
+      _m_areBuffersKnown[kElementArraySlot] = false;
+    }
+
+    _m_vertexArray = vertexArray;
+    _m_isVertexArrayKnown = true;
+    return _count(isRedundant);
+  }
+
+  bool
+  StateTrackerOpenGL::bindBuffer(const GLenum& target, const GLuint& buffer)
+  {
+    int32 slot = BufferSlot(target);
+    if (slot < 0)
+    {
+      return _count(false);
+    }
+
+    bool isRedundant = _m_areBuffersKnown[slot] && _m_buffers[slot] == buffer;
+    _m_buffers[slot] = buffer;
+    _m_areBuffersKnown[slot] = true;
+    return _count(isRedundant);
+  }
+
+  bool
+  StateTrackerOpenGL::setCapability(const GLenum& capability, const bool& enabled)
+  {
+    int32 slot = CapabilitySlot(capability);
+    if (slot < 0)
+    {
+      return _count(false);
+    }
+
+    int8 value = enabled ? 1 : 0;
+    bool isRedundant = _m_capabilities[slot] == value;
+    _m_capabilities[slot] = value;
+    return _count(isRedundant);
+  }
+
+  bool
+  StateTrackerOpenGL::setDepthFunc(const GLenum& function)
+  {
+    bool isRedundant = _m_depthFunc == function;
+    _m_depthFunc = function;
+    return _count(isRedundant);
+  }
+
+  bool
+  StateTrackerOpenGL::setDepthMask(const bool& enabled)
+  {
+    int8 value = enabled ? 1 : 0;
+    bool isRedundant = _m_depthMask == value;
+    _m_depthMask = value;
+    return _count(isRedundant);
+  }
+
+  bool
+  StateTrackerOpenGL::setBlendFunc(const GLenum& source, const GLenum& destination)
+  {
+    // GL_ZERO is a valid factor, so an unknown function is marked by both
+    // factors being zero, which nobody sets.
+    bool isKnown = _m_blendSource != 0 || _m_blendDestination != 0;
+    bool isRedundant = isKnown
+      && _m_blendSource == source
+      && _m_blendDestination == destination;
+    _m_blendSource = source;
+    _m_blendDestination = destination;
+    return _count(isRedundant);
+  }
+
+  bool
+  StateTrackerOpenGL::setCullFace(const GLenum& face)
+  {
+    bool isRedundant = _m_cullFace == face;
+    _m_cullFace = face;
+    return _count(isRedundant);
+  }
+
+  bool
+  StateTrackerOpenGL::setViewport
+  (
+    const int32& x,
+    const int32& y,
+    const int32& width,
+    const int32& height
+  )
+  {
+    bool isRedundant = _m_isViewportKnown
+      && _m_viewport[0] == x
+      && _m_viewport[1] == y
+      && _m_viewport[2] == width
+      && _m_viewport[3] == height;
+    _m_viewport[0] = x;
+    _m_viewport[1] = y;
+    _m_viewport[2] = width;
+    _m_viewport[3] = height;
+    _m_isViewportKnown = true;
+    return _count(isRedundant);
+  }
+
+  bool
+  StateTrackerOpenGL::setClearColor(const float& r, const float& g, const float& b, const float& a)
+  {
+    bool isRedundant = _m_isClearColorKnown
+      && _m_clearColor[0] == r
+      && _m_clearColor[1] == g
+      && _m_clearColor[2] == b
+      && _m_clearColor[3] == a;
+    _m_clearColor[0] = r;
+    _m_clearColor[1] = g;
+    _m_clearColor[2] = b;
+    _m_clearColor[3] = a;
+    _m_isClearColorKnown = true;
+    return _count(isRedundant);
+  }
+
+  bool
+  StateTrackerOpenGL::setVertexAttribArray(const GLuint& index, const bool& enabled)
+  {
+    if (!_m_isVertexArrayKnown || index >= 32)
+    {
+      return _count(false);
+    }
+
+    VertexArrayState& state = _m_vertexArrays[_m_vertexArray];
+    uint32 bit = 1u << index;
+    bool isRedundant = (state.knownMask & bit) != 0
+      && ((state.enabledMask & bit) != 0) == enabled;
+
+    state.knownMask |= bit;
+    if (enabled)
+    {
+      state.enabledMask |= bit;
+    }
+    else
+    {
+      state.enabledMask &= ~bit;
+    }
+    return _count(isRedundant);
+  }
+
+  void
+  StateTrackerOpenGL::onBufferDeleted(const GLuint& buffer)
+  {
+    if (0 == buffer)
+    {
+      return;
+    }
+
+    for (uint32 i = 0; i < kBufferSlotsSize; ++i)
+    {
+      if (_m_areBuffersKnown[i] && _m_buffers[i] == buffer)
+      {
+        _m_buffers[i] = 0;
+      }
+    }
+
+    // It may still be the index buffer of a vertex array object that isn't
+    // bound, which is not tracked.
+  }
+
+  void
+  StateTrackerOpenGL::onVertexArrayDeleted(const GLuint& vertexArray)
+  {
+    if (0 == vertexArray)
+    {
+      return;
+    }
+
+    _m_vertexArrays.erase(vertexArray);
+    if (_m_isVertexArrayKnown && _m_vertexArray == vertexArray)
+    {
+      _m_vertexArray = 0;
+      _m_areBuffersKnown[kElementArraySlot] = false;
+    }
+  }
+
+  uint32
+  StateTrackerOpenGL::getIssuedCalls() const
+  {
+    return _m_issuedCalls;
+  }
+
+  uint32
+  StateTrackerOpenGL::getFilteredCalls() const
+  {
+    return _m_filteredCalls;
+  }
+
+  void
+  StateTrackerOpenGL::resetCounters()
+  {
+    _m_issuedCalls = 0;
+    _m_filteredCalls = 0;
+  }
+
+  bool
+  StateTrackerOpenGL::_count(const bool& isRedundant)
+  {
+    if (isRedundant)
+    {
+      ++_m_filteredCalls;
+      return false;
+    }
+
+    ++_m_issuedCalls;
+    return true;
+  }
+
+  int32
+  StateTrackerOpenGL::BufferSlot(const GLenum& target)
+  {
+    switch (target)
+    {
+    case GL_ARRAY_BUFFER:
+      return 0;
+    case GL_ELEMENT_ARRAY_BUFFER:
+      return kElementArraySlot;
+    case GL_COPY_READ_BUFFER:
+      return 2;
+    case GL_COPY_WRITE_BUFFER:
+      return 3;
+    case GL_DRAW_INDIRECT_BUFFER:
+      return 4;
+    case GL_UNIFORM_BUFFER:
+      return 5;
+    default:
+      return -1;
+    }
+  }
+
+  int32
+  StateTrackerOpenGL::CapabilitySlot(const GLenum& capability)
+  {
+    switch (capability)
+    {
+    case GL_DEPTH_TEST:
+      return 0;
+    case GL_BLEND:
+      return 1;
+    case GL_CULL_FACE:
+      return 2;
+    case GL_SCISSOR_TEST:
+      return 3;
+    default:
+      return -1;
+    }
+  }
+}
\ No newline at end of file
@@ -8,7 +8,9 @@ namespace hk
   WindowOpenGL::WindowOpenGL() :
     _m_observers(),
     _m_pWindow(nullptr),
-    _m_title("")
+    _m_title(""),
+    _m_framebufferWidth(0),
+    _m_framebufferHeight(0)
   { }
 
   WindowOpenGL::~WindowOpenGL()
@@ -40,6 +42,7 @@ namespace hk
     }
 
     glfwMakeContextCurrent(_m_pWindow);
+    _updateFramebufferSize();
     return eRESULT::kSuccess;
   }
 
@@ -105,6 +108,7 @@ namespace hk
   WindowOpenGL::pollEvents()
   {
     glfwPollEvents();
+    _updateFramebufferSize();
   }
 
   void 
@@ -125,6 +129,21 @@ namespace hk
     }
   }
 
+  void
+  WindowOpenGL::makeContextCurrent()
+  {
+    if (_m_pWindow != nullptr)
+    {
+      glfwMakeContextCurrent(_m_pWindow);
+    }
+  }
+
+  void
+  WindowOpenGL::releaseContext()
+  {
+    glfwMakeContextCurrent(nullptr);
+  }
+
   void 
   WindowOpenGL::destroy()
   {
@@ -139,7 +158,7 @@ namespace hk
   }
 
   void 
-  WindowOpenGL::addObserver(const WindowObserver* pObserver)
+  WindowOpenGL::addObserver(WindowObserver* pObserver)
   {
     _m_observers.push_back(pObserver);
   }
@@ -147,35 +166,19 @@ namespace hk
   Vector2u 
   WindowOpenGL::getSize()
   {
-    int width { 0 };
-    int height { 0 };
-    if (_m_pWindow != nullptr)
-    { 
-      glfwGetFramebufferSize(_m_pWindow, &width, &height);
-    }
-    return Vector2u((uint32)width, (uint32)height);
+    return Vector2u(_m_framebufferWidth, _m_framebufferHeight);
   }
 
   uint32 
   WindowOpenGL::getWidth()
   {
-    int width { 0 };
-    if (_m_pWindow != nullptr)
-    {
-      glfwGetFramebufferSize(_m_pWindow, &width, NULL);
-    }
-    return (uint32)width;
+    return _m_framebufferWidth;
   }
 
   uint32 
   WindowOpenGL::getHeight()
   {
-    int height { 0 };
-    if (_m_pWindow != nullptr)
-    {
-      glfwGetFramebufferSize(_m_pWindow, NULL, &height);
-    }
-    return (uint32)height;
+    return _m_framebufferHeight;
   }
 
   String 
@@ -189,4 +192,17 @@ namespace hk
   {
     return _m_pWindow;
   }
+
+  void
+  WindowOpenGL::_updateFramebufferSize()
+  {
+    int width { 0 };
+    int height { 0 };
+    if (_m_pWindow != nullptr)
+    {
+      glfwGetFramebufferSize(_m_pWindow, &width, &height);
+    }
+    _m_framebufferWidth = (uint32)width;
+    _m_framebufferHeight = (uint32)height;
+  }
 }
\ No newline at end of file
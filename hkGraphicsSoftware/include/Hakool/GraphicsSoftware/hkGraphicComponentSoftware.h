@@ -0,0 +1,208 @@
+#pragma once
+
+#include <Hakool\Utils\hkColor.h>
+#include <Hakool\Utils\hkMatrix4.h>
+#include <Hakool\Utils\hkVector3.h>
+#include <Hakool\GraphicsSoftware\hkGraphicsSoftwarePrerequisites.h>
+#include <Hakool\GraphicsSoftware\hkRasterizerSoftware.h>
+#include <Hakool\Core\hkGraphicComponent.h>
+#include <Hakool\Core\hkRenderStats.h>
+
+namespace hk
+{
+  class IWindow;
+  class WindowNull;
+  class MeshSoftware;
+
+  /**
+  * GraphicComponent that rasterizes on the CPU, for machines without a GPU or
+  * a display. Meshes are drawn with the default position color shading into
+  * a framebuffer of the size of the window, which can be read or saved to an
+  * image.
+  */
+  class HK_GRAPHICS_SOFTWARE_EXPORT GraphicComponentSoftware :
+    public GraphicComponent
+  {
+  public:
+
+    /**
+    * Constructor.
+    */
+    GraphicComponentSoftware();
+
+    /**
+    * Destructor.
+    */
+    virtual
+    ~GraphicComponentSoftware();
+
+    virtual eRESULT
+    init(
+      const GraphicsConfiguration& _graphicConfiguration,
+      const WindowConfiguration& windowConfig,
+      ResourceManager& resourceManager) override;
+
+    virtual void
+    clear(const Color& _clearColor) override;
+
+    virtual void
+    prepareToDraw(Camera* pCamera) override;
+
+    /**
+    * Initialize whole queued meshes until the upload budget is reached.
+    */
+    virtual void
+    uploadMeshes() override;
+
+    virtual void
+    drawScene(Scene* pScene) override;
+
+    /**
+    * Rasterize all the packets of the queue at once.
+    */
+    virtual void
+    drawQueue(const RenderQueue& queue) override;
+
+    virtual const RenderStats&
+    getRenderStats() override;
+
+    virtual IMesh*
+    createMesh() override;
+
+    virtual void
+    destroyMesh(IMesh* pMesh) override;
+
+    virtual void
+    setModelMatrix(const Matrix4& modelMatrix) override;
+
+    virtual void
+    setPositionDequantization(const Vector3f& offset, const Vector3f& scale) override;
+
+    virtual IShader*
+    createVertexShader() override;
+
+    virtual IShader*
+    createFragmentShader() override;
+
+    virtual IProgram*
+    createProgram() override;
+
+    virtual IWindow*
+    getWindow() override;
+
+    virtual void
+    destroy() override;
+
+    virtual eGRAPHIC_INTERFACE
+    getGraphicInterfaceId() override;
+
+    virtual void
+    onWindowSizeChanged(
+      const uint32& width,
+      const uint32& height,
+      IWindow* pWindow) override;
+
+    /**
+    * Rasterize a mesh with the current model matrix and dequantization.
+    */
+    void
+    drawMesh(const MeshSoftware* pMesh);
+
+    /**
+    * Get the rasterizer, to read the framebuffer.
+    */
+    const RasterizerSoftware&
+    getRasterizer() const;
+
+    /**
+    * Write the color buffer to an uncompressed 32 bit TGA image.
+    *
+    * @param path The path of the image.
+    *
+    * @return Operation result.
+    */
+    eRESULT
+    saveFramebuffer(const String& path) const;
+
+  private:
+
+    /**
+    * Resize the framebuffer to the size of the window, if it changed.
+    */
+    void
+    _updateSize();
+
+    /**
+    * Add the draw of a mesh to the draws of the rasterizer.
+    */
+    void
+    _addDraw(const MeshSoftware* pMesh, const Matrix4& modelMatrix);
+
+    /**
+    * Get an id for a new mesh, shader or program. Zero is never used.
+    */
+    uint32
+    _nextObjectId();
+
+    RasterizerSoftware
+    _m_rasterizer;
+
+    /**
+    * Draws given to the rasterizer, kept to reuse their memory.
+    */
+    Vector<DrawSoftware>
+    _m_draws;
+
+    /**
+    * Projection and view matrix of the camera, in the order of Matrix4.
+    */
+    Matrix4
+    _m_projViewMatrix;
+
+    /**
+    * Model matrix of drawMesh, in the order of the RenderPackets.
+    */
+    Matrix4
+    _m_modelMatrix;
+
+    Vector3f
+    _m_positionOffset;
+
+    Vector3f
+    _m_positionScale;
+
+    uint32
+    _m_lastObjectId;
+
+    /**
+    * Counters of the last drawQueue call.
+    */
+    RenderStats
+    _m_renderStats;
+
+    /**
+    * Bytes of queued mesh data uploaded each frame, 0 for no limit.
+    */
+    uint32
+    _m_meshUploadBudget;
+
+    /**
+    * Bytes uploaded from the queue by the last uploadMeshes call.
+    */
+    uint32
+    _m_uploadedBytes;
+
+    ResourceManager*
+    _m_pResourceManager;
+
+    /**
+    * The window of the null backend, the framebuffer is read from this
+    * component instead.
+    */
+    WindowNull*
+    _m_pWindow;
+
+    bool
+    _m_isReady;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <Hakool\GraphicsSoftware\hkGraphicsSoftwarePrerequisites.h>
+#include <Hakool\GraphicsSoftware\hkGraphicComponentSoftware.h>
+#include <Hakool\Core\hkGraphicComponentPlugin.h>
+
+namespace hk
+{
+  extern "C"
+  {
+    HK_GRAPHICS_SOFTWARE_EXPORT IPlugin* createGraphicComponentSoftwarePlugin();
+    HK_GRAPHICS_SOFTWARE_EXPORT void destroyGraphicComponentSoftwarePlugin();
+  }
+
+  /**
+  * Creates and provides access to a GraphicComponentSoftware instance.
+  */
+  typedef GraphicComponentPlugin<GraphicComponentSoftware> GraphicsSoftwarePlugin;
+}
\ No newline at end of file
@@ -0,0 +1,5 @@
+#pragma once
+
+#include <Hakool\Utils\hkConfigPlatform.h>
+#include <Hakool\Utils\hkConfigTypes.h>
+#include <Hakool\GraphicsSoftware\hkConfigGraphicsSoftware.h>
\ No newline at end of file
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <Hakool\Core\hkIMesh.h>
+#include <Hakool\GraphicsSoftware\hkGraphicsSoftwarePrerequisites.h>
+
+#include <atomic>
+
+namespace hk
+{
+  class GraphicComponentSoftware;
+
+  /**
+  * Mesh kept in memory for the RasterizerSoftware. Quantized positions are
+  * kept normalized and decoded with the dequantization set when the mesh is
+  * drawn, as the vertex shader of the other graphic components does.
+  */
+  class HK_GRAPHICS_SOFTWARE_EXPORT MeshSoftware : public IMesh
+  {
+  public:
+
+    MeshSoftware(GraphicComponentSoftware* pGraphicComponent, const uint32& id);
+
+    virtual
+    ~MeshSoftware();
+
+    /**
+    * Copy the positions and the indices.
+    */
+    virtual void
+    init(const MeshDescription& description) override;
+
+    /**
+    * Resident from init to destroy.
+    */
+    virtual bool
+    isResident() override;
+
+    virtual void
+    draw(GraphicComponent* pGraphicComponent) override;
+
+    virtual uint32
+    getVertexesSize() override;
+
+    virtual float*
+    getVertexesArray() override;
+
+    virtual uint32
+    getId() override;
+
+    virtual void
+    destroy() override;
+
+    /**
+    * Set the dequantization of this mesh.
+    *
+    * @param pGraphicComponent Pointer to the GraphicComponent.
+    */
+    void
+    bind(GraphicComponent* pGraphicComponent);
+
+    /**
+    * Get the positions, 3 floats per vertex.
+    */
+    const float*
+    getPositions() const;
+
+    /**
+    * Get the count of vertices.
+    */
+    uint32
+    getPositionsSize() const;
+
+    /**
+    * Get the triangle list indices.
+    *
+    * @return The indices, nullptr if the vertices are drawn in order.
+    */
+    const uint32*
+    getIndices() const;
+
+    /**
+    * Get the count of triangles drawn.
+    */
+    uint32
+    getTrianglesSize() const;
+
+  private:
+
+    GraphicComponentSoftware*
+    _m_pGraphicComponent;
+
+    uint32
+    _m_id;
+
+    Vector<float>
+    _m_positions;
+
+    /**
+    * Indices, empty if the mesh isn't indexed.
+    */
+    Vector<uint32>
+    _m_indices;
+
+    bool
+    _m_isQuantized;
+
+    VertexQuantization
+    _m_quantization;
+
+    std::atomic<bool>
+    _m_isResident;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,439 @@
+#pragma once
+
+#include <Hakool\Utils\hkUtilitiesUtilities.h>
+#include <Hakool\Utils\hkColor.h>
+#include <Hakool\Utils\hkMatrix4.h>
+#include <Hakool\Utils\hkVector3.h>
+#include <Hakool\GraphicsSoftware\hkGraphicsSoftwarePrerequisites.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace hk
+{
+  class MeshSoftware;
+
+  /**
+  * A mesh drawn by the RasterizerSoftware.
+  */
+  struct DrawSoftware
+  {
+    const MeshSoftware*
+    pMesh;
+
+    /**
+    * Projection, view and model matrix, in the row major order of Matrix4.
+    */
+    Matrix4
+    matrix;
+
+    Vector3f
+    positionOffset;
+
+    Vector3f
+    positionScale;
+  };
+
+  /**
+  * A vertex transformed to clip space, with its color. Vertices inside the
+  * near plane and the guard band are also projected, once for all of their
+  * triangles.
+  */
+  struct ClipVertexSoftware
+  {
+    float
+    x;
+
+    float
+    y;
+
+    float
+    z;
+
+    float
+    w;
+
+    float
+    r;
+
+    float
+    g;
+
+    float
+    b;
+
+    /**
+    * Bits of the frustum planes the vertex is outside of, and of the planes
+    * it must be clipped against.
+    */
+    uint32
+    clipCodes;
+
+    /**
+    * Position in fixed point pixels, with the top row first.
+    */
+    int32
+    screenX;
+
+    int32
+    screenY;
+
+    float
+    inverseW;
+  };
+
+  /**
+  * A triangle ready to be rasterized, in fixed point screen coordinates.
+  */
+  struct TriangleSoftware
+  {
+    /**
+    * Edge functions, E(x, y) = stepX * x + stepY * y + origin at the center
+    * of the pixel (x, y). A pixel is covered when the 3 are positive or zero.
+    */
+    int32
+    edgeStepX[3];
+
+    int32
+    edgeStepY[3];
+
+    int64
+    edgeOrigin[3];
+
+    /**
+    * Window depth, 1 / w and the color divided by w, as a value at the pixel
+    * (minX, minY) and its steps per pixel.
+    */
+    float
+    planeOrigin[5];
+
+    float
+    planeStepX[5];
+
+    float
+    planeStepY[5];
+
+    /**
+    * Pixels of the bounding box, inclusive and inside the framebuffer.
+    */
+    int32
+    minX;
+
+    int32
+    minY;
+
+    int32
+    maxX;
+
+    int32
+    maxY;
+  };
+
+  /**
+  * Rasterizes triangles on the CPU into a color and a depth buffer.
+  *
+  * The framebuffer is split in tiles of TILE_SIZE pixels. A draw runs in
+  * three passes shared by all the threads: the vertices are transformed, the
+  * triangles are clipped, set up and binned into the tiles they touch, and
+  * then each tile is rasterized by one thread. The threads bin contiguous
+  * ranges of triangles and the tiles read the bins in the same order, so the
+  * triangles of a tile are drawn in submission order and the image doesn't
+  * depend on the count of threads.
+  *
+  * Coverage uses fixed point edge functions with 4 bits of sub pixel
+  * precision and the top left fill rule, evaluated for 4 pixels at once with
+  * SSE2. The depth test is less or equal, as the OpenGL component sets it.
+  *
+  * Only use it from one thread at a time.
+  */
+  class RasterizerSoftware
+  {
+  public:
+
+    static const int32 TILE_SIZE = 64;
+
+    /**
+    * Largest width and height of the framebuffer, so the fixed point edge
+    * functions of the guard band fit in 32 bits inside a tile.
+    */
+    static const uint32 MAX_SIZE = 8192;
+
+    RasterizerSoftware();
+
+    ~RasterizerSoftware();
+
+    /**
+    * Start the threads.
+    *
+    * @param threadsSize Threads that rasterize, including the calling one. 0
+    * uses one per hardware thread.
+    */
+    void
+    init(const uint32& threadsSize);
+
+    /**
+    * Stop the threads and release the framebuffer.
+    */
+    void
+    destroy();
+
+    /**
+    * Resize the framebuffer, its content is undefined until the next clear.
+    * Sizes over MAX_SIZE are clamped.
+    */
+    void
+    resize(const uint32& width, const uint32& height);
+
+    /**
+    * Clear the color buffer to a color and the depth buffer to 1.
+    */
+    void
+    clear(const Color& color);
+
+    /**
+    * Rasterize meshes with the default position color shading.
+    */
+    void
+    draw(const Vector<DrawSoftware>& draws);
+
+    uint32
+    getWidth() const;
+
+    uint32
+    getHeight() const;
+
+    /**
+    * Get the count of pixels between two rows of the buffers.
+    */
+    uint32
+    getPitch() const;
+
+    /**
+    * Get the color buffer, RGBA with 8 bits per channel and the top row
+    * first.
+    */
+    const uint32*
+    getColors() const;
+
+    /**
+    * Get the depth buffer, the window depth in [0, 1] with the top row first.
+    */
+    const float*
+    getDepths() const;
+
+    /**
+    * Get the count of threads, including the calling one.
+    */
+    uint32
+    getThreadsSize() const;
+
+    /**
+    * Get the count of triangles binned by the last draw, after clipping and
+    * culling.
+    */
+    uint32
+    getBinnedTrianglesSize() const;
+
+  private:
+
+    enum class ePASS
+    {
+      kClear,
+      kVertices,
+      kTriangles,
+      kTiles
+    };
+
+    /**
+    * Run a pass on every thread, and wait for all of them.
+    */
+    void
+    _dispatch(const ePASS& pass);
+
+    /**
+    * Run the part of a pass of a thread.
+    */
+    void
+    _runPass(const ePASS& pass, const uint32& thread);
+
+    /**
+    * Loop of the threads other than the calling one.
+    */
+    void
+    _run(const uint32& thread);
+
+    void
+    _clearTiles();
+
+    /**
+    * Transform the vertices of a range of the draws.
+    */
+    void
+    _transformVertices(const uint32& first, const uint32& end);
+
+    /**
+    * Clip, set up and bin a range of the triangles of the draws.
+    */
+    void
+    _binTriangles(const uint32& first, const uint32& end, const uint32& thread);
+
+    /**
+    * Clip a triangle against the near plane and the guard band, and bin the
+    * triangles of the result.
+    */
+    void
+    _clipTriangle(const ClipVertexSoftware* apVertices[3], const uint32& thread);
+
+    /**
+    * Set the clip codes of a vertex, and project it if it's inside the near
+    * plane and the guard band.
+    */
+    void
+    _projectVertex(ClipVertexSoftware& vertex) const;
+
+    /**
+    * Set up and bin a triangle of projected vertices.
+    */
+    void
+    _setupTriangle
+    (
+      const ClipVertexSoftware& v0,
+      const ClipVertexSoftware& v1,
+      const ClipVertexSoftware& v2,
+      const uint32& thread
+    );
+
+    void
+    _rasterizeTiles();
+
+    /**
+    * Rasterize a triangle in the part of its bounding box inside a tile.
+    */
+    void
+    _rasterizeTriangle(const TriangleSoftware& triangle, const int32& tileX, const int32& tileY);
+
+    /**
+    * Get the first of a range of count items split among the threads.
+    */
+    uint32
+    _getRangeStart(const uint32& count, const uint32& thread) const;
+
+    Vector<uint32>
+    _m_colors;
+
+    Vector<float>
+    _m_depths;
+
+    uint32
+    _m_width;
+
+    uint32
+    _m_height;
+
+    uint32
+    _m_pitch;
+
+    uint32
+    _m_tilesX;
+
+    uint32
+    _m_tilesY;
+
+    /**
+    * Clip space bounds of the guard band, in multiples of w.
+    */
+    float
+    _m_guardX;
+
+    float
+    _m_guardY;
+
+    /**
+    * Color the clear pass fills the tiles with.
+    */
+    uint32
+    _m_clearColor;
+
+    /**
+    * Draws of the current draw call, and the first of their vertices and
+    * triangles in the passes.
+    */
+    const Vector<DrawSoftware>*
+    _m_pDraws;
+
+    Vector<uint32>
+    _m_firstVertices;
+
+    Vector<uint32>
+    _m_firstTriangles;
+
+    uint32
+    _m_verticesSize;
+
+    uint32
+    _m_trianglesSize;
+
+    Vector<ClipVertexSoftware>
+    _m_vertices;
+
+    /**
+    * Triangles set up by each thread.
+    */
+    Vector<Vector<TriangleSoftware>>
+    _m_triangles;
+
+    /**
+    * Triangles of each tile set up by each thread, as indices in the
+    * triangles of the thread. The bins of a thread start at thread * tiles.
+    */
+    Vector<Vector<uint32>>
+    _m_bins;
+
+    /**
+    * Next tile of the passes that share the tiles.
+    */
+    std::atomic<uint32>
+    _m_nextTile;
+
+    uint32
+    _m_binnedTrianglesSize;
+
+    Vector<std::thread>
+    _m_threads;
+
+    ePASS
+    _m_pass;
+
+    /**
+    * Incremented for each pass, a thread runs it when it changes.
+    */
+    uint64
+    _m_passIndex;
+
+    /**
+    * Threads still running the current pass.
+    */
+    uint32
+    _m_busyThreads;
+
+    bool
+    _m_stopRequested;
+
+    std::mutex
+    _m_mutex;
+
+    /**
+    * Signaled when a pass or the stop request is given.
+    */
+    std::condition_variable
+    _m_passQueued;
+
+    /**
+    * Signaled when the last thread finishes a pass.
+    */
+    std::condition_variable
+    _m_passDone;
+  };
+}
\ No newline at end of file
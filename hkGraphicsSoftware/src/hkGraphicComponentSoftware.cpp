@@ -0,0 +1,346 @@
+#include <Hakool\GraphicsSoftware\hkGraphicComponentSoftware.h>
+
+#include <fstream>
+
+#include <Hakool\Utils\hkLogger.h>
+#include <Hakool\Utils\hkMath.h>
+#include <Hakool\Utils\hkIWindow.h>
+#include <Hakool\Core\hkCamera.h>
+#include <Hakool\Core\hkResourceManager.h>
+#include <Hakool\Core\hkRenderQueue.h>
+#include <Hakool\GraphicsNull\hkShaderNull.h>
+#include <Hakool\GraphicsNull\hkProgramNull.h>
+#include <Hakool\GraphicsNull\hkWindowNull.h>
+#include <Hakool\GraphicsSoftware\hkMeshSoftware.h>
+
+namespace hk
+{
+  GraphicComponentSoftware::GraphicComponentSoftware() :
+    _m_rasterizer(),
+    _m_draws(),
+    _m_projViewMatrix(Matrix4::GetIdentity()),
+    _m_modelMatrix(Matrix4::GetIdentity()),
+    _m_positionOffset(0.0f, 0.0f, 0.0f),
+    _m_positionScale(1.0f, 1.0f, 1.0f),
+    _m_lastObjectId(0),
+    _m_renderStats(),
+    _m_meshUploadBudget(0),
+    _m_uploadedBytes(0),
+    _m_pResourceManager(nullptr),
+    _m_pWindow(nullptr),
+    _m_isReady(false)
+  { }
+
+  GraphicComponentSoftware::~GraphicComponentSoftware()
+  {
+    destroy();
+  }
+
+  eRESULT
+  GraphicComponentSoftware::init(
+    const GraphicsConfiguration& _graphicConfiguration,
+    const WindowConfiguration& windowConfig,
+    ResourceManager& resourceManager)
+  {
+    if (_m_isReady)
+    {
+      Logger::GetReference().warning("Software GraphicComponent already created.");
+      return eRESULT::kFail;
+    }
+
+    _m_pResourceManager = &resourceManager;
+    _m_meshUploadBudget = _graphicConfiguration.meshUploadBudget;
+    _m_pWindow = new WindowNull(nullptr);
+    _m_pWindow->init(windowConfig);
+
+    _m_rasterizer.init(_graphicConfiguration.rasterizerThreads);
+    _updateSize();
+
+    _m_projViewMatrix = Matrix4::GetIdentity();
+    _m_modelMatrix = Matrix4::GetIdentity();
+    _m_positionOffset = Vector3f(0.0f, 0.0f, 0.0f);
+    _m_positionScale = Vector3f(1.0f, 1.0f, 1.0f);
+
+    _m_pWindow->addObserver(this);
+    _m_isReady = !_m_isReady;
+    return eRESULT::kSuccess;
+  }
+
+  void
+  GraphicComponentSoftware::clear(const Color& _clearColor)
+  {
+    _updateSize();
+    _m_rasterizer.clear(_clearColor);
+  }
+
+  void
+  GraphicComponentSoftware::prepareToDraw(Camera* _camera)
+  {
+    _updateSize();
+    if (_camera == nullptr)
+    {
+      _m_projViewMatrix = Matrix4::GetIdentity();
+      return;
+    }
+
+    if (_m_pWindow->getHeight() > 0)
+    {
+      _camera->setAspectRatio((float)_m_pWindow->getWidth() / (float)_m_pWindow->getHeight());
+    }
+
+    // The other components transpose it for the shaders.
+    _m_projViewMatrix = _camera->getProjectionMatrix() * Matrix4::GetTranslation(_camera->getPosition());
+  }
+
+  void
+  GraphicComponentSoftware::uploadMeshes()
+  {
+    _m_uploadedBytes = 0;
+
+    MeshUploadQueue& queue = _m_pResourceManager->getMeshes().getUploadQueue();
+    MeshUpload upload;
+    while ((0 == _m_meshUploadBudget || _m_uploadedBytes < _m_meshUploadBudget)
+           && queue.pop(upload))
+    {
+      upload.pMesh->init(upload.getDescription());
+      _m_uploadedBytes += static_cast<uint32>(upload.getSize());
+    }
+  }
+
+  void
+  GraphicComponentSoftware::drawScene(Scene* pScene)
+  {
+    return;
+  }
+
+  void
+  GraphicComponentSoftware::drawQueue(const RenderQueue& queue)
+  {
+    _m_renderStats = RenderStats();
+    _m_renderStats.packets = queue.getSize();
+    _m_renderStats.uploadedBytes = _m_uploadedBytes;
+    _m_renderStats.pendingUploads = _m_pResourceManager->getMeshes().getUploadQueue().getSize();
+    if (0 == _m_renderStats.packets)
+    {
+      return;
+    }
+
+    _m_draws.clear();
+    MeshSoftware* pBoundMesh = nullptr;
+    for (uint32 i = 0; i < _m_renderStats.packets; ++i)
+    {
+      const RenderPacket& packet = queue.getPacket(i);
+      MeshSoftware* pMesh = static_cast<MeshSoftware*>(packet.pMesh);
+      if (pMesh != pBoundMesh)
+      {
+        pMesh->bind(this);
+        pBoundMesh = pMesh;
+        ++_m_renderStats.meshBinds;
+      }
+      else
+      {
+        ++_m_renderStats.skippedMeshBinds;
+      }
+
+      _addDraw(pMesh, packet.modelMatrix);
+    }
+
+    // The whole queue is binned and rasterized together.
+    _m_rasterizer.draw(_m_draws);
+    _m_renderStats.drawCalls = 1;
+  }
+
+  const RenderStats&
+  GraphicComponentSoftware::getRenderStats()
+  {
+    return _m_renderStats;
+  }
+
+  IMesh*
+  GraphicComponentSoftware::createMesh()
+  {
+    return new MeshSoftware(this, _nextObjectId());
+  }
+
+  void
+  GraphicComponentSoftware::destroyMesh(IMesh* pMesh)
+  {
+    // The uploads are done as soon as they are taken from the queue.
+    pMesh->destroy();
+    delete pMesh;
+  }
+
+  void
+  GraphicComponentSoftware::setModelMatrix(const Matrix4& modelMatrix)
+  {
+    _m_modelMatrix = modelMatrix;
+  }
+
+  void
+  GraphicComponentSoftware::setPositionDequantization
+  (
+    const Vector3f& offset,
+    const Vector3f& scale
+  )
+  {
+    _m_positionOffset = offset;
+    _m_positionScale = scale;
+  }
+
+  IShader*
+  GraphicComponentSoftware::createVertexShader()
+  {
+    return new ShaderNull(_nextObjectId());
+  }
+
+  IShader*
+  GraphicComponentSoftware::createFragmentShader()
+  {
+    return new ShaderNull(_nextObjectId());
+  }
+
+  IProgram*
+  GraphicComponentSoftware::createProgram()
+  {
+    return new ProgramNull(_nextObjectId());
+  }
+
+  IWindow*
+  GraphicComponentSoftware::getWindow()
+  {
+    return _m_pWindow;
+  }
+
+  void
+  GraphicComponentSoftware::destroy()
+  {
+    if (!_m_isReady)
+    {
+      return;
+    }
+
+    _m_rasterizer.destroy();
+    _m_draws.clear();
+
+    if (_m_pWindow != nullptr)
+    {
+      delete _m_pWindow;
+      _m_pWindow = nullptr;
+    }
+
+    _m_isReady = !_m_isReady;
+    return;
+  }
+
+  eGRAPHIC_INTERFACE
+  GraphicComponentSoftware::getGraphicInterfaceId()
+  {
+    return eGRAPHIC_INTERFACE::kSoftware;
+  }
+
+  void
+  GraphicComponentSoftware::onWindowSizeChanged(
+    const uint32& width,
+    const uint32& height,
+    IWindow* pWindow)
+  {
+    // The framebuffer follows the window size in clear and prepareToDraw.
+    return;
+  }
+
+  void
+  GraphicComponentSoftware::drawMesh(const MeshSoftware* pMesh)
+  {
+    _m_draws.clear();
+    _addDraw(pMesh, _m_modelMatrix);
+    _m_rasterizer.draw(_m_draws);
+  }
+
+  const RasterizerSoftware&
+  GraphicComponentSoftware::getRasterizer() const
+  {
+    return _m_rasterizer;
+  }
+
+  eRESULT
+  GraphicComponentSoftware::saveFramebuffer(const String& path) const
+  {
+    uint32 width = _m_rasterizer.getWidth();
+    uint32 height = _m_rasterizer.getHeight();
+    const uint32* pColors = _m_rasterizer.getColors();
+    if (pColors == nullptr || 0 == width || 0 == height)
+    {
+      Logger::Error("| GraphicComponentSoftware | There is no framebuffer to save.");
+      return eRESULT::kFail;
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+      Logger::Error("| GraphicComponentSoftware | Couldn't write the image: " + path);
+      return eRESULT::kFail;
+    }
+
+    // Uncompressed true color, 8 bits of alpha and the top row first.
+    uchar aHeader[18] = { 0 };
+    aHeader[2] = 2;
+    aHeader[12] = static_cast<uchar>(width & 0xFF);
+    aHeader[13] = static_cast<uchar>(width >> 8);
+    aHeader[14] = static_cast<uchar>(height & 0xFF);
+    aHeader[15] = static_cast<uchar>(height >> 8);
+    aHeader[16] = 32;
+    aHeader[17] = 0x28;
+    file.write(reinterpret_cast<const char*>(aHeader), sizeof(aHeader));
+
+    Vector<uchar> row(static_cast<hkSize>(width) * 4);
+    for (uint32 y = 0; y < height; ++y)
+    {
+      const uint32* pRow = pColors + static_cast<hkSize>(y) * _m_rasterizer.getPitch();
+      for (uint32 x = 0; x < width; ++x)
+      {
+        uint32 color = pRow[x];
+        row[x * 4] = static_cast<uchar>((color >> 16) & 0xFF);
+        row[x * 4 + 1] = static_cast<uchar>((color >> 8) & 0xFF);
+        row[x * 4 + 2] = static_cast<uchar>(color & 0xFF);
+        row[x * 4 + 3] = static_cast<uchar>(color >> 24);
+      }
+      file.write(reinterpret_cast<const char*>(row.data()), row.size());
+    }
+
+    if (!file.good())
+    {
+      Logger::Error("| GraphicComponentSoftware | Couldn't write the image: " + path);
+      return eRESULT::kFail;
+    }
+    return eRESULT::kSuccess;
+  }
+
+  void
+  GraphicComponentSoftware::_updateSize()
+  {
+    uint32 width = Math::Min(_m_pWindow->getWidth(), RasterizerSoftware::MAX_SIZE);
+    uint32 height = Math::Min(_m_pWindow->getHeight(), RasterizerSoftware::MAX_SIZE);
+    if (width != _m_rasterizer.getWidth() || height != _m_rasterizer.getHeight())
+    {
+      _m_rasterizer.resize(width, height);
+    }
+  }
+
+  void
+  GraphicComponentSoftware::_addDraw(const MeshSoftware* pMesh, const Matrix4& modelMatrix)
+  {
+    // The model matrices are stored transposed, as the instance attributes.
+    DrawSoftware draw;
+    draw.pMesh = pMesh;
+    draw.matrix = _m_projViewMatrix * modelMatrix.getTranspose();
+    draw.positionOffset = _m_positionOffset;
+    draw.positionScale = _m_positionScale;
+    _m_draws.push_back(draw);
+  }
+
+  uint32
+  GraphicComponentSoftware::_nextObjectId()
+  {
+    return ++_m_lastObjectId;
+  }
+}
\ No newline at end of file
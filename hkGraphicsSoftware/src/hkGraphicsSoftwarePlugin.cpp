@@ -0,0 +1,16 @@
+#include <Hakool\GraphicsSoftware\hkGraphicsSoftwarePlugin.h>
+
+namespace hk
+{
+  HK_GRAPHICS_SOFTWARE_EXPORT IPlugin* 
+  createGraphicComponentSoftwarePlugin()
+  {
+    return new GraphicsSoftwarePlugin();
+  }
+
+  HK_GRAPHICS_SOFTWARE_EXPORT void 
+  destroyGraphicComponentSoftwarePlugin()
+  {
+    return;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include <Hakool/GraphicsSoftware/hkMeshSoftware.h>
+#include <Hakool/GraphicsSoftware/hkGraphicComponentSoftware.h>
+
+namespace hk
+{
+  MeshSoftware::MeshSoftware(GraphicComponentSoftware* pGraphicComponent, const uint32& id) :
+    IMesh(),
+    _m_pGraphicComponent(pGraphicComponent),
+    _m_id(id),
+    _m_positions(),
+    _m_indices(),
+    _m_isQuantized(false),
+    _m_quantization(),
+    _m_isResident(false)
+  { }
+
+  MeshSoftware::~MeshSoftware()
+  {
+    destroy();
+  }
+
+  void
+  MeshSoftware::init(const MeshDescription& description)
+  {
+    _m_isQuantized = description.vertexFormat == eVERTEX_FORMAT::kQuantized;
+    _m_quantization = description.quantization;
+
+    uint32 verticesSize = description.pVertices != nullptr ? description.verticesSize : 0;
+    _m_positions.resize(static_cast<hkSize>(verticesSize) * 3);
+    if (_m_isQuantized)
+    {
+      // Unsigned normalized, as the vertex attribute of the other components.
+      const QuantizedVertex* pVertices = static_cast<const QuantizedVertex*>(description.pVertices);
+      const float kNormalize = 1.0f / 65535.0f;
+      for (uint32 i = 0; i < verticesSize; ++i)
+      {
+        _m_positions[i * 3] = pVertices[i].px * kNormalize;
+        _m_positions[i * 3 + 1] = pVertices[i].py * kNormalize;
+        _m_positions[i * 3 + 2] = pVertices[i].pz * kNormalize;
+      }
+    }
+    else if (verticesSize > 0)
+    {
+      const float* pVertices = static_cast<const float*>(description.pVertices);
+      _m_positions.assign(pVertices, pVertices + _m_positions.size());
+    }
+
+    _m_indices.clear();
+    if (description.getIndexType() != eINDEX_TYPE::kNone)
+    {
+      // Indices out of the vertices are dropped with their triangle.
+      _m_indices.reserve(description.indicesSize - description.indicesSize % 3);
+      for (uint32 i = 0; i + 2 < description.indicesSize; i += 3)
+      {
+        const uint32* pTriangle = description.pIndices + i;
+        if (pTriangle[0] < verticesSize && pTriangle[1] < verticesSize && pTriangle[2] < verticesSize)
+        {
+          _m_indices.insert(_m_indices.end(), pTriangle, pTriangle + 3);
+        }
+      }
+    }
+
+    _m_isResident.store(true, std::memory_order_release);
+  }
+
+  bool
+  MeshSoftware::isResident()
+  {
+    return _m_isResident.load(std::memory_order_acquire);
+  }
+
+  void
+  MeshSoftware::draw(GraphicComponent* pGraphicComponent)
+  {
+    bind(pGraphicComponent);
+    _m_pGraphicComponent->drawMesh(this);
+  }
+
+  void
+  MeshSoftware::bind(GraphicComponent* pGraphicComponent)
+  {
+    if (_m_isQuantized)
+    {
+      pGraphicComponent->setPositionDequantization
+      (
+        _m_quantization.positionOffset,
+        _m_quantization.positionScale
+      );
+    }
+    else
+    {
+      pGraphicComponent->setPositionDequantization
+      (
+        Vector3f(0.0f, 0.0f, 0.0f),
+        Vector3f(1.0f, 1.0f, 1.0f)
+      );
+    }
+  }
+
+  const float*
+  MeshSoftware::getPositions() const
+  {
+    return _m_positions.data();
+  }
+
+  uint32
+  MeshSoftware::getPositionsSize() const
+  {
+    return static_cast<uint32>(_m_positions.size() / 3);
+  }
+
+  const uint32*
+  MeshSoftware::getIndices() const
+  {
+    return _m_indices.empty() ? nullptr : _m_indices.data();
+  }
+
+  uint32
+  MeshSoftware::getTrianglesSize() const
+  {
+    return _m_indices.empty()
+      ? getPositionsSize() / 3
+      : static_cast<uint32>(_m_indices.size() / 3);
+  }
+
+  uint32
+  MeshSoftware::getVertexesSize()
+  {
+    return getPositionsSize();
+  }
+
+  float*
+  MeshSoftware::getVertexesArray()
+  {
+    return _m_positions.empty() ? nullptr : _m_positions.data();
+  }
+
+  void
+  MeshSoftware::destroy()
+  {
+    _m_isResident.store(false, std::memory_order_release);
+    _m_positions.clear();
+    _m_positions.shrink_to_fit();
+    _m_indices.clear();
+    _m_indices.shrink_to_fit();
+  }
+
+  uint32
+  MeshSoftware::getId()
+  {
+    return _m_id;
+  }
+}
\ No newline at end of file
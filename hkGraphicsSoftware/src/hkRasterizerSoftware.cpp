@@ -0,0 +1,1050 @@
+#include <Hakool\GraphicsSoftware\hkRasterizerSoftware.h>
+
+#include <algorithm>
+
+#include <Hakool\Utils\hkMath.h>
+#include <Hakool\GraphicsSoftware\hkMeshSoftware.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define HK_SOFTWARE_SSE2 1
+#include <emmintrin.h>
+#else
+#define HK_SOFTWARE_SSE2 0
+#endif
+
+namespace hk
+{
+  namespace
+  {
+    /**
+    * Sub pixel precision of the screen coordinates.
+    */
+    const int32 kSubpixelBits = 4;
+
+    const float kSubpixelSize = static_cast<float>(1 << kSubpixelBits);
+
+    /**
+    * Distance in pixels from the center of the framebuffer to the guard band.
+    * Triangles crossing it are clipped, so the screen coordinates stay within
+    * 2^14 pixels.
+    */
+    const float kGuardBand = 8192.0f;
+
+    /**
+    * Offset that keeps the snapped coordinates positive, see SnapSubpixel.
+    */
+    const float kSnapOffset = 1048576.0f;
+
+    const uint32 kPlanesSize = 5;
+
+    /**
+    * Clip codes of the frustum planes, a triangle with all of its vertices
+    * outside of one of them is culled.
+    */
+    const uint32 kFrustumCodes = 0x3F;
+
+    /**
+    * Clip codes of the near plane and the guard band, a triangle with a
+    * vertex outside of one of them is clipped.
+    */
+    const uint32 kClipCodes = 0x7C0;
+
+    const uint32 kFirstClipCode = 0x40;
+
+    /**
+    * Clipping produces a vertex for each plane at most.
+    */
+    const uint32 kMaxClipVertices = 3 + 5;
+
+    /**
+    * Edges of a triangle, by vertex. The edge k is opposite to the vertex k.
+    */
+    const uint32 kEdgeStart[3] = { 1, 2, 0 };
+
+    const uint32 kEdgeEnd[3] = { 2, 0, 1 };
+
+    /**
+    * Divide by 2^kSubpixelBits, rounding towards negative infinity.
+    */
+    int32
+    FloorSubpixel(const int32& value)
+    {
+      return value >= 0
+        ? value >> kSubpixelBits
+        : -((-value + (1 << kSubpixelBits) - 1) >> kSubpixelBits);
+    }
+
+    /**
+    * Round a screen coordinate to the sub pixel grid. The guard band keeps it
+    * within 2^18 sub pixels, so with the offset it is positive and the
+    * conversion rounds down without calling std::floor.
+    */
+    int32
+    SnapSubpixel(const float& value)
+    {
+      return static_cast<int32>(value * kSubpixelSize + (kSnapOffset + 0.5f)) - static_cast<int32>(kSnapOffset);
+    }
+
+    /**
+    * Project a vertex in front of the camera to the screen.
+    */
+    void
+    Project(ClipVertexSoftware& vertex, const float& halfWidth, const float& halfHeight)
+    {
+      vertex.inverseW = 1.0f / vertex.w;
+      vertex.screenX = SnapSubpixel((vertex.x * vertex.inverseW + 1.0f) * halfWidth);
+      vertex.screenY = SnapSubpixel((1.0f - vertex.y * vertex.inverseW) * halfHeight);
+    }
+
+    uint32
+    PackChannel(const float& value)
+    {
+      return static_cast<uint32>(Math::Min(Math::Max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+    }
+
+    uint32
+    PackColor(const float& r, const float& g, const float& b, const float& a)
+    {
+      return PackChannel(r) | (PackChannel(g) << 8) | (PackChannel(b) << 16) | (PackChannel(a) << 24);
+    }
+
+    ClipVertexSoftware
+    Lerp(const ClipVertexSoftware& a, const ClipVertexSoftware& b, const float& t)
+    {
+      ClipVertexSoftware vertex;
+      vertex.x = a.x + (b.x - a.x) * t;
+      vertex.y = a.y + (b.y - a.y) * t;
+      vertex.z = a.z + (b.z - a.z) * t;
+      vertex.w = a.w + (b.w - a.w) * t;
+      vertex.r = a.r + (b.r - a.r) * t;
+      vertex.g = a.g + (b.g - a.g) * t;
+      vertex.b = a.b + (b.b - a.b) * t;
+      vertex.clipCodes = 0;
+      vertex.screenX = 0;
+      vertex.screenY = 0;
+      vertex.inverseW = 0.0f;
+      return vertex;
+    }
+
+    /**
+    * Get the signed distances of a vertex to the clipping planes, positive
+    * inside: near, then right, left, top and bottom of the guard band.
+    */
+    void
+    GetClipDistances
+    (
+      const ClipVertexSoftware& vertex,
+      const float& guardX,
+      const float& guardY,
+      float aDistances[5]
+    )
+    {
+      aDistances[0] = vertex.z + vertex.w;
+      aDistances[1] = guardX * vertex.w - vertex.x;
+      aDistances[2] = guardX * vertex.w + vertex.x;
+      aDistances[3] = guardY * vertex.w - vertex.y;
+      aDistances[4] = guardY * vertex.w + vertex.y;
+    }
+
+    /**
+    * Get the bits of the frustum planes a vertex is outside of.
+    */
+    uint32
+    GetOutcode(const ClipVertexSoftware& vertex)
+    {
+      return (vertex.x > vertex.w ? 1u : 0u)
+        | (vertex.x < -vertex.w ? 2u : 0u)
+        | (vertex.y > vertex.w ? 4u : 0u)
+        | (vertex.y < -vertex.w ? 8u : 0u)
+        | (vertex.z > vertex.w ? 16u : 0u)
+        | (vertex.z < -vertex.w ? 32u : 0u);
+    }
+  }
+
+  RasterizerSoftware::RasterizerSoftware() :
+    _m_colors(),
+    _m_depths(),
+    _m_width(0),
+    _m_height(0),
+    _m_pitch(0),
+    _m_tilesX(0),
+    _m_tilesY(0),
+    _m_guardX(1.0f),
+    _m_guardY(1.0f),
+    _m_clearColor(0),
+    _m_pDraws(nullptr),
+    _m_firstVertices(),
+    _m_firstTriangles(),
+    _m_verticesSize(0),
+    _m_trianglesSize(0),
+    _m_vertices(),
+    _m_triangles(),
+    _m_bins(),
+    _m_nextTile(0),
+    _m_binnedTrianglesSize(0),
+    _m_threads(),
+    _m_pass(ePASS::kClear),
+    _m_passIndex(0),
+    _m_busyThreads(0),
+    _m_stopRequested(false),
+    _m_mutex(),
+    _m_passQueued(),
+    _m_passDone()
+  { }
+
+  RasterizerSoftware::~RasterizerSoftware()
+  {
+    destroy();
+  }
+
+  void
+  RasterizerSoftware::init(const uint32& threadsSize)
+  {
+    destroy();
+
+    uint32 size = threadsSize;
+    if (0 == size)
+    {
+      size = Math::Max(1u, std::thread::hardware_concurrency());
+    }
+
+    _m_triangles.resize(size);
+    _m_stopRequested = false;
+    for (uint32 i = 1; i < size; ++i)
+    {
+      _m_threads.push_back(std::thread(&RasterizerSoftware::_run, this, i));
+    }
+  }
+
+  void
+  RasterizerSoftware::destroy()
+  {
+    {
+      std::lock_guard<std::mutex> lock(_m_mutex);
+      _m_stopRequested = true;
+    }
+    _m_passQueued.notify_all();
+
+    for (std::thread& thread : _m_threads)
+    {
+      thread.join();
+    }
+    _m_threads.clear();
+
+    _m_colors.clear();
+    _m_colors.shrink_to_fit();
+    _m_depths.clear();
+    _m_depths.shrink_to_fit();
+    _m_vertices.clear();
+    _m_vertices.shrink_to_fit();
+    _m_triangles.clear();
+    _m_bins.clear();
+    _m_width = 0;
+    _m_height = 0;
+    _m_pitch = 0;
+    _m_tilesX = 0;
+    _m_tilesY = 0;
+  }
+
+  void
+  RasterizerSoftware::resize(const uint32& width, const uint32& height)
+  {
+    _m_width = Math::Min(width, MAX_SIZE);
+    _m_height = Math::Min(height, MAX_SIZE);
+
+    // Rows are a multiple of 4 pixels, so the blocks of 4 pixels never cross
+    // a row, nor the tile of another thread.
+    _m_pitch = (_m_width + 3) & ~3u;
+    _m_colors.resize(static_cast<hkSize>(_m_pitch) * _m_height);
+    _m_depths.resize(static_cast<hkSize>(_m_pitch) * _m_height);
+
+    _m_tilesX = (_m_width + TILE_SIZE - 1) / TILE_SIZE;
+    _m_tilesY = (_m_height + TILE_SIZE - 1) / TILE_SIZE;
+    _m_bins.assign(static_cast<hkSize>(_m_triangles.size()) * _m_tilesX * _m_tilesY, Vector<uint32>());
+
+    _m_guardX = _m_width > 0 ? kGuardBand / (0.5f * _m_width) : 1.0f;
+    _m_guardY = _m_height > 0 ? kGuardBand / (0.5f * _m_height) : 1.0f;
+  }
+
+  void
+  RasterizerSoftware::clear(const Color& color)
+  {
+    if (_m_colors.empty())
+    {
+      return;
+    }
+
+    _m_clearColor = PackColor(color.r, color.g, color.b, color.a);
+    _m_nextTile.store(0);
+    _dispatch(ePASS::kClear);
+  }
+
+  void
+  RasterizerSoftware::draw(const Vector<DrawSoftware>& draws)
+  {
+    _m_binnedTrianglesSize = 0;
+    if (_m_colors.empty() || draws.empty())
+    {
+      return;
+    }
+
+    _m_firstVertices.resize(draws.size() + 1);
+    _m_firstTriangles.resize(draws.size() + 1);
+    _m_verticesSize = 0;
+    _m_trianglesSize = 0;
+    for (hkSize i = 0; i < draws.size(); ++i)
+    {
+      _m_firstVertices[i] = _m_verticesSize;
+      _m_firstTriangles[i] = _m_trianglesSize;
+      _m_verticesSize += draws[i].pMesh->getPositionsSize();
+      _m_trianglesSize += draws[i].pMesh->getTrianglesSize();
+    }
+    _m_firstVertices[draws.size()] = _m_verticesSize;
+    _m_firstTriangles[draws.size()] = _m_trianglesSize;
+
+    if (0 == _m_trianglesSize)
+    {
+      return;
+    }
+
+    _m_vertices.resize(_m_verticesSize);
+    _m_pDraws = &draws;
+
+    _dispatch(ePASS::kVertices);
+    _dispatch(ePASS::kTriangles);
+
+    for (const Vector<TriangleSoftware>& triangles : _m_triangles)
+    {
+      _m_binnedTrianglesSize += static_cast<uint32>(triangles.size());
+    }
+
+    if (_m_binnedTrianglesSize > 0)
+    {
+      _m_nextTile.store(0);
+      _dispatch(ePASS::kTiles);
+    }
+
+    _m_pDraws = nullptr;
+  }
+
+  uint32
+  RasterizerSoftware::getWidth() const
+  {
+    return _m_width;
+  }
+
+  uint32
+  RasterizerSoftware::getHeight() const
+  {
+    return _m_height;
+  }
+
+  uint32
+  RasterizerSoftware::getPitch() const
+  {
+    return _m_pitch;
+  }
+
+  const uint32*
+  RasterizerSoftware::getColors() const
+  {
+    return _m_colors.empty() ? nullptr : _m_colors.data();
+  }
+
+  const float*
+  RasterizerSoftware::getDepths() const
+  {
+    return _m_depths.empty() ? nullptr : _m_depths.data();
+  }
+
+  uint32
+  RasterizerSoftware::getThreadsSize() const
+  {
+    return static_cast<uint32>(_m_threads.size() + 1);
+  }
+
+  uint32
+  RasterizerSoftware::getBinnedTrianglesSize() const
+  {
+    return _m_binnedTrianglesSize;
+  }
+
+  void
+  RasterizerSoftware::_dispatch(const ePASS& pass)
+  {
+    if (!_m_threads.empty())
+    {
+      {
+        std::lock_guard<std::mutex> lock(_m_mutex);
+        _m_pass = pass;
+        _m_busyThreads = static_cast<uint32>(_m_threads.size());
+        ++_m_passIndex;
+      }
+      _m_passQueued.notify_all();
+    }
+
+    _runPass(pass, 0);
+
+    if (!_m_threads.empty())
+    {
+      std::unique_lock<std::mutex> lock(_m_mutex);
+      _m_passDone.wait
+      (
+        lock,
+        [this]()
+        {
+          return 0 == _m_busyThreads;
+        }
+      );
+    }
+  }
+
+  void
+  RasterizerSoftware::_runPass(const ePASS& pass, const uint32& thread)
+  {
+    switch (pass)
+    {
+    case ePASS::kClear:
+      _clearTiles();
+      break;
+
+    case ePASS::kVertices:
+      _transformVertices
+      (
+        _getRangeStart(_m_verticesSize, thread),
+        _getRangeStart(_m_verticesSize, thread + 1)
+      );
+      break;
+
+    case ePASS::kTriangles:
+      _binTriangles
+      (
+        _getRangeStart(_m_trianglesSize, thread),
+        _getRangeStart(_m_trianglesSize, thread + 1),
+        thread
+      );
+      break;
+
+    case ePASS::kTiles:
+      _rasterizeTiles();
+      break;
+    }
+  }
+
+  void
+  RasterizerSoftware::_run(const uint32& thread)
+  {
+    uint64 passIndex = 0;
+    for (;;)
+    {
+      ePASS pass;
+      {
+        std::unique_lock<std::mutex> lock(_m_mutex);
+        _m_passQueued.wait
+        (
+          lock,
+          [this, passIndex]()
+          {
+            return _m_stopRequested || _m_passIndex != passIndex;
+          }
+        );
+
+        if (_m_stopRequested)
+        {
+          return;
+        }
+
+        passIndex = _m_passIndex;
+        pass = _m_pass;
+      }
+
+      _runPass(pass, thread);
+
+      bool isLast = false;
+      {
+        std::lock_guard<std::mutex> lock(_m_mutex);
+        isLast = 0 == --_m_busyThreads;
+      }
+
+      if (isLast)
+      {
+        _m_passDone.notify_one();
+      }
+    }
+  }
+
+  void
+  RasterizerSoftware::_clearTiles()
+  {
+    uint32 tilesSize = _m_tilesX * _m_tilesY;
+    for (uint32 tile = _m_nextTile.fetch_add(1); tile < tilesSize; tile = _m_nextTile.fetch_add(1))
+    {
+      uint32 x0 = (tile % _m_tilesX) * TILE_SIZE;
+      uint32 y0 = (tile / _m_tilesX) * TILE_SIZE;
+
+      // The last tile of a row takes the padding of the pitch.
+      uint32 x1 = Math::Min(x0 + TILE_SIZE, _m_pitch);
+      uint32 y1 = Math::Min(y0 + TILE_SIZE, _m_height);
+
+      for (uint32 y = y0; y < y1; ++y)
+      {
+        hkSize row = static_cast<hkSize>(y) * _m_pitch;
+        std::fill(_m_colors.begin() + row + x0, _m_colors.begin() + row + x1, _m_clearColor);
+        std::fill(_m_depths.begin() + row + x0, _m_depths.begin() + row + x1, 1.0f);
+      }
+    }
+  }
+
+  void
+  RasterizerSoftware::_transformVertices(const uint32& first, const uint32& end)
+  {
+    if (first >= end)
+    {
+      return;
+    }
+
+    const Vector<DrawSoftware>& draws = *_m_pDraws;
+    uint32 drawIndex = static_cast<uint32>
+    (
+      std::upper_bound(_m_firstVertices.begin(), _m_firstVertices.end(), first) - _m_firstVertices.begin() - 1
+    );
+
+    for (uint32 i = first; i < end; ++drawIndex)
+    {
+      const DrawSoftware& draw = draws[drawIndex];
+      uint32 drawEnd = Math::Min(end, _m_firstVertices[drawIndex + 1]);
+      const float* pPosition = draw.pMesh->getPositions() + static_cast<hkSize>(i - _m_firstVertices[drawIndex]) * 3;
+      const Matrix4& matrix = draw.matrix;
+      const Vector3f& offset = draw.positionOffset;
+      const Vector3f& scale = draw.positionScale;
+
+      for (; i < drawEnd; ++i, pPosition += 3)
+      {
+        float x = offset.x + pPosition[0] * scale.x;
+        float y = offset.y + pPosition[1] * scale.y;
+        float z = offset.z + pPosition[2] * scale.z;
+
+        // The default vertex shader.
+        ClipVertexSoftware& vertex = _m_vertices[i];
+        vertex.x = matrix.m00 * x + matrix.m01 * y + matrix.m02 * z + matrix.m03;
+        vertex.y = matrix.m10 * x + matrix.m11 * y + matrix.m12 * z + matrix.m13;
+        vertex.z = matrix.m20 * x + matrix.m21 * y + matrix.m22 * z + matrix.m23;
+        vertex.w = matrix.m30 * x + matrix.m31 * y + matrix.m32 * z + matrix.m33;
+        vertex.r = x * 0.5f + 0.5f;
+        vertex.g = y * 0.5f + 0.5f;
+        vertex.b = z * 0.5f + 0.5f;
+        _projectVertex(vertex);
+      }
+    }
+  }
+
+  void
+  RasterizerSoftware::_binTriangles(const uint32& first, const uint32& end, const uint32& thread)
+  {
+    uint32 tilesSize = _m_tilesX * _m_tilesY;
+    _m_triangles[thread].clear();
+    for (uint32 tile = 0; tile < tilesSize; ++tile)
+    {
+      _m_bins[static_cast<hkSize>(thread) * tilesSize + tile].clear();
+    }
+
+    if (first >= end)
+    {
+      return;
+    }
+
+    const Vector<DrawSoftware>& draws = *_m_pDraws;
+    uint32 drawIndex = static_cast<uint32>
+    (
+      std::upper_bound(_m_firstTriangles.begin(), _m_firstTriangles.end(), first) - _m_firstTriangles.begin() - 1
+    );
+
+    for (uint32 i = first; i < end; ++drawIndex)
+    {
+      const MeshSoftware* pMesh = draws[drawIndex].pMesh;
+      const uint32* pIndices = pMesh->getIndices();
+      const ClipVertexSoftware* pVertices = _m_vertices.data() + _m_firstVertices[drawIndex];
+      uint32 drawEnd = Math::Min(end, _m_firstTriangles[drawIndex + 1]);
+
+      for (; i < drawEnd; ++i)
+      {
+        uint32 triangle = (i - _m_firstTriangles[drawIndex]) * 3;
+        const ClipVertexSoftware* apVertices[3];
+        for (uint32 k = 0; k < 3; ++k)
+        {
+          apVertices[k] = pVertices + (pIndices != nullptr ? pIndices[triangle + k] : triangle + k);
+        }
+
+        // Outside of a plane of the frustum.
+        uint32 codes0 = apVertices[0]->clipCodes;
+        uint32 codes1 = apVertices[1]->clipCodes;
+        uint32 codes2 = apVertices[2]->clipCodes;
+        if ((codes0 & codes1 & codes2 & kFrustumCodes) != 0)
+        {
+          continue;
+        }
+
+        if (0 == ((codes0 | codes1 | codes2) & kClipCodes))
+        {
+          _setupTriangle(*apVertices[0], *apVertices[1], *apVertices[2], thread);
+        }
+        else
+        {
+          _clipTriangle(apVertices, thread);
+        }
+      }
+    }
+  }
+
+  void
+  RasterizerSoftware::_clipTriangle(const ClipVertexSoftware* apVertices[3], const uint32& thread)
+  {
+    ClipVertexSoftware aPolygons[2][kMaxClipVertices];
+    uint32 size = 3;
+    for (uint32 k = 0; k < 3; ++k)
+    {
+      aPolygons[0][k] = *apVertices[k];
+    }
+
+    uint32 current = 0;
+    for (uint32 plane = 0; plane < 5 && size >= 3; ++plane)
+    {
+      const ClipVertexSoftware* pInput = aPolygons[current];
+      ClipVertexSoftware* pOutput = aPolygons[current ^ 1];
+      uint32 outputSize = 0;
+
+      for (uint32 k = 0; k < size; ++k)
+      {
+        const ClipVertexSoftware& a = pInput[k];
+        const ClipVertexSoftware& b = pInput[(k + 1) % size];
+        float aDistancesA[5];
+        float aDistancesB[5];
+        GetClipDistances(a, _m_guardX, _m_guardY, aDistancesA);
+        GetClipDistances(b, _m_guardX, _m_guardY, aDistancesB);
+        float distanceA = aDistancesA[plane];
+        float distanceB = aDistancesB[plane];
+
+        if (distanceA >= 0.0f && outputSize < kMaxClipVertices)
+        {
+          pOutput[outputSize++] = a;
+        }
+        if ((distanceA >= 0.0f) != (distanceB >= 0.0f) && outputSize < kMaxClipVertices)
+        {
+          pOutput[outputSize++] = Lerp(a, b, distanceA / (distanceA - distanceB));
+        }
+      }
+
+      size = outputSize;
+      current ^= 1;
+    }
+
+    // The vertices on the planes may be outside by a rounding error, they are
+    // projected without checking the planes again.
+    ClipVertexSoftware* pPolygon = aPolygons[current];
+    float halfWidth = 0.5f * _m_width;
+    float halfHeight = 0.5f * _m_height;
+    for (uint32 k = 0; k < size; ++k)
+    {
+      if (pPolygon[k].w <= 0.0f)
+      {
+        return;
+      }
+      Project(pPolygon[k], halfWidth, halfHeight);
+    }
+
+    for (uint32 k = 1; k + 1 < size; ++k)
+    {
+      _setupTriangle(pPolygon[0], pPolygon[k], pPolygon[k + 1], thread);
+    }
+  }
+
+  void
+  RasterizerSoftware::_projectVertex(ClipVertexSoftware& vertex) const
+  {
+    uint32 codes = GetOutcode(vertex);
+    float aDistances[5];
+    GetClipDistances(vertex, _m_guardX, _m_guardY, aDistances);
+    for (uint32 plane = 0; plane < 5; ++plane)
+    {
+      if (aDistances[plane] < 0.0f)
+      {
+        codes |= kFirstClipCode << plane;
+      }
+    }
+
+    // Behind the camera without being outside of the near plane, with an
+    // unusual projection. Clipping drops it.
+    if (vertex.w <= 0.0f)
+    {
+      codes |= kFirstClipCode;
+    }
+
+    vertex.clipCodes = codes;
+    if (0 == (codes & kClipCodes))
+    {
+      Project(vertex, 0.5f * _m_width, 0.5f * _m_height);
+    }
+  }
+
+  void
+  RasterizerSoftware::_setupTriangle
+  (
+    const ClipVertexSoftware& v0,
+    const ClipVertexSoftware& v1,
+    const ClipVertexSoftware& v2,
+    const uint32& thread
+  )
+  {
+    const ClipVertexSoftware* apVertices[3] = { &v0, &v1, &v2 };
+    int32 aX[3] = { v0.screenX, v1.screenX, v2.screenX };
+    int32 aY[3] = { v0.screenY, v1.screenY, v2.screenY };
+    float aInverseW[3] = { v0.inverseW, v1.inverseW, v2.inverseW };
+
+    int64 area = static_cast<int64>(aX[1] - aX[0]) * (aY[2] - aY[0])
+      - static_cast<int64>(aX[2] - aX[0]) * (aY[1] - aY[0]);
+    if (0 == area)
+    {
+      return;
+    }
+
+    // Both faces are drawn, the vertices are ordered so the inside of every
+    // edge is positive.
+    if (area < 0)
+    {
+      std::swap(apVertices[1], apVertices[2]);
+      std::swap(aX[1], aX[2]);
+      std::swap(aY[1], aY[2]);
+      std::swap(aInverseW[1], aInverseW[2]);
+    }
+
+    TriangleSoftware triangle;
+    int32 minX = Math::Min(aX[0], Math::Min(aX[1], aX[2]));
+    int32 minY = Math::Min(aY[0], Math::Min(aY[1], aY[2]));
+    int32 maxX = Math::Max(aX[0], Math::Max(aX[1], aX[2]));
+    int32 maxY = Math::Max(aY[0], Math::Max(aY[1], aY[2]));
+
+    // Pixels with their center inside the bounding box.
+    const int32 kHalfPixel = 1 << (kSubpixelBits - 1);
+    const int32 kPixelSize = 1 << kSubpixelBits;
+    triangle.minX = Math::Max(0, FloorSubpixel(minX - kHalfPixel + kPixelSize - 1));
+    triangle.minY = Math::Max(0, FloorSubpixel(minY - kHalfPixel + kPixelSize - 1));
+    triangle.maxX = Math::Min(static_cast<int32>(_m_width) - 1, FloorSubpixel(maxX - kHalfPixel));
+    triangle.maxY = Math::Min(static_cast<int32>(_m_height) - 1, FloorSubpixel(maxY - kHalfPixel));
+    if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY)
+    {
+      return;
+    }
+
+    for (uint32 k = 0; k < 3; ++k)
+    {
+      uint32 a = kEdgeStart[k];
+      uint32 b = kEdgeEnd[k];
+      int32 stepX = aY[a] - aY[b];
+      int32 stepY = aX[b] - aX[a];
+      int64 origin = -static_cast<int64>(stepX) * aX[a] - static_cast<int64>(stepY) * aY[a];
+
+      // Top left rule: the pixels on the other edges belong to the adjacent
+      // triangle.
+      if (!(stepX > 0 || (0 == stepX && stepY > 0)))
+      {
+        origin -= 1;
+      }
+
+      // At the pixel centers, in pixel steps.
+      triangle.edgeStepX[k] = stepX * kPixelSize;
+      triangle.edgeStepY[k] = stepY * kPixelSize;
+      triangle.edgeOrigin[k] = origin
+        + static_cast<int64>(stepX) * kHalfPixel
+        + static_cast<int64>(stepY) * kHalfPixel;
+    }
+
+    // Planes of the attributes, over the snapped positions.
+    float aScreenX[3];
+    float aScreenY[3];
+    float aAttributes[3][kPlanesSize];
+    for (uint32 k = 0; k < 3; ++k)
+    {
+      aScreenX[k] = aX[k] / kSubpixelSize;
+      aScreenY[k] = aY[k] / kSubpixelSize;
+
+      const ClipVertexSoftware& vertex = *apVertices[k];
+      aAttributes[k][0] = vertex.z * aInverseW[k] * 0.5f + 0.5f;
+      aAttributes[k][1] = aInverseW[k];
+      aAttributes[k][2] = vertex.r * aInverseW[k];
+      aAttributes[k][3] = vertex.g * aInverseW[k];
+      aAttributes[k][4] = vertex.b * aInverseW[k];
+    }
+
+    float x10 = aScreenX[1] - aScreenX[0];
+    float y10 = aScreenY[1] - aScreenY[0];
+    float x20 = aScreenX[2] - aScreenX[0];
+    float y20 = aScreenY[2] - aScreenY[0];
+    float inverseArea = 1.0f / (x10 * y20 - x20 * y10);
+    float pixelX = triangle.minX + 0.5f - aScreenX[0];
+    float pixelY = triangle.minY + 0.5f - aScreenY[0];
+
+    for (uint32 i = 0; i < kPlanesSize; ++i)
+    {
+      float a10 = aAttributes[1][i] - aAttributes[0][i];
+      float a20 = aAttributes[2][i] - aAttributes[0][i];
+      triangle.planeStepX[i] = (a10 * y20 - a20 * y10) * inverseArea;
+      triangle.planeStepY[i] = (a20 * x10 - a10 * x20) * inverseArea;
+      triangle.planeOrigin[i] = aAttributes[0][i]
+        + triangle.planeStepX[i] * pixelX
+        + triangle.planeStepY[i] * pixelY;
+    }
+
+    Vector<TriangleSoftware>& triangles = _m_triangles[thread];
+    uint32 index = static_cast<uint32>(triangles.size());
+    triangles.push_back(triangle);
+
+    uint32 tilesSize = _m_tilesX * _m_tilesY;
+    Vector<uint32>* pBins = _m_bins.data() + static_cast<hkSize>(thread) * tilesSize;
+    for (int32 tileY = triangle.minY / TILE_SIZE; tileY <= triangle.maxY / TILE_SIZE; ++tileY)
+    {
+      for (int32 tileX = triangle.minX / TILE_SIZE; tileX <= triangle.maxX / TILE_SIZE; ++tileX)
+      {
+        pBins[tileY * _m_tilesX + tileX].push_back(index);
+      }
+    }
+  }
+
+  void
+  RasterizerSoftware::_rasterizeTiles()
+  {
+    uint32 tilesSize = _m_tilesX * _m_tilesY;
+    uint32 threadsSize = static_cast<uint32>(_m_triangles.size());
+    for (uint32 tile = _m_nextTile.fetch_add(1); tile < tilesSize; tile = _m_nextTile.fetch_add(1))
+    {
+      int32 tileX = static_cast<int32>(tile % _m_tilesX) * TILE_SIZE;
+      int32 tileY = static_cast<int32>(tile / _m_tilesX) * TILE_SIZE;
+
+      // The bins of the threads in order, so in submission order.
+      for (uint32 thread = 0; thread < threadsSize; ++thread)
+      {
+        const Vector<TriangleSoftware>& triangles = _m_triangles[thread];
+        for (uint32 index : _m_bins[static_cast<hkSize>(thread) * tilesSize + tile])
+        {
+          _rasterizeTriangle(triangles[index], tileX, tileY);
+        }
+      }
+    }
+  }
+
+  void
+  RasterizerSoftware::_rasterizeTriangle
+  (
+    const TriangleSoftware& triangle,
+    const int32& tileX,
+    const int32& tileY
+  )
+  {
+    // Blocks of 4 pixels aligned in the tile. The pixels of the block out of
+    // the bounding box are outside of the triangle.
+    int32 x0 = Math::Max(triangle.minX, tileX) & ~3;
+    int32 y0 = Math::Max(triangle.minY, tileY);
+    int32 x1 = Math::Min(triangle.maxX, tileX + TILE_SIZE - 1);
+    int32 y1 = Math::Min(triangle.maxY, tileY + TILE_SIZE - 1);
+    if (x0 > x1 || y0 > y1)
+    {
+      return;
+    }
+
+    // The edges are tested on the corners of the area. An edge with all of
+    // the area inside is skipped, and the rest fit in 32 bits.
+    int32 aEdgeRow[3];
+    int32 aEdgeStepX[3];
+    int32 aEdgeStepY[3];
+    for (uint32 k = 0; k < 3; ++k)
+    {
+      int64 stepX = triangle.edgeStepX[k];
+      int64 stepY = triangle.edgeStepY[k];
+      int64 corner = triangle.edgeOrigin[k] + stepX * x0 + stepY * y0;
+      int64 spanX = stepX * (x1 - x0);
+      int64 spanY = stepY * (y1 - y0);
+      int64 minimum = corner + Math::Min(static_cast<int64>(0), spanX) + Math::Min(static_cast<int64>(0), spanY);
+      int64 maximum = corner + Math::Max(static_cast<int64>(0), spanX) + Math::Max(static_cast<int64>(0), spanY);
+
+      if (maximum < 0)
+      {
+        return;
+      }
+
+      if (minimum >= 0)
+      {
+        aEdgeRow[k] = 0;
+        aEdgeStepX[k] = 0;
+        aEdgeStepY[k] = 0;
+      }
+      else
+      {
+        aEdgeRow[k] = static_cast<int32>(corner);
+        aEdgeStepX[k] = triangle.edgeStepX[k];
+        aEdgeStepY[k] = triangle.edgeStepY[k];
+      }
+    }
+
+    float aPlaneRow[kPlanesSize];
+    for (uint32 i = 0; i < kPlanesSize; ++i)
+    {
+      aPlaneRow[i] = triangle.planeOrigin[i]
+        + triangle.planeStepX[i] * (x0 - triangle.minX)
+        + triangle.planeStepY[i] * (y0 - triangle.minY);
+    }
+
+#if HK_SOFTWARE_SSE2
+    const __m128i kLanes = _mm_set_epi32(3, 2, 1, 0);
+    const __m128 kLanesF = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    const __m128i kMinusOne = _mm_set1_epi32(-1);
+    const __m128 kZero = _mm_setzero_ps();
+    const __m128 kOne = _mm_set1_ps(1.0f);
+    const __m128 k255 = _mm_set1_ps(255.0f);
+    const __m128 kHalf = _mm_set1_ps(0.5f);
+    const __m128i kAlpha = _mm_set1_epi32(static_cast<int32>(0xFF000000u));
+    const __m128i kEnd = _mm_set1_epi32(x1 + 1);
+
+    __m128i aEdgeBlockStep[3];
+    __m128i aEdgeRowStep[3];
+    __m128i aEdge[3];
+    for (uint32 k = 0; k < 3; ++k)
+    {
+      aEdgeBlockStep[k] = _mm_set1_epi32(aEdgeStepX[k] * 4);
+      aEdgeRowStep[k] = _mm_set1_epi32(aEdgeStepY[k]);
+
+      // The offsets of the lanes are multiplied outside, SSE2 has no 32 bit
+      // multiply.
+      aEdge[k] = _mm_add_epi32
+      (
+        _mm_set1_epi32(aEdgeRow[k]),
+        _mm_set_epi32(aEdgeStepX[k] * 3, aEdgeStepX[k] * 2, aEdgeStepX[k], 0)
+      );
+    }
+
+    __m128 aPlaneBlockStep[kPlanesSize];
+    __m128 aPlane[kPlanesSize];
+    for (uint32 i = 0; i < kPlanesSize; ++i)
+    {
+      aPlaneBlockStep[i] = _mm_set1_ps(triangle.planeStepX[i] * 4.0f);
+      aPlane[i] = _mm_add_ps(_mm_set1_ps(aPlaneRow[i]), _mm_mul_ps(kLanesF, _mm_set1_ps(triangle.planeStepX[i])));
+    }
+
+    for (int32 y = y0; y <= y1; ++y)
+    {
+      uint32* pColors = _m_colors.data() + static_cast<hkSize>(y) * _m_pitch;
+      float* pDepths = _m_depths.data() + static_cast<hkSize>(y) * _m_pitch;
+
+      __m128i e0 = aEdge[0];
+      __m128i e1 = aEdge[1];
+      __m128i e2 = aEdge[2];
+      __m128 z = aPlane[0];
+      __m128 inverseW = aPlane[1];
+      __m128 r = aPlane[2];
+      __m128 g = aPlane[3];
+      __m128 b = aPlane[4];
+      __m128i pixelX = _mm_add_epi32(_mm_set1_epi32(x0), kLanes);
+
+      for (int32 x = x0; x <= x1; x += 4)
+      {
+        // Inside when no edge is negative, and in the area.
+        __m128i edges = _mm_or_si128(e0, _mm_or_si128(e1, e2));
+        __m128i covered = _mm_and_si128(_mm_cmpgt_epi32(edges, kMinusOne), _mm_cmplt_epi32(pixelX, kEnd));
+
+        if (_mm_movemask_ps(_mm_castsi128_ps(covered)) != 0)
+        {
+          __m128 depth = _mm_loadu_ps(pDepths + x);
+          __m128 pass = _mm_and_ps(_mm_castsi128_ps(covered), _mm_cmple_ps(z, depth));
+
+          if (_mm_movemask_ps(pass) != 0)
+          {
+            _mm_storeu_ps(pDepths + x, _mm_or_ps(_mm_and_ps(pass, z), _mm_andnot_ps(pass, depth)));
+
+            // Perspective correct color. A division, so the image is the same
+            // on every CPU.
+            __m128 w = _mm_div_ps(kOne, inverseW);
+            __m128i red = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_mul_ps(r, w), kZero), kOne), k255), kHalf));
+            __m128i green = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_mul_ps(g, w), kZero), kOne), k255), kHalf));
+            __m128i blue = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_mul_ps(b, w), kZero), kOne), k255), kHalf));
+            __m128i color = _mm_or_si128
+            (
+              _mm_or_si128(red, _mm_slli_epi32(green, 8)),
+              _mm_or_si128(_mm_slli_epi32(blue, 16), kAlpha)
+            );
+
+            __m128i passMask = _mm_castps_si128(pass);
+            __m128i previous = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pColors + x));
+            _mm_storeu_si128
+            (
+              reinterpret_cast<__m128i*>(pColors + x),
+              _mm_or_si128(_mm_and_si128(passMask, color), _mm_andnot_si128(passMask, previous))
+            );
+          }
+        }
+
+        e0 = _mm_add_epi32(e0, aEdgeBlockStep[0]);
+        e1 = _mm_add_epi32(e1, aEdgeBlockStep[1]);
+        e2 = _mm_add_epi32(e2, aEdgeBlockStep[2]);
+        z = _mm_add_ps(z, aPlaneBlockStep[0]);
+        inverseW = _mm_add_ps(inverseW, aPlaneBlockStep[1]);
+        r = _mm_add_ps(r, aPlaneBlockStep[2]);
+        g = _mm_add_ps(g, aPlaneBlockStep[3]);
+        b = _mm_add_ps(b, aPlaneBlockStep[4]);
+        pixelX = _mm_add_epi32(pixelX, _mm_set1_epi32(4));
+      }
+
+      for (uint32 k = 0; k < 3; ++k)
+      {
+        aEdge[k] = _mm_add_epi32(aEdge[k], aEdgeRowStep[k]);
+      }
+      for (uint32 i = 0; i < kPlanesSize; ++i)
+      {
+        aPlane[i] = _mm_add_ps(aPlane[i], _mm_set1_ps(triangle.planeStepY[i]));
+      }
+    }
+#else
+    for (int32 y = y0; y <= y1; ++y)
+    {
+      uint32* pColors = _m_colors.data() + static_cast<hkSize>(y) * _m_pitch;
+      float* pDepths = _m_depths.data() + static_cast<hkSize>(y) * _m_pitch;
+
+      int32 aEdge[3] = { aEdgeRow[0], aEdgeRow[1], aEdgeRow[2] };
+      float aPlane[kPlanesSize];
+      std::copy(aPlaneRow, aPlaneRow + kPlanesSize, aPlane);
+
+      for (int32 x = x0; x <= x1; ++x)
+      {
+        if ((aEdge[0] | aEdge[1] | aEdge[2]) >= 0 && aPlane[0] <= pDepths[x])
+        {
+          pDepths[x] = aPlane[0];
+
+          float w = 1.0f / aPlane[1];
+          pColors[x] = PackColor(aPlane[2] * w, aPlane[3] * w, aPlane[4] * w, 1.0f);
+        }
+
+        for (uint32 k = 0; k < 3; ++k)
+        {
+          aEdge[k] += aEdgeStepX[k];
+        }
+        for (uint32 i = 0; i < kPlanesSize; ++i)
+        {
+          aPlane[i] += triangle.planeStepX[i];
+        }
+      }
+
+      for (uint32 k = 0; k < 3; ++k)
+      {
+        aEdgeRow[k] += aEdgeStepY[k];
+      }
+      for (uint32 i = 0; i < kPlanesSize; ++i)
+      {
+        aPlaneRow[i] += triangle.planeStepY[i];
+      }
+    }
+#endif
+  }
+
+  uint32
+  RasterizerSoftware::_getRangeStart(const uint32& count, const uint32& thread) const
+  {
+    return static_cast<uint32>(static_cast<uint64>(count) * thread / _m_triangles.size());
+  }
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <Hakool/Utils/hkUtilitiesUtilities.h>
+
+/**
+* Define and register a test function.
+*/
+#define HK_TEST(name) \
+  static void name(); \
+  static hk::tests::TestRegistrar name##Registrar(#name, &name); \
+  static void name()
+
+/**
+* Check a condition in the running test.
+*/
+#define HK_CHECK(condition) \
+  hk::tests::Check((condition), #condition, __FILE__, __LINE__)
+
+namespace hk
+{
+  namespace tests
+  {
+    /**
+    * A test function, registered with HK_TEST.
+    */
+    struct TestCase
+    {
+      const char* pName;
+
+      void (*pFunction)();
+    };
+
+    /**
+    * Get the tests registered before main.
+    */
+    Vector<TestCase>&
+    GetTestCases();
+
+    /**
+    * Registers a test when it is constructed. Use HK_TEST instead.
+    */
+    class TestRegistrar
+    {
+    public:
+
+      TestRegistrar(const char* pName, void (*pFunction)());
+    };
+
+    /**
+    * Report a check of the running test. Failed checks are logged and make
+    * the test fail, the test goes on.
+    *
+    * @param condition Result of the check.
+    * @param pExpression Text of the checked expression.
+    * @param pFile Source file of the check.
+    * @param line Source line of the check.
+    */
+    void
+    Check
+    (
+      const bool& condition,
+      const char* pExpression,
+      const char* pFile,
+      const int32& line
+    );
+
+    /**
+    * Get the failed checks since the last call, and reset the count.
+    */
+    uint32
+    TakeFailedChecks();
+  }
+}
\ No newline at end of file
@@ -0,0 +1,287 @@
+#include <Hakool/Core/hkCommandBuffer.h>
+#include <Hakool/Core/hkGameObject.h>
+#include <Hakool/Core/hkIGameObjectComponent.h>
+#include <Hakool/Core/hkIMesh.h>
+#include <Hakool/Core/hkJobPool.h>
+#include <Hakool/Core/hkMeshDescription.h>
+#include <Hakool/Core/hkRenderQueue.h>
+#include <Hakool/Core/hkResourceManager.h>
+#include <Hakool/GraphicsNull/hkGraphicComponentNull.h>
+#include "test.h"
+
+#include <cstring>
+
+namespace hk
+{
+  namespace tests
+  {
+    namespace
+    {
+      const uint32 kObjectsSize = 1000;
+
+      const uint32 kMeshesSize = 3;
+
+      /**
+      * Draws a mesh at the position of its object.
+      */
+      class DrawComponent :
+        public IGameObjectComponent
+      {
+      public:
+
+        DrawComponent(IMesh* pMesh, const uint32& material) :
+          _m_pMesh(pMesh),
+          _m_material(material),
+          _m_pGameObject(nullptr)
+        { }
+
+        virtual void
+        init(GameObject* pGameObject) override
+        {
+          _m_pGameObject = pGameObject;
+        }
+
+        virtual void
+        update() override
+        { }
+
+        virtual void
+        draw(CommandBuffer& commands) override
+        {
+          commands.draw
+          (
+            _m_pMesh,
+            _m_pGameObject->getModelMatrix(),
+            _m_pGameObject->getLocalPosition(),
+            _m_material
+          );
+        }
+
+        virtual void
+        destroy() override
+        { }
+
+        virtual eCOMPONENT
+        getID() override
+        {
+          return eCOMPONENT::kModel;
+        }
+
+        virtual GameObject*
+        getGameObject() override
+        {
+          return _m_pGameObject;
+        }
+
+      private:
+
+        IMesh*
+        _m_pMesh;
+
+        uint32
+        _m_material;
+
+        GameObject*
+        _m_pGameObject;
+      };
+
+      /**
+      * A null graphic component with a few resident meshes, and a scene
+      * drawing them from many objects. Many draws share their key, so the
+      * order of equal keys is checked too.
+      */
+      struct SceneFixture
+      {
+        SceneFixture() :
+          resourceManager(),
+          graphicComponent(),
+          apMeshes(),
+          root("root")
+        {
+          GraphicsConfiguration graphicsConfig;
+          WindowConfiguration windowConfig;
+          windowConfig.width = 64;
+          windowConfig.height = 64;
+          graphicComponent.init(graphicsConfig, windowConfig, resourceManager);
+
+          float aVertices[9] = { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+          MeshDescription description;
+          description.pVertices = aVertices;
+          description.verticesSize = 3;
+          for (uint32 i = 0; i < kMeshesSize; ++i)
+          {
+            apMeshes[i] = graphicComponent.createMesh();
+            apMeshes[i]->init(description);
+          }
+
+          uint32 seed = 7;
+          for (uint32 i = 0; i < kObjectsSize; ++i)
+          {
+            seed = seed * 1664525u + 1013904223u;
+
+            GameObject* pObject = new GameObject("object_" + std::to_string(i), root);
+            // Mirrored positions have the same depth and different matrices.
+            float depth = static_cast<float>((seed >> 8) % 16);
+            pObject->setLocalPosition((seed >> 12) % 2 ? depth : -depth, 0.0f, 0.0f);
+
+            pObject->addComponent(new DrawComponent(apMeshes[(seed >> 16) % kMeshesSize], (seed >> 24) % 2));
+            pObject->init();
+          }
+        }
+
+        ~SceneFixture()
+        {
+          root.destroy();
+          for (uint32 i = 0; i < kMeshesSize; ++i)
+          {
+            apMeshes[i]->destroy();
+            delete apMeshes[i];
+          }
+          graphicComponent.destroy();
+        }
+
+        /**
+        * Record the scene with a pool of threads and merge the buffers.
+        */
+        void
+        record(const uint32& threadsSize, RenderQueue& queue)
+        {
+          JobPool jobPool;
+          jobPool.init(threadsSize);
+
+          Vector<CommandBuffer> commandBuffers;
+          root.drawParallel(commandBuffers, Vector3f(0.0f, 0.0f, 0.0f), jobPool);
+          queue.merge(commandBuffers);
+        }
+
+        ResourceManager
+        resourceManager;
+
+        GraphicComponentNull
+        graphicComponent;
+
+        IMesh*
+        apMeshes[kMeshesSize];
+
+        GameObject
+        root;
+      };
+
+      bool
+      AreSameMatrices(const Matrix4& a, const Matrix4& b)
+      {
+        return 0 == std::memcmp(a.a, b.a, sizeof(a.a));
+      }
+
+      bool
+      AreSamePackets(const RenderPacket& a, const RenderPacket& b)
+      {
+        return a.sortKey == b.sortKey
+          && a.pMesh == b.pMesh
+          && AreSameMatrices(a.modelMatrix, b.modelMatrix);
+      }
+    }
+
+    HK_TEST(MergedQueueIsSorted)
+    {
+      SceneFixture fixture;
+      RenderQueue queue;
+      fixture.record(4, queue);
+
+      HK_CHECK(queue.getSize() == kObjectsSize);
+      for (uint32 i = 1; i < queue.getSize(); ++i)
+      {
+        HK_CHECK(queue.getPacket(i - 1).sortKey <= queue.getPacket(i).sortKey);
+      }
+    }
+
+    HK_TEST(MergedQueueKeepsSerialOrderOfEqualKeys)
+    {
+      SceneFixture fixture;
+
+      // A single buffer recorded on this thread, sorted by the queue.
+      CommandBuffer commandBuffer;
+      commandBuffer.begin(Vector3f(0.0f, 0.0f, 0.0f));
+      fixture.root.draw(commandBuffer);
+
+      Vector<CommandBuffer> commandBuffers(1, commandBuffer);
+      RenderQueue serialQueue;
+      serialQueue.merge(commandBuffers);
+
+      RenderQueue queue;
+      fixture.record(4, queue);
+
+      HK_CHECK(queue.getSize() == serialQueue.getSize());
+      for (uint32 i = 0; i < queue.getSize() && i < serialQueue.getSize(); ++i)
+      {
+        HK_CHECK(AreSamePackets(queue.getPacket(i), serialQueue.getPacket(i)));
+      }
+    }
+
+    HK_TEST(MergedQueueDoesNotDependOnThreads)
+    {
+      SceneFixture fixture;
+      RenderQueue referenceQueue;
+      fixture.record(1, referenceQueue);
+
+      fixture.graphicComponent.resetRecording();
+      fixture.graphicComponent.drawQueue(referenceQueue);
+      Vector<RecordedCommand> referenceCommands = fixture.graphicComponent.getCommands();
+
+      const uint32 aThreadsSizes[4] = { 2, 3, 5, 8 };
+      for (uint32 threadsSize : aThreadsSizes)
+      {
+        // Repeated, as a different schedule must not change the result.
+        for (uint32 frame = 0; frame < 4; ++frame)
+        {
+          RenderQueue queue;
+          fixture.record(threadsSize, queue);
+
+          HK_CHECK(queue.getSize() == referenceQueue.getSize());
+          for (uint32 i = 0; i < queue.getSize() && i < referenceQueue.getSize(); ++i)
+          {
+            HK_CHECK(AreSamePackets(queue.getPacket(i), referenceQueue.getPacket(i)));
+          }
+
+          fixture.graphicComponent.resetRecording();
+          fixture.graphicComponent.drawQueue(queue);
+          const Vector<RecordedCommand>& commands = fixture.graphicComponent.getCommands();
+
+          HK_CHECK(commands.size() == referenceCommands.size());
+          for (hkSize i = 0; i < commands.size() && i < referenceCommands.size(); ++i)
+          {
+            HK_CHECK(commands[i].type == referenceCommands[i].type);
+            HK_CHECK(commands[i].objectId == referenceCommands[i].objectId);
+            HK_CHECK(commands[i].instances == referenceCommands[i].instances);
+            HK_CHECK(AreSameMatrices(commands[i].matrix, referenceCommands[i].matrix));
+          }
+        }
+      }
+    }
+
+    HK_TEST(JobPoolRunsEveryJobOnce)
+    {
+      JobPool jobPool;
+      jobPool.init(4);
+      HK_CHECK(jobPool.getThreadsSize() == 4);
+
+      Vector<uint32> runs(100, 0);
+      for (uint32 frame = 0; frame < 10; ++frame)
+      {
+        jobPool.run
+        (
+          static_cast<uint32>(runs.size()),
+          [&runs](uint32 job)
+          {
+            ++runs[job];
+          }
+        );
+      }
+
+      for (uint32 count : runs)
+      {
+        HK_CHECK(count == 10);
+      }
+    }
+  }
+}
\ No newline at end of file
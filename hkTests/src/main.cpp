@@ -0,0 +1,36 @@
+#include <Hakool/Utils/hkLoggerConsole.h>
+#include "test.h"
+
+using hk::Logger;
+using hk::LoggerConsole;
+using hk::tests::TestCase;
+
+int
+main(int argc, char* argv[])
+{
+  Logger::Prepare(new LoggerConsole());
+
+  hk::uint32 failedTests = 0;
+  for (const TestCase& testCase : hk::tests::GetTestCases())
+  {
+    testCase.pFunction();
+    if (hk::tests::TakeFailedChecks() > 0)
+    {
+      Logger::Error("| Tests | FAILED " + hk::String(testCase.pName));
+      ++failedTests;
+    }
+    else
+    {
+      Logger::Log("| Tests | passed " + hk::String(testCase.pName));
+    }
+  }
+
+  Logger::Log
+  (
+    "| Tests | " + std::to_string(hk::tests::GetTestCases().size() - failedTests)
+    + " of " + std::to_string(hk::tests::GetTestCases().size()) + " passed."
+  );
+
+  Logger::Shutdown();
+  return failedTests > 0 ? 1 : 0;
+}
\ No newline at end of file
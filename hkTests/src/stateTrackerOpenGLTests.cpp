@@ -0,0 +1,185 @@
+#include <Hakool/GraphicsOpenGL/hkStateTrackerOpenGL.h>
+#include "test.h"
+
+namespace hk
+{
+  namespace tests
+  {
+    HK_TEST(StateTrackerFiltersRepeatedBinds)
+    {
+      StateTrackerOpenGL tracker;
+
+      HK_CHECK(tracker.useProgram(3));
+      HK_CHECK(!tracker.useProgram(3));
+      HK_CHECK(tracker.useProgram(4));
+
+      HK_CHECK(tracker.bindVertexArray(1));
+      HK_CHECK(!tracker.bindVertexArray(1));
+
+      HK_CHECK(tracker.bindBuffer(GL_ARRAY_BUFFER, 7));
+      HK_CHECK(!tracker.bindBuffer(GL_ARRAY_BUFFER, 7));
+      HK_CHECK(tracker.bindBuffer(GL_UNIFORM_BUFFER, 7));
+      HK_CHECK(!tracker.bindBuffer(GL_UNIFORM_BUFFER, 7));
+      HK_CHECK(tracker.bindBuffer(GL_ARRAY_BUFFER, 8));
+
+      HK_CHECK(tracker.getIssuedCalls() == 6);
+      HK_CHECK(tracker.getFilteredCalls() == 4);
+    }
+
+    HK_TEST(StateTrackerAlwaysIssuesUntrackedTargets)
+    {
+      StateTrackerOpenGL tracker;
+
+      HK_CHECK(tracker.bindBuffer(GL_TEXTURE_BUFFER, 2));
+      HK_CHECK(tracker.bindBuffer(GL_TEXTURE_BUFFER, 2));
+
+      HK_CHECK(tracker.setCapability(GL_STENCIL_TEST, true));
+      HK_CHECK(tracker.setCapability(GL_STENCIL_TEST, true));
+
+      HK_CHECK(tracker.getIssuedCalls() == 4);
+      HK_CHECK(tracker.getFilteredCalls() == 0);
+    }
+
+    HK_TEST(StateTrackerFiltersRepeatedStates)
+    {
+      StateTrackerOpenGL tracker;
+
+      HK_CHECK(tracker.setCapability(GL_DEPTH_TEST, true));
+      HK_CHECK(!tracker.setCapability(GL_DEPTH_TEST, true));
+      HK_CHECK(tracker.setCapability(GL_DEPTH_TEST, false));
+      HK_CHECK(tracker.setCapability(GL_BLEND, false));
+      HK_CHECK(!tracker.setCapability(GL_BLEND, false));
+
+      HK_CHECK(tracker.setDepthFunc(GL_LEQUAL));
+      HK_CHECK(!tracker.setDepthFunc(GL_LEQUAL));
+      HK_CHECK(tracker.setDepthMask(false));
+      HK_CHECK(!tracker.setDepthMask(false));
+      HK_CHECK(tracker.setCullFace(GL_BACK));
+      HK_CHECK(!tracker.setCullFace(GL_BACK));
+
+      // GL_ZERO is a valid factor.
+      HK_CHECK(tracker.setBlendFunc(GL_ZERO, GL_ONE));
+      HK_CHECK(!tracker.setBlendFunc(GL_ZERO, GL_ONE));
+      HK_CHECK(tracker.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+
+      HK_CHECK(tracker.setViewport(0, 0, 1024, 768));
+      HK_CHECK(!tracker.setViewport(0, 0, 1024, 768));
+      HK_CHECK(tracker.setViewport(0, 0, 800, 600));
+
+      HK_CHECK(tracker.setClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+      HK_CHECK(!tracker.setClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+      HK_CHECK(tracker.setClearColor(1.0f, 0.0f, 0.0f, 1.0f));
+    }
+
+    HK_TEST(StateTrackerTracksAttributesPerVertexArray)
+    {
+      StateTrackerOpenGL tracker;
+
+      // Without a known vertex array the arrays belong to an unknown object.
+      HK_CHECK(tracker.setVertexAttribArray(0, true));
+      HK_CHECK(tracker.setVertexAttribArray(0, true));
+
+      tracker.bindVertexArray(1);
+      HK_CHECK(tracker.setVertexAttribArray(0, true));
+      HK_CHECK(!tracker.setVertexAttribArray(0, true));
+      HK_CHECK(tracker.setVertexAttribArray(0, false));
+
+      tracker.bindVertexArray(2);
+      HK_CHECK(tracker.setVertexAttribArray(0, false));
+
+      tracker.bindVertexArray(1);
+      HK_CHECK(!tracker.setVertexAttribArray(0, false));
+
+      // A new object under the same name starts unknown.
+      tracker.onVertexArrayDeleted(1);
+      tracker.bindVertexArray(1);
+      HK_CHECK(tracker.setVertexAttribArray(0, false));
+    }
+
+    HK_TEST(StateTrackerForgetsIndexBufferOfOtherVertexArray)
+    {
+      StateTrackerOpenGL tracker;
+      tracker.bindVertexArray(1);
+      HK_CHECK(tracker.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 5));
+      HK_CHECK(tracker.bindBuffer(GL_ARRAY_BUFFER, 6));
+
+      HK_CHECK(!tracker.bindVertexArray(1));
+      HK_CHECK(!tracker.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 5));
+
+      // The index buffer is part of the vertex array, the array buffer isn't.
+      tracker.bindVertexArray(2);
+      HK_CHECK(tracker.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 5));
+      HK_CHECK(!tracker.bindBuffer(GL_ARRAY_BUFFER, 6));
+
+      tracker.onVertexArrayDeleted(2);
+      HK_CHECK(tracker.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 5));
+    }
+
+    HK_TEST(StateTrackerUnbindsDeletedBuffers)
+    {
+      StateTrackerOpenGL tracker;
+      tracker.bindBuffer(GL_ARRAY_BUFFER, 9);
+      tracker.bindBuffer(GL_COPY_WRITE_BUFFER, 9);
+      tracker.bindBuffer(GL_UNIFORM_BUFFER, 4);
+
+      // The deleted name may be reused by a new buffer, and the bindings of
+      // the deleted buffer revert to zero.
+      tracker.onBufferDeleted(9);
+      HK_CHECK(tracker.bindBuffer(GL_ARRAY_BUFFER, 9));
+      HK_CHECK(!tracker.bindBuffer(GL_COPY_WRITE_BUFFER, 0));
+      HK_CHECK(!tracker.bindBuffer(GL_UNIFORM_BUFFER, 4));
+    }
+
+    HK_TEST(StateTrackerIssuesEverythingAfterInvalidate)
+    {
+      StateTrackerOpenGL tracker;
+      tracker.useProgram(1);
+      tracker.bindVertexArray(1);
+      tracker.bindBuffer(GL_ARRAY_BUFFER, 1);
+      tracker.setCapability(GL_CULL_FACE, true);
+      tracker.setDepthFunc(GL_LESS);
+      tracker.setDepthMask(true);
+      tracker.setBlendFunc(GL_ONE, GL_ZERO);
+      tracker.setCullFace(GL_FRONT);
+      tracker.setViewport(0, 0, 4, 4);
+      tracker.setClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+      tracker.setVertexAttribArray(2, true);
+
+      tracker.invalidate();
+      tracker.resetCounters();
+      HK_CHECK(tracker.getIssuedCalls() == 0);
+      HK_CHECK(tracker.getFilteredCalls() == 0);
+
+      HK_CHECK(tracker.useProgram(1));
+      HK_CHECK(tracker.bindVertexArray(1));
+      HK_CHECK(tracker.bindBuffer(GL_ARRAY_BUFFER, 1));
+      HK_CHECK(tracker.setCapability(GL_CULL_FACE, true));
+      HK_CHECK(tracker.setDepthFunc(GL_LESS));
+      HK_CHECK(tracker.setDepthMask(true));
+      HK_CHECK(tracker.setBlendFunc(GL_ONE, GL_ZERO));
+      HK_CHECK(tracker.setCullFace(GL_FRONT));
+      HK_CHECK(tracker.setViewport(0, 0, 4, 4));
+      HK_CHECK(tracker.setClearColor(0.0f, 0.0f, 0.0f, 0.0f));
+      HK_CHECK(tracker.setVertexAttribArray(2, true));
+
+      HK_CHECK(tracker.getIssuedCalls() == 11);
+      HK_CHECK(tracker.getFilteredCalls() == 0);
+    }
+
+    HK_TEST(StateTrackerCountersKeepStateAcrossReset)
+    {
+      StateTrackerOpenGL tracker;
+      tracker.useProgram(2);
+      tracker.useProgram(2);
+      HK_CHECK(tracker.getIssuedCalls() == 1);
+      HK_CHECK(tracker.getFilteredCalls() == 1);
+
+      tracker.resetCounters();
+      HK_CHECK(tracker.getIssuedCalls() == 0);
+      HK_CHECK(tracker.getFilteredCalls() == 0);
+
+      HK_CHECK(!tracker.useProgram(2));
+      HK_CHECK(tracker.getFilteredCalls() == 1);
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "test.h"
+
+#include <Hakool/Utils/hkLogger.h>
+
+namespace hk
+{
+  namespace tests
+  {
+    namespace
+    {
+      uint32 failedChecks = 0;
+    }
+
+    Vector<TestCase>&
+    GetTestCases()
+    {
+      // Built on first use, the registrars run before main in any order.
+      static Vector<TestCase> testCases;
+      return testCases;
+    }
+
+    TestRegistrar::TestRegistrar(const char* pName, void (*pFunction)())
+    {
+      TestCase testCase;
+      testCase.pName = pName;
+      testCase.pFunction = pFunction;
+      GetTestCases().push_back(testCase);
+    }
+
+    void
+    Check
+    (
+      const bool& condition,
+      const char* pExpression,
+      const char* pFile,
+      const int32& line
+    )
+    {
+      if (condition)
+      {
+        return;
+      }
+
+      ++failedChecks;
+      Logger::Error
+      (
+        "| Tests | " + String(pFile) + "(" + std::to_string(line) + "): " + pExpression
+      );
+    }
+
+    uint32
+    TakeFailedChecks()
+    {
+      uint32 checks = failedChecks;
+      failedChecks = 0;
+      return checks;
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Hakool/Utils/hkUtilsPrerequisites.h"
+#include "Hakool/Utils/hkVector3.h"
+
+namespace hk
+{
+  class Matrix4;
+
+  /**
+   * Axis aligned bounding box. A default constructed box is empty, its
+   * minimum is greater than its maximum.
+   */
+  struct HK_UTILITY_EXPORT BoundingBox
+  {
+  public:
+
+    BoundingBox();
+
+    BoundingBox(const Vector3f& minimum, const Vector3f& maximum);
+
+    /**
+     * Get the box of a strided array of positions.
+     *
+     * @param positions Pointer to the x coordinate of the first position,
+     * followed by the y and z coordinates.
+     * @param positionsSize Number of positions.
+     * @param stride Bytes between two consecutive positions.
+     */
+    static BoundingBox
+    FromPositions
+    (
+      const float* positions,
+      const uint32& positionsSize,
+      const uint32& stride
+    );
+
+    /**
+     * Check if the box contains at least a point.
+     */
+    bool
+    isValid() const;
+
+    /**
+     * Grow this box to contain the given one.
+     */
+    void
+    merge(const BoundingBox& box);
+
+    Vector3f
+    getCenter() const;
+
+    /**
+     * Get the half size of the box in every axis.
+     */
+    Vector3f
+    getExtents() const;
+
+    /**
+     * Get the box that contains this box transformed by the given matrix.
+     */
+    BoundingBox
+    getTransformed(const Matrix4& transform) const;
+
+    Vector3f
+    minimum;
+
+    Vector3f
+    maximum;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Hakool/Utils/hkUtilsPrerequisites.h"
+#include "Hakool/Utils/hkVector3.h"
+
+namespace hk
+{
+  class Matrix4;
+  struct BoundingBox;
+
+  /**
+   * Bounding sphere. A negative radius means an empty sphere.
+   */
+  struct HK_UTILITY_EXPORT BoundingSphere
+  {
+  public:
+
+    BoundingSphere();
+
+    BoundingSphere(const Vector3f& center, const float& radius);
+
+    /**
+     * Get the sphere of a strided array of positions, centered in the given
+     * box of the same positions.
+     *
+     * @param positions Pointer to the x coordinate of the first position,
+     * followed by the y and z coordinates.
+     * @param positionsSize Number of positions.
+     * @param stride Bytes between two consecutive positions.
+     * @param box Bounding box of the positions.
+     */
+    static BoundingSphere
+    FromPositions
+    (
+      const float* positions,
+      const uint32& positionsSize,
+      const uint32& stride,
+      const BoundingBox& box
+    );
+
+    bool
+    isValid() const;
+
+    /**
+     * Grow this sphere to contain the given one.
+     */
+    void
+    merge(const BoundingSphere& sphere);
+
+    /**
+     * Get the sphere that contains this sphere transformed by the given
+     * matrix. Non uniform scales grow the radius by the biggest scale.
+     */
+    BoundingSphere
+    getTransformed(const Matrix4& transform) const;
+
+    Vector3f
+    center;
+
+    float
+    radius;
+  };
+}
\ No newline at end of file
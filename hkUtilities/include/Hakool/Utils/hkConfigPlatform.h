@@ -104,6 +104,16 @@
 # define HK_ARCH_TYPE HK_ARCHITECTURE_x86_32
 #endif
 
+/************************************************************************/
+/* SIMD instruction sets                                                */
+/************************************************************************/
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define HK_SSE2 1
+#else
+# define HK_SSE2 0
+#endif
+
 /************************************************************************/
 /* Memory Alignment macros                                              */
 /************************************************************************/
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Hakool/Utils/hkUtilsPrerequisites.h"
+
+namespace hk
+{
+  /**
+   * Non cryptographic hashes, to identify identical data.
+   */
+  struct HK_UTILITY_EXPORT Hash
+  {
+  public:
+
+    /**
+     * Offset basis of the 64 bits FNV-1a hash.
+     */
+    static const uint64 FNV_OFFSET_BASIS;
+
+    /**
+     * Prime of the 64 bits FNV-1a hash.
+     */
+    static const uint64 FNV_PRIME;
+
+    /**
+     * 64 bits FNV-1a hash of a block of bytes.
+     *
+     * @param data Bytes to hash.
+     * @param dataSize Number of bytes.
+     * @param seed Hash of the previous blocks, to hash several blocks as if
+     * they were contiguous.
+     *
+     * @return The hash.
+     */
+    static uint64
+    Fnv1a(const void* data, const hkSize& dataSize, const uint64& seed = FNV_OFFSET_BASIS);
+  };
+}
\ No newline at end of file
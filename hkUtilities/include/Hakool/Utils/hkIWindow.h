@@ -96,6 +96,19 @@ namespace hk
     virtual void
     present() = 0;
 
+    /**
+     * Make the graphic context of the window current on the calling thread.
+     */
+    virtual void
+    makeContextCurrent() = 0;
+
+    /**
+     * Detach the graphic context of the window from the calling thread, so
+     * another thread can make it current.
+     */
+    virtual void
+    releaseContext() = 0;
+
     /**
     * Destroy this window and release its resources.
     */
@@ -108,7 +121,7 @@ namespace hk
      * @param observer Observer.
      */
     virtual void
-    addObserver(const WindowObserver* pObserver) = 0;
+    addObserver(WindowObserver* pObserver) = 0;
 
     /**
     * Get the size of the rendering region of the window (pixels).
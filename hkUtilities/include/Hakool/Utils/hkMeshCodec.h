@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Hakool/Utils/hkUtilsPrerequisites.h"
+
+namespace hk
+{
+  /**
+   * Lossless codec for vertex and index buffers.
+   *
+   * Vertex buffers are encoded in blocks of 256 vertices. Every byte of the
+   * vertex is stored as its own plane, delta encoded against the previous
+   * vertex, zigzagged and bit packed in groups of 16 values (0, 2, 4 or 8
+   * bits each). Decoding a group is a handful of SSE2 instructions.
+   *
+   * Index buffers are delta encoded against the previous index, zigzagged
+   * and written as varints, which works best on cache optimized orders.
+   *
+   * Every encoded buffer is independent, so chunks of a big buffer can be
+   * decoded in parallel or as they are streamed.
+   */
+  class HK_UTILITY_EXPORT MeshCodec
+  {
+  public:
+
+    /**
+     * Encode a vertex buffer, appending the result to the output.
+     *
+     * @param vertices Vertex data.
+     * @param verticesSize Number of vertices.
+     * @param stride Size of a vertex in bytes.
+     * @param out Encoded data.
+     */
+    static void
+    EncodeVertexBuffer
+    (
+      const uint8* vertices,
+      const uint32& verticesSize,
+      const uint32& stride,
+      Vector<uint8>& out
+    );
+
+    /**
+     * Decode a vertex buffer.
+     *
+     * @param vertices Output vertex data, verticesSize * stride bytes.
+     * @param verticesSize Number of vertices.
+     * @param stride Size of a vertex in bytes.
+     * @param data Encoded data.
+     * @param dataSize Size of the encoded data.
+     *
+     * @return False if the encoded data is malformed.
+     */
+    static bool
+    DecodeVertexBuffer
+    (
+      uint8* vertices,
+      const uint32& verticesSize,
+      const uint32& stride,
+      const uint8* data,
+      const hkSize& dataSize
+    );
+
+    /**
+     * Encode an index buffer, appending the result to the output.
+     *
+     * @param indices Indices.
+     * @param indicesSize Number of indices.
+     * @param out Encoded data.
+     */
+    static void
+    EncodeIndexBuffer
+    (
+      const uint32* indices,
+      const uint32& indicesSize,
+      Vector<uint8>& out
+    );
+
+    /**
+     * Decode an index buffer.
+     *
+     * @param indices Output indices.
+     * @param indicesSize Number of indices.
+     * @param data Encoded data.
+     * @param dataSize Size of the encoded data.
+     *
+     * @return False if the encoded data is malformed.
+     */
+    static bool
+    DecodeIndexBuffer
+    (
+      uint32* indices,
+      const uint32& indicesSize,
+      const uint8* data,
+      const hkSize& dataSize
+    );
+  };
+}
\ No newline at end of file
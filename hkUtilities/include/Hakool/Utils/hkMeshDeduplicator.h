@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Hakool/Utils/hkUtilsPrerequisites.h"
+
+namespace hk
+{
+  struct Vertex;
+  class MultiMesh;
+
+  /**
+   * Finds the meshes of a multimesh with the same content, keeps a single
+   * copy of them and describes their repetitions as instances.
+   */
+  class HK_UTILITY_EXPORT MeshDeduplicator
+  {
+  public:
+
+    /**
+     * Hash of the vertices and indices of a mesh. Identical meshes have the
+     * same hash, and the same hash is used to share meshes between files.
+     *
+     * @param vertices Vertices of the mesh.
+     * @param verticesSize Number of vertices.
+     * @param indices Indices of the mesh, relative to its first vertex.
+     * @param indicesSize Number of indices.
+     */
+    static uint64
+    ContentHash
+    (
+      const Vertex* vertices,
+      const uint32& verticesSize,
+      const uint32* indices,
+      const uint32& indicesSize
+    );
+
+    /**
+     * Build the deduplicated copy of a multimesh.
+     *
+     * Meshes with the same content as a previous mesh are dropped and the
+     * nodes are remapped to the kept copy. The instances of the result list,
+     * for every mesh drawn by the nodes, the transforms it is drawn with.
+     *
+     * LODs, quantized vertices and batch ranges are not copied, they should
+     * be generated on the deduplicated multimesh.
+     *
+     * @param pMultiMesh Source multimesh, not modified. The content hashes
+     * of its meshes must be computed.
+     *
+     * @return The new multimesh, owned by the caller.
+     */
+    static MultiMesh*
+    Deduplicate(MultiMesh* pMultiMesh);
+  };
+}
\ No newline at end of file
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "Hakool/Utils/hkUtilsPrerequisites.h"
+
+namespace hk
+{
+  /**
+   * Streams stored in the chunks of a mesh file.
+   */
+  enum class HK_UTILITY_EXPORT eMESH_FILE_STREAM : uint32
+  {
+    kVertices,
+    kQuantizedVertices,
+    kIndices,
+    kLodIndices
+  };
+
+  /**
+   * Header of a ".hkmesh" file. The file is laid out as:
+   *  - MeshFileHeader.
+   *  - Metadata: meshes with their bounds, nodes, node meshes indices, mesh
+   *    names, LODs, batch ranges and instances, metadataSize bytes, in the
+   *    MultiMesh layout. The node bounds are computed on load.
+   *  - Table of chunksSize MeshFileChunk.
+   *  - Chunk data, each chunk encoded on its own with MeshCodec.
+   *
+   * All the values are little endian.
+   */
+  struct HK_UTILITY_EXPORT MeshFileHeader
+  {
+  public:
+
+    MeshFileHeader();
+
+    /**
+     * "HKMS".
+     */
+    static const uint32 MAGIC;
+
+    static const uint32 VERSION;
+
+    /**
+     * The file has the float vertices.
+     */
+    static const uint32 FLAG_FLOAT_VERTICES;
+
+    /**
+     * The file has the quantized vertices. Without float vertices, the
+     * loaded multimesh only keeps the quantized ones.
+     */
+    static const uint32 FLAG_QUANTIZED_VERTICES;
+
+    /**
+     * Size of the header in the file.
+     */
+    static const uint32 SIZE;
+
+    uint32
+    magic;
+
+    uint32
+    version;
+
+    uint32
+    flags;
+
+    uint32
+    verticesSize;
+
+    uint32
+    indicesSize;
+
+    uint32
+    meshesSize;
+
+    uint32
+    nodesSize;
+
+    uint32
+    nodeMeshesIndicesSize;
+
+    uint32
+    namesSize;
+
+    uint32
+    lodsSize;
+
+    uint32
+    lodIndicesSize;
+
+    uint32
+    batchRangesSize;
+
+    /**
+     * Number of nodes of the multimesh the batch ranges come from.
+     */
+    uint32
+    batchSourceNodesSize;
+
+    /**
+     * Number of meshes of the multimesh the batch ranges come from.
+     */
+    uint32
+    batchSourceMeshesSize;
+
+    uint32
+    instancesSize;
+
+    uint32
+    instanceTransformsSize;
+
+    uint32
+    chunksSize;
+
+    uint32
+    metadataSize;
+  };
+
+  /**
+   * Entry of the chunk table of a mesh file.
+   */
+  struct HK_UTILITY_EXPORT MeshFileChunk
+  {
+  public:
+
+    MeshFileChunk();
+
+    /**
+     * Maximum number of vertices in a chunk.
+     */
+    static const uint32 VERTICES_PER_CHUNK;
+
+    /**
+     * Maximum number of indices in a chunk, a multiple of 3.
+     */
+    static const uint32 INDICES_PER_CHUNK;
+
+    /**
+     * Size of a chunk table entry in the file.
+     */
+    static const uint32 SIZE;
+
+    eMESH_FILE_STREAM
+    stream;
+
+    /**
+     * Index of the first element of the stream in this chunk.
+     */
+    uint32
+    firstElement;
+
+    uint32
+    elementsSize;
+
+    /**
+     * Size of the encoded data.
+     */
+    uint32
+    dataSize;
+
+    /**
+     * Offset of the encoded data from the start of the file.
+     */
+    uint64
+    offset;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Hakool/Utils/hkUtilsPrerequisites.h"
+#include "Hakool/Utils/hkUtilitiesUtilities.h"
+
+namespace hk
+{
+  class MultiMesh;
+
+  /**
+   * Writes a MultiMesh to a compressed mesh file. The vertex and index
+   * streams are split in chunks and every chunk is encoded with MeshCodec, so
+   * they can be decoded in parallel when the file is loaded.
+   */
+  class HK_UTILITY_EXPORT MeshFileWriter
+  {
+  public:
+
+    MeshFileWriter();
+
+    ~MeshFileWriter();
+
+    /**
+     * Writes the multimesh to the file at the given path.
+     */
+    eRESULT
+    write(MultiMesh* pMultiMesh, const String& path);
+
+    /**
+     * Writes the multimesh to the given buffer.
+     */
+    eRESULT
+    write(MultiMesh* pMultiMesh, Vector<uint8>& out);
+
+    /**
+     * Set if the float vertices are written when the multimesh has quantized
+     * vertices. Without them the file is smaller, and the loaded multimesh
+     * only keeps the quantized vertices. Multimeshes quantized by the
+     * VertexQuantizer have no float vertices to write.
+     */
+    void
+    setWriteFloatVertices(const bool& writeFloatVertices);
+
+    const bool&
+    getWriteFloatVertices() const;
+
+  private:
+
+    bool
+    _m_writeFloatVertices;
+  };
+}
\ No newline at end of file
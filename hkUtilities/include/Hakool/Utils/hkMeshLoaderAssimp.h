@@ -3,6 +3,7 @@
 #include "Hakool/Utils/hkMatrix4.h"
 #include "Hakool/Utils/hkIMeshLoader.h"
 #include "Hakool/Utils/hkAiMeshNode.h"
+#include "Hakool/Utils/hkUtilitiesUtilities.h"
 
 struct aiNode;
 struct aiScene;
@@ -21,11 +22,26 @@ namespace hk
 
     MeshLoaderAssimp();
 
+    MeshLoaderAssimp(const MeshImportConfiguration& configuration);
+
     virtual ~MeshLoaderAssimp();
 
     virtual MultiMesh*
     load(String path) override;
 
+    void
+    setConfiguration(const MeshImportConfiguration& configuration);
+
+    const MeshImportConfiguration&
+    getConfiguration() const;
+
+    /**
+     * Get the files the last load read besides the loaded one, like the
+     * buffers of a glTF file or the materials of an OBJ file.
+     */
+    const Vector<String>&
+    getDependencies() const;
+
   private:
 
     void
@@ -62,5 +78,11 @@ namespace hk
       Vector<AiMeshNode*>& aiMeshNodes,
       MultiMesh* pMultiMesh
     );
+
+    MeshImportConfiguration
+    _m_configuration;
+
+    Vector<String>
+    _m_dependencies;
   };
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Hakool/Utils/hkIMeshLoader.h"
+#include "Hakool/Utils/hkUtilitiesUtilities.h"
+
+namespace hk
+{
+  class MultiMesh;
+
+  /**
+   * Loads binary glTF 2.0 (.glb) files directly from their accessors,
+   * without building an Assimp scene. The file is mapped in memory and the
+   * vertex attributes are copied once, from the binary chunk to the
+   * multimesh.
+   *
+   * Other formats, and glTF features this loader doesn't read (external or
+   * embedded URI buffers, sparse accessors, required extensions), fall back
+   * to MeshLoaderAssimp.
+   */
+  class HK_UTILITY_EXPORT MeshLoaderGltf : public IMeshLoader
+  {
+  public:
+
+    MeshLoaderGltf();
+
+    MeshLoaderGltf(const MeshImportConfiguration& configuration);
+
+    virtual ~MeshLoaderGltf();
+
+    /**
+     * Loads the mesh file at the given path. Returns nullptr if a GLB file
+     * couldn't be read or is malformed.
+     */
+    virtual MultiMesh*
+    load(String path) override;
+
+    /**
+     * Loads a GLB file from memory. Returns nullptr if the data is malformed
+     * or uses a feature this loader doesn't read.
+     */
+    MultiMesh*
+    loadFromMemory(const uint8* data, const hkSize& dataSize);
+
+    void
+    setConfiguration(const MeshImportConfiguration& configuration);
+
+    const MeshImportConfiguration&
+    getConfiguration() const;
+
+    /**
+     * Get the files the last load read besides the loaded one. GLB files
+     * read directly have none.
+     */
+    const Vector<String>&
+    getDependencies() const;
+
+    /**
+     * Check if a file is a GLB file, by its extension.
+     */
+    static bool
+    IsGlb(const String& path);
+
+  private:
+
+    /**
+     * Parses a GLB file. Sets unsupported, and returns nullptr, if the file
+     * is valid but uses a feature this loader doesn't read.
+     */
+    MultiMesh*
+    parse(const uint8* data, const hkSize& dataSize, bool& unsupported);
+
+    MeshImportConfiguration
+    _m_configuration;
+
+    Vector<String>
+    _m_dependencies;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Hakool/Utils/hkIMeshLoader.h"
+#include "Hakool/Utils/hkUtilitiesUtilities.h"
+
+namespace hk
+{
+  class MultiMesh;
+
+  /**
+   * Loads the compressed mesh files written by MeshFileWriter. The chunks of
+   * the file are decoded in parallel.
+   */
+  class HK_UTILITY_EXPORT MeshLoaderNative : public IMeshLoader
+  {
+  public:
+
+    MeshLoaderNative();
+
+    virtual ~MeshLoaderNative();
+
+    /**
+     * Loads the mesh file at the given path. Returns nullptr if the file
+     * couldn't be read or is malformed.
+     */
+    virtual MultiMesh*
+    load(String path) override;
+
+    /**
+     * Loads a mesh file from memory. Returns nullptr if the data is malformed.
+     */
+    MultiMesh*
+    loadFromMemory(const uint8* data, const hkSize& dataSize);
+
+    /**
+     * Set the number of threads used to decode the chunks. Zero uses the
+     * number of hardware threads.
+     */
+    void
+    setThreadsSize(const uint32& threadsSize);
+
+    const uint32&
+    getThreadsSize() const;
+
+  private:
+
+    uint32
+    _m_threadsSize;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Hakool/Utils/hkUtilsPrerequisites.h"
+#include "Hakool/Utils/hkUtilitiesUtilities.h"
+
+namespace hk
+{
+  class MultiMesh;
+
+  /**
+   * Runs the optional import passes of a MeshImportConfiguration on a
+   * freshly loaded multimesh, so every mesh loader produces the same result.
+   */
+  class HK_UTILITY_EXPORT MeshPostProcessor
+  {
+  public:
+
+    /**
+     * Deduplicate, batch, generate the LODs and quantize the vertices, in
+     * that order, as enabled by the configuration.
+     *
+     * @param pMultiMesh Loaded multimesh, with its mesh bounds and content
+     * hashes computed. Released if a pass builds a new multimesh.
+     * @param configuration Passes to run.
+     *
+     * @return The processed multimesh, owned by the caller.
+     */
+    static MultiMesh*
+    Process(MultiMesh* pMultiMesh, const MeshImportConfiguration& configuration);
+  };
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Hakool/Utils/hkUtilsPrerequisites.h"
+
+namespace hk
+{
+  struct Vertex;
+  class MultiMesh;
+
+  /**
+   * Simplifies triangle lists with quadric error metrics. Edges are collapsed
+   * onto one of their vertices, so the simplified indices always reference
+   * the original vertices and a LOD only needs its own index buffer.
+   *
+   * Open borders are preserved with constraint planes along the boundary
+   * edges, and vertices with split attributes (seams) are only collapsed
+   * when every one of their copies has a matching copy on the target.
+   */
+  class HK_UTILITY_EXPORT MeshSimplifier
+  {
+  public:
+
+    MeshSimplifier();
+
+    ~MeshSimplifier();
+
+    /**
+     * Set the weight of the border constraint planes. Higher values keep
+     * the open borders closer to their original shape.
+     */
+    void
+    setBorderWeight(const float& weight);
+
+    const float&
+    getBorderWeight() const;
+
+    /**
+     * Set the weight of the attribute difference in the collapse cost.
+     */
+    void
+    setAttributeWeight(const float& weight);
+
+    const float&
+    getAttributeWeight() const;
+
+    /**
+     * Simplify a triangle list.
+     *
+     * @param vertices Vertices referenced by the indices.
+     * @param verticesSize Number of vertices.
+     * @param attributes Optional per vertex attributes (normals, uvs...),
+     * attributesSize floats per vertex. Can be nullptr.
+     * @param attributesSize Number of attribute floats per vertex.
+     * @param indices Triangle list indices.
+     * @param indicesSize Number of indices.
+     * @param targetIndicesSize Desired number of indices.
+     * @param maxError Maximum allowed deviation, in mesh units.
+     * @param outIndices Simplified triangle list.
+     *
+     * @return The deviation from the original surface, in mesh units.
+     */
+    float
+    simplify
+    (
+      const Vertex* vertices,
+      const uint32& verticesSize,
+      const float* attributes,
+      const uint32& attributesSize,
+      const uint32* indices,
+      const uint32& indicesSize,
+      const uint32& targetIndicesSize,
+      const float& maxError,
+      Vector<uint32>& outIndices
+    );
+
+    /**
+     * Generate a chain of LODs for every mesh of a MultiMesh and store it
+     * in the MultiMesh.
+     *
+     * @param pMultiMesh The MultiMesh.
+     * @param ratios Triangle ratio of each LOD relative to the full mesh,
+     * from finest to coarsest (e.g. 0.5, 0.25, 0.125).
+     */
+    void
+    generateLods(MultiMesh* pMultiMesh, const Vector<float>& ratios);
+
+  private:
+
+    float
+    _m_borderWeight;
+
+    float
+    _m_attributeWeight;
+  };
+}
\ No newline at end of file
@@ -1,31 +1,58 @@
 #pragma once
 
 #include "Hakool/Utils/hkUtilsPrerequisites.h"
+#include "Hakool/Utils/hkBoundingBox.h"
+#include "Hakool/Utils/hkBoundingSphere.h"
+#include "Hakool/Utils/hkMultiMeshLayout.h"
 
 namespace hk
 {
   struct Vertex;
+  struct QuantizedVertex;
   struct MultiMeshMesh;
   struct MultiMeshNode;
+  struct MultiMeshLod;
+  struct MultiMeshBatchRange;
+  struct MultiMeshInstance;
+  class Matrix4;
 
+  /**
+   * Meshes, nodes and their data, allocated in a single arena laid out by a
+   * MultiMeshLayout. The arena holds no pointers, the meshes and nodes
+   * address the other arrays by offsets.
+   */
   class HK_UTILITY_EXPORT MultiMesh
   {
   public:
 
-    MultiMesh
-    (
-      Vertex* vertices,
-      uint32 verticesSize,
-      uint32* indices,
-      uint32 indicesSize,
-      MultiMeshMesh* meshes,
-      uint32 meshesSize,
-      MultiMeshNode* nodes,
-      uint32 nodesSize
-    );
+    /**
+     * Allocate the arrays of the layout in one arena. The elements are
+     * default constructed.
+     */
+    explicit MultiMesh(const MultiMeshLayout& layout);
+
+    MultiMesh(MultiMesh&& other);
+
+    MultiMesh(const MultiMesh&) = delete;
 
     virtual ~MultiMesh();
 
+    MultiMesh&
+    operator=(MultiMesh&& other);
+
+    MultiMesh&
+    operator=(const MultiMesh&) = delete;
+
+    /**
+     * Get the size in bytes of the arena.
+     */
+    const hkSize&
+    getArenaSize() const;
+
+    /**
+     * Get the float vertices, nullptr if the multimesh only keeps the
+     * quantized ones.
+     */
     Vertex* const
     getVerticesPtr();
 
@@ -50,14 +77,246 @@ namespace hk
     const uint32&
     getNodesSize() const;
 
+    /**
+     * Get the mesh indices of all the nodes, addressed by
+     * MultiMeshNode::firstMeshIndexIndex.
+     */
+    uint32* const
+    getNodeMeshesIndicesPtr();
+
+    const uint32&
+    getNodeMeshesIndicesSize() const;
+
+    /**
+     * Get the terminated names of all the meshes, addressed by
+     * MultiMeshMesh::nameOffset.
+     */
+    char* const
+    getNamesPtr();
+
+    const uint32&
+    getNamesSize() const;
+
+    /**
+     * Get the name of a mesh, empty if it has none.
+     */
+    const char*
+    getMeshName(const uint32& meshIndex) const;
+
+    /**
+     * Copy the name of a mesh after the names already set. The names array
+     * must have room for it (see MultiMeshLayout::NameSize).
+     */
+    void
+    setMeshName(const uint32& meshIndex, const String& name);
+
+    /**
+     * Set the quantized copy of the vertices, decoded with the
+     * VertexQuantization of each mesh. The MultiMesh takes ownership of the
+     * array, which must have getVerticesSize() elements.
+     * <p>
+     * The arrays given to the setters are allocated on their own, apart from
+     * the arena; the arrays of the layout are filled through the getters.
+     */
+    void
+    setQuantizedVertices(QuantizedVertex* quantizedVertices);
+
+    /**
+     * Get the quantized vertices, nullptr if the vertices were not quantized.
+     * The count of both vertex arrays is getVerticesSize().
+     */
+    QuantizedVertex* const
+    getQuantizedVerticesPtr();
+
+    /**
+     * Set the simplified LODs of the meshes. The MultiMesh takes ownership
+     * of both arrays and releases the previous ones.
+     *
+     * @param lods LODs of every mesh, addressed by MultiMeshMesh::firstLodIndex.
+     * @param lodsSize Number of LODs.
+     * @param lodIndices Indices of every LOD, relative to its mesh vertices.
+     * @param lodIndicesSize Number of LOD indices.
+     */
+    void
+    setLods
+    (
+      MultiMeshLod* lods,
+      uint32 lodsSize,
+      uint32* lodIndices,
+      uint32 lodIndicesSize
+    );
+
+    MultiMeshLod* const
+    getLodsPtr();
+
+    const uint32&
+    getLodsSize() const;
+
+    uint32* const
+    getLodIndicesPtr();
+
+    const uint32&
+    getLodIndicesSize() const;
+
+    /**
+     * Choose the coarsest LOD of a mesh whose screen space error does not
+     * exceed the given threshold.
+     *
+     * @param meshIndex Index of the mesh.
+     * @param distance Distance from the camera to the mesh.
+     * @param projectionScale Pixels per world unit at distance one.
+     * @param maxScreenError Maximum allowed error in pixels.
+     *
+     * @return 0 for the full mesh, i for the LOD at firstLodIndex + i - 1.
+     */
+    uint32
+    selectLod
+    (
+      const uint32& meshIndex,
+      const float& distance,
+      const float& projectionScale,
+      const float& maxScreenError
+    );
+
+    /**
+     * Set the batch ranges of a multimesh built by StaticBatcher. The
+     * MultiMesh takes ownership of the array and releases the previous one.
+     *
+     * @param batchRanges Ranges sorted by their first index.
+     * @param batchRangesSize Number of ranges.
+     */
+    void
+    setBatchRanges(MultiMeshBatchRange* batchRanges, uint32 batchRangesSize);
+
+    MultiMeshBatchRange* const
+    getBatchRangesPtr();
+
+    const uint32&
+    getBatchRangesSize() const;
+
+    /**
+     * Set the number of nodes and meshes of the multimesh the batch ranges
+     * come from, the range of their source indices.
+     */
+    void
+    setBatchSource(const uint32& nodesSize, const uint32& meshesSize);
+
+    const uint32&
+    getBatchSourceNodesSize() const;
+
+    const uint32&
+    getBatchSourceMeshesSize() const;
+
+    /**
+     * Find the batch range that contains an index, to know the source node
+     * and mesh of a picked triangle.
+     *
+     * @param indexIndex Position of the index in the indices of the
+     * multimesh, the first index of the mesh plus three times the triangle.
+     *
+     * @return The range, nullptr if the multimesh is not batched or the
+     * index is out of the ranges.
+     */
+    const MultiMeshBatchRange*
+    findBatchRange(const uint32& indexIndex) const;
+
+    /**
+     * Set the instances of a multimesh built by MeshDeduplicator. The
+     * MultiMesh takes ownership of both arrays and releases the previous
+     * ones.
+     *
+     * @param instances Meshes drawn by the nodes and their transforms.
+     * @param instancesSize Number of instances.
+     * @param instanceTransforms Transforms of every instance, addressed by
+     * MultiMeshInstance::firstTransformIndex.
+     * @param instanceTransformsSize Number of transforms.
+     */
+    void
+    setInstances
+    (
+      MultiMeshInstance* instances,
+      uint32 instancesSize,
+      Matrix4* instanceTransforms,
+      uint32 instanceTransformsSize
+    );
+
+    MultiMeshInstance* const
+    getInstancesPtr();
+
+    const uint32&
+    getInstancesSize() const;
+
+    Matrix4* const
+    getInstanceTransformsPtr();
+
+    const uint32&
+    getInstanceTransformsSize() const;
+
+    /**
+     * Compute the world space bounds of every node, and of the whole
+     * multimesh, from the mesh space bounds of the meshes and the node
+     * transforms. The vertices are not read.
+     */
+    void
+    computeNodesBounds();
+
+    /**
+     * Get the world space bounding box of all the nodes.
+     */
+    const BoundingBox&
+    getBoundingBox() const;
+
+    /**
+     * Get the world space bounding sphere of all the nodes.
+     */
+    const BoundingSphere&
+    getBoundingSphere() const;
+
    protected:
 
+     /**
+      * Release the arena and the arrays allocated apart from it.
+      */
+     void
+     release();
+
+     /**
+      * Leave this multimesh empty, without releasing anything.
+      */
+     void
+     reset();
+
+     /**
+      * Check if an array is in the arena.
+      */
+     bool
+     isInArena(const void* array) const;
+
+     /**
+      * Allocation of the arena, ALIGNMENT - 1 bytes bigger than it so the
+      * arena can start aligned in it.
+      */
+     uint8*
+     _m_arenaAllocation;
+
+     /**
+      * Start of the arena, aligned to MultiMeshLayout::ALIGNMENT.
+      */
+     uint8*
+     _m_arena;
+
+     hkSize
+     _m_arenaSize;
+
      Vertex*
      _m_vertices;
 
      uint32
      _m_verticesSize;
 
+     QuantizedVertex*
+     _m_quantizedVertices;
+
      uint32*
      _m_indices;
 
@@ -75,5 +334,65 @@ namespace hk
 
      uint32
      _m_nodesSize;
+
+     uint32*
+     _m_nodeMeshesIndices;
+
+     uint32
+     _m_nodeMeshesIndicesSize;
+
+     char*
+     _m_names;
+
+     uint32
+     _m_namesSize;
+
+     /**
+      * Bytes of the names array used by setMeshName.
+      */
+     uint32
+     _m_namesUsed;
+
+     MultiMeshLod*
+     _m_lods;
+
+     uint32
+     _m_lodsSize;
+
+     uint32*
+     _m_lodIndices;
+
+     uint32
+     _m_lodIndicesSize;
+
+     MultiMeshBatchRange*
+     _m_batchRanges;
+
+     uint32
+     _m_batchRangesSize;
+
+     uint32
+     _m_batchSourceNodesSize;
+
+     uint32
+     _m_batchSourceMeshesSize;
+
+     MultiMeshInstance*
+     _m_instances;
+
+     uint32
+     _m_instancesSize;
+
+     Matrix4*
+     _m_instanceTransforms;
+
+     uint32
+     _m_instanceTransformsSize;
+
+     BoundingBox
+     _m_boundingBox;
+
+     BoundingSphere
+     _m_boundingSphere;
   };
 }
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Hakool/Utils/hkUtilsPrerequisites.h"
+
+namespace hk
+{
+  /**
+   * Range of indices of a batched mesh that comes from a mesh of a node of
+   * the source multimesh (see StaticBatcher).
+   */
+  struct HK_UTILITY_EXPORT MultiMeshBatchRange
+  {
+  public:
+
+    MultiMeshBatchRange();
+
+    MultiMeshBatchRange
+    (
+      const uint32& firstIndexIndex,
+      const uint32& indicesSize,
+      const uint32& sourceNodeIndex,
+      const uint32& sourceMeshIndex
+    );
+
+    /**
+     * Index of the first index of the range in the indices of the multimesh.
+     */
+    uint32
+    firstIndexIndex;
+
+    uint32
+    indicesSize;
+
+    uint32
+    sourceNodeIndex;
+
+    uint32
+    sourceMeshIndex;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Hakool/Utils/hkUtilsPrerequisites.h"
+
+namespace hk
+{
+  /**
+   * A mesh of a multimesh drawn with several transforms, one per node that
+   * references it (see MeshDeduplicator).
+   */
+  struct HK_UTILITY_EXPORT MultiMeshInstance
+  {
+  public:
+
+    MultiMeshInstance();
+
+    MultiMeshInstance
+    (
+      const uint32& meshIndex,
+      const uint32& firstTransformIndex,
+      const uint32& transformsSize
+    );
+
+    uint32
+    meshIndex;
+
+    /**
+     * Index of the first transform of this mesh in the instance transforms
+     * of the multimesh.
+     */
+    uint32
+    firstTransformIndex;
+
+    uint32
+    transformsSize;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Hakool/Utils/hkUtilsPrerequisites.h"
+
+namespace hk
+{
+  /**
+   * Sizes of the arrays of a MultiMesh. The MultiMesh allocates all of them
+   * in a single arena, at offsets computed from these sizes.
+   */
+  struct HK_UTILITY_EXPORT MultiMeshLayout
+  {
+  public:
+
+    MultiMeshLayout();
+
+    /**
+     * Size in bytes of a name in the names array, with its terminator.
+     */
+    static uint32
+    NameSize(const String& name);
+
+    /**
+     * Size in bytes of the arena, with every array aligned to ALIGNMENT.
+     */
+    hkSize
+    getArenaSize() const;
+
+    /**
+     * Alignment of the arrays in the arena.
+     */
+    static const hkSize ALIGNMENT;
+
+    uint32
+    verticesSize;
+
+    /**
+     * Allocate the float vertices. Quantized multimeshes leave them out.
+     */
+    bool
+    floatVertices;
+
+    /**
+     * Allocate the quantized vertices.
+     */
+    bool
+    quantizedVertices;
+
+    uint32
+    indicesSize;
+
+    uint32
+    meshesSize;
+
+    uint32
+    nodesSize;
+
+    /**
+     * Number of mesh indices of all the nodes.
+     */
+    uint32
+    nodeMeshesIndicesSize;
+
+    /**
+     * Bytes of all the mesh names (see NameSize).
+     */
+    uint32
+    namesSize;
+
+    uint32
+    lodsSize;
+
+    uint32
+    lodIndicesSize;
+
+    uint32
+    batchRangesSize;
+
+    uint32
+    instancesSize;
+
+    uint32
+    instanceTransformsSize;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Hakool/Utils/hkUtilsPrerequisites.h"
+
+namespace hk
+{
+  /**
+   * A simplified level of detail of a MultiMeshMesh. A LOD reuses the
+   * vertices of its mesh and only stores its own range of indices in the
+   * LOD indices array of the MultiMesh.
+   */
+  struct HK_UTILITY_EXPORT MultiMeshLod
+  {
+  public:
+
+    MultiMeshLod();
+
+    MultiMeshLod
+    (
+      const uint32& firstIndexIndex,
+      const uint32& indicesSize,
+      const float& error
+    );
+
+    /**
+     * Get the error of this LOD projected on the screen.
+     *
+     * @param distance Distance from the camera to the mesh.
+     * @param projectionScale Pixels per world unit at distance one, usually
+     * viewportHeight / (2 * tan(fovY / 2)).
+     *
+     * @return The error in pixels.
+     */
+    float
+    getScreenSpaceError(const float& distance, const float& projectionScale) const;
+
+    /**
+     * Index of the first LOD index in the LOD indices array of the MultiMesh.
+     */
+    uint32
+    firstIndexIndex;
+
+    /**
+     * Number of indices of this LOD.
+     */
+    uint32
+    indicesSize;
+
+    /**
+     * Maximum deviation from the original surface, in mesh units.
+     */
+    float
+    error;
+  };
+}
\ No newline at end of file
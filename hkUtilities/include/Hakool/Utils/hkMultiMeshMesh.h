@@ -2,6 +2,9 @@
 
 #include "Hakool/Utils/hkUtilsPrerequisites.h"
 #include "Hakool/Utils/hkMultiMeshNode.h"
+#include "Hakool/Utils/hkQuantizedVertex.h"
+#include "Hakool/Utils/hkBoundingBox.h"
+#include "Hakool/Utils/hkBoundingSphere.h"
 
 namespace hk
 {
@@ -11,17 +14,23 @@ namespace hk
 
     MultiMeshMesh
     (
-      String name,
       uint32 firstVertexIndex,
       uint32 verticesSize,
       uint32 firstIndexIndex,
       uint32 indicesSize
     );
 
-    explicit MultiMeshMesh(const MultiMeshMesh&);
+    /**
+     * Name offset of the meshes without a name.
+     */
+    static const uint32 NO_NAME;
 
-    String
-    name;
+    /**
+     * Offset of the name of this mesh in the names of the MultiMesh, or
+     * NO_NAME (see MultiMesh::getMeshName).
+     */
+    uint32
+    nameOffset;
 
     uint32
     firstVertexIndex;
@@ -34,5 +43,49 @@ namespace hk
 
     uint32
     indicesSize;
+
+    /**
+     * Index of the material of this mesh in the imported scene.
+     */
+    uint32
+    materialIndex;
+
+    /**
+     * Hash of the vertices and indices of this mesh (see
+     * MeshDeduplicator::ContentHash).
+     */
+    uint64
+    contentHash;
+
+    /**
+     * Index of the first LOD of this mesh in the LODs array of the MultiMesh.
+     * LOD zero is the mesh itself and is not stored.
+     */
+    uint32
+    firstLodIndex;
+
+    /**
+     * Number of simplified LODs of this mesh.
+     */
+    uint32
+    lodsSize;
+
+    /**
+     * Decoding parameters of the quantized vertices of this mesh.
+     */
+    VertexQuantization
+    quantization;
+
+    /**
+     * Bounding box of the vertices of this mesh, in mesh space.
+     */
+    BoundingBox
+    boundingBox;
+
+    /**
+     * Bounding sphere of the vertices of this mesh, in mesh space.
+     */
+    BoundingSphere
+    boundingSphere;
   };
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "Hakool/Utils/hkUtilsPrerequisites.h"
 #include "Hakool/Utils/hkMatrix4.h"
+#include "Hakool/Utils/hkBoundingBox.h"
+#include "Hakool/Utils/hkBoundingSphere.h"
 
 namespace hk
 {
@@ -13,22 +15,34 @@ namespace hk
 
     MultiMeshNode
     (
-      uint32* meshesIndices,
+      const uint32& firstMeshIndexIndex,
       const uint32& meshesIndicesSize,
       const Matrix4& transform
     );
 
-    explicit MultiMeshNode(const MultiMeshNode& copy);
-
-    ~MultiMeshNode();
-
-    uint32*
-    meshesIndices;
+    /**
+     * Index of the first mesh index of this node in the node meshes indices
+     * of the MultiMesh.
+     */
+    uint32
+    firstMeshIndexIndex;
 
     uint32
     meshesIndicesSize;
 
     Matrix4
     transform;
+
+    /**
+     * Bounding box of the meshes of this node, in world space.
+     */
+    BoundingBox
+    boundingBox;
+
+    /**
+     * Bounding sphere of the meshes of this node, in world space.
+     */
+    BoundingSphere
+    boundingSphere;
   };
 }
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Hakool/Utils/hkUtilsPrerequisites.h"
+#include "Hakool/Utils/hkVector3.h"
+
+namespace hk
+{
+  /**
+   * Compressed Vertex, 20 bytes instead of 44:
+   *  - Position: unsigned normalized 16 bit, relative to the mesh AABB.
+   *  - Normal and tangent: signed normalized 16 bit octahedral encoding.
+   *  - Texture coordinates: half floats.
+   */
+  struct HK_UTILITY_EXPORT QuantizedVertex
+  {
+  public:
+
+    QuantizedVertex();
+
+    uint16
+    px;
+
+    uint16
+    py;
+
+    uint16
+    pz;
+
+    /**
+     * Padding, keeps the normal aligned to 4 bytes.
+     */
+    uint16
+    pw;
+
+    int16
+    nx;
+
+    int16
+    ny;
+
+    int16
+    tx;
+
+    int16
+    ty;
+
+    uint16
+    u;
+
+    uint16
+    v;
+  };
+
+  /**
+   * Parameters needed to decode the QuantizedVertex of a mesh, and the
+   * maximum errors measured when they were encoded.
+   */
+  struct HK_UTILITY_EXPORT VertexQuantization
+  {
+  public:
+
+    VertexQuantization();
+
+    /**
+     * Minimum corner of the mesh AABB. position = offset + scale * unorm.
+     */
+    Vector3f
+    positionOffset;
+
+    /**
+     * Size of the mesh AABB.
+     */
+    Vector3f
+    positionScale;
+
+    /**
+     * Maximum position error per axis, in mesh units.
+     */
+    float
+    positionError;
+
+    /**
+     * Maximum angle between an original and a decoded normal, in radians.
+     */
+    float
+    normalError;
+
+    /**
+     * Maximum angle between an original and a decoded tangent, in radians.
+     */
+    float
+    tangentError;
+
+    /**
+     * Maximum texture coordinate error.
+     */
+    float
+    uvError;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Hakool/Utils/hkUtilsPrerequisites.h"
+
+namespace hk
+{
+  /**
+   * Allocates ranges of a linear space, like the elements of a buffer. Only
+   * the bookkeeping is done here, the owner of the space moves the data.
+   *
+   * Free ranges are kept sorted by offset and merged with their neighbours
+   * when released. Allocations take the smallest free range they fit in.
+   */
+  class HK_UTILITY_EXPORT RangeAllocator
+  {
+  public:
+
+    /**
+     * Offset returned when an allocation doesn't fit.
+     */
+    static const uint32 INVALID_OFFSET;
+
+    RangeAllocator();
+
+    /**
+     * Free everything and set the size of the space.
+     *
+     * @param capacity Size of the space.
+     */
+    void
+    reset(const uint32& capacity);
+
+    /**
+     * Enlarge the space. The new part is free.
+     *
+     * @param capacity New size of the space, not smaller than the current one.
+     */
+    void
+    grow(const uint32& capacity);
+
+    /**
+     * Allocate a range.
+     *
+     * @param size Size of the range, not zero.
+     *
+     * @return Offset of the range, or INVALID_OFFSET if no free range is big
+     * enough.
+     */
+    uint32
+    allocate(const uint32& size);
+
+    /**
+     * Release a range given by allocate.
+     *
+     * @param offset Offset of the range.
+     * @param size Size of the range.
+     */
+    void
+    free(const uint32& offset, const uint32& size);
+
+    uint32
+    getCapacity() const;
+
+    uint32
+    getUsedSize() const;
+
+    /**
+     * Size of the largest allocation that would succeed.
+     */
+    uint32
+    getLargestFreeRange() const;
+
+    /**
+     * Number of separate free ranges.
+     */
+    uint32
+    getFreeRangesSize() const;
+
+    /**
+     * Check if the free space is split enough that compacting the
+     * allocations is worth it: the largest free range is less than half of
+     * the free space.
+     */
+    bool
+    isFragmented() const;
+
+  private:
+
+    struct FreeRange
+    {
+      uint32 offset;
+      uint32 size;
+    };
+
+    /**
+     * Insert a free range, merging it with its neighbours.
+     */
+    void
+    _insertFreeRange(const uint32& offset, const uint32& size);
+
+    /**
+     * Free ranges sorted by offset, never adjacent.
+     */
+    Vector<FreeRange>
+    _m_freeRanges;
+
+    uint32
+    _m_capacity;
+
+    uint32
+    _m_usedSize;
+  };
+}
\ No newline at end of file
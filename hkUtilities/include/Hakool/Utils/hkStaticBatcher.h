@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Hakool/Utils/hkUtilsPrerequisites.h"
+
+namespace hk
+{
+  class MultiMesh;
+
+  /**
+   * Bakes the node transforms of a multimesh into its vertices and merges
+   * the meshes that share a material, so a static model is drawn with a draw
+   * per material.
+   */
+  class HK_UTILITY_EXPORT StaticBatcher
+  {
+  public:
+
+    /**
+     * Build the batched copy of a multimesh.
+     *
+     * Every mesh drawn by a node is copied with the node transform applied
+     * to its vertices, in model space. The copies of the same material are
+     * merged in one mesh, drawn by a single node with the identity
+     * transform. Meshes not drawn by any node are dropped. The batch ranges
+     * of the result map its indices back to the source nodes and meshes.
+     *
+     * LODs and quantized vertices are not copied, they should be generated
+     * on the batched multimesh.
+     *
+     * @param pMultiMesh Source multimesh, not modified.
+     *
+     * @return The new multimesh, owned by the caller.
+     */
+    static MultiMesh*
+    Batch(MultiMesh* pMultiMesh);
+  };
+}
\ No newline at end of file
@@ -63,6 +63,52 @@ namespace hk
     title;
   };
 
+  /**
+  * Configuration object that specifies how meshes are processed on import.
+  */
+  struct HK_UTILITY_EXPORT MeshImportConfiguration
+  {
+  public:
+    /**
+    * Constructor.
+    */
+    MeshImportConfiguration() :
+      lodRatios(),
+      quantizeVertices(false),
+      deduplicateMeshes(false),
+      staticBatching(false)
+    {
+      return;
+    }
+
+    /**
+    * Triangle ratio of each generated LOD relative to the full mesh, from
+    * finest to coarsest. Empty to skip the LOD generation.
+    */
+    Vector<float>
+    lodRatios;
+
+    /**
+    * Store a quantized copy of the vertices (see QuantizedVertex).
+    */
+    bool
+    quantizeVertices;
+
+    /**
+    * Keep a single copy of the meshes with the same content and describe
+    * their repetitions as instances (see MeshDeduplicator).
+    */
+    bool
+    deduplicateMeshes;
+
+    /**
+    * Bake the node transforms and merge the meshes by material (see
+    * StaticBatcher). Done before generating the LODs and quantizing.
+    */
+    bool
+    staticBatching;
+  };
+
   /**
   * Check if two float values are relatively equal.
   *
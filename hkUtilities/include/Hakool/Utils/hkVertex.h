@@ -22,5 +22,38 @@ namespace hk
 
     float
     z;
+
+    /**
+     * Normal.
+     */
+    float
+    nx;
+
+    float
+    ny;
+
+    float
+    nz;
+
+    /**
+     * Tangent.
+     */
+    float
+    tx;
+
+    float
+    ty;
+
+    float
+    tz;
+
+    /**
+     * Texture coordinates.
+     */
+    float
+    u;
+
+    float
+    v;
   };
 }
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Hakool/Utils/hkUtilsPrerequisites.h"
+#include "Hakool/Utils/hkVector3.h"
+#include "Hakool/Utils/hkQuantizedVertex.h"
+
+namespace hk
+{
+  struct Vertex;
+  class MultiMesh;
+
+  /**
+   * Encodes and decodes QuantizedVertex.
+   */
+  class HK_UTILITY_EXPORT VertexQuantizer
+  {
+  public:
+
+    /**
+     * Quantize an array of vertices relative to their AABB.
+     *
+     * @param vertices Vertices to encode.
+     * @param verticesSize Number of vertices.
+     * @param quantizedVertices Output array, verticesSize elements.
+     *
+     * @return The decoding parameters and the measured errors.
+     */
+    static VertexQuantization
+    Quantize
+    (
+      const Vertex* vertices,
+      const uint32& verticesSize,
+      QuantizedVertex* quantizedVertices
+    );
+
+    /**
+     * Decode an array of quantized vertices.
+     *
+     * @param quantizedVertices Vertices to decode.
+     * @param verticesSize Number of vertices.
+     * @param quantization Decoding parameters.
+     * @param vertices Output array, verticesSize elements.
+     */
+    static void
+    Dequantize
+    (
+      const QuantizedVertex* quantizedVertices,
+      const uint32& verticesSize,
+      const VertexQuantization& quantization,
+      Vertex* vertices
+    );
+
+    /**
+     * Quantize every mesh of a MultiMesh, each one relative to its own AABB.
+     *
+     * @param pMultiMesh MultiMesh to quantize, left unchanged.
+     *
+     * @return A new MultiMesh with the same meshes, that keeps only the
+     * quantized vertices.
+     */
+    static MultiMesh*
+    QuantizeMultiMesh(MultiMesh* pMultiMesh);
+
+    /**
+     * Encode a unit vector with the octahedral mapping.
+     */
+    static void
+    EncodeOctahedral(const Vector3f& _v, int16& _x, int16& _y);
+
+    /**
+     * Decode an octahedral encoded unit vector.
+     */
+    static Vector3f
+    DecodeOctahedral(const int16& _x, const int16& _y);
+
+    /**
+     * Convert a float to a IEEE 754 half float, rounding to nearest.
+     */
+    static uint16
+    FloatToHalf(const float& _value);
+
+    /**
+     * Convert a IEEE 754 half float to a float.
+     */
+    static float
+    HalfToFloat(const uint16& _value);
+  };
+}
\ No newline at end of file
@@ -19,6 +19,6 @@ namespace hk
      * @param window Reference to the window which size has changed.
      */
     virtual void
-    onWindowSizeChanged(const uint32& width, const uint32& height, IWindow* window) const = 0;
+    onWindowSizeChanged(const uint32& width, const uint32& height, IWindow* window) = 0;
   };
 }
\ No newline at end of file
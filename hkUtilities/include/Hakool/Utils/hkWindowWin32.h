@@ -42,6 +42,12 @@ namespace hk
     virtual void
     present() override;
 
+    virtual void
+    makeContextCurrent() override;
+
+    virtual void
+    releaseContext() override;
+
     virtual HANDLER
     getWindowHandler() override;
 
@@ -49,7 +55,7 @@ namespace hk
     destroy() override;
 
     virtual void
-    addObserver(const WindowObserver* pObserver) override;
+    addObserver(WindowObserver* pObserver) override;
 
     virtual Vector2u
     getSize() override;
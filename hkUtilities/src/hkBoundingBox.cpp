@@ -0,0 +1,171 @@
+#include "Hakool/Utils/hkBoundingBox.h"
+
+#include "Hakool/Utils/hkMatrix4.h"
+
+#if HK_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace hk
+{
+  BoundingBox::BoundingBox() :
+    minimum
+    (
+      std::numeric_limits<float>::max(),
+      std::numeric_limits<float>::max(),
+      std::numeric_limits<float>::max()
+    ),
+    maximum
+    (
+      -std::numeric_limits<float>::max(),
+      -std::numeric_limits<float>::max(),
+      -std::numeric_limits<float>::max()
+    )
+  { }
+
+  BoundingBox::BoundingBox(const Vector3f& _minimum, const Vector3f& _maximum) :
+    minimum(_minimum),
+    maximum(_maximum)
+  { }
+
+  BoundingBox
+  BoundingBox::FromPositions
+  (
+    const float* positions,
+    const uint32& positionsSize,
+    const uint32& stride
+  )
+  {
+    BoundingBox box;
+    if (0 == positionsSize)
+      return box;
+
+    const uint8* bytes = reinterpret_cast<const uint8*>(positions);
+    uint32 i = 0;
+
+#if HK_SSE2
+    // Loads four floats per position, the fourth lane is ignored. The loads
+    // stay inside the array only if every position is followed by another
+    // float, so packed positions use the scalar loop.
+    if (stride >= 4 * sizeof(float))
+    {
+      __m128 minimum0 = _mm_loadu_ps(positions);
+      __m128 maximum0 = minimum0;
+      __m128 minimum1 = minimum0;
+      __m128 maximum1 = minimum0;
+
+      for (; i + 2 <= positionsSize; i += 2)
+      {
+        __m128 position0 = _mm_loadu_ps(reinterpret_cast<const float*>(bytes + i * stride));
+        __m128 position1 = _mm_loadu_ps(reinterpret_cast<const float*>(bytes + (i + 1) * stride));
+        minimum0 = _mm_min_ps(minimum0, position0);
+        maximum0 = _mm_max_ps(maximum0, position0);
+        minimum1 = _mm_min_ps(minimum1, position1);
+        maximum1 = _mm_max_ps(maximum1, position1);
+      }
+
+      float minimum[4];
+      float maximum[4];
+      _mm_storeu_ps(minimum, _mm_min_ps(minimum0, minimum1));
+      _mm_storeu_ps(maximum, _mm_max_ps(maximum0, maximum1));
+
+      box.minimum = Vector3f(minimum[0], minimum[1], minimum[2]);
+      box.maximum = Vector3f(maximum[0], maximum[1], maximum[2]);
+    }
+#endif
+
+    for (; i < positionsSize; ++i)
+    {
+      const float* position = reinterpret_cast<const float*>(bytes + i * stride);
+      box.minimum.x = Math::Min(box.minimum.x, position[0]);
+      box.minimum.y = Math::Min(box.minimum.y, position[1]);
+      box.minimum.z = Math::Min(box.minimum.z, position[2]);
+      box.maximum.x = Math::Max(box.maximum.x, position[0]);
+      box.maximum.y = Math::Max(box.maximum.y, position[1]);
+      box.maximum.z = Math::Max(box.maximum.z, position[2]);
+    }
+
+    return box;
+  }
+
+  bool
+  BoundingBox::isValid() const
+  {
+    return minimum.x <= maximum.x && minimum.y <= maximum.y && minimum.z <= maximum.z;
+  }
+
+  void
+  BoundingBox::merge(const BoundingBox& box)
+  {
+    minimum.x = Math::Min(minimum.x, box.minimum.x);
+    minimum.y = Math::Min(minimum.y, box.minimum.y);
+    minimum.z = Math::Min(minimum.z, box.minimum.z);
+    maximum.x = Math::Max(maximum.x, box.maximum.x);
+    maximum.y = Math::Max(maximum.y, box.maximum.y);
+    maximum.z = Math::Max(maximum.z, box.maximum.z);
+  }
+
+  Vector3f
+  BoundingBox::getCenter() const
+  {
+    return Vector3f
+    (
+      (minimum.x + maximum.x) * 0.5f,
+      (minimum.y + maximum.y) * 0.5f,
+      (minimum.z + maximum.z) * 0.5f
+    );
+  }
+
+  Vector3f
+  BoundingBox::getExtents() const
+  {
+    return Vector3f
+    (
+      (maximum.x - minimum.x) * 0.5f,
+      (maximum.y - minimum.y) * 0.5f,
+      (maximum.z - minimum.z) * 0.5f
+    );
+  }
+
+  BoundingBox
+  BoundingBox::getTransformed(const Matrix4& transform) const
+  {
+    if (!isValid())
+      return BoundingBox();
+
+    // Transform the center and add the extents projected on every axis of
+    // the transformed space.
+    Vector3f center = getCenter();
+    Vector3f extents = getExtents();
+
+    float transformedCenter[3];
+    float transformedExtents[3];
+    for (uint32 row = 0; row < 3; ++row)
+    {
+      transformedCenter[row] = transform.m[row][0] * center.x
+                             + transform.m[row][1] * center.y
+                             + transform.m[row][2] * center.z
+                             + transform.m[row][3];
+
+      transformedExtents[row] = Math::Abs(transform.m[row][0]) * extents.x
+                              + Math::Abs(transform.m[row][1]) * extents.y
+                              + Math::Abs(transform.m[row][2]) * extents.z;
+    }
+
+    return BoundingBox
+    (
+      Vector3f
+      (
+        transformedCenter[0] - transformedExtents[0],
+        transformedCenter[1] - transformedExtents[1],
+        transformedCenter[2] - transformedExtents[2]
+      ),
+      Vector3f
+      (
+        transformedCenter[0] + transformedExtents[0],
+        transformedCenter[1] + transformedExtents[1],
+        transformedCenter[2] + transformedExtents[2]
+      )
+    );
+  }
+}
\ No newline at end of file
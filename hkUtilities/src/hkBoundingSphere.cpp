@@ -0,0 +1,107 @@
+#include "Hakool/Utils/hkBoundingSphere.h"
+
+#include "Hakool/Utils/hkBoundingBox.h"
+#include "Hakool/Utils/hkMatrix4.h"
+
+namespace hk
+{
+  BoundingSphere::BoundingSphere() :
+    center(0.0f, 0.0f, 0.0f),
+    radius(-1.0f)
+  { }
+
+  BoundingSphere::BoundingSphere(const Vector3f& _center, const float& _radius) :
+    center(_center),
+    radius(_radius)
+  { }
+
+  BoundingSphere
+  BoundingSphere::FromPositions
+  (
+    const float* positions,
+    const uint32& positionsSize,
+    const uint32& stride,
+    const BoundingBox& box
+  )
+  {
+    if (0 == positionsSize || !box.isValid())
+      return BoundingSphere();
+
+    Vector3f center = box.getCenter();
+    const uint8* bytes = reinterpret_cast<const uint8*>(positions);
+
+    float squaredRadius = 0.0f;
+    for (uint32 i = 0; i < positionsSize; ++i)
+    {
+      const float* position = reinterpret_cast<const float*>(bytes + i * stride);
+      float x = position[0] - center.x;
+      float y = position[1] - center.y;
+      float z = position[2] - center.z;
+      squaredRadius = Math::Max(squaredRadius, x * x + y * y + z * z);
+    }
+
+    return BoundingSphere(center, Math::Sqrt(squaredRadius));
+  }
+
+  bool
+  BoundingSphere::isValid() const
+  {
+    return radius >= 0.0f;
+  }
+
+  void
+  BoundingSphere::merge(const BoundingSphere& sphere)
+  {
+    if (!sphere.isValid())
+      return;
+
+    if (!isValid())
+    {
+      *this = sphere;
+      return;
+    }
+
+    Vector3f offset = sphere.center - center;
+    float distance = offset.magnitude();
+
+    // One of the spheres already contains the other.
+    if (distance + sphere.radius <= radius)
+      return;
+
+    if (distance + radius <= sphere.radius)
+    {
+      *this = sphere;
+      return;
+    }
+
+    float mergedRadius = (distance + radius + sphere.radius) * 0.5f;
+    center = center + offset * ((mergedRadius - radius) / distance);
+    radius = mergedRadius;
+  }
+
+  BoundingSphere
+  BoundingSphere::getTransformed(const Matrix4& transform) const
+  {
+    if (!isValid())
+      return BoundingSphere();
+
+    Vector3f transformedCenter
+    (
+      transform.m00 * center.x + transform.m01 * center.y + transform.m02 * center.z + transform.m03,
+      transform.m10 * center.x + transform.m11 * center.y + transform.m12 * center.z + transform.m13,
+      transform.m20 * center.x + transform.m21 * center.y + transform.m22 * center.z + transform.m23
+    );
+
+    // The biggest scale is the length of the longest basis vector.
+    float squaredScale = 0.0f;
+    for (uint32 column = 0; column < 3; ++column)
+    {
+      float x = transform.m[0][column];
+      float y = transform.m[1][column];
+      float z = transform.m[2][column];
+      squaredScale = Math::Max(squaredScale, x * x + y * y + z * z);
+    }
+
+    return BoundingSphere(transformedCenter, radius * Math::Sqrt(squaredScale));
+  }
+}
\ No newline at end of file
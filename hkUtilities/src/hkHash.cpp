@@ -0,0 +1,23 @@
+#include "Hakool/Utils/hkHash.h"
+
+namespace hk
+{
+  const uint64 Hash::FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+
+  const uint64 Hash::FNV_PRIME = 0x00000100000001b3ull;
+
+  uint64
+  Hash::Fnv1a(const void* data, const hkSize& dataSize, const uint64& seed)
+  {
+    const uint8* bytes = static_cast<const uint8*>(data);
+
+    uint64 hash = seed;
+    for (hkSize i = 0; i < dataSize; ++i)
+    {
+      hash ^= bytes[i];
+      hash *= FNV_PRIME;
+    }
+
+    return hash;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,455 @@
+#include "Hakool/Utils/hkMeshCodec.h"
+
+#include <Hakool\Utils\hkMath.h>
+
+#if HK_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace hk
+{
+  namespace
+  {
+    const uint32 kVERTEX_BLOCK_SIZE = 256;
+
+    const uint32 kGROUP_SIZE = 16;
+
+    const uint32 kTILE_PLANES = 16;
+
+    /**
+     * Bytes of a packed group for each of the 2 bit group codes.
+     */
+    const uint32 kGROUP_BYTES[4] = { 0, 4, 8, 16 };
+
+    uint8
+    ZigZag8(const uint8& _delta)
+    {
+      return static_cast<uint8>
+      (
+        (_delta << 1) ^ static_cast<uint8>(static_cast<int8>(_delta) >> 7)
+      );
+    }
+
+    uint8
+    UnZigZag8(const uint8& _value)
+    {
+      return static_cast<uint8>((_value >> 1) ^ (0 - (_value & 1)));
+    }
+
+    uint8
+    GroupCode(const uint8* _values)
+    {
+      uint8 bits = 0;
+      for (uint32 i = 0; i < kGROUP_SIZE; ++i)
+        bits |= _values[i];
+
+      if (0 == bits)
+        return 0;
+      if (bits < 4)
+        return 1;
+      if (bits < 16)
+        return 2;
+      return 3;
+    }
+
+    void
+    EncodeGroup(const uint8* _values, const uint8& _code, Vector<uint8>& _out)
+    {
+      switch (_code)
+      {
+      case 1:
+        for (uint32 i = 0; i < kGROUP_SIZE; i += 4)
+        {
+          _out.push_back
+          (
+            static_cast<uint8>
+            (
+              _values[i]
+              | (_values[i + 1] << 2)
+              | (_values[i + 2] << 4)
+              | (_values[i + 3] << 6)
+            )
+          );
+        }
+        break;
+
+      case 2:
+        for (uint32 i = 0; i < kGROUP_SIZE; i += 2)
+          _out.push_back(static_cast<uint8>(_values[i] | (_values[i + 1] << 4)));
+        break;
+
+      case 3:
+        _out.insert(_out.end(), _values, _values + kGROUP_SIZE);
+        break;
+
+      default:
+        break;
+      }
+    }
+
+    /**
+     * Unpack a group of 16 zigzagged deltas and turn them into the absolute
+     * values of its byte plane.
+     *
+     * @param _data Packed group.
+     * @param _code Group code.
+     * @param _previous Value before the group, updated to the last value.
+     * @param _values Output values.
+     */
+    void
+    DecodeGroup
+    (
+      const uint8* _data,
+      const uint8& _code,
+      uint8& _previous,
+      uint8* _values
+    )
+    {
+#if HK_SSE2
+      __m128i deltas;
+      switch (_code)
+      {
+      case 1:
+      {
+        int32 packed;
+        std::memcpy(&packed, _data, sizeof(int32));
+        __m128i bytes = _mm_cvtsi32_si128(packed);
+        __m128i mask = _mm_set1_epi8(3);
+        __m128i a = _mm_and_si128(bytes, mask);
+        __m128i b = _mm_and_si128(_mm_srli_epi16(bytes, 2), mask);
+        __m128i c = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+        __m128i d = _mm_and_si128(_mm_srli_epi16(bytes, 6), mask);
+        deltas = _mm_unpacklo_epi16(_mm_unpacklo_epi8(a, b), _mm_unpacklo_epi8(c, d));
+        break;
+      }
+
+      case 2:
+      {
+        __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(_data));
+        __m128i mask = _mm_set1_epi8(15);
+        __m128i low = _mm_and_si128(bytes, mask);
+        __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+        deltas = _mm_unpacklo_epi8(low, high);
+        break;
+      }
+
+      case 3:
+        deltas = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_data));
+        break;
+
+      default:
+        deltas = _mm_setzero_si128();
+        break;
+      }
+
+      // Undo the zigzag: (v >> 1) ^ -(v & 1).
+      __m128i half = _mm_and_si128(_mm_srli_epi16(deltas, 1), _mm_set1_epi8(0x7f));
+      __m128i sign = _mm_sub_epi8
+      (
+        _mm_setzero_si128(),
+        _mm_and_si128(deltas, _mm_set1_epi8(1))
+      );
+      deltas = _mm_xor_si128(half, sign);
+
+      // Prefix sum of the 16 deltas, plus the last value of the plane.
+      deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 1));
+      deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 2));
+      deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 4));
+      deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 8));
+      deltas = _mm_add_epi8(deltas, _mm_set1_epi8(static_cast<char>(_previous)));
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(_values), deltas);
+      _previous = _values[kGROUP_SIZE - 1];
+#else
+      for (uint32 i = 0; i < kGROUP_SIZE; ++i)
+      {
+        uint8 delta = 0;
+        switch (_code)
+        {
+        case 1:
+          delta = (_data[i / 4] >> ((i % 4) * 2)) & 3;
+          break;
+        case 2:
+          delta = (_data[i / 2] >> ((i % 2) * 4)) & 15;
+          break;
+        case 3:
+          delta = _data[i];
+          break;
+        default:
+          break;
+        }
+
+        _previous = static_cast<uint8>(_previous + UnZigZag8(delta));
+        _values[i] = _previous;
+      }
+#endif
+    }
+
+    /**
+     * Write 16 planes of up to 16 vertices back as vertices.
+     *
+     * @param _planes First value of the first plane, planes are
+     * kVERTEX_BLOCK_SIZE bytes apart.
+     * @param _planesSize Number of valid planes.
+     * @param _vertices Destination of the first plane of the first vertex.
+     * @param _stride Size of a vertex in bytes.
+     * @param _verticesSize Number of vertices to write.
+     */
+    void
+    TransposeTile
+    (
+      const uint8* _planes,
+      const uint32& _planesSize,
+      uint8* _vertices,
+      const uint32& _stride,
+      const uint32& _verticesSize
+    )
+    {
+#if HK_SSE2
+      __m128i r[kTILE_PLANES];
+      for (uint32 i = 0; i < kTILE_PLANES; ++i)
+      {
+        r[i] = i < _planesSize
+             ? _mm_loadu_si128
+               (
+                 reinterpret_cast<const __m128i*>(_planes + i * kVERTEX_BLOCK_SIZE)
+               )
+             : _mm_setzero_si128();
+      }
+
+      // 16 x 16 byte transpose, interleaving 1, 2, 4 and 8 bytes.
+      __m128i t[kTILE_PLANES];
+      for (uint32 i = 0; i < kTILE_PLANES; i += 2)
+      {
+        t[i] = _mm_unpacklo_epi8(r[i], r[i + 1]);
+        t[i + 1] = _mm_unpackhi_epi8(r[i], r[i + 1]);
+      }
+
+      for (uint32 i = 0; i < kTILE_PLANES; i += 4)
+      {
+        r[i] = _mm_unpacklo_epi16(t[i], t[i + 2]);
+        r[i + 1] = _mm_unpackhi_epi16(t[i], t[i + 2]);
+        r[i + 2] = _mm_unpacklo_epi16(t[i + 1], t[i + 3]);
+        r[i + 3] = _mm_unpackhi_epi16(t[i + 1], t[i + 3]);
+      }
+
+      for (uint32 i = 0; i < kTILE_PLANES; i += 8)
+      {
+        for (uint32 j = 0; j < 4; ++j)
+        {
+          t[i + j * 2] = _mm_unpacklo_epi32(r[i + j], r[i + j + 4]);
+          t[i + j * 2 + 1] = _mm_unpackhi_epi32(r[i + j], r[i + j + 4]);
+        }
+      }
+
+      for (uint32 i = 0; i < 8; ++i)
+      {
+        r[i * 2] = _mm_unpacklo_epi64(t[i], t[i + 8]);
+        r[i * 2 + 1] = _mm_unpackhi_epi64(t[i], t[i + 8]);
+      }
+
+      if (kTILE_PLANES == _planesSize)
+      {
+        for (uint32 i = 0; i < _verticesSize; ++i)
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(_vertices + i * _stride), r[i]);
+      }
+      else
+      {
+        uint8 row[kTILE_PLANES];
+        for (uint32 i = 0; i < _verticesSize; ++i)
+        {
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(row), r[i]);
+          std::memcpy(_vertices + i * _stride, row, _planesSize);
+        }
+      }
+#else
+      for (uint32 i = 0; i < _verticesSize; ++i)
+      {
+        for (uint32 k = 0; k < _planesSize; ++k)
+          _vertices[i * _stride + k] = _planes[k * kVERTEX_BLOCK_SIZE + i];
+      }
+#endif
+    }
+  }
+
+  void
+  MeshCodec::EncodeVertexBuffer
+  (
+    const uint8* vertices,
+    const uint32& verticesSize,
+    const uint32& stride,
+    Vector<uint8>& out
+  )
+  {
+    Vector<uint8> lastVertex(stride, 0);
+    uint8 deltas[kVERTEX_BLOCK_SIZE];
+
+    for (uint32 blockStart = 0; blockStart < verticesSize; blockStart += kVERTEX_BLOCK_SIZE)
+    {
+      uint32 blockSize = Math::Min(kVERTEX_BLOCK_SIZE, verticesSize - blockStart);
+      uint32 groupsSize = (blockSize + kGROUP_SIZE - 1) / kGROUP_SIZE;
+
+      for (uint32 k = 0; k < stride; ++k)
+      {
+        std::memset(deltas, 0, sizeof(deltas));
+
+        uint8 previous = lastVertex[k];
+        for (uint32 i = 0; i < blockSize; ++i)
+        {
+          uint8 value = vertices[(blockStart + i) * stride + k];
+          deltas[i] = ZigZag8(static_cast<uint8>(value - previous));
+          previous = value;
+        }
+        lastVertex[k] = previous;
+
+        // 2 bit code per group, then the packed groups.
+        hkSize headerOffset = out.size();
+        out.resize(out.size() + (groupsSize + 3) / 4, 0);
+        for (uint32 g = 0; g < groupsSize; ++g)
+        {
+          uint8 code = GroupCode(deltas + g * kGROUP_SIZE);
+          out[headerOffset + g / 4] |= static_cast<uint8>(code << ((g % 4) * 2));
+          EncodeGroup(deltas + g * kGROUP_SIZE, code, out);
+        }
+      }
+    }
+  }
+
+  bool
+  MeshCodec::DecodeVertexBuffer
+  (
+    uint8* vertices,
+    const uint32& verticesSize,
+    const uint32& stride,
+    const uint8* data,
+    const hkSize& dataSize
+  )
+  {
+    const uint8* pData = data;
+    const uint8* pEnd = data + dataSize;
+    Vector<uint8> lastVertex(stride, 0);
+
+    // Up to 16 decoded planes of a block, transposed back into vertices
+    // 16 x 16 bytes at a time.
+    uint8 planes[kTILE_PLANES * kVERTEX_BLOCK_SIZE];
+
+    for (uint32 blockStart = 0; blockStart < verticesSize; blockStart += kVERTEX_BLOCK_SIZE)
+    {
+      uint32 blockSize = Math::Min(kVERTEX_BLOCK_SIZE, verticesSize - blockStart);
+      uint32 groupsSize = (blockSize + kGROUP_SIZE - 1) / kGROUP_SIZE;
+      hkSize headerSize = (groupsSize + 3) / 4;
+
+      for (uint32 tileStart = 0; tileStart < stride; tileStart += kTILE_PLANES)
+      {
+        uint32 tileSize = Math::Min(kTILE_PLANES, stride - tileStart);
+
+        for (uint32 t = 0; t < tileSize; ++t)
+        {
+          if (static_cast<hkSize>(pEnd - pData) < headerSize)
+            return false;
+
+          const uint8* pHeader = pData;
+          pData += headerSize;
+
+          uint32 k = tileStart + t;
+          uint8 previous = lastVertex[k];
+          for (uint32 g = 0; g < groupsSize; ++g)
+          {
+            uint8 code = (pHeader[g / 4] >> ((g % 4) * 2)) & 3;
+            if (static_cast<hkSize>(pEnd - pData) < kGROUP_BYTES[code])
+              return false;
+
+            DecodeGroup
+            (
+              pData,
+              code,
+              previous,
+              planes + t * kVERTEX_BLOCK_SIZE + g * kGROUP_SIZE
+            );
+            pData += kGROUP_BYTES[code];
+          }
+          lastVertex[k] = previous;
+        }
+
+        for (uint32 g = 0; g < groupsSize; ++g)
+        {
+          uint32 first = g * kGROUP_SIZE;
+          TransposeTile
+          (
+            planes + first,
+            tileSize,
+            vertices + (blockStart + first) * stride + tileStart,
+            stride,
+            Math::Min(kGROUP_SIZE, blockSize - first)
+          );
+        }
+      }
+    }
+
+    return pData == pEnd;
+  }
+
+  void
+  MeshCodec::EncodeIndexBuffer
+  (
+    const uint32* indices,
+    const uint32& indicesSize,
+    Vector<uint8>& out
+  )
+  {
+    uint32 previous = 0;
+    for (uint32 i = 0; i < indicesSize; ++i)
+    {
+      int32 delta = static_cast<int32>(indices[i] - previous);
+      uint32 value = (static_cast<uint32>(delta) << 1) ^ static_cast<uint32>(delta >> 31);
+      previous = indices[i];
+
+      while (value >= 0x80)
+      {
+        out.push_back(static_cast<uint8>(value | 0x80));
+        value >>= 7;
+      }
+      out.push_back(static_cast<uint8>(value));
+    }
+  }
+
+  bool
+  MeshCodec::DecodeIndexBuffer
+  (
+    uint32* indices,
+    const uint32& indicesSize,
+    const uint8* data,
+    const hkSize& dataSize
+  )
+  {
+    const uint8* pData = data;
+    const uint8* pEnd = data + dataSize;
+
+    uint32 previous = 0;
+    for (uint32 i = 0; i < indicesSize; ++i)
+    {
+      uint32 value = 0;
+      uint32 shift = 0;
+      uint8 byte = 0;
+      do
+      {
+        if (pData == pEnd || shift > 28)
+          return false;
+
+        byte = *pData++;
+
+        // The fifth byte only holds the 4 highest bits of the value.
+        if (28 == shift && (byte & 0xf0))
+          return false;
+
+        value |= static_cast<uint32>(byte & 0x7f) << shift;
+        shift += 7;
+      } while (byte & 0x80);
+
+      previous += (value >> 1) ^ (0 - (value & 1));
+      indices[i] = previous;
+    }
+
+    return pData == pEnd;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,205 @@
+#include "Hakool/Utils/hkMeshDeduplicator.h"
+
+#include <algorithm>
+#include "Hakool/Utils/hkHash.h"
+#include "Hakool/Utils/hkVertex.h"
+#include "Hakool/Utils/hkMultiMesh.h"
+#include "Hakool/Utils/hkMultiMeshMesh.h"
+#include "Hakool/Utils/hkMultiMeshNode.h"
+#include "Hakool/Utils/hkMultiMeshInstance.h"
+
+namespace hk
+{
+  namespace
+  {
+    const uint32 kINVALID_INDEX = std::numeric_limits<uint32>::max();
+
+    /**
+     * Compare the content of two meshes, the hashes can collide.
+     */
+    bool
+    SameContent(MultiMesh* _pMultiMesh, const MultiMeshMesh& _a, const MultiMeshMesh& _b)
+    {
+      if (_a.verticesSize != _b.verticesSize || _a.indicesSize != _b.indicesSize)
+        return false;
+
+      const Vertex* vertices = _pMultiMesh->getVerticesPtr();
+      const uint32* indices = _pMultiMesh->getIndicesPtr();
+
+      return 0 == std::memcmp
+      (
+        vertices + _a.firstVertexIndex,
+        vertices + _b.firstVertexIndex,
+        sizeof(Vertex) * _a.verticesSize
+      )
+      && 0 == std::memcmp
+      (
+        indices + _a.firstIndexIndex,
+        indices + _b.firstIndexIndex,
+        sizeof(uint32) * _a.indicesSize
+      );
+    }
+  }
+
+  uint64
+  MeshDeduplicator::ContentHash
+  (
+    const Vertex* vertices,
+    const uint32& verticesSize,
+    const uint32* indices,
+    const uint32& indicesSize
+  )
+  {
+    uint64 hash = Hash::Fnv1a(vertices, sizeof(Vertex) * verticesSize);
+    return Hash::Fnv1a(indices, sizeof(uint32) * indicesSize, hash);
+  }
+
+  MultiMesh*
+  MeshDeduplicator::Deduplicate(MultiMesh* pMultiMesh)
+  {
+    const MultiMeshMesh* sourceMeshes = pMultiMesh->getMeshesPtr();
+    const uint32 sourceMeshesSize = pMultiMesh->getMeshesSize();
+
+    // Map every source mesh to the first mesh with the same content.
+    Map<uint64, Vector<uint32>> keptByHash;
+    Vector<uint32> keptMeshes;
+    Vector<uint32> remap(sourceMeshesSize, kINVALID_INDEX);
+    uint32 verticesSize = 0;
+    uint32 indicesSize = 0;
+    for (uint32 i = 0; i < sourceMeshesSize; ++i)
+    {
+      const MultiMeshMesh& mesh = sourceMeshes[i];
+      Vector<uint32>& candidates = keptByHash[mesh.contentHash];
+      for (uint32 candidate : candidates)
+      {
+        if (SameContent(pMultiMesh, sourceMeshes[candidate], mesh))
+        {
+          remap[i] = remap[candidate];
+          break;
+        }
+      }
+
+      if (kINVALID_INDEX != remap[i])
+        continue;
+
+      remap[i] = static_cast<uint32>(keptMeshes.size());
+      candidates.push_back(i);
+      keptMeshes.push_back(i);
+      verticesSize += mesh.verticesSize;
+      indicesSize += mesh.indicesSize;
+    }
+
+    uint32 meshesSize = static_cast<uint32>(keptMeshes.size());
+
+    // Collect the nodes every kept mesh is drawn by.
+    const MultiMeshNode* sourceNodes = pMultiMesh->getNodes();
+    const uint32* sourceNodeMeshesIndices = pMultiMesh->getNodeMeshesIndicesPtr();
+    const uint32 nodesSize = pMultiMesh->getNodesSize();
+    Vector<Vector<uint32>> meshNodes(meshesSize);
+    for (uint32 i = 0; i < nodesSize; ++i)
+    {
+      const MultiMeshNode& sourceNode = sourceNodes[i];
+      for (uint32 j = 0; j < sourceNode.meshesIndicesSize; ++j)
+        meshNodes[remap[sourceNodeMeshesIndices[sourceNode.firstMeshIndexIndex + j]]].push_back(i);
+    }
+
+    MultiMeshLayout layout;
+    layout.verticesSize = verticesSize;
+    layout.indicesSize = indicesSize;
+    layout.meshesSize = meshesSize;
+    layout.nodesSize = nodesSize;
+    layout.nodeMeshesIndicesSize = pMultiMesh->getNodeMeshesIndicesSize();
+    layout.instanceTransformsSize = pMultiMesh->getNodeMeshesIndicesSize();
+    for (uint32 i = 0; i < meshesSize; ++i)
+    {
+      layout.namesSize += MultiMeshLayout::NameSize(pMultiMesh->getMeshName(keptMeshes[i]));
+      if (!meshNodes[i].empty())
+        ++layout.instancesSize;
+    }
+
+    MultiMesh* pDeduplicated = new MultiMesh(layout);
+    Vertex* vertices = pDeduplicated->getVerticesPtr();
+    uint32* indices = pDeduplicated->getIndicesPtr();
+    MultiMeshMesh* meshes = pDeduplicated->getMeshesPtr();
+
+    uint32 vertexIndex = 0;
+    uint32 indexIndex = 0;
+    for (uint32 i = 0; i < meshesSize; ++i)
+    {
+      const MultiMeshMesh& sourceMesh = sourceMeshes[keptMeshes[i]];
+      MultiMeshMesh& mesh = meshes[i];
+      pDeduplicated->setMeshName(i, pMultiMesh->getMeshName(keptMeshes[i]));
+      mesh.firstVertexIndex = vertexIndex;
+      mesh.verticesSize = sourceMesh.verticesSize;
+      mesh.firstIndexIndex = indexIndex;
+      mesh.indicesSize = sourceMesh.indicesSize;
+      mesh.materialIndex = sourceMesh.materialIndex;
+      mesh.contentHash = sourceMesh.contentHash;
+      mesh.boundingBox = sourceMesh.boundingBox;
+      mesh.boundingSphere = sourceMesh.boundingSphere;
+
+      const Vertex* sourceVertices =
+        pMultiMesh->getVerticesPtr() + sourceMesh.firstVertexIndex;
+      std::copy
+      (
+        sourceVertices,
+        sourceVertices + sourceMesh.verticesSize,
+        vertices + vertexIndex
+      );
+      const uint32* sourceIndices =
+        pMultiMesh->getIndicesPtr() + sourceMesh.firstIndexIndex;
+      std::copy
+      (
+        sourceIndices,
+        sourceIndices + sourceMesh.indicesSize,
+        indices + indexIndex
+      );
+
+      vertexIndex += sourceMesh.verticesSize;
+      indexIndex += sourceMesh.indicesSize;
+    }
+
+    // Remap the nodes to the kept meshes.
+    MultiMeshNode* nodes = pDeduplicated->getNodes();
+    uint32* nodeMeshesIndices = pDeduplicated->getNodeMeshesIndicesPtr();
+    for (uint32 i = 0; i < nodesSize; ++i)
+    {
+      const MultiMeshNode& sourceNode = sourceNodes[i];
+      MultiMeshNode& node = nodes[i];
+      node.firstMeshIndexIndex = sourceNode.firstMeshIndexIndex;
+      node.meshesIndicesSize = sourceNode.meshesIndicesSize;
+      node.transform = sourceNode.transform;
+
+      for (uint32 j = 0; j < node.meshesIndicesSize; ++j)
+      {
+        uint32 meshIndexIndex = node.firstMeshIndexIndex + j;
+        nodeMeshesIndices[meshIndexIndex] = remap[sourceNodeMeshesIndices[meshIndexIndex]];
+      }
+    }
+
+    // Collect the transforms every mesh is drawn with.
+    MultiMeshInstance* instances = pDeduplicated->getInstancesPtr();
+    Matrix4* transforms = pDeduplicated->getInstanceTransformsPtr();
+    uint32 instanceIndex = 0;
+    uint32 transformIndex = 0;
+    for (uint32 i = 0; i < meshesSize; ++i)
+    {
+      if (meshNodes[i].empty())
+        continue;
+
+      instances[instanceIndex++] = MultiMeshInstance
+      (
+        i,
+        transformIndex,
+        static_cast<uint32>(meshNodes[i].size())
+      );
+
+      for (uint32 nodeIndex : meshNodes[i])
+        transforms[transformIndex++] = nodes[nodeIndex].transform;
+    }
+
+    pDeduplicated->computeNodesBounds();
+
+    return pDeduplicated;
+  }
+}
\ No newline at end of file
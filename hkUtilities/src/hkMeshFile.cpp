@@ -0,0 +1,49 @@
+#include "Hakool/Utils/hkMeshFile.h"
+
+namespace hk
+{
+  const uint32 MeshFileHeader::MAGIC = 0x534d4b48;
+
+  const uint32 MeshFileHeader::VERSION = 6;
+
+  const uint32 MeshFileHeader::FLAG_FLOAT_VERTICES = 1 << 0;
+
+  const uint32 MeshFileHeader::FLAG_QUANTIZED_VERTICES = 1 << 1;
+
+  const uint32 MeshFileHeader::SIZE = 18 * sizeof(uint32);
+
+  const uint32 MeshFileChunk::VERTICES_PER_CHUNK = 16384;
+
+  const uint32 MeshFileChunk::INDICES_PER_CHUNK = 3 * 16384;
+
+  const uint32 MeshFileChunk::SIZE = 4 * sizeof(uint32) + sizeof(uint64);
+
+  MeshFileHeader::MeshFileHeader() :
+    magic(MAGIC),
+    version(VERSION),
+    flags(0),
+    verticesSize(0),
+    indicesSize(0),
+    meshesSize(0),
+    nodesSize(0),
+    nodeMeshesIndicesSize(0),
+    namesSize(0),
+    lodsSize(0),
+    lodIndicesSize(0),
+    batchRangesSize(0),
+    batchSourceNodesSize(0),
+    batchSourceMeshesSize(0),
+    instancesSize(0),
+    instanceTransformsSize(0),
+    chunksSize(0),
+    metadataSize(0)
+  { }
+
+  MeshFileChunk::MeshFileChunk() :
+    stream(eMESH_FILE_STREAM::kVertices),
+    firstElement(0),
+    elementsSize(0),
+    dataSize(0),
+    offset(0)
+  { }
+}
\ No newline at end of file
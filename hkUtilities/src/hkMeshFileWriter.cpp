@@ -0,0 +1,354 @@
+#include "Hakool/Utils/hkMeshFileWriter.h"
+
+#include "Hakool/Utils/hkLogger.h"
+#include "Hakool/Utils/hkMeshFile.h"
+#include "Hakool/Utils/hkMeshCodec.h"
+#include "Hakool/Utils/hkVertex.h"
+#include "Hakool/Utils/hkQuantizedVertex.h"
+#include "Hakool/Utils/hkMultiMesh.h"
+#include "Hakool/Utils/hkMultiMeshMesh.h"
+#include "Hakool/Utils/hkMultiMeshNode.h"
+#include "Hakool/Utils/hkMultiMeshLod.h"
+#include "Hakool/Utils/hkMultiMeshBatchRange.h"
+#include "Hakool/Utils/hkMultiMeshInstance.h"
+
+namespace hk
+{
+  namespace
+  {
+    template<typename T>
+    void
+    Append(Vector<uint8>& _out, const T& _value)
+    {
+      hkSize offset = _out.size();
+      _out.resize(offset + sizeof(T));
+      std::memcpy(_out.data() + offset, &_value, sizeof(T));
+    }
+
+    void
+    AppendVector3(Vector<uint8>& _out, const Vector3f& _value)
+    {
+      Append(_out, _value.x);
+      Append(_out, _value.y);
+      Append(_out, _value.z);
+    }
+
+    void
+    AppendMetadata(MultiMesh* _pMultiMesh, Vector<uint8>& _out)
+    {
+      for (uint32 i = 0; i < _pMultiMesh->getMeshesSize(); ++i)
+      {
+        const MultiMeshMesh& mesh = _pMultiMesh->getMeshesPtr()[i];
+
+        Append(_out, mesh.nameOffset);
+        Append(_out, mesh.firstVertexIndex);
+        Append(_out, mesh.verticesSize);
+        Append(_out, mesh.firstIndexIndex);
+        Append(_out, mesh.indicesSize);
+        Append(_out, mesh.materialIndex);
+        Append(_out, mesh.contentHash);
+        Append(_out, mesh.firstLodIndex);
+        Append(_out, mesh.lodsSize);
+
+        AppendVector3(_out, mesh.quantization.positionOffset);
+        AppendVector3(_out, mesh.quantization.positionScale);
+        Append(_out, mesh.quantization.positionError);
+        Append(_out, mesh.quantization.normalError);
+        Append(_out, mesh.quantization.tangentError);
+        Append(_out, mesh.quantization.uvError);
+
+        AppendVector3(_out, mesh.boundingBox.minimum);
+        AppendVector3(_out, mesh.boundingBox.maximum);
+        AppendVector3(_out, mesh.boundingSphere.center);
+        Append(_out, mesh.boundingSphere.radius);
+      }
+
+      for (uint32 i = 0; i < _pMultiMesh->getNodesSize(); ++i)
+      {
+        const MultiMeshNode& node = _pMultiMesh->getNodes()[i];
+
+        Append(_out, node.firstMeshIndexIndex);
+        Append(_out, node.meshesIndicesSize);
+        for (uint32 j = 0; j < 16; ++j)
+          Append(_out, node.transform.a[j]);
+      }
+
+      for (uint32 i = 0; i < _pMultiMesh->getNodeMeshesIndicesSize(); ++i)
+        Append(_out, _pMultiMesh->getNodeMeshesIndicesPtr()[i]);
+
+      const char* names = _pMultiMesh->getNamesPtr();
+      _out.insert(_out.end(), names, names + _pMultiMesh->getNamesSize());
+
+      for (uint32 i = 0; i < _pMultiMesh->getLodsSize(); ++i)
+      {
+        const MultiMeshLod& lod = _pMultiMesh->getLodsPtr()[i];
+
+        Append(_out, lod.firstIndexIndex);
+        Append(_out, lod.indicesSize);
+        Append(_out, lod.error);
+      }
+
+      for (uint32 i = 0; i < _pMultiMesh->getBatchRangesSize(); ++i)
+      {
+        const MultiMeshBatchRange& range = _pMultiMesh->getBatchRangesPtr()[i];
+
+        Append(_out, range.firstIndexIndex);
+        Append(_out, range.indicesSize);
+        Append(_out, range.sourceNodeIndex);
+        Append(_out, range.sourceMeshIndex);
+      }
+
+      for (uint32 i = 0; i < _pMultiMesh->getInstancesSize(); ++i)
+      {
+        const MultiMeshInstance& instance = _pMultiMesh->getInstancesPtr()[i];
+
+        Append(_out, instance.meshIndex);
+        Append(_out, instance.firstTransformIndex);
+        Append(_out, instance.transformsSize);
+      }
+
+      for (uint32 i = 0; i < _pMultiMesh->getInstanceTransformsSize(); ++i)
+      {
+        const Matrix4& transform = _pMultiMesh->getInstanceTransformsPtr()[i];
+        for (uint32 j = 0; j < 16; ++j)
+          Append(_out, transform.a[j]);
+      }
+    }
+
+    /**
+     * Encodes a vertex stream in chunks of VERTICES_PER_CHUNK vertices.
+     */
+    void
+    EncodeVertexChunks
+    (
+      const eMESH_FILE_STREAM& _stream,
+      const uint8* _vertices,
+      const uint32& _verticesSize,
+      const uint32& _stride,
+      Vector<MeshFileChunk>& _chunks,
+      Vector<uint8>& _data
+    )
+    {
+      for (uint32 first = 0; first < _verticesSize; first += MeshFileChunk::VERTICES_PER_CHUNK)
+      {
+        MeshFileChunk chunk;
+        chunk.stream = _stream;
+        chunk.firstElement = first;
+        chunk.elementsSize = Math::Min(MeshFileChunk::VERTICES_PER_CHUNK, _verticesSize - first);
+        chunk.offset = _data.size();
+
+        MeshCodec::EncodeVertexBuffer
+        (
+          _vertices + static_cast<hkSize>(first) * _stride,
+          chunk.elementsSize,
+          _stride,
+          _data
+        );
+
+        chunk.dataSize = static_cast<uint32>(_data.size() - chunk.offset);
+        _chunks.push_back(chunk);
+      }
+    }
+
+    /**
+     * Encodes an index stream in chunks of INDICES_PER_CHUNK indices.
+     */
+    void
+    EncodeIndexChunks
+    (
+      const eMESH_FILE_STREAM& _stream,
+      const uint32* _indices,
+      const uint32& _indicesSize,
+      Vector<MeshFileChunk>& _chunks,
+      Vector<uint8>& _data
+    )
+    {
+      for (uint32 first = 0; first < _indicesSize; first += MeshFileChunk::INDICES_PER_CHUNK)
+      {
+        MeshFileChunk chunk;
+        chunk.stream = _stream;
+        chunk.firstElement = first;
+        chunk.elementsSize = Math::Min(MeshFileChunk::INDICES_PER_CHUNK, _indicesSize - first);
+        chunk.offset = _data.size();
+
+        MeshCodec::EncodeIndexBuffer(_indices + first, chunk.elementsSize, _data);
+
+        chunk.dataSize = static_cast<uint32>(_data.size() - chunk.offset);
+        _chunks.push_back(chunk);
+      }
+    }
+  }
+
+  MeshFileWriter::MeshFileWriter() :
+    _m_writeFloatVertices(true)
+  { }
+
+  MeshFileWriter::~MeshFileWriter()
+  { }
+
+  eRESULT
+  MeshFileWriter::write(MultiMesh* pMultiMesh, const String& path)
+  {
+    Vector<uint8> data;
+    if (eRESULT::kSuccess != write(pMultiMesh, data))
+      return eRESULT::kFail;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+      Logger::Error("| MeshFileWriter | Couldn't open the file: " + path);
+      return eRESULT::kFail;
+    }
+
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    if (!file.good())
+    {
+      Logger::Error("| MeshFileWriter | Couldn't write the file: " + path);
+      return eRESULT::kFail;
+    }
+
+    return eRESULT::kSuccess;
+  }
+
+  eRESULT
+  MeshFileWriter::write(MultiMesh* pMultiMesh, Vector<uint8>& out)
+  {
+    if (nullptr == pMultiMesh)
+    {
+      Logger::Error("| MeshFileWriter | Null multimesh.");
+      return eRESULT::kFail;
+    }
+
+    MeshFileHeader header;
+    header.verticesSize = pMultiMesh->getVerticesSize();
+    header.indicesSize = pMultiMesh->getIndicesSize();
+    header.meshesSize = pMultiMesh->getMeshesSize();
+    header.nodesSize = pMultiMesh->getNodesSize();
+    header.nodeMeshesIndicesSize = pMultiMesh->getNodeMeshesIndicesSize();
+    header.namesSize = pMultiMesh->getNamesSize();
+    header.lodsSize = pMultiMesh->getLodsSize();
+    header.lodIndicesSize = pMultiMesh->getLodIndicesSize();
+    header.batchRangesSize = pMultiMesh->getBatchRangesSize();
+    header.batchSourceNodesSize = pMultiMesh->getBatchSourceNodesSize();
+    header.batchSourceMeshesSize = pMultiMesh->getBatchSourceMeshesSize();
+    header.instancesSize = pMultiMesh->getInstancesSize();
+    header.instanceTransformsSize = pMultiMesh->getInstanceTransformsSize();
+
+    const QuantizedVertex* quantizedVertices = pMultiMesh->getQuantizedVerticesPtr();
+    if (nullptr != quantizedVertices)
+      header.flags |= MeshFileHeader::FLAG_QUANTIZED_VERTICES;
+
+    // Quantized multimeshes don't keep the float vertices.
+    if (nullptr != pMultiMesh->getVerticesPtr()
+        && (nullptr == quantizedVertices || _m_writeFloatVertices))
+      header.flags |= MeshFileHeader::FLAG_FLOAT_VERTICES;
+
+    Vector<uint8> metadata;
+    AppendMetadata(pMultiMesh, metadata);
+    header.metadataSize = static_cast<uint32>(metadata.size());
+
+    // Chunk offsets are relative to the chunk data until the table size is
+    // known.
+    Vector<MeshFileChunk> chunks;
+    Vector<uint8> chunksData;
+
+    if (header.flags & MeshFileHeader::FLAG_FLOAT_VERTICES)
+    {
+      EncodeVertexChunks
+      (
+        eMESH_FILE_STREAM::kVertices,
+        reinterpret_cast<const uint8*>(pMultiMesh->getVerticesPtr()),
+        header.verticesSize,
+        sizeof(Vertex),
+        chunks,
+        chunksData
+      );
+    }
+
+    if (header.flags & MeshFileHeader::FLAG_QUANTIZED_VERTICES)
+    {
+      EncodeVertexChunks
+      (
+        eMESH_FILE_STREAM::kQuantizedVertices,
+        reinterpret_cast<const uint8*>(quantizedVertices),
+        header.verticesSize,
+        sizeof(QuantizedVertex),
+        chunks,
+        chunksData
+      );
+    }
+
+    EncodeIndexChunks
+    (
+      eMESH_FILE_STREAM::kIndices,
+      pMultiMesh->getIndicesPtr(),
+      header.indicesSize,
+      chunks,
+      chunksData
+    );
+
+    EncodeIndexChunks
+    (
+      eMESH_FILE_STREAM::kLodIndices,
+      pMultiMesh->getLodIndicesPtr(),
+      header.lodIndicesSize,
+      chunks,
+      chunksData
+    );
+
+    header.chunksSize = static_cast<uint32>(chunks.size());
+
+    uint64 dataOffset = MeshFileHeader::SIZE
+                      + static_cast<uint64>(header.metadataSize)
+                      + static_cast<uint64>(header.chunksSize) * MeshFileChunk::SIZE;
+
+    out.clear();
+    out.reserve(static_cast<hkSize>(dataOffset) + chunksData.size());
+
+    Append(out, header.magic);
+    Append(out, header.version);
+    Append(out, header.flags);
+    Append(out, header.verticesSize);
+    Append(out, header.indicesSize);
+    Append(out, header.meshesSize);
+    Append(out, header.nodesSize);
+    Append(out, header.nodeMeshesIndicesSize);
+    Append(out, header.namesSize);
+    Append(out, header.lodsSize);
+    Append(out, header.lodIndicesSize);
+    Append(out, header.batchRangesSize);
+    Append(out, header.batchSourceNodesSize);
+    Append(out, header.batchSourceMeshesSize);
+    Append(out, header.instancesSize);
+    Append(out, header.instanceTransformsSize);
+    Append(out, header.chunksSize);
+    Append(out, header.metadataSize);
+
+    out.insert(out.end(), metadata.begin(), metadata.end());
+
+    for (const MeshFileChunk& chunk : chunks)
+    {
+      Append(out, static_cast<uint32>(chunk.stream));
+      Append(out, chunk.firstElement);
+      Append(out, chunk.elementsSize);
+      Append(out, chunk.dataSize);
+      Append(out, dataOffset + chunk.offset);
+    }
+
+    out.insert(out.end(), chunksData.begin(), chunksData.end());
+
+    return eRESULT::kSuccess;
+  }
+
+  void
+  MeshFileWriter::setWriteFloatVertices(const bool& writeFloatVertices)
+  {
+    _m_writeFloatVertices = writeFloatVertices;
+  }
+
+  const bool&
+  MeshFileWriter::getWriteFloatVertices() const
+  {
+    return _m_writeFloatVertices;
+  }
+}
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "Hakool/Utils/hkMeshLoaderAssimp.h"
 
+#include <algorithm>
+
 #include <assimp/Importer.hpp>
+#include <assimp/DefaultIOSystem.h>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 #include <assimp/matrix4x4.h>
@@ -8,10 +11,58 @@
 #include "Hakool/Utils/hkMultiMesh.h"
 #include "Hakool/Utils/hkMultiMeshMesh.h"
 #include "Hakool/Utils/hkMultiMeshNode.h"
+#include "Hakool/Utils/hkMeshDeduplicator.h"
+#include "Hakool/Utils/hkMeshPostProcessor.h"
 
 namespace hk
 {
-  MeshLoaderAssimp::MeshLoaderAssimp()
+  namespace
+  {
+    /**
+     * File system of the importer, that remembers the files it opens besides
+     * the imported one.
+     */
+    class DependencyIOSystem : public Assimp::DefaultIOSystem
+    {
+    public:
+
+      DependencyIOSystem(const String& _path, Vector<String>& _dependencies) :
+        Assimp::DefaultIOSystem(),
+        _m_path(_path),
+        _m_dependencies(_dependencies)
+      { }
+
+      using Assimp::DefaultIOSystem::Open;
+
+      Assimp::IOStream*
+      Open(const char* _pFile, const char* _pMode) override
+      {
+        Assimp::IOStream* pStream = Assimp::DefaultIOSystem::Open(_pFile, _pMode);
+        if (nullptr != pStream
+            && _m_path != _pFile
+            && _m_dependencies.end() == std::find(_m_dependencies.begin(), _m_dependencies.end(), _pFile))
+          _m_dependencies.push_back(_pFile);
+
+        return pStream;
+      }
+
+    private:
+
+      String _m_path;
+
+      Vector<String>& _m_dependencies;
+    };
+  }
+
+  MeshLoaderAssimp::MeshLoaderAssimp() :
+    _m_configuration(),
+    _m_dependencies()
+  {
+  }
+
+  MeshLoaderAssimp::MeshLoaderAssimp(const MeshImportConfiguration& configuration) :
+    _m_configuration(configuration),
+    _m_dependencies()
   {
   }
 
@@ -19,10 +70,31 @@ namespace hk
   {
   }
 
+  void
+  MeshLoaderAssimp::setConfiguration(const MeshImportConfiguration& configuration)
+  {
+    _m_configuration = configuration;
+  }
+
+  const MeshImportConfiguration&
+  MeshLoaderAssimp::getConfiguration() const
+  {
+    return _m_configuration;
+  }
+
+  const Vector<String>&
+  MeshLoaderAssimp::getDependencies() const
+  {
+    return _m_dependencies;
+  }
+
   MultiMesh*
   MeshLoaderAssimp::load(String path)
   {
+    _m_dependencies.clear();
+
     Assimp::Importer importer;
+    importer.SetIOHandler(new DependencyIOSystem(path, _m_dependencies));
     const aiScene* pAiScene = importer.ReadFile
     (
       path,
@@ -48,6 +120,9 @@ namespace hk
     MultiMesh* pMultiMesh = mallocMultiMeshInstance(pAiScene, aiMeshNodes);
     saveMeshesData(pAiScene, pMultiMesh);
     saveMeshNodesData(aiMeshNodes, pMultiMesh);
+    pMultiMesh->computeNodesBounds();
+
+    pMultiMesh = MeshPostProcessor::Process(pMultiMesh, _m_configuration);
 
     for (AiMeshNode* pMeshNode : aiMeshNodes)
       delete pMeshNode;
@@ -87,30 +162,23 @@ namespace hk
       Vector<AiMeshNode*>& aiMeshNodes
     )
   {
-    uint32 numMeshes = pAiScene->mNumMeshes;
-    uint32 numVertices = 0;
-    uint32 numIndices = 0;
-    for (uint32 aiMeshIndex = 0; aiMeshIndex < numMeshes; ++aiMeshIndex)
+    MultiMeshLayout layout;
+    layout.meshesSize = pAiScene->mNumMeshes;
+    layout.nodesSize = static_cast<uint32>(aiMeshNodes.size());
+    for (uint32 aiMeshIndex = 0; aiMeshIndex < layout.meshesSize; ++aiMeshIndex)
     {
       aiMesh* pAiMesh = pAiScene->mMeshes[aiMeshIndex];
-      numVertices += pAiMesh->mNumVertices;
+      layout.verticesSize += pAiMesh->mNumVertices;
+      layout.namesSize += MultiMeshLayout::NameSize(pAiMesh->mName.C_Str());
 
       for (uint32 aiFaceIndex = 0; aiFaceIndex < pAiMesh->mNumFaces; ++aiFaceIndex)
-        numIndices += pAiMesh->mFaces[aiFaceIndex].mNumIndices;
+        layout.indicesSize += pAiMesh->mFaces[aiFaceIndex].mNumIndices;
     }
 
-    uint32 numNodes = aiMeshNodes.size();
-    return new MultiMesh
-    (
-      new Vertex[numVertices],
-      numVertices,
-      new uint32[numIndices],
-      numIndices,
-      new MultiMeshMesh[numMeshes],
-      numMeshes,
-      new MultiMeshNode[numNodes],
-      numNodes
-    );
+    for (AiMeshNode* pAiMeshNode : aiMeshNodes)
+      layout.nodeMeshesIndicesSize += pAiMeshNode->pAiNode->mNumMeshes;
+
+    return new MultiMesh(layout);
   }
 
   void 
@@ -128,6 +196,7 @@ namespace hk
         indexIndex,
         pMultiMesh
       );
+      pMultiMesh->setMeshName(aiMeshIndex, pAiScene->mMeshes[aiMeshIndex]->mName.C_Str());
     }
   }
 
@@ -141,9 +210,9 @@ namespace hk
     MultiMesh* pMultiMesh
   )
   {
-    pMesh->name = String(pAiMesh->mName.C_Str());
     pMesh->firstVertexIndex = vertexIndex;
     pMesh->firstIndexIndex = indexIndex;
+    pMesh->materialIndex = pAiMesh->mMaterialIndex;
 
     pMesh->verticesSize = pAiMesh->mNumVertices;
     for (int32 aiVertexIndex = 0; aiVertexIndex < pAiMesh->mNumVertices; ++aiVertexIndex)
@@ -152,9 +221,39 @@ namespace hk
       pVertex->x = pAiMesh->mVertices[aiVertexIndex].x;
       pVertex->y = pAiMesh->mVertices[aiVertexIndex].y;
       pVertex->z = pAiMesh->mVertices[aiVertexIndex].z;
+
+      if (pAiMesh->HasNormals())
+      {
+        pVertex->nx = pAiMesh->mNormals[aiVertexIndex].x;
+        pVertex->ny = pAiMesh->mNormals[aiVertexIndex].y;
+        pVertex->nz = pAiMesh->mNormals[aiVertexIndex].z;
+      }
+
+      if (pAiMesh->HasTangentsAndBitangents())
+      {
+        pVertex->tx = pAiMesh->mTangents[aiVertexIndex].x;
+        pVertex->ty = pAiMesh->mTangents[aiVertexIndex].y;
+        pVertex->tz = pAiMesh->mTangents[aiVertexIndex].z;
+      }
+
+      if (pAiMesh->HasTextureCoords(0))
+      {
+        pVertex->u = pAiMesh->mTextureCoords[0][aiVertexIndex].x;
+        pVertex->v = pAiMesh->mTextureCoords[0][aiVertexIndex].y;
+      }
       ++vertexIndex;
     }
 
+    const float* positions = &(pMultiMesh->getVerticesPtr()[pMesh->firstVertexIndex].x);
+    pMesh->boundingBox = BoundingBox::FromPositions(positions, pMesh->verticesSize, sizeof(Vertex));
+    pMesh->boundingSphere = BoundingSphere::FromPositions
+    (
+      positions,
+      pMesh->verticesSize,
+      sizeof(Vertex),
+      pMesh->boundingBox
+    );
+
     pMesh->indicesSize = 0;
     for (int32 aiFaceIndex = 0; aiFaceIndex < pAiMesh->mNumFaces; ++aiFaceIndex)
     {
@@ -166,6 +265,14 @@ namespace hk
         ++indexIndex;
       }
     }
+
+    pMesh->contentHash = MeshDeduplicator::ContentHash
+    (
+      pMultiMesh->getVerticesPtr() + pMesh->firstVertexIndex,
+      pMesh->verticesSize,
+      pMultiMesh->getIndicesPtr() + pMesh->firstIndexIndex,
+      pMesh->indicesSize
+    );
   }
 
   void
@@ -175,17 +282,19 @@ namespace hk
     MultiMesh* pMultiMesh
   )
   {
+    uint32 meshIndexIndex = 0;
     for (uint32 i = 0; i < aiMeshNodes.size(); ++i)
     {
       AiMeshNode* pAiMeshNode = aiMeshNodes[i];
-      uint32* meshesIndices = new uint32[pAiMeshNode->pAiNode->mNumMeshes];
+      uint32* meshesIndices = pMultiMesh->getNodeMeshesIndicesPtr() + meshIndexIndex;
       for (int32 j = 0; j < pAiMeshNode->pAiNode->mNumMeshes; ++j)
         meshesIndices[j] = pAiMeshNode->pAiNode->mMeshes[j];
 
       MultiMeshNode* pMultiMeshNode = &(pMultiMesh->getNodes()[i]);
-      pMultiMeshNode->meshesIndices = meshesIndices;
+      pMultiMeshNode->firstMeshIndexIndex = meshIndexIndex;
       pMultiMeshNode->meshesIndicesSize = pAiMeshNode->pAiNode->mNumMeshes;
       pMultiMeshNode->transform = pAiMeshNode->transformation;
+      meshIndexIndex += pAiMeshNode->pAiNode->mNumMeshes;
     }
   }
 }
\ No newline at end of file
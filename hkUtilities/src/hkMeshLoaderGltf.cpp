@@ -0,0 +1,1500 @@
+#include "Hakool/Utils/hkMeshLoaderGltf.h"
+
+#include <cctype>
+
+#if HK_PLATFORM == HK_PLATFORM_WIN32
+#include <Windows.h>
+#endif
+
+#include "Hakool/Utils/hkLogger.h"
+#include "Hakool/Utils/hkMatrix4.h"
+#include "Hakool/Utils/hkVertex.h"
+#include "Hakool/Utils/hkMultiMesh.h"
+#include "Hakool/Utils/hkMultiMeshMesh.h"
+#include "Hakool/Utils/hkMultiMeshNode.h"
+#include "Hakool/Utils/hkMeshDeduplicator.h"
+#include "Hakool/Utils/hkMeshLoaderAssimp.h"
+#include "Hakool/Utils/hkMeshPostProcessor.h"
+
+namespace hk
+{
+  namespace
+  {
+    const uint32 GLB_MAGIC = 0x46546C67;
+
+    const uint32 GLB_VERSION = 2;
+
+    const uint32 GLB_CHUNK_JSON = 0x4E4F534A;
+
+    const uint32 GLB_CHUNK_BIN = 0x004E4942;
+
+    const uint32 GLTF_BYTE = 5120;
+
+    const uint32 GLTF_UNSIGNED_BYTE = 5121;
+
+    const uint32 GLTF_SHORT = 5122;
+
+    const uint32 GLTF_UNSIGNED_SHORT = 5123;
+
+    const uint32 GLTF_UNSIGNED_INT = 5125;
+
+    const uint32 GLTF_FLOAT = 5126;
+
+    const uint32 GLTF_TRIANGLES = 4;
+
+    const uint32 JSON_MAX_DEPTH = 64;
+
+    /**
+     * Read only file contents. Mapped in memory on Windows, read in a buffer
+     * on the other platforms.
+     */
+    class MappedFile
+    {
+    public:
+
+      MappedFile() :
+#if HK_PLATFORM == HK_PLATFORM_WIN32
+        _m_file(INVALID_HANDLE_VALUE),
+        _m_mapping(nullptr),
+#endif
+        _m_data(nullptr),
+        _m_size(0)
+      { }
+
+      ~MappedFile()
+      {
+#if HK_PLATFORM == HK_PLATFORM_WIN32
+        if (nullptr != _m_data)
+          UnmapViewOfFile(_m_data);
+        if (nullptr != _m_mapping)
+          CloseHandle(_m_mapping);
+        if (INVALID_HANDLE_VALUE != _m_file)
+          CloseHandle(_m_file);
+#endif
+      }
+
+      bool
+      open(const String& path)
+      {
+#if HK_PLATFORM == HK_PLATFORM_WIN32
+        _m_file = CreateFileA
+        (
+          path.c_str(),
+          GENERIC_READ,
+          FILE_SHARE_READ,
+          nullptr,
+          OPEN_EXISTING,
+          FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+          nullptr
+        );
+        if (INVALID_HANDLE_VALUE == _m_file)
+          return false;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(_m_file, &fileSize) || 0 == fileSize.QuadPart)
+          return false;
+
+        _m_mapping = CreateFileMappingA(_m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (nullptr == _m_mapping)
+          return false;
+
+        _m_data = static_cast<const uint8*>(MapViewOfFile(_m_mapping, FILE_MAP_READ, 0, 0, 0));
+        _m_size = static_cast<hkSize>(fileSize.QuadPart);
+        return nullptr != _m_data;
+#else
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+          return false;
+
+        std::streamoff fileSize = file.tellg();
+        file.seekg(0, std::ios::beg);
+
+        _m_buffer.resize(static_cast<hkSize>(fileSize));
+        file.read(reinterpret_cast<char*>(_m_buffer.data()), fileSize);
+        if (!file.good())
+          return false;
+
+        _m_data = _m_buffer.data();
+        _m_size = _m_buffer.size();
+        return true;
+#endif
+      }
+
+      const uint8*
+      getData() const
+      {
+        return _m_data;
+      }
+
+      const hkSize&
+      getSize() const
+      {
+        return _m_size;
+      }
+
+    private:
+
+#if HK_PLATFORM == HK_PLATFORM_WIN32
+      HANDLE
+      _m_file;
+
+      HANDLE
+      _m_mapping;
+#else
+      Vector<uint8>
+      _m_buffer;
+#endif
+
+      const uint8*
+      _m_data;
+
+      hkSize
+      _m_size;
+    };
+
+    /**
+     * Value of a JSON document.
+     */
+    struct JsonValue
+    {
+      enum class eTYPE
+      {
+        kNull,
+        kBool,
+        kNumber,
+        kString,
+        kArray,
+        kObject
+      };
+
+      JsonValue() :
+        type(eTYPE::kNull),
+        boolean(false),
+        number(0.0)
+      { }
+
+      /**
+       * Find a member of an object, nullptr if it is missing or this is not
+       * an object.
+       */
+      const JsonValue*
+      find(const char* key) const
+      {
+        for (const std::pair<String, JsonValue>& member : members)
+        {
+          if (member.first == key)
+            return &member.second;
+        }
+        return nullptr;
+      }
+
+      /**
+       * Get an element of an array, nullptr if it is out of range or this is
+       * not an array.
+       */
+      const JsonValue*
+      at(const hkSize& index) const
+      {
+        return index < elements.size() ? &elements[index] : nullptr;
+      }
+
+      double
+      getNumber(const char* key, const double& defaultValue) const
+      {
+        const JsonValue* pValue = find(key);
+        return nullptr != pValue && eTYPE::kNumber == pValue->type ? pValue->number : defaultValue;
+      }
+
+      /**
+       * Get a member that must be a non negative integer. Returns false if
+       * the member exists but is not one.
+       */
+      bool
+      getIndex(const char* key, uint32& index) const
+      {
+        const JsonValue* pValue = find(key);
+        if (nullptr == pValue)
+          return true;
+
+        if (eTYPE::kNumber != pValue->type
+            || pValue->number < 0.0
+            || pValue->number > 4294967295.0
+            || pValue->number != static_cast<double>(static_cast<uint32>(pValue->number)))
+          return false;
+
+        index = static_cast<uint32>(pValue->number);
+        return true;
+      }
+
+      eTYPE
+      type;
+
+      bool
+      boolean;
+
+      double
+      number;
+
+      String
+      string;
+
+      Vector<JsonValue>
+      elements;
+
+      Vector<std::pair<String, JsonValue>>
+      members;
+    };
+
+    /**
+     * Recursive descent parser of the JSON chunk.
+     */
+    class JsonParser
+    {
+    public:
+
+      JsonParser(const char* begin, const char* end) :
+        _m_current(begin),
+        _m_end(end)
+      { }
+
+      bool
+      parse(JsonValue& value)
+      {
+        if (!parseValue(value, 0))
+          return false;
+
+        skipWhitespace();
+        return _m_current == _m_end;
+      }
+
+    private:
+
+      void
+      skipWhitespace()
+      {
+        while (_m_current < _m_end
+               && (' ' == *_m_current || '\t' == *_m_current
+                   || '\n' == *_m_current || '\r' == *_m_current))
+          ++_m_current;
+      }
+
+      bool
+      parseValue(JsonValue& value, const uint32& depth)
+      {
+        if (depth > JSON_MAX_DEPTH)
+          return false;
+
+        skipWhitespace();
+        if (_m_current >= _m_end)
+          return false;
+
+        switch (*_m_current)
+        {
+        case '{':
+          value.type = JsonValue::eTYPE::kObject;
+          return parseObject(value, depth);
+        case '[':
+          value.type = JsonValue::eTYPE::kArray;
+          return parseArray(value, depth);
+        case '"':
+          value.type = JsonValue::eTYPE::kString;
+          return parseString(value.string);
+        case 't':
+          value.type = JsonValue::eTYPE::kBool;
+          value.boolean = true;
+          return parseLiteral("true");
+        case 'f':
+          value.type = JsonValue::eTYPE::kBool;
+          value.boolean = false;
+          return parseLiteral("false");
+        case 'n':
+          value.type = JsonValue::eTYPE::kNull;
+          return parseLiteral("null");
+        default:
+          value.type = JsonValue::eTYPE::kNumber;
+          return parseNumber(value.number);
+        }
+      }
+
+      bool
+      parseObject(JsonValue& value, const uint32& depth)
+      {
+        ++_m_current;
+        skipWhitespace();
+        if (_m_current < _m_end && '}' == *_m_current)
+        {
+          ++_m_current;
+          return true;
+        }
+
+        while (true)
+        {
+          skipWhitespace();
+          value.members.emplace_back();
+          std::pair<String, JsonValue>& member = value.members.back();
+          if (_m_current >= _m_end || '"' != *_m_current || !parseString(member.first))
+            return false;
+
+          skipWhitespace();
+          if (_m_current >= _m_end || ':' != *_m_current)
+            return false;
+          ++_m_current;
+
+          if (!parseValue(member.second, depth + 1))
+            return false;
+
+          skipWhitespace();
+          if (_m_current >= _m_end)
+            return false;
+          if ('}' == *_m_current)
+          {
+            ++_m_current;
+            return true;
+          }
+          if (',' != *_m_current)
+            return false;
+          ++_m_current;
+        }
+      }
+
+      bool
+      parseArray(JsonValue& value, const uint32& depth)
+      {
+        ++_m_current;
+        skipWhitespace();
+        if (_m_current < _m_end && ']' == *_m_current)
+        {
+          ++_m_current;
+          return true;
+        }
+
+        while (true)
+        {
+          value.elements.emplace_back();
+          if (!parseValue(value.elements.back(), depth + 1))
+            return false;
+
+          skipWhitespace();
+          if (_m_current >= _m_end)
+            return false;
+          if (']' == *_m_current)
+          {
+            ++_m_current;
+            return true;
+          }
+          if (',' != *_m_current)
+            return false;
+          ++_m_current;
+        }
+      }
+
+      bool
+      parseHex(uint32& codePoint)
+      {
+        if (_m_end - _m_current < 4)
+          return false;
+
+        codePoint = 0;
+        for (uint32 i = 0; i < 4; ++i)
+        {
+          char c = *_m_current++;
+          codePoint <<= 4;
+          if (c >= '0' && c <= '9')
+            codePoint |= c - '0';
+          else if (c >= 'a' && c <= 'f')
+            codePoint |= c - 'a' + 10;
+          else if (c >= 'A' && c <= 'F')
+            codePoint |= c - 'A' + 10;
+          else
+            return false;
+        }
+        return true;
+      }
+
+      void
+      appendUtf8(String& string, const uint32& codePoint)
+      {
+        if (codePoint < 0x80)
+        {
+          string += static_cast<char>(codePoint);
+        }
+        else if (codePoint < 0x800)
+        {
+          string += static_cast<char>(0xC0 | (codePoint >> 6));
+          string += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else if (codePoint < 0x10000)
+        {
+          string += static_cast<char>(0xE0 | (codePoint >> 12));
+          string += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+          string += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else
+        {
+          string += static_cast<char>(0xF0 | (codePoint >> 18));
+          string += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+          string += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+          string += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+      }
+
+      bool
+      parseString(String& string)
+      {
+        ++_m_current;
+        while (_m_current < _m_end)
+        {
+          char c = *_m_current++;
+          if ('"' == c)
+            return true;
+
+          if ('\\' != c)
+          {
+            string += c;
+            continue;
+          }
+
+          if (_m_current >= _m_end)
+            return false;
+
+          char escaped = *_m_current++;
+          switch (escaped)
+          {
+          case '"':
+          case '\\':
+          case '/':
+            string += escaped;
+            break;
+          case 'b':
+            string += '\b';
+            break;
+          case 'f':
+            string += '\f';
+            break;
+          case 'n':
+            string += '\n';
+            break;
+          case 'r':
+            string += '\r';
+            break;
+          case 't':
+            string += '\t';
+            break;
+          case 'u':
+          {
+            uint32 codePoint;
+            if (!parseHex(codePoint))
+              return false;
+
+            // Join the surrogate pairs.
+            if (codePoint >= 0xD800 && codePoint < 0xDC00
+                && _m_end - _m_current >= 6
+                && '\\' == _m_current[0] && 'u' == _m_current[1])
+            {
+              _m_current += 2;
+              uint32 lowSurrogate;
+              if (!parseHex(lowSurrogate))
+                return false;
+              codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+            }
+            appendUtf8(string, codePoint);
+            break;
+          }
+          default:
+            return false;
+          }
+        }
+        return false;
+      }
+
+      bool
+      parseNumber(double& number)
+      {
+        const char* begin = _m_current;
+        while (_m_current < _m_end
+               && (('0' <= *_m_current && *_m_current <= '9')
+                   || '-' == *_m_current || '+' == *_m_current
+                   || '.' == *_m_current || 'e' == *_m_current || 'E' == *_m_current))
+          ++_m_current;
+
+        // strtod needs a terminated string, the chunk is not.
+        char buffer[64];
+        hkSize length = static_cast<hkSize>(_m_current - begin);
+        if (0 == length || length >= sizeof(buffer))
+          return false;
+
+        std::memcpy(buffer, begin, length);
+        buffer[length] = '\0';
+
+        char* parsedEnd = nullptr;
+        number = std::strtod(buffer, &parsedEnd);
+        return parsedEnd == buffer + length;
+      }
+
+      bool
+      parseLiteral(const char* literal)
+      {
+        hkSize length = std::strlen(literal);
+        if (static_cast<hkSize>(_m_end - _m_current) < length
+            || 0 != std::memcmp(_m_current, literal, length))
+          return false;
+
+        _m_current += length;
+        return true;
+      }
+
+      const char*
+      _m_current;
+
+      const char*
+      _m_end;
+    };
+
+    /**
+     * Typed view of an accessor over the binary chunk.
+     */
+    struct GltfAccessor
+    {
+      GltfAccessor() :
+        data(nullptr),
+        count(0),
+        componentType(0),
+        componentsSize(0),
+        stride(0),
+        normalized(false)
+      { }
+
+      const uint8*
+      data;
+
+      uint32
+      count;
+
+      uint32
+      componentType;
+
+      uint32
+      componentsSize;
+
+      uint32
+      stride;
+
+      bool
+      normalized;
+    };
+
+    /**
+     * Result of resolving a part of the document.
+     */
+    enum class eGLTF_RESULT
+    {
+      kSuccess,
+      kMalformed,
+      kUnsupported
+    };
+
+    uint32
+    ComponentTypeSize(const uint32& componentType)
+    {
+      switch (componentType)
+      {
+      case GLTF_BYTE:
+      case GLTF_UNSIGNED_BYTE:
+        return 1;
+      case GLTF_SHORT:
+      case GLTF_UNSIGNED_SHORT:
+        return 2;
+      case GLTF_UNSIGNED_INT:
+      case GLTF_FLOAT:
+        return 4;
+      default:
+        return 0;
+      }
+    }
+
+    uint32
+    AccessorTypeComponents(const String& type)
+    {
+      if ("SCALAR" == type)
+        return 1;
+      if ("VEC2" == type)
+        return 2;
+      if ("VEC3" == type)
+        return 3;
+      if ("VEC4" == type)
+        return 4;
+      return 0;
+    }
+
+    /**
+     * Resolve an accessor to its data in the binary chunk, checking that all
+     * its elements are in the chunk.
+     */
+    eGLTF_RESULT
+    ResolveAccessor
+    (
+      const JsonValue& _root,
+      const uint8* _bin,
+      const hkSize& _binSize,
+      const uint32& _accessorIndex,
+      GltfAccessor& _accessor
+    )
+    {
+      const JsonValue* pAccessors = _root.find("accessors");
+      const JsonValue* pAccessor = nullptr != pAccessors ? pAccessors->at(_accessorIndex) : nullptr;
+      if (nullptr == pAccessor)
+        return eGLTF_RESULT::kMalformed;
+
+      // Sparse and buffer less accessors are not read.
+      if (nullptr != pAccessor->find("sparse") || nullptr == pAccessor->find("bufferView"))
+        return eGLTF_RESULT::kUnsupported;
+
+      uint32 bufferViewIndex = 0;
+      uint32 accessorOffset = 0;
+      uint32 count = 0;
+      uint32 componentType = 0;
+      if (!pAccessor->getIndex("bufferView", bufferViewIndex)
+          || !pAccessor->getIndex("byteOffset", accessorOffset)
+          || !pAccessor->getIndex("count", count)
+          || !pAccessor->getIndex("componentType", componentType))
+        return eGLTF_RESULT::kMalformed;
+
+      const JsonValue* pType = pAccessor->find("type");
+      uint32 componentsSize = nullptr != pType ? AccessorTypeComponents(pType->string) : 0;
+      uint32 componentSize = ComponentTypeSize(componentType);
+      if (0 == componentsSize || 0 == componentSize)
+        return eGLTF_RESULT::kMalformed;
+
+      const JsonValue* pBufferViews = _root.find("bufferViews");
+      const JsonValue* pBufferView = nullptr != pBufferViews ? pBufferViews->at(bufferViewIndex) : nullptr;
+      if (nullptr == pBufferView)
+        return eGLTF_RESULT::kMalformed;
+
+      uint32 bufferIndex = 0;
+      uint32 viewOffset = 0;
+      uint32 viewLength = 0;
+      uint32 elementSize = componentsSize * componentSize;
+      uint32 stride = elementSize;
+      if (!pBufferView->getIndex("buffer", bufferIndex)
+          || !pBufferView->getIndex("byteOffset", viewOffset)
+          || !pBufferView->getIndex("byteLength", viewLength)
+          || !pBufferView->getIndex("byteStride", stride)
+          || stride < elementSize)
+        return eGLTF_RESULT::kMalformed;
+
+      // Only the binary chunk of the GLB is read, buffers with an URI are
+      // left to Assimp.
+      const JsonValue* pBuffers = _root.find("buffers");
+      const JsonValue* pBuffer = nullptr != pBuffers ? pBuffers->at(bufferIndex) : nullptr;
+      if (nullptr == pBuffer)
+        return eGLTF_RESULT::kMalformed;
+      if (0 != bufferIndex || nullptr != pBuffer->find("uri") || nullptr == _bin)
+        return eGLTF_RESULT::kUnsupported;
+
+      if (static_cast<uint64>(viewOffset) + viewLength > _binSize)
+        return eGLTF_RESULT::kMalformed;
+
+      if (count > 0
+          && static_cast<uint64>(accessorOffset)
+             + static_cast<uint64>(stride) * (count - 1)
+             + elementSize > viewLength)
+        return eGLTF_RESULT::kMalformed;
+
+      const JsonValue* pNormalized = pAccessor->find("normalized");
+
+      _accessor.data = _bin + viewOffset + accessorOffset;
+      _accessor.count = count;
+      _accessor.componentType = componentType;
+      _accessor.componentsSize = componentsSize;
+      _accessor.stride = stride;
+      _accessor.normalized = nullptr != pNormalized && pNormalized->boolean;
+      return eGLTF_RESULT::kSuccess;
+    }
+
+    float
+    ReadComponent(const uint8* _data, const uint32& _componentType, const bool& _normalized)
+    {
+      switch (_componentType)
+      {
+      case GLTF_FLOAT:
+      {
+        float value;
+        std::memcpy(&value, _data, sizeof(float));
+        return value;
+      }
+      case GLTF_BYTE:
+      {
+        float value = static_cast<float>(static_cast<int8>(_data[0]));
+        return _normalized ? Math::Max(value / 127.0f, -1.0f) : value;
+      }
+      case GLTF_UNSIGNED_BYTE:
+      {
+        float value = static_cast<float>(_data[0]);
+        return _normalized ? value / 255.0f : value;
+      }
+      case GLTF_SHORT:
+      {
+        int16 component;
+        std::memcpy(&component, _data, sizeof(int16));
+        float value = static_cast<float>(component);
+        return _normalized ? Math::Max(value / 32767.0f, -1.0f) : value;
+      }
+      case GLTF_UNSIGNED_SHORT:
+      {
+        uint16 component;
+        std::memcpy(&component, _data, sizeof(uint16));
+        float value = static_cast<float>(component);
+        return _normalized ? value / 65535.0f : value;
+      }
+      default:
+        return 0.0f;
+      }
+    }
+
+    /**
+     * Copy the first components of every element of an accessor to the
+     * vertices, starting at the given vertex field.
+     */
+    void
+    CopyAttribute
+    (
+      const GltfAccessor& _accessor,
+      const uint32& _componentsSize,
+      Vertex* _vertices,
+      float Vertex::* _field
+    )
+    {
+      uint32 componentSize = ComponentTypeSize(_accessor.componentType);
+      for (uint32 i = 0; i < _accessor.count; ++i)
+      {
+        const uint8* element = _accessor.data + static_cast<hkSize>(_accessor.stride) * i;
+        float* destination = &(_vertices[i].*_field);
+
+        if (GLTF_FLOAT == _accessor.componentType)
+        {
+          std::memcpy(destination, element, _componentsSize * sizeof(float));
+          continue;
+        }
+
+        for (uint32 j = 0; j < _componentsSize; ++j)
+        {
+          destination[j] = ReadComponent
+          (
+            element + j * componentSize,
+            _accessor.componentType,
+            _accessor.normalized
+          );
+        }
+      }
+    }
+
+    /**
+     * Compute per vertex tangents from the texture coordinates, for the
+     * primitives without a TANGENT attribute, as Assimp does on import.
+     */
+    void
+    ComputeTangents
+    (
+      Vertex* _vertices,
+      const uint32& _verticesSize,
+      const uint32* _indices,
+      const uint32& _indicesSize
+    )
+    {
+      for (uint32 i = 0; i + 2 < _indicesSize; i += 3)
+      {
+        Vertex& v0 = _vertices[_indices[i]];
+        Vertex& v1 = _vertices[_indices[i + 1]];
+        Vertex& v2 = _vertices[_indices[i + 2]];
+
+        Vector3f edge1(v1.x - v0.x, v1.y - v0.y, v1.z - v0.z);
+        Vector3f edge2(v2.x - v0.x, v2.y - v0.y, v2.z - v0.z);
+        float du1 = v1.u - v0.u;
+        float dv1 = v1.v - v0.v;
+        float du2 = v2.u - v0.u;
+        float dv2 = v2.v - v0.v;
+
+        float determinant = du1 * dv2 - du2 * dv1;
+        if (Math::Abs(determinant) <= Math::FLOAT_EPSILON)
+          continue;
+
+        float inverse = 1.0f / determinant;
+        Vector3f tangent = (edge1 * dv2 - edge2 * dv1) * inverse;
+
+        for (Vertex* pVertex : { &v0, &v1, &v2 })
+        {
+          pVertex->tx += tangent.x;
+          pVertex->ty += tangent.y;
+          pVertex->tz += tangent.z;
+        }
+      }
+
+      // Orthogonalize against the normal.
+      for (uint32 i = 0; i < _verticesSize; ++i)
+      {
+        Vertex& vertex = _vertices[i];
+        Vector3f normal(vertex.nx, vertex.ny, vertex.nz);
+        Vector3f tangent(vertex.tx, vertex.ty, vertex.tz);
+        tangent = tangent - normal * (normal | tangent);
+
+        float length = tangent.magnitude();
+        if (length > Math::FLOAT_EPSILON)
+          tangent = tangent * (1.0f / length);
+        else
+          tangent = Vector3f(0.0f, 0.0f, 0.0f);
+
+        vertex.tx = tangent.x;
+        vertex.ty = tangent.y;
+        vertex.tz = tangent.z;
+      }
+    }
+
+    /**
+     * Local transform of a node, from its matrix or its TRS properties.
+     */
+    Matrix4
+    NodeTransform(const JsonValue& _node)
+    {
+      const JsonValue* pMatrix = _node.find("matrix");
+      if (nullptr != pMatrix && 16 == pMatrix->elements.size())
+      {
+        // glTF matrices are column major.
+        Matrix4 transform;
+        for (uint32 column = 0; column < 4; ++column)
+        {
+          for (uint32 row = 0; row < 4; ++row)
+            transform.m[row][column] = static_cast<float>(pMatrix->elements[column * 4 + row].number);
+        }
+        return transform;
+      }
+
+      float t[3] = { 0.0f, 0.0f, 0.0f };
+      float r[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+      float s[3] = { 1.0f, 1.0f, 1.0f };
+
+      const JsonValue* pTranslation = _node.find("translation");
+      if (nullptr != pTranslation && 3 == pTranslation->elements.size())
+      {
+        for (uint32 i = 0; i < 3; ++i)
+          t[i] = static_cast<float>(pTranslation->elements[i].number);
+      }
+
+      const JsonValue* pRotation = _node.find("rotation");
+      if (nullptr != pRotation && 4 == pRotation->elements.size())
+      {
+        for (uint32 i = 0; i < 4; ++i)
+          r[i] = static_cast<float>(pRotation->elements[i].number);
+      }
+
+      const JsonValue* pScale = _node.find("scale");
+      if (nullptr != pScale && 3 == pScale->elements.size())
+      {
+        for (uint32 i = 0; i < 3; ++i)
+          s[i] = static_cast<float>(pScale->elements[i].number);
+      }
+
+      float x = r[0];
+      float y = r[1];
+      float z = r[2];
+      float w = r[3];
+
+      return Matrix4
+      (
+        (1.0f - 2.0f * (y * y + z * z)) * s[0],
+        2.0f * (x * y - z * w) * s[1],
+        2.0f * (x * z + y * w) * s[2],
+        t[0],
+        2.0f * (x * y + z * w) * s[0],
+        (1.0f - 2.0f * (x * x + z * z)) * s[1],
+        2.0f * (y * z - x * w) * s[2],
+        t[1],
+        2.0f * (x * z - y * w) * s[0],
+        2.0f * (y * z + x * w) * s[1],
+        (1.0f - 2.0f * (x * x + y * y)) * s[2],
+        t[2],
+        0.0f, 0.0f, 0.0f, 1.0f
+      );
+    }
+
+    /**
+     * Accessors of a triangle primitive.
+     */
+    struct GltfPrimitive
+    {
+      GltfPrimitive() :
+        meshIndex(0),
+        materialIndex(0),
+        hasNormals(false),
+        hasTangents(false),
+        hasTexCoords(false),
+        hasIndices(false)
+      { }
+
+      uint32
+      meshIndex;
+
+      uint32
+      materialIndex;
+
+      GltfAccessor
+      positions;
+
+      GltfAccessor
+      normals;
+
+      GltfAccessor
+      tangents;
+
+      GltfAccessor
+      texCoords;
+
+      GltfAccessor
+      indices;
+
+      bool
+      hasNormals;
+
+      bool
+      hasTangents;
+
+      bool
+      hasTexCoords;
+
+      bool
+      hasIndices;
+    };
+
+    /**
+     * Resolve an optional vertex attribute of a primitive and check its
+     * type.
+     */
+    eGLTF_RESULT
+    ResolveAttribute
+    (
+      const JsonValue& _root,
+      const JsonValue& _attributes,
+      const char* _name,
+      const uint8* _bin,
+      const hkSize& _binSize,
+      const uint32& _minComponents,
+      const bool& _allowNormalized,
+      GltfAccessor& _accessor,
+      bool& _found
+    )
+    {
+      _found = false;
+      if (nullptr == _attributes.find(_name))
+        return eGLTF_RESULT::kSuccess;
+
+      uint32 accessorIndex = 0;
+      if (!_attributes.getIndex(_name, accessorIndex))
+        return eGLTF_RESULT::kMalformed;
+
+      eGLTF_RESULT result = ResolveAccessor(_root, _bin, _binSize, accessorIndex, _accessor);
+      if (eGLTF_RESULT::kSuccess != result)
+        return result;
+
+      bool validType = GLTF_FLOAT == _accessor.componentType
+                       || (_allowNormalized && _accessor.normalized);
+      if (!validType || _accessor.componentsSize < _minComponents)
+        return eGLTF_RESULT::kMalformed;
+
+      _found = true;
+      return eGLTF_RESULT::kSuccess;
+    }
+  }
+
+  MeshLoaderGltf::MeshLoaderGltf() :
+    _m_configuration(),
+    _m_dependencies()
+  { }
+
+  MeshLoaderGltf::MeshLoaderGltf(const MeshImportConfiguration& configuration) :
+    _m_configuration(configuration),
+    _m_dependencies()
+  { }
+
+  MeshLoaderGltf::~MeshLoaderGltf()
+  { }
+
+  void
+  MeshLoaderGltf::setConfiguration(const MeshImportConfiguration& configuration)
+  {
+    _m_configuration = configuration;
+  }
+
+  const MeshImportConfiguration&
+  MeshLoaderGltf::getConfiguration() const
+  {
+    return _m_configuration;
+  }
+
+  const Vector<String>&
+  MeshLoaderGltf::getDependencies() const
+  {
+    return _m_dependencies;
+  }
+
+  bool
+  MeshLoaderGltf::IsGlb(const String& path)
+  {
+    hkSize dot = path.find_last_of('.');
+    if (String::npos == dot)
+      return false;
+
+    String extension = path.substr(dot);
+    for (char& c : extension)
+      c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+
+    return ".glb" == extension;
+  }
+
+  MultiMesh*
+  MeshLoaderGltf::load(String path)
+  {
+    _m_dependencies.clear();
+    if (!IsGlb(path))
+    {
+      MeshLoaderAssimp meshLoader(_m_configuration);
+      MultiMesh* pMultiMesh = meshLoader.load(path);
+      _m_dependencies = meshLoader.getDependencies();
+      return pMultiMesh;
+    }
+
+    MultiMesh* pMultiMesh = nullptr;
+    bool unsupported = false;
+    {
+      MappedFile file;
+      if (!file.open(path))
+      {
+        Logger::Error("| MeshLoaderGltf | Couldn't open the file: " + path);
+        return nullptr;
+      }
+
+      pMultiMesh = parse(file.getData(), file.getSize(), unsupported);
+    }
+
+    if (unsupported)
+    {
+      Logger::Warning("| MeshLoaderGltf | Loading with Assimp: " + path);
+      MeshLoaderAssimp meshLoader(_m_configuration);
+      pMultiMesh = meshLoader.load(path);
+      _m_dependencies = meshLoader.getDependencies();
+      return pMultiMesh;
+    }
+
+    return pMultiMesh;
+  }
+
+  MultiMesh*
+  MeshLoaderGltf::loadFromMemory(const uint8* data, const hkSize& dataSize)
+  {
+    bool unsupported = false;
+    return parse(data, dataSize, unsupported);
+  }
+
+  MultiMesh*
+  MeshLoaderGltf::parse(const uint8* data, const hkSize& dataSize, bool& unsupported)
+  {
+    unsupported = false;
+
+    uint32 header[3];
+    if (dataSize < sizeof(header))
+    {
+      Logger::Error("| MeshLoaderGltf | The data is too small for a GLB file.");
+      return nullptr;
+    }
+
+    std::memcpy(header, data, sizeof(header));
+    if (GLB_MAGIC != header[0])
+    {
+      Logger::Error("| MeshLoaderGltf | The data is not a GLB file.");
+      return nullptr;
+    }
+
+    if (GLB_VERSION != header[1])
+    {
+      Logger::Warning("| MeshLoaderGltf | Unsupported GLB version: " + std::to_string(header[1]));
+      unsupported = true;
+      return nullptr;
+    }
+
+    hkSize length = Math::Min(static_cast<hkSize>(header[2]), dataSize);
+
+    // The JSON chunk comes first, the binary chunk is optional.
+    const uint8* json = nullptr;
+    hkSize jsonSize = 0;
+    const uint8* bin = nullptr;
+    hkSize binSize = 0;
+    hkSize offset = sizeof(header);
+    while (length - offset >= 2 * sizeof(uint32))
+    {
+      uint32 chunkHeader[2];
+      std::memcpy(chunkHeader, data + offset, sizeof(chunkHeader));
+      offset += sizeof(chunkHeader);
+
+      if (chunkHeader[0] > length - offset)
+      {
+        Logger::Error("| MeshLoaderGltf | Truncated GLB chunk.");
+        return nullptr;
+      }
+
+      if (GLB_CHUNK_JSON == chunkHeader[1] && nullptr == json)
+      {
+        json = data + offset;
+        jsonSize = chunkHeader[0];
+      }
+      else if (GLB_CHUNK_BIN == chunkHeader[1] && nullptr == bin)
+      {
+        bin = data + offset;
+        binSize = chunkHeader[0];
+      }
+
+      offset += chunkHeader[0];
+    }
+
+    JsonValue root;
+    JsonParser parser(reinterpret_cast<const char*>(json),
+                      reinterpret_cast<const char*>(json) + jsonSize);
+    if (nullptr == json || !parser.parse(root) || JsonValue::eTYPE::kObject != root.type)
+    {
+      Logger::Error("| MeshLoaderGltf | Malformed glTF JSON chunk.");
+      return nullptr;
+    }
+
+    const JsonValue* pExtensionsRequired = root.find("extensionsRequired");
+    if (nullptr != pExtensionsRequired && !pExtensionsRequired->elements.empty())
+    {
+      Logger::Warning("| MeshLoaderGltf | The file requires glTF extensions.");
+      unsupported = true;
+      return nullptr;
+    }
+
+    // Resolve the triangle primitives of every mesh, each one is loaded as
+    // a mesh of the multimesh.
+    const JsonValue emptyValue;
+    const JsonValue* pMeshes = root.find("meshes");
+    const Vector<JsonValue>& gltfMeshes = nullptr != pMeshes ? pMeshes->elements : emptyValue.elements;
+
+    Vector<GltfPrimitive> primitives;
+    Vector<Vector<uint32>> meshPrimitives(gltfMeshes.size());
+    uint32 verticesSize = 0;
+    uint32 indicesSize = 0;
+    for (uint32 meshIndex = 0; meshIndex < gltfMeshes.size(); ++meshIndex)
+    {
+      const JsonValue* pPrimitives = gltfMeshes[meshIndex].find("primitives");
+      if (nullptr == pPrimitives)
+        continue;
+
+      for (const JsonValue& gltfPrimitive : pPrimitives->elements)
+      {
+        uint32 mode = GLTF_TRIANGLES;
+        const JsonValue* pAttributes = gltfPrimitive.find("attributes");
+        if (!gltfPrimitive.getIndex("mode", mode) || nullptr == pAttributes)
+        {
+          Logger::Error("| MeshLoaderGltf | Malformed glTF primitive.");
+          return nullptr;
+        }
+
+        if (GLTF_TRIANGLES != mode)
+        {
+          Logger::Warning("| MeshLoaderGltf | Skipped a primitive that is not a triangle list.");
+          continue;
+        }
+
+        GltfPrimitive primitive;
+        primitive.meshIndex = meshIndex;
+
+        bool hasPositions = false;
+        eGLTF_RESULT results[5];
+        results[0] = ResolveAttribute(root, *pAttributes, "POSITION", bin, binSize, 3, false, primitive.positions, hasPositions);
+        results[1] = ResolveAttribute(root, *pAttributes, "NORMAL", bin, binSize, 3, false, primitive.normals, primitive.hasNormals);
+        results[2] = ResolveAttribute(root, *pAttributes, "TANGENT", bin, binSize, 3, false, primitive.tangents, primitive.hasTangents);
+        results[3] = ResolveAttribute(root, *pAttributes, "TEXCOORD_0", bin, binSize, 2, true, primitive.texCoords, primitive.hasTexCoords);
+        results[4] = eGLTF_RESULT::kSuccess;
+
+        uint32 indicesAccessor = 0;
+        if (nullptr != gltfPrimitive.find("indices"))
+        {
+          if (!gltfPrimitive.getIndex("indices", indicesAccessor))
+            results[4] = eGLTF_RESULT::kMalformed;
+          else
+            results[4] = ResolveAccessor(root, bin, binSize, indicesAccessor, primitive.indices);
+
+          primitive.hasIndices = true;
+          if (eGLTF_RESULT::kSuccess == results[4]
+              && (1 != primitive.indices.componentsSize
+                  || (GLTF_UNSIGNED_BYTE != primitive.indices.componentType
+                      && GLTF_UNSIGNED_SHORT != primitive.indices.componentType
+                      && GLTF_UNSIGNED_INT != primitive.indices.componentType)))
+            results[4] = eGLTF_RESULT::kMalformed;
+        }
+
+        if (!gltfPrimitive.getIndex("material", primitive.materialIndex))
+          results[4] = eGLTF_RESULT::kMalformed;
+
+        for (const eGLTF_RESULT& result : results)
+        {
+          if (eGLTF_RESULT::kUnsupported == result)
+          {
+            Logger::Warning("| MeshLoaderGltf | The file uses external buffers or sparse accessors.");
+            unsupported = true;
+            return nullptr;
+          }
+        }
+
+        for (const eGLTF_RESULT& result : results)
+        {
+          if (eGLTF_RESULT::kMalformed == result)
+          {
+            Logger::Error("| MeshLoaderGltf | Malformed glTF accessor.");
+            return nullptr;
+          }
+        }
+
+        if (!hasPositions)
+        {
+          Logger::Warning("| MeshLoaderGltf | Skipped a primitive without positions.");
+          continue;
+        }
+
+        uint32 primitiveVertices = primitive.positions.count;
+        if ((primitive.hasNormals && primitive.normals.count != primitiveVertices)
+            || (primitive.hasTangents && primitive.tangents.count != primitiveVertices)
+            || (primitive.hasTexCoords && primitive.texCoords.count != primitiveVertices))
+        {
+          Logger::Error("| MeshLoaderGltf | The attributes of a primitive have different counts.");
+          return nullptr;
+        }
+
+        uint32 primitiveIndices = primitive.hasIndices ? primitive.indices.count : primitiveVertices;
+        primitiveIndices -= primitiveIndices % 3;
+        if (static_cast<uint64>(verticesSize) + primitiveVertices > 0xFFFFFFFF
+            || static_cast<uint64>(indicesSize) + primitiveIndices > 0xFFFFFFFF)
+        {
+          Logger::Error("| MeshLoaderGltf | The file has too many vertices.");
+          return nullptr;
+        }
+
+        meshPrimitives[meshIndex].push_back(static_cast<uint32>(primitives.size()));
+        primitives.push_back(primitive);
+        verticesSize += primitiveVertices;
+        indicesSize += primitiveIndices;
+      }
+    }
+
+    if (primitives.empty())
+      return nullptr;
+
+    // Collect the nodes that draw a mesh, with their world transform.
+    const JsonValue* pNodes = root.find("nodes");
+    const Vector<JsonValue>& gltfNodes = nullptr != pNodes ? pNodes->elements : emptyValue.elements;
+
+    Vector<uint32> roots;
+    const JsonValue* pScenes = root.find("scenes");
+    if (nullptr != pScenes && !pScenes->elements.empty())
+    {
+      uint32 sceneIndex = 0;
+      root.getIndex("scene", sceneIndex);
+      const JsonValue* pScene = pScenes->at(sceneIndex);
+      const JsonValue* pSceneNodes = nullptr != pScene ? pScene->find("nodes") : nullptr;
+      if (nullptr != pSceneNodes)
+      {
+        for (const JsonValue& sceneNode : pSceneNodes->elements)
+        {
+          if (sceneNode.number >= 0.0)
+            roots.push_back(static_cast<uint32>(sceneNode.number));
+        }
+      }
+    }
+    else
+    {
+      Vector<bool> isChild(gltfNodes.size(), false);
+      for (const JsonValue& gltfNode : gltfNodes)
+      {
+        const JsonValue* pChildren = gltfNode.find("children");
+        if (nullptr == pChildren)
+          continue;
+        for (const JsonValue& child : pChildren->elements)
+        {
+          if (child.number >= 0.0 && child.number < gltfNodes.size())
+            isChild[static_cast<hkSize>(child.number)] = true;
+        }
+      }
+
+      for (uint32 i = 0; i < gltfNodes.size(); ++i)
+      {
+        if (!isChild[i])
+          roots.push_back(i);
+      }
+    }
+
+    Vector<std::pair<uint32, Matrix4>> meshNodes;
+    Vector<bool> visited(gltfNodes.size(), false);
+    Stack<std::pair<uint32, Matrix4>> pending;
+    for (auto it = roots.rbegin(); it != roots.rend(); ++it)
+      pending.push(std::make_pair(*it, Matrix4::GetIdentity()));
+
+    while (!pending.empty())
+    {
+      std::pair<uint32, Matrix4> current = pending.top();
+      pending.pop();
+
+      if (current.first >= gltfNodes.size() || visited[current.first])
+        continue;
+      visited[current.first] = true;
+
+      const JsonValue& gltfNode = gltfNodes[current.first];
+      Matrix4 transform = current.second * NodeTransform(gltfNode);
+
+      uint32 meshIndex = 0;
+      if (nullptr != gltfNode.find("mesh")
+          && gltfNode.getIndex("mesh", meshIndex)
+          && meshIndex < meshPrimitives.size()
+          && !meshPrimitives[meshIndex].empty())
+        meshNodes.push_back(std::make_pair(meshIndex, transform));
+
+      const JsonValue* pChildren = gltfNode.find("children");
+      if (nullptr == pChildren)
+        continue;
+
+      for (auto it = pChildren->elements.rbegin(); it != pChildren->elements.rend(); ++it)
+      {
+        if (it->number >= 0.0)
+          pending.push(std::make_pair(static_cast<uint32>(it->number), transform));
+      }
+    }
+
+    // Fill the multimesh straight from the accessors.
+    MultiMeshLayout layout;
+    layout.verticesSize = verticesSize;
+    layout.indicesSize = indicesSize;
+    layout.meshesSize = static_cast<uint32>(primitives.size());
+    layout.nodesSize = static_cast<uint32>(meshNodes.size());
+    for (const GltfPrimitive& primitive : primitives)
+    {
+      const JsonValue* pName = gltfMeshes[primitive.meshIndex].find("name");
+      if (nullptr != pName)
+        layout.namesSize += MultiMeshLayout::NameSize(pName->string);
+    }
+    for (const std::pair<uint32, Matrix4>& meshNode : meshNodes)
+      layout.nodeMeshesIndicesSize += static_cast<uint32>(meshPrimitives[meshNode.first].size());
+
+    MultiMesh* pMultiMesh = new MultiMesh(layout);
+    Vertex* vertices = pMultiMesh->getVerticesPtr();
+    uint32* indices = pMultiMesh->getIndicesPtr();
+    MultiMeshMesh* meshes = pMultiMesh->getMeshesPtr();
+    MultiMeshNode* nodes = pMultiMesh->getNodes();
+    uint32* nodeMeshesIndices = pMultiMesh->getNodeMeshesIndicesPtr();
+
+    uint32 vertexIndex = 0;
+    uint32 indexIndex = 0;
+    for (uint32 i = 0; i < primitives.size(); ++i)
+    {
+      const GltfPrimitive& primitive = primitives[i];
+      MultiMeshMesh& mesh = meshes[i];
+
+      const JsonValue* pName = gltfMeshes[primitive.meshIndex].find("name");
+      if (nullptr != pName)
+        pMultiMesh->setMeshName(i, pName->string);
+      mesh.firstVertexIndex = vertexIndex;
+      mesh.verticesSize = primitive.positions.count;
+      mesh.firstIndexIndex = indexIndex;
+      mesh.materialIndex = primitive.materialIndex;
+
+      Vertex* meshVertices = vertices + vertexIndex;
+      CopyAttribute(primitive.positions, 3, meshVertices, &Vertex::x);
+      if (primitive.hasNormals)
+        CopyAttribute(primitive.normals, 3, meshVertices, &Vertex::nx);
+      if (primitive.hasTangents)
+        CopyAttribute(primitive.tangents, 3, meshVertices, &Vertex::tx);
+      if (primitive.hasTexCoords)
+      {
+        CopyAttribute(primitive.texCoords, 2, meshVertices, &Vertex::u);
+
+        // glTF has the texture origin at the top left, Assimp flips it.
+        for (uint32 j = 0; j < mesh.verticesSize; ++j)
+          meshVertices[j].v = 1.0f - meshVertices[j].v;
+      }
+
+      uint32* meshIndices = indices + indexIndex;
+      if (primitive.hasIndices)
+      {
+        mesh.indicesSize = primitive.indices.count - primitive.indices.count % 3;
+        uint32 componentSize = ComponentTypeSize(primitive.indices.componentType);
+        for (uint32 j = 0; j < mesh.indicesSize; ++j)
+        {
+          const uint8* element = primitive.indices.data + static_cast<hkSize>(primitive.indices.stride) * j;
+          uint32 index = 0;
+          if (1 == componentSize)
+          {
+            index = element[0];
+          }
+          else if (2 == componentSize)
+          {
+            uint16 shortIndex;
+            std::memcpy(&shortIndex, element, sizeof(uint16));
+            index = shortIndex;
+          }
+          else
+          {
+            std::memcpy(&index, element, sizeof(uint32));
+          }
+
+          if (index >= mesh.verticesSize)
+          {
+            Logger::Error("| MeshLoaderGltf | Index out of the primitive vertices.");
+            delete pMultiMesh;
+            return nullptr;
+          }
+          meshIndices[j] = index;
+        }
+      }
+      else
+      {
+        mesh.indicesSize = mesh.verticesSize - mesh.verticesSize % 3;
+        for (uint32 j = 0; j < mesh.indicesSize; ++j)
+          meshIndices[j] = j;
+      }
+
+      if (!primitive.hasTangents && primitive.hasNormals && primitive.hasTexCoords)
+        ComputeTangents(meshVertices, mesh.verticesSize, meshIndices, mesh.indicesSize);
+
+      const float* positions = &meshVertices[0].x;
+      mesh.boundingBox = BoundingBox::FromPositions(positions, mesh.verticesSize, sizeof(Vertex));
+      mesh.boundingSphere = BoundingSphere::FromPositions
+      (
+        positions,
+        mesh.verticesSize,
+        sizeof(Vertex),
+        mesh.boundingBox
+      );
+      mesh.contentHash = MeshDeduplicator::ContentHash
+      (
+        meshVertices,
+        mesh.verticesSize,
+        meshIndices,
+        mesh.indicesSize
+      );
+
+      vertexIndex += mesh.verticesSize;
+      indexIndex += mesh.indicesSize;
+    }
+
+    uint32 meshIndexIndex = 0;
+    for (uint32 i = 0; i < meshNodes.size(); ++i)
+    {
+      const Vector<uint32>& nodePrimitives = meshPrimitives[meshNodes[i].first];
+      for (uint32 j = 0; j < nodePrimitives.size(); ++j)
+        nodeMeshesIndices[meshIndexIndex + j] = nodePrimitives[j];
+
+      nodes[i].firstMeshIndexIndex = meshIndexIndex;
+      nodes[i].meshesIndicesSize = static_cast<uint32>(nodePrimitives.size());
+      nodes[i].transform = meshNodes[i].second;
+      meshIndexIndex += nodes[i].meshesIndicesSize;
+    }
+
+    pMultiMesh->computeNodesBounds();
+    return MeshPostProcessor::Process(pMultiMesh, _m_configuration);
+  }
+}
\ No newline at end of file
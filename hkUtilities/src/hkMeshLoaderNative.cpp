@@ -0,0 +1,620 @@
+#include "Hakool/Utils/hkMeshLoaderNative.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "Hakool/Utils/hkLogger.h"
+#include "Hakool/Utils/hkMeshFile.h"
+#include "Hakool/Utils/hkMeshCodec.h"
+#include "Hakool/Utils/hkVertex.h"
+#include "Hakool/Utils/hkQuantizedVertex.h"
+#include "Hakool/Utils/hkMultiMesh.h"
+#include "Hakool/Utils/hkMultiMeshMesh.h"
+#include "Hakool/Utils/hkMultiMeshNode.h"
+#include "Hakool/Utils/hkMultiMeshLod.h"
+#include "Hakool/Utils/hkMultiMeshBatchRange.h"
+#include "Hakool/Utils/hkMultiMeshInstance.h"
+
+namespace hk
+{
+  namespace
+  {
+    /**
+     * Bounds checked reader of the file data.
+     */
+    class DataReader
+    {
+    public:
+
+      DataReader(const uint8* data, const hkSize& dataSize) :
+        _m_data(data),
+        _m_dataSize(dataSize),
+        _m_offset(0),
+        _m_failed(false)
+      { }
+
+      template<typename T>
+      T
+      read()
+      {
+        T value = T();
+        if (_m_failed || _m_dataSize - _m_offset < sizeof(T))
+        {
+          _m_failed = true;
+          return value;
+        }
+
+        std::memcpy(&value, _m_data + _m_offset, sizeof(T));
+        _m_offset += sizeof(T);
+        return value;
+      }
+
+      Vector3f
+      readVector3()
+      {
+        float x = read<float>();
+        float y = read<float>();
+        float z = read<float>();
+        return Vector3f(x, y, z);
+      }
+
+      void
+      readBytes(void* destination, const uint32& size)
+      {
+        if (_m_failed || _m_dataSize - _m_offset < size)
+        {
+          _m_failed = true;
+          return;
+        }
+
+        std::memcpy(destination, _m_data + _m_offset, size);
+        _m_offset += size;
+      }
+
+      const hkSize&
+      getOffset() const
+      {
+        return _m_offset;
+      }
+
+      const bool&
+      failed() const
+      {
+        return _m_failed;
+      }
+
+    private:
+
+      const uint8*
+      _m_data;
+
+      hkSize
+      _m_dataSize;
+
+      hkSize
+      _m_offset;
+
+      bool
+      _m_failed;
+    };
+
+    /**
+     * Arrays of the multimesh the streams of a mesh file are decoded to.
+     */
+    struct MeshFileStreams
+    {
+      explicit MeshFileStreams(MultiMesh& multiMesh) :
+        vertices(multiMesh.getVerticesPtr()),
+        quantizedVertices(multiMesh.getQuantizedVerticesPtr()),
+        indices(multiMesh.getIndicesPtr()),
+        meshes(multiMesh.getMeshesPtr()),
+        nodes(multiMesh.getNodes()),
+        nodeMeshesIndices(multiMesh.getNodeMeshesIndicesPtr()),
+        names(multiMesh.getNamesPtr()),
+        lods(multiMesh.getLodsPtr()),
+        lodIndices(multiMesh.getLodIndicesPtr()),
+        batchRanges(multiMesh.getBatchRangesPtr()),
+        instances(multiMesh.getInstancesPtr()),
+        instanceTransforms(multiMesh.getInstanceTransformsPtr())
+      { }
+
+      Vertex* vertices;
+
+      QuantizedVertex* quantizedVertices;
+
+      uint32* indices;
+
+      MultiMeshMesh* meshes;
+
+      MultiMeshNode* nodes;
+
+      uint32* nodeMeshesIndices;
+
+      char* names;
+
+      MultiMeshLod* lods;
+
+      uint32* lodIndices;
+
+      MultiMeshBatchRange* batchRanges;
+
+      MultiMeshInstance* instances;
+
+      Matrix4* instanceTransforms;
+    };
+
+    bool
+    ReadMetadata
+    (
+      DataReader& _reader,
+      const MeshFileHeader& _header,
+      MeshFileStreams& _streams
+    )
+    {
+      for (uint32 i = 0; i < _header.meshesSize; ++i)
+      {
+        MultiMeshMesh& mesh = _streams.meshes[i];
+
+        mesh.nameOffset = _reader.read<uint32>();
+        mesh.firstVertexIndex = _reader.read<uint32>();
+        mesh.verticesSize = _reader.read<uint32>();
+        mesh.firstIndexIndex = _reader.read<uint32>();
+        mesh.indicesSize = _reader.read<uint32>();
+        mesh.materialIndex = _reader.read<uint32>();
+        mesh.contentHash = _reader.read<uint64>();
+        mesh.firstLodIndex = _reader.read<uint32>();
+        mesh.lodsSize = _reader.read<uint32>();
+
+        mesh.quantization.positionOffset = _reader.readVector3();
+        mesh.quantization.positionScale = _reader.readVector3();
+        mesh.quantization.positionError = _reader.read<float>();
+        mesh.quantization.normalError = _reader.read<float>();
+        mesh.quantization.tangentError = _reader.read<float>();
+        mesh.quantization.uvError = _reader.read<float>();
+
+        mesh.boundingBox.minimum = _reader.readVector3();
+        mesh.boundingBox.maximum = _reader.readVector3();
+        mesh.boundingSphere.center = _reader.readVector3();
+        mesh.boundingSphere.radius = _reader.read<float>();
+
+        if (_reader.failed()
+            || (MultiMeshMesh::NO_NAME != mesh.nameOffset && mesh.nameOffset >= _header.namesSize)
+            || static_cast<uint64>(mesh.firstVertexIndex) + mesh.verticesSize > _header.verticesSize
+            || static_cast<uint64>(mesh.firstIndexIndex) + mesh.indicesSize > _header.indicesSize
+            || static_cast<uint64>(mesh.firstLodIndex) + mesh.lodsSize > _header.lodsSize)
+          return false;
+      }
+
+      for (uint32 i = 0; i < _header.nodesSize; ++i)
+      {
+        MultiMeshNode& node = _streams.nodes[i];
+
+        node.firstMeshIndexIndex = _reader.read<uint32>();
+        node.meshesIndicesSize = _reader.read<uint32>();
+        for (uint32 j = 0; j < 16; ++j)
+          node.transform.a[j] = _reader.read<float>();
+
+        if (_reader.failed()
+            || static_cast<uint64>(node.firstMeshIndexIndex) + node.meshesIndicesSize
+               > _header.nodeMeshesIndicesSize)
+          return false;
+      }
+
+      for (uint32 i = 0; i < _header.nodeMeshesIndicesSize; ++i)
+      {
+        _streams.nodeMeshesIndices[i] = _reader.read<uint32>();
+        if (_streams.nodeMeshesIndices[i] >= _header.meshesSize)
+          return false;
+      }
+
+      // Every name is terminated, so the names array must end with one.
+      _reader.readBytes(_streams.names, _header.namesSize);
+      if (_reader.failed() || (0 != _header.namesSize && '\0' != _streams.names[_header.namesSize - 1]))
+        return false;
+
+      for (uint32 i = 0; i < _header.lodsSize; ++i)
+      {
+        MultiMeshLod& lod = _streams.lods[i];
+
+        lod.firstIndexIndex = _reader.read<uint32>();
+        lod.indicesSize = _reader.read<uint32>();
+        lod.error = _reader.read<float>();
+
+        if (_reader.failed()
+            || static_cast<uint64>(lod.firstIndexIndex) + lod.indicesSize > _header.lodIndicesSize)
+          return false;
+      }
+
+      for (uint32 i = 0; i < _header.batchRangesSize; ++i)
+      {
+        MultiMeshBatchRange& range = _streams.batchRanges[i];
+
+        range.firstIndexIndex = _reader.read<uint32>();
+        range.indicesSize = _reader.read<uint32>();
+        range.sourceNodeIndex = _reader.read<uint32>();
+        range.sourceMeshIndex = _reader.read<uint32>();
+
+        if (_reader.failed()
+            || static_cast<uint64>(range.firstIndexIndex) + range.indicesSize > _header.indicesSize
+            || range.sourceNodeIndex >= _header.batchSourceNodesSize
+            || range.sourceMeshIndex >= _header.batchSourceMeshesSize)
+          return false;
+      }
+
+      for (uint32 i = 0; i < _header.instancesSize; ++i)
+      {
+        MultiMeshInstance& instance = _streams.instances[i];
+
+        instance.meshIndex = _reader.read<uint32>();
+        instance.firstTransformIndex = _reader.read<uint32>();
+        instance.transformsSize = _reader.read<uint32>();
+
+        if (_reader.failed()
+            || instance.meshIndex >= _header.meshesSize
+            || static_cast<uint64>(instance.firstTransformIndex) + instance.transformsSize
+               > _header.instanceTransformsSize)
+          return false;
+      }
+
+      for (uint32 i = 0; i < _header.instanceTransformsSize; ++i)
+      {
+        for (uint32 j = 0; j < 16; ++j)
+          _streams.instanceTransforms[i].a[j] = _reader.read<float>();
+      }
+
+      return !_reader.failed();
+    }
+
+    /**
+     * Sorts the chunks by stream and first element, and checks that the
+     * chunks of every stream cover it whole without overlapping, so every
+     * element is decoded once and by a single thread.
+     */
+    bool
+    CheckChunkTable(Vector<MeshFileChunk>& _chunks, const uint32 (&_streamsSize)[4])
+    {
+      std::sort
+      (
+        _chunks.begin(),
+        _chunks.end(),
+        [](const MeshFileChunk& _a, const MeshFileChunk& _b)
+        {
+          if (_a.stream != _b.stream)
+            return _a.stream < _b.stream;
+          return _a.firstElement < _b.firstElement;
+        }
+      );
+
+      uint64 aStreamsEnd[4] = { 0, 0, 0, 0 };
+      for (const MeshFileChunk& chunk : _chunks)
+      {
+        uint32 stream = static_cast<uint32>(chunk.stream);
+        if (stream >= 4 || chunk.firstElement != aStreamsEnd[stream])
+          return false;
+
+        aStreamsEnd[stream] += chunk.elementsSize;
+      }
+
+      for (uint32 i = 0; i < 4; ++i)
+      {
+        if (aStreamsEnd[i] != _streamsSize[i])
+          return false;
+      }
+      return true;
+    }
+
+    /**
+     * Checks that the indices and the LOD indices of every mesh address its
+     * own vertices.
+     */
+    bool
+    CheckIndices(const MeshFileHeader& _header, const MeshFileStreams& _streams)
+    {
+      for (uint32 i = 0; i < _header.meshesSize; ++i)
+      {
+        const MultiMeshMesh& mesh = _streams.meshes[i];
+        const uint32* indices = _streams.indices + mesh.firstIndexIndex;
+        for (uint32 j = 0; j < mesh.indicesSize; ++j)
+        {
+          if (indices[j] >= mesh.verticesSize)
+            return false;
+        }
+
+        for (uint32 j = 0; j < mesh.lodsSize; ++j)
+        {
+          const MultiMeshLod& lod = _streams.lods[mesh.firstLodIndex + j];
+          const uint32* lodIndices = _streams.lodIndices + lod.firstIndexIndex;
+          for (uint32 k = 0; k < lod.indicesSize; ++k)
+          {
+            if (lodIndices[k] >= mesh.verticesSize)
+              return false;
+          }
+        }
+      }
+      return true;
+    }
+
+    /**
+     * Decodes a chunk into its stream. Returns false if the chunk is out of
+     * the stream or its data is malformed.
+     */
+    bool
+    DecodeChunk
+    (
+      const MeshFileChunk& _chunk,
+      const MeshFileHeader& _header,
+      const uint8* _data,
+      const hkSize& _dataSize,
+      MeshFileStreams& _streams
+    )
+    {
+      if (_chunk.offset > _dataSize || _dataSize - _chunk.offset < _chunk.dataSize)
+        return false;
+
+      const uint8* chunkData = _data + _chunk.offset;
+      uint64 lastElement = static_cast<uint64>(_chunk.firstElement) + _chunk.elementsSize;
+
+      switch (_chunk.stream)
+      {
+      case eMESH_FILE_STREAM::kVertices:
+        if (nullptr == _streams.vertices || lastElement > _header.verticesSize)
+          return false;
+
+        return MeshCodec::DecodeVertexBuffer
+        (
+          reinterpret_cast<uint8*>(_streams.vertices + _chunk.firstElement),
+          _chunk.elementsSize,
+          sizeof(Vertex),
+          chunkData,
+          _chunk.dataSize
+        );
+
+      case eMESH_FILE_STREAM::kQuantizedVertices:
+        if (nullptr == _streams.quantizedVertices || lastElement > _header.verticesSize)
+          return false;
+
+        return MeshCodec::DecodeVertexBuffer
+        (
+          reinterpret_cast<uint8*>(_streams.quantizedVertices + _chunk.firstElement),
+          _chunk.elementsSize,
+          sizeof(QuantizedVertex),
+          chunkData,
+          _chunk.dataSize
+        );
+
+      case eMESH_FILE_STREAM::kIndices:
+        if (lastElement > _header.indicesSize)
+          return false;
+
+        return MeshCodec::DecodeIndexBuffer
+        (
+          _streams.indices + _chunk.firstElement,
+          _chunk.elementsSize,
+          chunkData,
+          _chunk.dataSize
+        );
+
+      case eMESH_FILE_STREAM::kLodIndices:
+        if (lastElement > _header.lodIndicesSize)
+          return false;
+
+        return MeshCodec::DecodeIndexBuffer
+        (
+          _streams.lodIndices + _chunk.firstElement,
+          _chunk.elementsSize,
+          chunkData,
+          _chunk.dataSize
+        );
+
+      default:
+        return false;
+      }
+    }
+  }
+
+  MeshLoaderNative::MeshLoaderNative() :
+    _m_threadsSize(0)
+  { }
+
+  MeshLoaderNative::~MeshLoaderNative()
+  { }
+
+  MultiMesh*
+  MeshLoaderNative::load(String path)
+  {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+      Logger::Error("| MeshLoaderNative | Couldn't open the file: " + path);
+      return nullptr;
+    }
+
+    std::streamoff fileSize = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    Vector<uint8> data(static_cast<hkSize>(fileSize));
+    file.read(reinterpret_cast<char*>(data.data()), fileSize);
+    if (!file.good())
+    {
+      Logger::Error("| MeshLoaderNative | Couldn't read the file: " + path);
+      return nullptr;
+    }
+
+    return loadFromMemory(data.data(), data.size());
+  }
+
+  MultiMesh*
+  MeshLoaderNative::loadFromMemory(const uint8* data, const hkSize& dataSize)
+  {
+    DataReader reader(data, dataSize);
+
+    MeshFileHeader header;
+    header.magic = reader.read<uint32>();
+    header.version = reader.read<uint32>();
+    header.flags = reader.read<uint32>();
+    header.verticesSize = reader.read<uint32>();
+    header.indicesSize = reader.read<uint32>();
+    header.meshesSize = reader.read<uint32>();
+    header.nodesSize = reader.read<uint32>();
+    header.nodeMeshesIndicesSize = reader.read<uint32>();
+    header.namesSize = reader.read<uint32>();
+    header.lodsSize = reader.read<uint32>();
+    header.lodIndicesSize = reader.read<uint32>();
+    header.batchRangesSize = reader.read<uint32>();
+    header.batchSourceNodesSize = reader.read<uint32>();
+    header.batchSourceMeshesSize = reader.read<uint32>();
+    header.instancesSize = reader.read<uint32>();
+    header.instanceTransformsSize = reader.read<uint32>();
+    header.chunksSize = reader.read<uint32>();
+    header.metadataSize = reader.read<uint32>();
+
+    if (reader.failed() || MeshFileHeader::MAGIC != header.magic)
+    {
+      Logger::Error("| MeshLoaderNative | Not a mesh file.");
+      return nullptr;
+    }
+
+    if (MeshFileHeader::VERSION != header.version)
+    {
+      Logger::Error("| MeshLoaderNative | Unsupported mesh file version.");
+      return nullptr;
+    }
+
+    const bool hasFloatVertices = 0 != (header.flags & MeshFileHeader::FLAG_FLOAT_VERTICES);
+    const bool hasQuantizedVertices = 0 != (header.flags & MeshFileHeader::FLAG_QUANTIZED_VERTICES);
+    if (!hasFloatVertices && !hasQuantizedVertices)
+    {
+      Logger::Error("| MeshLoaderNative | The mesh file has no vertices.");
+      return nullptr;
+    }
+
+    // Every element of the streams needs at least a byte of encoded data, so
+    // the sizes are checked before allocating them.
+    if (static_cast<uint64>(header.verticesSize) + header.indicesSize + header.lodIndicesSize > dataSize
+        || header.metadataSize > dataSize
+        || static_cast<uint64>(header.meshesSize) + header.nodesSize
+           + header.nodeMeshesIndicesSize + header.namesSize + header.lodsSize
+           + header.batchRangesSize + header.instancesSize + header.instanceTransformsSize
+           > header.metadataSize
+        || static_cast<uint64>(header.chunksSize) * MeshFileChunk::SIZE > dataSize)
+    {
+      Logger::Error("| MeshLoaderNative | Malformed mesh file.");
+      return nullptr;
+    }
+
+    MultiMeshLayout layout;
+    layout.verticesSize = header.verticesSize;
+    layout.floatVertices = hasFloatVertices;
+    layout.quantizedVertices = hasQuantizedVertices;
+    layout.indicesSize = header.indicesSize;
+    layout.meshesSize = header.meshesSize;
+    layout.nodesSize = header.nodesSize;
+    layout.nodeMeshesIndicesSize = header.nodeMeshesIndicesSize;
+    layout.namesSize = header.namesSize;
+    layout.lodsSize = header.lodsSize;
+    layout.lodIndicesSize = header.lodIndicesSize;
+    layout.batchRangesSize = header.batchRangesSize;
+    layout.instancesSize = header.instancesSize;
+    layout.instanceTransformsSize = header.instanceTransformsSize;
+
+    // The streams are decoded straight into the arena of the multimesh.
+    MultiMesh* pMultiMesh = new MultiMesh(layout);
+    pMultiMesh->setBatchSource(header.batchSourceNodesSize, header.batchSourceMeshesSize);
+    MeshFileStreams streams(*pMultiMesh);
+
+    hkSize metadataStart = reader.getOffset();
+    if (!ReadMetadata(reader, header, streams)
+        || reader.getOffset() - metadataStart != header.metadataSize)
+    {
+      Logger::Error("| MeshLoaderNative | Malformed mesh file metadata.");
+      delete pMultiMesh;
+      return nullptr;
+    }
+
+    Vector<MeshFileChunk> chunks(header.chunksSize);
+    for (MeshFileChunk& chunk : chunks)
+    {
+      chunk.stream = static_cast<eMESH_FILE_STREAM>(reader.read<uint32>());
+      chunk.firstElement = reader.read<uint32>();
+      chunk.elementsSize = reader.read<uint32>();
+      chunk.dataSize = reader.read<uint32>();
+      chunk.offset = reader.read<uint64>();
+    }
+
+    // A file with missing or overlapping chunks would leave parts of the
+    // streams uninitialized, or decode them twice at the same time.
+    const uint32 aStreamsSize[4] =
+    {
+      hasFloatVertices ? header.verticesSize : 0,
+      hasQuantizedVertices ? header.verticesSize : 0,
+      header.indicesSize,
+      header.lodIndicesSize
+    };
+    if (reader.failed() || !CheckChunkTable(chunks, aStreamsSize))
+    {
+      Logger::Error("| MeshLoaderNative | Malformed mesh file chunk table.");
+      delete pMultiMesh;
+      return nullptr;
+    }
+
+    // Decode the chunks in parallel. Every chunk writes a disjoint range of
+    // its stream.
+    uint32 threadsSize = _m_threadsSize;
+    if (0 == threadsSize)
+      threadsSize = Math::Max(1u, std::thread::hardware_concurrency());
+    threadsSize = Math::Min(threadsSize, Math::Max(1u, header.chunksSize));
+
+    std::atomic<uint32> nextChunk(0);
+    std::atomic<bool> failed(false);
+    auto decodeChunks = [&]()
+    {
+      for (uint32 i = nextChunk++; i < header.chunksSize && !failed; i = nextChunk++)
+      {
+        if (!DecodeChunk(chunks[i], header, data, dataSize, streams))
+          failed = true;
+      }
+    };
+
+    Vector<std::thread> threads;
+    for (uint32 i = 1; i < threadsSize; ++i)
+      threads.push_back(std::thread(decodeChunks));
+
+    decodeChunks();
+
+    for (std::thread& thread : threads)
+      thread.join();
+
+    if (failed)
+    {
+      Logger::Error("| MeshLoaderNative | Malformed mesh file chunk data.");
+      delete pMultiMesh;
+      return nullptr;
+    }
+
+    // The indices are read by the GPU, so they can't address vertices out of
+    // their mesh.
+    if (!CheckIndices(header, streams))
+    {
+      Logger::Error("| MeshLoaderNative | Mesh file indices out of their mesh.");
+      delete pMultiMesh;
+      return nullptr;
+    }
+
+    pMultiMesh->computeNodesBounds();
+
+    return pMultiMesh;
+  }
+
+  void
+  MeshLoaderNative::setThreadsSize(const uint32& threadsSize)
+  {
+    _m_threadsSize = threadsSize;
+  }
+
+  const uint32&
+  MeshLoaderNative::getThreadsSize() const
+  {
+    return _m_threadsSize;
+  }
+}
\ No newline at end of file
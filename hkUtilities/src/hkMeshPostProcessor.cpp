@@ -0,0 +1,47 @@
+#include "Hakool/Utils/hkMeshPostProcessor.h"
+
+#include "Hakool/Utils/hkMultiMesh.h"
+#include "Hakool/Utils/hkMeshSimplifier.h"
+#include "Hakool/Utils/hkStaticBatcher.h"
+#include "Hakool/Utils/hkMeshDeduplicator.h"
+#include "Hakool/Utils/hkVertexQuantizer.h"
+
+namespace hk
+{
+  MultiMesh*
+  MeshPostProcessor::Process
+  (
+    MultiMesh* pMultiMesh,
+    const MeshImportConfiguration& configuration
+  )
+  {
+    if (configuration.deduplicateMeshes)
+    {
+      MultiMesh* pDeduplicated = MeshDeduplicator::Deduplicate(pMultiMesh);
+      delete pMultiMesh;
+      pMultiMesh = pDeduplicated;
+    }
+
+    if (configuration.staticBatching)
+    {
+      MultiMesh* pBatched = StaticBatcher::Batch(pMultiMesh);
+      delete pMultiMesh;
+      pMultiMesh = pBatched;
+    }
+
+    if (!configuration.lodRatios.empty())
+    {
+      MeshSimplifier simplifier;
+      simplifier.generateLods(pMultiMesh, configuration.lodRatios);
+    }
+
+    if (configuration.quantizeVertices)
+    {
+      MultiMesh* pQuantized = VertexQuantizer::QuantizeMultiMesh(pMultiMesh);
+      delete pMultiMesh;
+      pMultiMesh = pQuantized;
+    }
+
+    return pMultiMesh;
+  }
+}
\ No newline at end of file
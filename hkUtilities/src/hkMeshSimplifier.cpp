@@ -0,0 +1,724 @@
+#include "Hakool/Utils/hkMeshSimplifier.h"
+
+#include <algorithm>
+#include "Hakool/Utils/hkVector3.h"
+#include "Hakool/Utils/hkVertex.h"
+#include "Hakool/Utils/hkMultiMesh.h"
+#include "Hakool/Utils/hkMultiMeshMesh.h"
+#include "Hakool/Utils/hkMultiMeshLod.h"
+
+namespace hk
+{
+  namespace
+  {
+    const uint32 kINVALID_INDEX = std::numeric_limits<uint32>::max();
+
+    enum eVERTEX_KIND : uint8
+    {
+      kManifold,
+      kBorder,
+      kLocked
+    };
+
+    /**
+     * Symmetric 4x4 matrix of a quadric error metric plus the accumulated
+     * weight of its planes, so the error can be normalized.
+     */
+    struct Quadric
+    {
+      float a00, a11, a22, a01, a02, a12;
+      float b0, b1, b2;
+      float c;
+      float w;
+    };
+
+    struct Collapse
+    {
+      uint32 v0;
+      uint32 v1;
+      float cost;
+      float error;
+    };
+
+    void
+    QuadricZero(Quadric& q)
+    {
+      std::memset(&q, 0, sizeof(Quadric));
+    }
+
+    void
+    QuadricFromPlane
+    (
+      Quadric& q,
+      const Vector3f& n,
+      const float& d,
+      const float& w
+    )
+    {
+      q.a00 = w * n.x * n.x;
+      q.a11 = w * n.y * n.y;
+      q.a22 = w * n.z * n.z;
+      q.a01 = w * n.x * n.y;
+      q.a02 = w * n.x * n.z;
+      q.a12 = w * n.y * n.z;
+      q.b0 = w * n.x * d;
+      q.b1 = w * n.y * d;
+      q.b2 = w * n.z * d;
+      q.c = w * d * d;
+      q.w = w;
+    }
+
+    void
+    QuadricAdd(Quadric& q, const Quadric& r)
+    {
+      q.a00 += r.a00;
+      q.a11 += r.a11;
+      q.a22 += r.a22;
+      q.a01 += r.a01;
+      q.a02 += r.a02;
+      q.a12 += r.a12;
+      q.b0 += r.b0;
+      q.b1 += r.b1;
+      q.b2 += r.b2;
+      q.c += r.c;
+      q.w += r.w;
+    }
+
+    /**
+     * Weighted mean of the squared distances from a point to the planes of
+     * the quadric.
+     */
+    float
+    QuadricError(const Quadric& q, const Vector3f& p)
+    {
+      float rx = q.b0 + q.a01 * p.y;
+      float ry = q.b1 + q.a12 * p.z;
+      float rz = q.b2 + q.a02 * p.x;
+
+      rx = 2.0f * rx + q.a00 * p.x;
+      ry = 2.0f * ry + q.a11 * p.y;
+      rz = 2.0f * rz + q.a22 * p.z;
+
+      float r = q.c + rx * p.x + ry * p.y + rz * p.z;
+      return q.w > 0.0f ? Math::Abs(r) / q.w : 0.0f;
+    }
+
+    uint64
+    EdgeKey(const uint32& a, const uint32& b)
+    {
+      return (static_cast<uint64>(a) << 32) | static_cast<uint64>(b);
+    }
+
+    /**
+     * Group the vertices that share a position. remap points every vertex to
+     * the first vertex of its group and wedge links the vertices of a group
+     * in a circular list.
+     */
+    void
+    BuildPositionRemap
+    (
+      const Vector<Vector3f>& positions,
+      Vector<uint32>& remap,
+      Vector<uint32>& wedge
+    )
+    {
+      uint32 verticesSize = static_cast<uint32>(positions.size());
+      Vector<uint32> order(verticesSize);
+      for (uint32 i = 0; i < verticesSize; ++i)
+        order[i] = i;
+
+      std::sort
+      (
+        order.begin(),
+        order.end(),
+        [&positions](const uint32& a, const uint32& b)
+        {
+          const Vector3f& pa = positions[a];
+          const Vector3f& pb = positions[b];
+          if (pa.x != pb.x) return pa.x < pb.x;
+          if (pa.y != pb.y) return pa.y < pb.y;
+          if (pa.z != pb.z) return pa.z < pb.z;
+          return a < b;
+        }
+      );
+
+      remap.resize(verticesSize);
+      wedge.resize(verticesSize);
+
+      uint32 groupStart = 0;
+      while (groupStart < verticesSize)
+      {
+        uint32 groupEnd = groupStart + 1;
+        const Vector3f& groupPosition = positions[order[groupStart]];
+        while (groupEnd < verticesSize
+               && positions[order[groupEnd]].x == groupPosition.x
+               && positions[order[groupEnd]].y == groupPosition.y
+               && positions[order[groupEnd]].z == groupPosition.z)
+          ++groupEnd;
+
+        uint32 representative = order[groupStart];
+        for (uint32 i = groupStart; i < groupEnd; ++i)
+        {
+          remap[order[i]] = representative;
+          wedge[order[i]] = order[i + 1 < groupEnd ? i + 1 : groupStart];
+        }
+
+        groupStart = groupEnd;
+      }
+    }
+
+    float
+    AttributeDistance
+    (
+      const float* attributes,
+      const uint32& attributesSize,
+      const uint32& a,
+      const uint32& b
+    )
+    {
+      float distance = 0.0f;
+      const float* pA = attributes + a * attributesSize;
+      const float* pB = attributes + b * attributesSize;
+      for (uint32 i = 0; i < attributesSize; ++i)
+      {
+        float delta = pA[i] - pB[i];
+        distance += delta * delta;
+      }
+
+      return distance;
+    }
+  }
+
+  MeshSimplifier::MeshSimplifier() :
+    _m_borderWeight(10.0f),
+    _m_attributeWeight(1.0f)
+  { }
+
+  MeshSimplifier::~MeshSimplifier()
+  { }
+
+  void
+  MeshSimplifier::setBorderWeight(const float& weight)
+  {
+    _m_borderWeight = weight;
+  }
+
+  const float&
+  MeshSimplifier::getBorderWeight() const
+  {
+    return _m_borderWeight;
+  }
+
+  void
+  MeshSimplifier::setAttributeWeight(const float& weight)
+  {
+    _m_attributeWeight = weight;
+  }
+
+  const float&
+  MeshSimplifier::getAttributeWeight() const
+  {
+    return _m_attributeWeight;
+  }
+
+  float
+  MeshSimplifier::simplify
+  (
+    const Vertex* vertices,
+    const uint32& verticesSize,
+    const float* attributes,
+    const uint32& attributesSize,
+    const uint32* indices,
+    const uint32& indicesSize,
+    const uint32& targetIndicesSize,
+    const float& maxError,
+    Vector<uint32>& outIndices
+  )
+  {
+    // Point and line lists are kept as they are.
+    outIndices.assign(indices, indices + indicesSize);
+    if (indicesSize < 3 || indicesSize % 3 != 0 || targetIndicesSize >= indicesSize || 0 == verticesSize)
+      return 0.0f;
+
+    // Work in the unit cube, so the error metric does not depend on the
+    // scale of the mesh.
+    Vector3f minPosition(vertices[0].x, vertices[0].y, vertices[0].z);
+    Vector3f maxPosition = minPosition;
+    for (uint32 i = 1; i < verticesSize; ++i)
+    {
+      minPosition.x = Math::Min(minPosition.x, vertices[i].x);
+      minPosition.y = Math::Min(minPosition.y, vertices[i].y);
+      minPosition.z = Math::Min(minPosition.z, vertices[i].z);
+      maxPosition.x = Math::Max(maxPosition.x, vertices[i].x);
+      maxPosition.y = Math::Max(maxPosition.y, vertices[i].y);
+      maxPosition.z = Math::Max(maxPosition.z, vertices[i].z);
+    }
+
+    Vector3f size = maxPosition - minPosition;
+    float extent = Math::Max(size.x, Math::Max(size.y, size.z));
+    if (extent <= 0.0f)
+      extent = 1.0f;
+    float invExtent = 1.0f / extent;
+
+    Vector<Vector3f> positions(verticesSize);
+    for (uint32 i = 0; i < verticesSize; ++i)
+    {
+      positions[i] = Vector3f
+      (
+        (vertices[i].x - minPosition.x) * invExtent,
+        (vertices[i].y - minPosition.y) * invExtent,
+        (vertices[i].z - minPosition.z) * invExtent
+      );
+    }
+
+    Vector<uint32> remap;
+    Vector<uint32> wedge;
+    BuildPositionRemap(positions, remap, wedge);
+
+    // Face quadrics, weighted by the triangle area.
+    Vector<Quadric> quadrics(verticesSize);
+    for (Quadric& quadric : quadrics)
+      QuadricZero(quadric);
+
+    Vector<uint64> edges;
+    edges.reserve(indicesSize);
+    for (uint32 i = 0; i + 2 < indicesSize; i += 3)
+    {
+      uint32 v[3] = { remap[indices[i]], remap[indices[i + 1]], remap[indices[i + 2]] };
+      for (uint32 e = 0; e < 3; ++e)
+        edges.push_back(EdgeKey(v[e], v[(e + 1) % 3]));
+
+      Vector3f normal = (positions[v[1]] - positions[v[0]])
+                      % (positions[v[2]] - positions[v[0]]);
+      float length = normal.magnitude();
+      if (length <= 0.0f)
+        continue;
+
+      normal /= length;
+      Quadric quadric;
+      QuadricFromPlane(quadric, normal, -(normal | positions[v[0]]), length * 0.5f);
+      for (uint32 c = 0; c < 3; ++c)
+        QuadricAdd(quadrics[v[c]], quadric);
+    }
+    std::sort(edges.begin(), edges.end());
+
+    // Border quadrics: planes through the open edges, perpendicular to their
+    // triangle, so the border can only slide along itself.
+    for (uint32 i = 0; i + 2 < indicesSize; i += 3)
+    {
+      uint32 v[3] = { remap[indices[i]], remap[indices[i + 1]], remap[indices[i + 2]] };
+      Vector3f normal = (positions[v[1]] - positions[v[0]])
+                      % (positions[v[2]] - positions[v[0]]);
+
+      for (uint32 e = 0; e < 3; ++e)
+      {
+        uint32 a = v[e];
+        uint32 b = v[(e + 1) % 3];
+        if (std::binary_search(edges.begin(), edges.end(), EdgeKey(b, a)))
+          continue;
+
+        Vector3f edge = positions[b] - positions[a];
+        Vector3f planeNormal = edge % normal;
+        float length = planeNormal.magnitude();
+        if (length <= 0.0f)
+          continue;
+
+        planeNormal /= length;
+        Quadric quadric;
+        QuadricFromPlane
+        (
+          quadric,
+          planeNormal,
+          -(planeNormal | positions[a]),
+          (edge | edge) * _m_borderWeight
+        );
+        QuadricAdd(quadrics[a], quadric);
+        QuadricAdd(quadrics[b], quadric);
+      }
+    }
+
+    float maxCost = (maxError * invExtent) * (maxError * invExtent);
+    float resultError = 0.0f;
+
+    Vector<uint8> kinds(verticesSize);
+    Vector<uint8> locked(verticesSize);
+    Vector<uint32> triangleOffsets(verticesSize + 1);
+    Vector<uint32> triangleList;
+    Vector<uint32> collapseRemap(verticesSize);
+    Vector<uint64> candidates;
+    Vector<Collapse> collapses;
+    Vector<std::pair<uint32, uint32>> wedgeMap;
+
+    // Map every referenced copy of v0 to a copy of v1 that shares a triangle
+    // with it. Fails if a copy has no such neighbor, which keeps the
+    // attribute seams intact.
+    auto mapWedges = [&](const uint32& v0, const uint32& v1, float& attributeCost)
+    {
+      wedgeMap.clear();
+      attributeCost = 0.0f;
+
+      uint32 w = v0;
+      do
+      {
+        if (triangleOffsets[w] != triangleOffsets[w + 1])
+        {
+          uint32 best = kINVALID_INDEX;
+          float bestDistance = std::numeric_limits<float>::max();
+          for (uint32 t = triangleOffsets[w]; t < triangleOffsets[w + 1]; ++t)
+          {
+            const uint32* pTriangle = &outIndices[triangleList[t] * 3];
+            for (uint32 c = 0; c < 3; ++c)
+            {
+              if (remap[pTriangle[c]] != v1)
+                continue;
+
+              float distance = nullptr != attributes
+                             ? AttributeDistance(attributes, attributesSize, w, pTriangle[c])
+                             : 0.0f;
+              if (distance < bestDistance)
+              {
+                best = pTriangle[c];
+                bestDistance = distance;
+              }
+            }
+          }
+
+          if (kINVALID_INDEX == best)
+            return false;
+
+          wedgeMap.push_back(std::make_pair(w, best));
+          attributeCost += bestDistance;
+        }
+        w = wedge[w];
+      } while (w != v0);
+
+      return true;
+    };
+
+    // Moving v0 onto v1 must not flip any of the triangles that survive.
+    auto hasFlip = [&](const uint32& v0, const uint32& v1)
+    {
+      uint32 w = v0;
+      do
+      {
+        for (uint32 t = triangleOffsets[w]; t < triangleOffsets[w + 1]; ++t)
+        {
+          const uint32* pTriangle = &outIndices[triangleList[t] * 3];
+          uint32 v[3] = { remap[pTriangle[0]], remap[pTriangle[1]], remap[pTriangle[2]] };
+          if (v[0] == v1 || v[1] == v1 || v[2] == v1)
+            continue;
+
+          Vector3f before = (positions[v[1]] - positions[v[0]])
+                          % (positions[v[2]] - positions[v[0]]);
+          for (uint32 c = 0; c < 3; ++c)
+          {
+            if (v[c] == v0)
+              v[c] = v1;
+          }
+          Vector3f after = (positions[v[1]] - positions[v[0]])
+                         % (positions[v[2]] - positions[v[0]]);
+
+          if ((before | after) <= 0.0f)
+            return true;
+        }
+        w = wedge[w];
+      } while (w != v0);
+
+      return false;
+    };
+
+    while (outIndices.size() > targetIndicesSize)
+    {
+      uint32 trianglesSize = static_cast<uint32>(outIndices.size() / 3);
+
+      // Triangles of every vertex.
+      std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0);
+      for (uint32 index : outIndices)
+        ++triangleOffsets[index + 1];
+      for (uint32 i = 0; i < verticesSize; ++i)
+        triangleOffsets[i + 1] += triangleOffsets[i];
+
+      triangleList.resize(outIndices.size());
+      Vector<uint32> cursor(triangleOffsets.begin(), triangleOffsets.end() - 1);
+      for (uint32 i = 0; i < outIndices.size(); ++i)
+        triangleList[cursor[outIndices[i]]++] = i / 3;
+
+      // Classify the vertices from the open edges of the current topology.
+      edges.clear();
+      for (uint32 i = 0; i < outIndices.size(); i += 3)
+      {
+        uint32 v[3] = { remap[outIndices[i]], remap[outIndices[i + 1]], remap[outIndices[i + 2]] };
+        for (uint32 e = 0; e < 3; ++e)
+          edges.push_back(EdgeKey(v[e], v[(e + 1) % 3]));
+      }
+      std::sort(edges.begin(), edges.end());
+
+      Vector<uint8> openOut(verticesSize, 0);
+      Vector<uint8> openIn(verticesSize, 0);
+      std::fill(kinds.begin(), kinds.end(), static_cast<uint8>(kManifold));
+      for (uint32 i = 0; i < edges.size(); ++i)
+      {
+        uint32 a = static_cast<uint32>(edges[i] >> 32);
+        uint32 b = static_cast<uint32>(edges[i] & 0xffffffff);
+
+        // The same directed edge twice means non-manifold topology.
+        if (i + 1 < edges.size() && edges[i] == edges[i + 1])
+        {
+          kinds[a] = kLocked;
+          kinds[b] = kLocked;
+        }
+
+        if (!std::binary_search(edges.begin(), edges.end(), EdgeKey(b, a)))
+        {
+          openOut[a] = static_cast<uint8>(Math::Min(openOut[a] + 1, 2));
+          openIn[b] = static_cast<uint8>(Math::Min(openIn[b] + 1, 2));
+        }
+      }
+
+      for (uint32 i = 0; i < verticesSize; ++i)
+      {
+        if (kLocked == kinds[i] || (0 == openOut[i] && 0 == openIn[i]))
+          continue;
+
+        kinds[i] = (1 == openOut[i] && 1 == openIn[i]) ? kBorder : kLocked;
+      }
+
+      // Unique edges of the current triangles.
+      candidates.clear();
+      for (uint64 edge : edges)
+      {
+        uint32 a = static_cast<uint32>(edge >> 32);
+        uint32 b = static_cast<uint32>(edge & 0xffffffff);
+        if (a != b)
+          candidates.push_back(EdgeKey(Math::Min(a, b), Math::Max(a, b)));
+      }
+      std::sort(candidates.begin(), candidates.end());
+      candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+      auto canCollapse = [&](const uint32& v0, const uint32& v1)
+      {
+        if (kLocked == kinds[v0])
+          return false;
+
+        if (kBorder == kinds[v0])
+        {
+          if (kManifold == kinds[v1])
+            return false;
+
+          bool borderEdge =
+            !std::binary_search(edges.begin(), edges.end(), EdgeKey(v1, v0))
+            || !std::binary_search(edges.begin(), edges.end(), EdgeKey(v0, v1));
+          if (!borderEdge)
+            return false;
+        }
+
+        return true;
+      };
+
+      collapses.clear();
+      for (uint64 candidate : candidates)
+      {
+        uint32 v[2] = { static_cast<uint32>(candidate >> 32),
+                        static_cast<uint32>(candidate & 0xffffffff) };
+
+        Collapse best = { kINVALID_INDEX, kINVALID_INDEX, 0.0f, 0.0f };
+        for (uint32 d = 0; d < 2; ++d)
+        {
+          uint32 v0 = v[d];
+          uint32 v1 = v[1 - d];
+
+          float attributeCost = 0.0f;
+          if (!canCollapse(v0, v1) || !mapWedges(v0, v1, attributeCost))
+            continue;
+
+          float error = QuadricError(quadrics[v0], positions[v1]);
+          float cost = error + attributeCost * _m_attributeWeight;
+          if (kINVALID_INDEX == best.v0 || cost < best.cost)
+            best = { v0, v1, cost, error };
+        }
+
+        if (kINVALID_INDEX != best.v0 && best.error <= maxCost)
+          collapses.push_back(best);
+      }
+
+      if (collapses.empty())
+        break;
+
+      std::sort
+      (
+        collapses.begin(),
+        collapses.end(),
+        [](const Collapse& a, const Collapse& b)
+        {
+          return a.cost < b.cost;
+        }
+      );
+
+      // Every interior collapse removes two triangles, a border one only one.
+      uint32 targetTriangles = targetIndicesSize / 3;
+      uint32 trianglesToRemove = trianglesSize - targetTriangles;
+      uint32 trianglesRemoved = 0;
+
+      for (uint32 i = 0; i < verticesSize; ++i)
+        collapseRemap[i] = i;
+      std::fill(locked.begin(), locked.end(), static_cast<uint8>(0));
+
+      for (const Collapse& collapse : collapses)
+      {
+        if (trianglesRemoved >= trianglesToRemove)
+          break;
+
+        if (locked[collapse.v0] || locked[collapse.v1])
+          continue;
+
+        if (hasFlip(collapse.v0, collapse.v1))
+          continue;
+
+        float attributeCost = 0.0f;
+        mapWedges(collapse.v0, collapse.v1, attributeCost);
+        for (const std::pair<uint32, uint32>& mapping : wedgeMap)
+          collapseRemap[mapping.first] = mapping.second;
+
+        // The one-ring of v0 changes, so its vertices wait for the next pass.
+        uint32 w = collapse.v0;
+        do
+        {
+          for (uint32 t = triangleOffsets[w]; t < triangleOffsets[w + 1]; ++t)
+          {
+            const uint32* pTriangle = &outIndices[triangleList[t] * 3];
+            for (uint32 c = 0; c < 3; ++c)
+              locked[remap[pTriangle[c]]] = 1;
+          }
+          w = wedge[w];
+        } while (w != collapse.v0);
+        locked[collapse.v1] = 1;
+
+        QuadricAdd(quadrics[collapse.v1], quadrics[collapse.v0]);
+        resultError = Math::Max(resultError, collapse.error);
+        trianglesRemoved += kBorder == kinds[collapse.v0] ? 1 : 2;
+      }
+
+      // Apply the collapses and drop the degenerated triangles.
+      uint32 writeIndex = 0;
+      for (uint32 i = 0; i < outIndices.size(); i += 3)
+      {
+        uint32 i0 = collapseRemap[outIndices[i]];
+        uint32 i1 = collapseRemap[outIndices[i + 1]];
+        uint32 i2 = collapseRemap[outIndices[i + 2]];
+        if (remap[i0] == remap[i1] || remap[i1] == remap[i2] || remap[i0] == remap[i2])
+          continue;
+
+        outIndices[writeIndex++] = i0;
+        outIndices[writeIndex++] = i1;
+        outIndices[writeIndex++] = i2;
+      }
+
+      if (writeIndex == outIndices.size())
+        break;
+
+      outIndices.resize(writeIndex);
+    }
+
+    return Math::Sqrt(resultError) * extent;
+  }
+
+  void
+  MeshSimplifier::generateLods(MultiMesh* pMultiMesh, const Vector<float>& ratios)
+  {
+    Vector<MultiMeshLod> lods;
+    Vector<uint32> lodIndices;
+    Vector<uint32> simplified;
+    Vector<float> attributes;
+
+    for (uint32 meshIndex = 0; meshIndex < pMultiMesh->getMeshesSize(); ++meshIndex)
+    {
+      MultiMeshMesh* pMesh = &(pMultiMesh->getMeshesPtr()[meshIndex]);
+      pMesh->firstLodIndex = static_cast<uint32>(lods.size());
+      pMesh->lodsSize = 0;
+
+      // Only triangle lists are simplified, the importer keeps point and line
+      // meshes too.
+      if (pMesh->indicesSize % 3 != 0)
+        continue;
+
+      const Vertex* pVertices = pMultiMesh->getVerticesPtr() + pMesh->firstVertexIndex;
+      const uint32* pIndices = pMultiMesh->getIndicesPtr() + pMesh->firstIndexIndex;
+
+      // Normals and texture coordinates drive the attribute cost.
+      attributes.resize(pMesh->verticesSize * 5);
+      for (uint32 i = 0; i < pMesh->verticesSize; ++i)
+      {
+        attributes[i * 5 + 0] = pVertices[i].nx;
+        attributes[i * 5 + 1] = pVertices[i].ny;
+        attributes[i * 5 + 2] = pVertices[i].nz;
+        attributes[i * 5 + 3] = pVertices[i].u;
+        attributes[i * 5 + 4] = pVertices[i].v;
+      }
+
+      uint32 previousIndicesSize = pMesh->indicesSize;
+      float previousError = 0.0f;
+      for (const float& ratio : ratios)
+      {
+        if (ratio <= 0.0f || ratio >= 1.0f)
+          continue;
+
+        uint32 targetIndicesSize =
+          static_cast<uint32>(static_cast<float>(pMesh->indicesSize / 3) * ratio) * 3;
+
+        float error = simplify
+        (
+          pVertices,
+          pMesh->verticesSize,
+          attributes.data(),
+          5,
+          pIndices,
+          pMesh->indicesSize,
+          targetIndicesSize,
+          std::numeric_limits<float>::max(),
+          simplified
+        );
+
+        // The mesh can not be simplified any further.
+        if (simplified.size() >= previousIndicesSize)
+          break;
+
+        previousIndicesSize = static_cast<uint32>(simplified.size());
+        previousError = Math::Max(previousError, error);
+
+        lods.push_back
+        (
+          MultiMeshLod
+          (
+            static_cast<uint32>(lodIndices.size()),
+            previousIndicesSize,
+            previousError
+          )
+        );
+        lodIndices.insert(lodIndices.end(), simplified.begin(), simplified.end());
+        ++pMesh->lodsSize;
+      }
+    }
+
+    MultiMeshLod* pLods = nullptr;
+    if (!lods.empty())
+    {
+      pLods = new MultiMeshLod[lods.size()];
+      std::copy(lods.begin(), lods.end(), pLods);
+    }
+
+    uint32* pLodIndices = nullptr;
+    if (!lodIndices.empty())
+    {
+      pLodIndices = new uint32[lodIndices.size()];
+      std::copy(lodIndices.begin(), lodIndices.end(), pLodIndices);
+    }
+
+    pMultiMesh->setLods
+    (
+      pLods,
+      static_cast<uint32>(lods.size()),
+      pLodIndices,
+      static_cast<uint32>(lodIndices.size())
+    );
+  }
+}
\ No newline at end of file
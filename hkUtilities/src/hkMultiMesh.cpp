@@ -1,38 +1,240 @@
 #include "Hakool/Utils/hkMultiMesh.h"
 
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+#include "Hakool/Utils/hkLogger.h"
 #include "Hakool/Utils/hkVertex.h"
+#include "Hakool/Utils/hkQuantizedVertex.h"
 #include "Hakool/Utils/hkMultiMeshMesh.h"
 #include "Hakool/Utils/hkMultiMeshNode.h"
+#include "Hakool/Utils/hkMultiMeshLod.h"
+#include "Hakool/Utils/hkMultiMeshBatchRange.h"
+#include "Hakool/Utils/hkMultiMeshInstance.h"
 
 namespace hk
 {
-  MultiMesh::MultiMesh
-  (
-    Vertex* vertices,
-    uint32 verticesSize,
-    uint32* indices,
-    uint32 indicesSize,
-    MultiMeshMesh* meshes,
-    uint32 meshesSize,
-    MultiMeshNode* nodes,
-    uint32 nodesSize
-  ) :
-    _m_vertices(vertices),
-    _m_verticesSize(verticesSize),
-    _m_indices(indices),
-    _m_indicesSize(indicesSize),
-    _m_meshes(meshes),
-    _m_meshesSize(meshesSize),
-    _m_nodes(nodes),
-    _m_nodesSize(nodesSize)
-  { }
+  namespace
+  {
+    static_assert
+    (
+      std::is_trivially_destructible<Vertex>::value
+      && std::is_trivially_destructible<MultiMeshMesh>::value
+      && std::is_trivially_destructible<MultiMeshNode>::value
+      && std::is_trivially_destructible<Matrix4>::value,
+      "The arena releases its elements without destroying them."
+    );
+
+    /**
+     * Construct an array at the offset of the arena and move the offset
+     * past it, keeping the next array aligned.
+     */
+    template<typename T>
+    T*
+    CarveArray(uint8* _arena, hkSize& _offset, const uint32& _size)
+    {
+      if (0 == _size)
+        return nullptr;
+
+      T* array = reinterpret_cast<T*>(_arena + _offset);
+      for (uint32 i = 0; i < _size; ++i)
+        new (array + i) T();
+
+      hkSize bytes = static_cast<hkSize>(_size) * sizeof(T);
+      _offset += (bytes + MultiMeshLayout::ALIGNMENT - 1) & ~(MultiMeshLayout::ALIGNMENT - 1);
+      return array;
+    }
+  }
+
+  MultiMesh::MultiMesh(const MultiMeshLayout& layout) :
+    _m_arenaAllocation(nullptr),
+    _m_arena(nullptr),
+    _m_arenaSize(layout.getArenaSize()),
+    _m_vertices(nullptr),
+    _m_verticesSize(layout.verticesSize),
+    _m_quantizedVertices(nullptr),
+    _m_indices(nullptr),
+    _m_indicesSize(layout.indicesSize),
+    _m_meshes(nullptr),
+    _m_meshesSize(layout.meshesSize),
+    _m_nodes(nullptr),
+    _m_nodesSize(layout.nodesSize),
+    _m_nodeMeshesIndices(nullptr),
+    _m_nodeMeshesIndicesSize(layout.nodeMeshesIndicesSize),
+    _m_names(nullptr),
+    _m_namesSize(layout.namesSize),
+    _m_namesUsed(0),
+    _m_lods(nullptr),
+    _m_lodsSize(layout.lodsSize),
+    _m_lodIndices(nullptr),
+    _m_lodIndicesSize(layout.lodIndicesSize),
+    _m_batchRanges(nullptr),
+    _m_batchRangesSize(layout.batchRangesSize),
+    _m_batchSourceNodesSize(0),
+    _m_batchSourceMeshesSize(0),
+    _m_instances(nullptr),
+    _m_instancesSize(layout.instancesSize),
+    _m_instanceTransforms(nullptr),
+    _m_instanceTransformsSize(layout.instanceTransformsSize),
+    _m_boundingBox(),
+    _m_boundingSphere()
+  {
+    if (0 == _m_arenaSize)
+      return;
+
+    // new doesn't align to more than the fundamental alignment, which can be
+    // 8 bytes, so the arena is aligned inside a bigger allocation.
+    _m_arenaAllocation = new uint8[_m_arenaSize + MultiMeshLayout::ALIGNMENT - 1];
+    uintptr_t address = reinterpret_cast<uintptr_t>(_m_arenaAllocation);
+    uintptr_t misalignment = address & (MultiMeshLayout::ALIGNMENT - 1);
+    _m_arena = _m_arenaAllocation + (0 == misalignment ? 0 : MultiMeshLayout::ALIGNMENT - misalignment);
+
+    hkSize offset = 0;
+    if (layout.floatVertices)
+      _m_vertices = CarveArray<Vertex>(_m_arena, offset, _m_verticesSize);
+    if (layout.quantizedVertices)
+      _m_quantizedVertices = CarveArray<QuantizedVertex>(_m_arena, offset, _m_verticesSize);
+    _m_indices = CarveArray<uint32>(_m_arena, offset, _m_indicesSize);
+    _m_meshes = CarveArray<MultiMeshMesh>(_m_arena, offset, _m_meshesSize);
+    _m_nodes = CarveArray<MultiMeshNode>(_m_arena, offset, _m_nodesSize);
+    _m_nodeMeshesIndices = CarveArray<uint32>(_m_arena, offset, _m_nodeMeshesIndicesSize);
+    _m_names = CarveArray<char>(_m_arena, offset, _m_namesSize);
+    _m_lods = CarveArray<MultiMeshLod>(_m_arena, offset, _m_lodsSize);
+    _m_lodIndices = CarveArray<uint32>(_m_arena, offset, _m_lodIndicesSize);
+    _m_batchRanges = CarveArray<MultiMeshBatchRange>(_m_arena, offset, _m_batchRangesSize);
+    _m_instances = CarveArray<MultiMeshInstance>(_m_arena, offset, _m_instancesSize);
+    _m_instanceTransforms = CarveArray<Matrix4>(_m_arena, offset, _m_instanceTransformsSize);
+  }
+
+  MultiMesh::MultiMesh(MultiMesh&& other)
+  {
+    reset();
+    *this = std::move(other);
+  }
 
   MultiMesh::~MultiMesh()
   {
-    delete[] _m_vertices;
-    delete[] _m_indices;
-    delete[] _m_meshes;
-    delete[] _m_nodes;
+    release();
+  }
+
+  MultiMesh&
+  MultiMesh::operator=(MultiMesh&& other)
+  {
+    if (this == &other)
+      return *this;
+
+    release();
+
+    _m_arenaAllocation = other._m_arenaAllocation;
+    _m_arena = other._m_arena;
+    _m_arenaSize = other._m_arenaSize;
+    _m_vertices = other._m_vertices;
+    _m_verticesSize = other._m_verticesSize;
+    _m_quantizedVertices = other._m_quantizedVertices;
+    _m_indices = other._m_indices;
+    _m_indicesSize = other._m_indicesSize;
+    _m_meshes = other._m_meshes;
+    _m_meshesSize = other._m_meshesSize;
+    _m_nodes = other._m_nodes;
+    _m_nodesSize = other._m_nodesSize;
+    _m_nodeMeshesIndices = other._m_nodeMeshesIndices;
+    _m_nodeMeshesIndicesSize = other._m_nodeMeshesIndicesSize;
+    _m_names = other._m_names;
+    _m_namesSize = other._m_namesSize;
+    _m_namesUsed = other._m_namesUsed;
+    _m_lods = other._m_lods;
+    _m_lodsSize = other._m_lodsSize;
+    _m_lodIndices = other._m_lodIndices;
+    _m_lodIndicesSize = other._m_lodIndicesSize;
+    _m_batchRanges = other._m_batchRanges;
+    _m_batchRangesSize = other._m_batchRangesSize;
+    _m_batchSourceNodesSize = other._m_batchSourceNodesSize;
+    _m_batchSourceMeshesSize = other._m_batchSourceMeshesSize;
+    _m_instances = other._m_instances;
+    _m_instancesSize = other._m_instancesSize;
+    _m_instanceTransforms = other._m_instanceTransforms;
+    _m_instanceTransformsSize = other._m_instanceTransformsSize;
+    _m_boundingBox = other._m_boundingBox;
+    _m_boundingSphere = other._m_boundingSphere;
+
+    other.reset();
+    return *this;
+  }
+
+  void
+  MultiMesh::release()
+  {
+    if (!isInArena(_m_quantizedVertices))
+      delete[] _m_quantizedVertices;
+    if (!isInArena(_m_lods))
+      delete[] _m_lods;
+    if (!isInArena(_m_lodIndices))
+      delete[] _m_lodIndices;
+    if (!isInArena(_m_batchRanges))
+      delete[] _m_batchRanges;
+    if (!isInArena(_m_instances))
+      delete[] _m_instances;
+    if (!isInArena(_m_instanceTransforms))
+      delete[] _m_instanceTransforms;
+
+    delete[] _m_arenaAllocation;
+    reset();
+  }
+
+  void
+  MultiMesh::reset()
+  {
+    _m_arenaAllocation = nullptr;
+    _m_arena = nullptr;
+    _m_arenaSize = 0;
+    _m_vertices = nullptr;
+    _m_verticesSize = 0;
+    _m_quantizedVertices = nullptr;
+    _m_indices = nullptr;
+    _m_indicesSize = 0;
+    _m_meshes = nullptr;
+    _m_meshesSize = 0;
+    _m_nodes = nullptr;
+    _m_nodesSize = 0;
+    _m_nodeMeshesIndices = nullptr;
+    _m_nodeMeshesIndicesSize = 0;
+    _m_names = nullptr;
+    _m_namesSize = 0;
+    _m_namesUsed = 0;
+    _m_lods = nullptr;
+    _m_lodsSize = 0;
+    _m_lodIndices = nullptr;
+    _m_lodIndicesSize = 0;
+    _m_batchRanges = nullptr;
+    _m_batchRangesSize = 0;
+    _m_batchSourceNodesSize = 0;
+    _m_batchSourceMeshesSize = 0;
+    _m_instances = nullptr;
+    _m_instancesSize = 0;
+    _m_instanceTransforms = nullptr;
+    _m_instanceTransformsSize = 0;
+    _m_boundingBox = BoundingBox();
+    _m_boundingSphere = BoundingSphere();
+  }
+
+  bool
+  MultiMesh::isInArena(const void* array) const
+  {
+    // Pointers to different allocations can't be ordered, their addresses
+    // can.
+    uintptr_t address = reinterpret_cast<uintptr_t>(array);
+    uintptr_t arenaAddress = reinterpret_cast<uintptr_t>(_m_arena);
+    return nullptr != array
+           && nullptr != _m_arena
+           && address >= arenaAddress
+           && address - arenaAddress < _m_arenaSize;
+  }
+
+  const hkSize&
+  MultiMesh::getArenaSize() const
+  {
+    return _m_arenaSize;
   }
 
   Vertex* const
@@ -82,4 +284,288 @@ namespace hk
   {
     return _m_nodesSize;
   }
+
+  uint32* const
+  MultiMesh::getNodeMeshesIndicesPtr()
+  {
+    return _m_nodeMeshesIndices;
+  }
+
+  const uint32&
+  MultiMesh::getNodeMeshesIndicesSize() const
+  {
+    return _m_nodeMeshesIndicesSize;
+  }
+
+  char* const
+  MultiMesh::getNamesPtr()
+  {
+    return _m_names;
+  }
+
+  const uint32&
+  MultiMesh::getNamesSize() const
+  {
+    return _m_namesSize;
+  }
+
+  const char*
+  MultiMesh::getMeshName(const uint32& meshIndex) const
+  {
+    uint32 nameOffset = _m_meshes[meshIndex].nameOffset;
+    if (MultiMeshMesh::NO_NAME == nameOffset || nameOffset >= _m_namesSize)
+      return "";
+
+    return _m_names + nameOffset;
+  }
+
+  void
+  MultiMesh::setMeshName(const uint32& meshIndex, const String& name)
+  {
+    MultiMeshMesh& mesh = _m_meshes[meshIndex];
+    mesh.nameOffset = MultiMeshMesh::NO_NAME;
+
+    uint32 nameSize = MultiMeshLayout::NameSize(name);
+    if (0 == nameSize)
+      return;
+
+    if (nameSize > _m_namesSize - _m_namesUsed)
+    {
+      Logger::Error("| MultiMesh | No room for the mesh name: " + name);
+      return;
+    }
+
+    std::memcpy(_m_names + _m_namesUsed, name.c_str(), nameSize);
+    mesh.nameOffset = _m_namesUsed;
+    _m_namesUsed += nameSize;
+  }
+
+  void
+  MultiMesh::setQuantizedVertices(QuantizedVertex* quantizedVertices)
+  {
+    if (!isInArena(_m_quantizedVertices))
+      delete[] _m_quantizedVertices;
+    _m_quantizedVertices = quantizedVertices;
+  }
+
+  QuantizedVertex* const
+  MultiMesh::getQuantizedVerticesPtr()
+  {
+    return _m_quantizedVertices;
+  }
+
+  void
+  MultiMesh::setLods
+  (
+    MultiMeshLod* lods,
+    uint32 lodsSize,
+    uint32* lodIndices,
+    uint32 lodIndicesSize
+  )
+  {
+    if (!isInArena(_m_lods))
+      delete[] _m_lods;
+    if (!isInArena(_m_lodIndices))
+      delete[] _m_lodIndices;
+
+    _m_lods = lods;
+    _m_lodsSize = lodsSize;
+    _m_lodIndices = lodIndices;
+    _m_lodIndicesSize = lodIndicesSize;
+  }
+
+  MultiMeshLod* const
+  MultiMesh::getLodsPtr()
+  {
+    return _m_lods;
+  }
+
+  const uint32&
+  MultiMesh::getLodsSize() const
+  {
+    return _m_lodsSize;
+  }
+
+  uint32* const
+  MultiMesh::getLodIndicesPtr()
+  {
+    return _m_lodIndices;
+  }
+
+  const uint32&
+  MultiMesh::getLodIndicesSize() const
+  {
+    return _m_lodIndicesSize;
+  }
+
+  uint32
+  MultiMesh::selectLod
+  (
+    const uint32& meshIndex,
+    const float& distance,
+    const float& projectionScale,
+    const float& maxScreenError
+  )
+  {
+    const MultiMeshMesh& mesh = _m_meshes[meshIndex];
+
+    // LODs are sorted from finest to coarsest, so their errors only grow.
+    uint32 selected = 0;
+    for (uint32 i = 0; i < mesh.lodsSize; ++i)
+    {
+      const MultiMeshLod& lod = _m_lods[mesh.firstLodIndex + i];
+      if (lod.getScreenSpaceError(distance, projectionScale) > maxScreenError)
+        break;
+
+      selected = i + 1;
+    }
+
+    return selected;
+  }
+
+  void
+  MultiMesh::setBatchRanges(MultiMeshBatchRange* batchRanges, uint32 batchRangesSize)
+  {
+    if (!isInArena(_m_batchRanges))
+      delete[] _m_batchRanges;
+
+    _m_batchRanges = batchRanges;
+    _m_batchRangesSize = batchRangesSize;
+  }
+
+  MultiMeshBatchRange* const
+  MultiMesh::getBatchRangesPtr()
+  {
+    return _m_batchRanges;
+  }
+
+  const uint32&
+  MultiMesh::getBatchRangesSize() const
+  {
+    return _m_batchRangesSize;
+  }
+
+  void
+  MultiMesh::setBatchSource(const uint32& nodesSize, const uint32& meshesSize)
+  {
+    _m_batchSourceNodesSize = nodesSize;
+    _m_batchSourceMeshesSize = meshesSize;
+  }
+
+  const uint32&
+  MultiMesh::getBatchSourceNodesSize() const
+  {
+    return _m_batchSourceNodesSize;
+  }
+
+  const uint32&
+  MultiMesh::getBatchSourceMeshesSize() const
+  {
+    return _m_batchSourceMeshesSize;
+  }
+
+  const MultiMeshBatchRange*
+  MultiMesh::findBatchRange(const uint32& indexIndex) const
+  {
+    // Binary search of the last range that starts at or before the index.
+    uint32 first = 0;
+    uint32 last = _m_batchRangesSize;
+    while (first < last)
+    {
+      uint32 middle = first + (last - first) / 2;
+      if (_m_batchRanges[middle].firstIndexIndex <= indexIndex)
+        first = middle + 1;
+      else
+        last = middle;
+    }
+
+    if (0 == first)
+      return nullptr;
+
+    const MultiMeshBatchRange& range = _m_batchRanges[first - 1];
+    if (indexIndex - range.firstIndexIndex >= range.indicesSize)
+      return nullptr;
+
+    return &range;
+  }
+
+  void
+  MultiMesh::setInstances
+  (
+    MultiMeshInstance* instances,
+    uint32 instancesSize,
+    Matrix4* instanceTransforms,
+    uint32 instanceTransformsSize
+  )
+  {
+    if (!isInArena(_m_instances))
+      delete[] _m_instances;
+    if (!isInArena(_m_instanceTransforms))
+      delete[] _m_instanceTransforms;
+
+    _m_instances = instances;
+    _m_instancesSize = instancesSize;
+    _m_instanceTransforms = instanceTransforms;
+    _m_instanceTransformsSize = instanceTransformsSize;
+  }
+
+  MultiMeshInstance* const
+  MultiMesh::getInstancesPtr()
+  {
+    return _m_instances;
+  }
+
+  const uint32&
+  MultiMesh::getInstancesSize() const
+  {
+    return _m_instancesSize;
+  }
+
+  Matrix4* const
+  MultiMesh::getInstanceTransformsPtr()
+  {
+    return _m_instanceTransforms;
+  }
+
+  const uint32&
+  MultiMesh::getInstanceTransformsSize() const
+  {
+    return _m_instanceTransformsSize;
+  }
+
+  void
+  MultiMesh::computeNodesBounds()
+  {
+    _m_boundingBox = BoundingBox();
+    _m_boundingSphere = BoundingSphere();
+
+    for (uint32 i = 0; i < _m_nodesSize; ++i)
+    {
+      MultiMeshNode& node = _m_nodes[i];
+      node.boundingBox = BoundingBox();
+      node.boundingSphere = BoundingSphere();
+
+      for (uint32 j = 0; j < node.meshesIndicesSize; ++j)
+      {
+        const MultiMeshMesh& mesh = _m_meshes[_m_nodeMeshesIndices[node.firstMeshIndexIndex + j]];
+        node.boundingBox.merge(mesh.boundingBox.getTransformed(node.transform));
+        node.boundingSphere.merge(mesh.boundingSphere.getTransformed(node.transform));
+      }
+
+      _m_boundingBox.merge(node.boundingBox);
+      _m_boundingSphere.merge(node.boundingSphere);
+    }
+  }
+
+  const BoundingBox&
+  MultiMesh::getBoundingBox() const
+  {
+    return _m_boundingBox;
+  }
+
+  const BoundingSphere&
+  MultiMesh::getBoundingSphere() const
+  {
+    return _m_boundingSphere;
+  }
 }
\ No newline at end of file
@@ -0,0 +1,24 @@
+#include "Hakool/Utils/hkMultiMeshBatchRange.h"
+
+namespace hk
+{
+  MultiMeshBatchRange::MultiMeshBatchRange() :
+    firstIndexIndex(0),
+    indicesSize(0),
+    sourceNodeIndex(0),
+    sourceMeshIndex(0)
+  { }
+
+  MultiMeshBatchRange::MultiMeshBatchRange
+  (
+    const uint32& _firstIndexIndex,
+    const uint32& _indicesSize,
+    const uint32& _sourceNodeIndex,
+    const uint32& _sourceMeshIndex
+  ) :
+    firstIndexIndex(_firstIndexIndex),
+    indicesSize(_indicesSize),
+    sourceNodeIndex(_sourceNodeIndex),
+    sourceMeshIndex(_sourceMeshIndex)
+  { }
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#include "Hakool/Utils/hkMultiMeshInstance.h"
+
+namespace hk
+{
+  MultiMeshInstance::MultiMeshInstance() :
+    meshIndex(0),
+    firstTransformIndex(0),
+    transformsSize(0)
+  { }
+
+  MultiMeshInstance::MultiMeshInstance
+  (
+    const uint32& _meshIndex,
+    const uint32& _firstTransformIndex,
+    const uint32& _transformsSize
+  ) :
+    meshIndex(_meshIndex),
+    firstTransformIndex(_firstTransformIndex),
+    transformsSize(_transformsSize)
+  { }
+}
\ No newline at end of file
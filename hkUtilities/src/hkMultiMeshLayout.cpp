@@ -0,0 +1,63 @@
+#include "Hakool/Utils/hkMultiMeshLayout.h"
+
+#include "Hakool/Utils/hkVertex.h"
+#include "Hakool/Utils/hkQuantizedVertex.h"
+#include "Hakool/Utils/hkMultiMeshMesh.h"
+#include "Hakool/Utils/hkMultiMeshNode.h"
+#include "Hakool/Utils/hkMultiMeshLod.h"
+#include "Hakool/Utils/hkMultiMeshBatchRange.h"
+#include "Hakool/Utils/hkMultiMeshInstance.h"
+
+namespace hk
+{
+  namespace
+  {
+    hkSize
+    ArraySize(const uint32& _size, const hkSize& _elementSize)
+    {
+      hkSize bytes = static_cast<hkSize>(_size) * _elementSize;
+      return (bytes + MultiMeshLayout::ALIGNMENT - 1) & ~(MultiMeshLayout::ALIGNMENT - 1);
+    }
+  }
+
+  const hkSize MultiMeshLayout::ALIGNMENT = 16;
+
+  MultiMeshLayout::MultiMeshLayout() :
+    verticesSize(0),
+    floatVertices(true),
+    quantizedVertices(false),
+    indicesSize(0),
+    meshesSize(0),
+    nodesSize(0),
+    nodeMeshesIndicesSize(0),
+    namesSize(0),
+    lodsSize(0),
+    lodIndicesSize(0),
+    batchRangesSize(0),
+    instancesSize(0),
+    instanceTransformsSize(0)
+  { }
+
+  uint32
+  MultiMeshLayout::NameSize(const String& name)
+  {
+    return name.empty() ? 0 : static_cast<uint32>(name.size() + 1);
+  }
+
+  hkSize
+  MultiMeshLayout::getArenaSize() const
+  {
+    return ArraySize(floatVertices ? verticesSize : 0, sizeof(Vertex))
+         + ArraySize(quantizedVertices ? verticesSize : 0, sizeof(QuantizedVertex))
+         + ArraySize(indicesSize, sizeof(uint32))
+         + ArraySize(meshesSize, sizeof(MultiMeshMesh))
+         + ArraySize(nodesSize, sizeof(MultiMeshNode))
+         + ArraySize(nodeMeshesIndicesSize, sizeof(uint32))
+         + ArraySize(namesSize, sizeof(char))
+         + ArraySize(lodsSize, sizeof(MultiMeshLod))
+         + ArraySize(lodIndicesSize, sizeof(uint32))
+         + ArraySize(batchRangesSize, sizeof(MultiMeshBatchRange))
+         + ArraySize(instancesSize, sizeof(MultiMeshInstance))
+         + ArraySize(instanceTransformsSize, sizeof(Matrix4));
+  }
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include "Hakool/Utils/hkMultiMeshLod.h"
+
+namespace hk
+{
+  MultiMeshLod::MultiMeshLod() :
+    firstIndexIndex(0),
+    indicesSize(0),
+    error(0.0f)
+  { }
+
+  MultiMeshLod::MultiMeshLod
+  (
+    const uint32& _firstIndexIndex,
+    const uint32& _indicesSize,
+    const float& _error
+  ) :
+    firstIndexIndex(_firstIndexIndex),
+    indicesSize(_indicesSize),
+    error(_error)
+  { }
+
+  float
+  MultiMeshLod::getScreenSpaceError
+  (
+    const float& distance,
+    const float& projectionScale
+  ) const
+  {
+    if (distance <= 0.0f)
+      return std::numeric_limits<float>::max();
+
+    return error * projectionScale / distance;
+  }
+}
\ No newline at end of file
@@ -2,34 +2,41 @@
 
 namespace hk
 {
+  const uint32 MultiMeshMesh::NO_NAME = 0xFFFFFFFF;
+
   MultiMeshMesh::MultiMeshMesh() :
-    name(""),
+    nameOffset(NO_NAME),
     firstVertexIndex(0),
     verticesSize(0),
     firstIndexIndex(0),
-    indicesSize(0)
+    indicesSize(0),
+    materialIndex(0),
+    contentHash(0),
+    firstLodIndex(0),
+    lodsSize(0),
+    quantization(),
+    boundingBox(),
+    boundingSphere()
   { }
 
   MultiMeshMesh::MultiMeshMesh
   (
-    String _name,
     uint32 _firstVertexIndex,
     uint32 _verticesSize,
     uint32 _firstIndexIndex,
     uint32 _indicesSize
   ) :
-    name(_name),
+    nameOffset(NO_NAME),
     firstVertexIndex(_firstVertexIndex),
     verticesSize(_verticesSize),
     firstIndexIndex(_firstIndexIndex),
-    indicesSize(_indicesSize)
-  { }
-
-  MultiMeshMesh::MultiMeshMesh(const MultiMeshMesh& copy):
-    name(copy.name),
-    firstVertexIndex(copy.firstVertexIndex),
-    verticesSize(copy.verticesSize),
-    firstIndexIndex(copy.firstIndexIndex),
-    indicesSize(copy.indicesSize)
+    indicesSize(_indicesSize),
+    materialIndex(0),
+    contentHash(0),
+    firstLodIndex(0),
+    lodsSize(0),
+    quantization(),
+    boundingBox(),
+    boundingSphere()
   { }
 }
\ No newline at end of file
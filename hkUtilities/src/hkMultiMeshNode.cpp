@@ -3,30 +3,23 @@
 namespace hk
 {
   MultiMeshNode::MultiMeshNode() :
-    meshesIndices(nullptr),
+    firstMeshIndexIndex(0),
     meshesIndicesSize(0),
-    transform()
+    transform(),
+    boundingBox(),
+    boundingSphere()
   { }
 
   MultiMeshNode::MultiMeshNode
   (
-    uint32* _meshesIndices,
+    const uint32& _firstMeshIndexIndex,
     const uint32& _meshesIndicesSize,
     const Matrix4& _transform
   ) :
-    meshesIndices(_meshesIndices),
+    firstMeshIndexIndex(_firstMeshIndexIndex),
     meshesIndicesSize(_meshesIndicesSize),
-    transform(_transform)
+    transform(_transform),
+    boundingBox(),
+    boundingSphere()
   { }
-
-  MultiMeshNode::MultiMeshNode(const MultiMeshNode& copy) :
-    meshesIndices(copy.meshesIndices),
-    meshesIndicesSize(copy.meshesIndicesSize),
-    transform(copy.transform)
-  { }
-
-  MultiMeshNode::~MultiMeshNode()
-  {
-    delete[] meshesIndices;
-  }
 }
\ No newline at end of file
@@ -0,0 +1,26 @@
+#include "Hakool/Utils/hkQuantizedVertex.h"
+
+namespace hk
+{
+  QuantizedVertex::QuantizedVertex() :
+    px(0),
+    py(0),
+    pz(0),
+    pw(0),
+    nx(0),
+    ny(0),
+    tx(0),
+    ty(0),
+    u(0),
+    v(0)
+  { }
+
+  VertexQuantization::VertexQuantization() :
+    positionOffset(0.0f, 0.0f, 0.0f),
+    positionScale(1.0f, 1.0f, 1.0f),
+    positionError(0.0f),
+    normalError(0.0f),
+    tangentError(0.0f),
+    uvError(0.0f)
+  { }
+}
\ No newline at end of file
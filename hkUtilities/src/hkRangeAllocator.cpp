@@ -0,0 +1,173 @@
+#include "Hakool/Utils/hkRangeAllocator.h"
+
+#include <algorithm>
+
+namespace hk
+{
+  const uint32 RangeAllocator::INVALID_OFFSET = 0xffffffff;
+
+  RangeAllocator::RangeAllocator() :
+    _m_freeRanges(),
+    _m_capacity(0),
+    _m_usedSize(0)
+  { }
+
+  void
+  RangeAllocator::reset(const uint32& capacity)
+  {
+    _m_freeRanges.clear();
+    _m_capacity = capacity;
+    _m_usedSize = 0;
+
+    if (capacity > 0)
+    {
+      _m_freeRanges.push_back(FreeRange{ 0, capacity });
+    }
+  }
+
+  void
+  RangeAllocator::grow(const uint32& capacity)
+  {
+    if (capacity <= _m_capacity)
+    {
+      return;
+    }
+
+    uint32 oldCapacity = _m_capacity;
+    _m_capacity = capacity;
+    _insertFreeRange(oldCapacity, capacity - oldCapacity);
+  }
+
+  uint32
+  RangeAllocator::allocate(const uint32& size)
+  {
+    if (0 == size)
+    {
+      return INVALID_OFFSET;
+    }
+
+    // Best fit: the smallest range the allocation fits in.
+    hkSize best = _m_freeRanges.size();
+    for (hkSize i = 0; i < _m_freeRanges.size(); ++i)
+    {
+      const FreeRange& range = _m_freeRanges[i];
+      if (range.size >= size
+          && (best == _m_freeRanges.size() || range.size < _m_freeRanges[best].size))
+      {
+        best = i;
+        if (range.size == size)
+        {
+          break;
+        }
+      }
+    }
+
+    if (best == _m_freeRanges.size())
+    {
+      return INVALID_OFFSET;
+    }
+
+    FreeRange& range = _m_freeRanges[best];
+    uint32 offset = range.offset;
+    if (range.size == size)
+    {
+      _m_freeRanges.erase(_m_freeRanges.begin() + best);
+    }
+    else
+    {
+      range.offset += size;
+      range.size -= size;
+    }
+
+    _m_usedSize += size;
+    return offset;
+  }
+
+  void
+  RangeAllocator::free(const uint32& offset, const uint32& size)
+  {
+    if (0 == size)
+    {
+      return;
+    }
+
+    _m_usedSize -= size;
+    _insertFreeRange(offset, size);
+  }
+
+  uint32
+  RangeAllocator::getCapacity() const
+  {
+    return _m_capacity;
+  }
+
+  uint32
+  RangeAllocator::getUsedSize() const
+  {
+    return _m_usedSize;
+  }
+
+  uint32
+  RangeAllocator::getLargestFreeRange() const
+  {
+    uint32 largest = 0;
+    for (const FreeRange& range : _m_freeRanges)
+    {
+      largest = std::max(largest, range.size);
+    }
+
+    return largest;
+  }
+
+  uint32
+  RangeAllocator::getFreeRangesSize() const
+  {
+    return static_cast<uint32>(_m_freeRanges.size());
+  }
+
+  bool
+  RangeAllocator::isFragmented() const
+  {
+    uint32 freeSize = _m_capacity - _m_usedSize;
+    return _m_freeRanges.size() > 1 && getLargestFreeRange() < freeSize / 2;
+  }
+
+  void
+  RangeAllocator::_insertFreeRange(const uint32& offset, const uint32& size)
+  {
+    auto next = std::lower_bound
+    (
+      _m_freeRanges.begin(),
+      _m_freeRanges.end(),
+      offset,
+      [](const FreeRange& range, const uint32& value)
+      {
+        return range.offset < value;
+      }
+    );
+
+    bool mergesPrevious = next != _m_freeRanges.begin()
+                          && (next - 1)->offset + (next - 1)->size == offset;
+    bool mergesNext = next != _m_freeRanges.end()
+                      && offset + size == next->offset;
+
+    if (mergesPrevious && mergesNext)
+    {
+      (next - 1)->size += size + next->size;
+      _m_freeRanges.erase(next);
+    }
+    else if (mergesPrevious)
+    {
+      (next - 1)->size += size;
+    }
+    else if (mergesNext)
+    {
+      next->offset = offset;
+      next->size += size;
+    }
+    else
+    {
+      _m_freeRanges.insert(next, FreeRange{ offset, size });
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,246 @@
+#include "Hakool/Utils/hkStaticBatcher.h"
+
+#include "Hakool/Utils/hkVertex.h"
+#include "Hakool/Utils/hkMeshDeduplicator.h"
+#include "Hakool/Utils/hkMultiMesh.h"
+#include "Hakool/Utils/hkMultiMeshMesh.h"
+#include "Hakool/Utils/hkMultiMeshNode.h"
+#include "Hakool/Utils/hkMultiMeshBatchRange.h"
+
+namespace hk
+{
+  namespace
+  {
+    /**
+     * A mesh drawn by a node.
+     */
+    struct BatchInstance
+    {
+      uint32 nodeIndex;
+
+      uint32 meshIndex;
+    };
+
+    /**
+     * Transforms of the vertex attributes of a node.
+     */
+    struct VertexTransform
+    {
+      explicit VertexTransform(const Matrix4& transform) :
+        matrix(transform),
+        mirrored(false)
+      {
+        Vector3f column0(transform.m00, transform.m10, transform.m20);
+        Vector3f column1(transform.m01, transform.m11, transform.m21);
+        Vector3f column2(transform.m02, transform.m12, transform.m22);
+
+        // Columns of the cofactor matrix, the inverse transpose scaled by the
+        // determinant. Its sign keeps the normals facing out on mirrored
+        // nodes.
+        normalColumn0 = column1 % column2;
+        normalColumn1 = column2 % column0;
+        normalColumn2 = column0 % column1;
+
+        mirrored = (column0 | normalColumn0) < 0.0f;
+        if (mirrored)
+        {
+          normalColumn0 *= -1.0f;
+          normalColumn1 *= -1.0f;
+          normalColumn2 *= -1.0f;
+        }
+      }
+
+      void
+      apply(const Vertex& _source, Vertex& _target) const
+      {
+        const Matrix4& m = matrix;
+        _target.x = m.m00 * _source.x + m.m01 * _source.y + m.m02 * _source.z + m.m03;
+        _target.y = m.m10 * _source.x + m.m11 * _source.y + m.m12 * _source.z + m.m13;
+        _target.z = m.m20 * _source.x + m.m21 * _source.y + m.m22 * _source.z + m.m23;
+
+        Vector3f normal = normalColumn0 * _source.nx
+                        + normalColumn1 * _source.ny
+                        + normalColumn2 * _source.nz;
+        normal = NormalizeOrZero(normal);
+        _target.nx = normal.x;
+        _target.ny = normal.y;
+        _target.nz = normal.z;
+
+        Vector3f tangent
+        (
+          m.m00 * _source.tx + m.m01 * _source.ty + m.m02 * _source.tz,
+          m.m10 * _source.tx + m.m11 * _source.ty + m.m12 * _source.tz,
+          m.m20 * _source.tx + m.m21 * _source.ty + m.m22 * _source.tz
+        );
+        tangent = NormalizeOrZero(tangent);
+        _target.tx = tangent.x;
+        _target.ty = tangent.y;
+        _target.tz = tangent.z;
+
+        _target.u = _source.u;
+        _target.v = _source.v;
+      }
+
+      static Vector3f
+      NormalizeOrZero(const Vector3f& _v)
+      {
+        float length = _v.magnitude();
+        if (length <= 0.0f)
+          return Vector3f(0.0f, 0.0f, 0.0f);
+
+        return Vector3f(_v.x / length, _v.y / length, _v.z / length);
+      }
+
+      Matrix4 matrix;
+
+      Vector3f normalColumn0;
+
+      Vector3f normalColumn1;
+
+      Vector3f normalColumn2;
+
+      /**
+       * The transform has a negative determinant and flips the winding.
+       */
+      bool mirrored;
+    };
+
+    String
+    BatchName(const uint32& _materialIndex)
+    {
+      return "batch" + std::to_string(_materialIndex);
+    }
+  }
+
+  MultiMesh*
+  StaticBatcher::Batch(MultiMesh* pMultiMesh)
+  {
+    MultiMeshMesh* sourceMeshes = pMultiMesh->getMeshesPtr();
+    MultiMeshNode* sourceNodes = pMultiMesh->getNodes();
+    const uint32* sourceNodeMeshesIndices = pMultiMesh->getNodeMeshesIndicesPtr();
+
+    // Group the meshes drawn by every node by material.
+    Map<uint32, Vector<BatchInstance>> batches;
+    uint32 verticesSize = 0;
+    uint32 indicesSize = 0;
+    uint32 instancesSize = 0;
+    for (uint32 i = 0; i < pMultiMesh->getNodesSize(); ++i)
+    {
+      const MultiMeshNode& node = sourceNodes[i];
+      for (uint32 j = 0; j < node.meshesIndicesSize; ++j)
+      {
+        uint32 meshIndex = sourceNodeMeshesIndices[node.firstMeshIndexIndex + j];
+        const MultiMeshMesh& mesh = sourceMeshes[meshIndex];
+        batches[mesh.materialIndex].push_back({ i, meshIndex });
+
+        verticesSize += mesh.verticesSize;
+        indicesSize += mesh.indicesSize;
+        ++instancesSize;
+      }
+    }
+
+    uint32 meshesSize = static_cast<uint32>(batches.size());
+
+    // A single node draws every batch.
+    MultiMeshLayout layout;
+    layout.verticesSize = verticesSize;
+    layout.indicesSize = indicesSize;
+    layout.meshesSize = meshesSize;
+    layout.nodesSize = 1;
+    layout.nodeMeshesIndicesSize = meshesSize;
+    layout.batchRangesSize = instancesSize;
+    for (const auto& batch : batches)
+      layout.namesSize += MultiMeshLayout::NameSize(BatchName(batch.first));
+
+    MultiMesh* pBatched = new MultiMesh(layout);
+    Vertex* vertices = pBatched->getVerticesPtr();
+    uint32* indices = pBatched->getIndicesPtr();
+    MultiMeshMesh* meshes = pBatched->getMeshesPtr();
+    MultiMeshBatchRange* ranges = pBatched->getBatchRangesPtr();
+    pBatched->setBatchSource(pMultiMesh->getNodesSize(), pMultiMesh->getMeshesSize());
+
+    uint32 vertexIndex = 0;
+    uint32 indexIndex = 0;
+    uint32 meshIndex = 0;
+    uint32 rangeIndex = 0;
+    for (const auto& batch : batches)
+    {
+      MultiMeshMesh& mesh = meshes[meshIndex];
+      pBatched->setMeshName(meshIndex, BatchName(batch.first));
+      mesh.materialIndex = batch.first;
+      mesh.firstVertexIndex = vertexIndex;
+      mesh.firstIndexIndex = indexIndex;
+
+      for (const BatchInstance& instance : batch.second)
+      {
+        const MultiMeshMesh& sourceMesh = sourceMeshes[instance.meshIndex];
+        VertexTransform transform(sourceNodes[instance.nodeIndex].transform);
+
+        // Indices are relative to the first vertex of their mesh.
+        uint32 baseVertex = vertexIndex - mesh.firstVertexIndex;
+
+        const Vertex* sourceVertices = pMultiMesh->getVerticesPtr() + sourceMesh.firstVertexIndex;
+        for (uint32 i = 0; i < sourceMesh.verticesSize; ++i)
+          transform.apply(sourceVertices[i], vertices[vertexIndex + i]);
+
+        const uint32* sourceIndices = pMultiMesh->getIndicesPtr() + sourceMesh.firstIndexIndex;
+        for (uint32 i = 0; i < sourceMesh.indicesSize; ++i)
+          indices[indexIndex + i] = baseVertex + sourceIndices[i];
+
+        // Keep the front faces of mirrored triangles.
+        if (transform.mirrored && 0 == sourceMesh.indicesSize % 3)
+        {
+          for (uint32 i = 0; i < sourceMesh.indicesSize; i += 3)
+            std::swap(indices[indexIndex + i + 1], indices[indexIndex + i + 2]);
+        }
+
+        ranges[rangeIndex] = MultiMeshBatchRange
+        (
+          indexIndex,
+          sourceMesh.indicesSize,
+          instance.nodeIndex,
+          instance.meshIndex
+        );
+
+        vertexIndex += sourceMesh.verticesSize;
+        indexIndex += sourceMesh.indicesSize;
+        ++rangeIndex;
+      }
+
+      mesh.verticesSize = vertexIndex - mesh.firstVertexIndex;
+      mesh.indicesSize = indexIndex - mesh.firstIndexIndex;
+
+      const float* positions = &(vertices[mesh.firstVertexIndex].x);
+      mesh.boundingBox = BoundingBox::FromPositions(positions, mesh.verticesSize, sizeof(Vertex));
+      mesh.boundingSphere = BoundingSphere::FromPositions
+      (
+        positions,
+        mesh.verticesSize,
+        sizeof(Vertex),
+        mesh.boundingBox
+      );
+
+      mesh.contentHash = MeshDeduplicator::ContentHash
+      (
+        vertices + mesh.firstVertexIndex,
+        mesh.verticesSize,
+        indices + mesh.firstIndexIndex,
+        mesh.indicesSize
+      );
+
+      ++meshIndex;
+    }
+
+    uint32* meshesIndices = pBatched->getNodeMeshesIndicesPtr();
+    for (uint32 i = 0; i < meshesSize; ++i)
+      meshesIndices[i] = i;
+
+    MultiMeshNode& node = pBatched->getNodes()[0];
+    node.firstMeshIndexIndex = 0;
+    node.meshesIndicesSize = meshesSize;
+    node.transform = Matrix4::GetIdentity();
+    pBatched->computeNodesBounds();
+
+    return pBatched;
+  }
+}
\ No newline at end of file
@@ -5,18 +5,42 @@ namespace hk
   Vertex::Vertex() :
     x(0.0f),
     y(0.0f),
-    z(0.0f)
+    z(0.0f),
+    nx(0.0f),
+    ny(0.0f),
+    nz(0.0f),
+    tx(0.0f),
+    ty(0.0f),
+    tz(0.0f),
+    u(0.0f),
+    v(0.0f)
   { }
 
   Vertex::Vertex(const float& _x, const float& _y, const float& _z) :
     x(_x),
     y(_y),
-    z(_z)
+    z(_z),
+    nx(0.0f),
+    ny(0.0f),
+    nz(0.0f),
+    tx(0.0f),
+    ty(0.0f),
+    tz(0.0f),
+    u(0.0f),
+    v(0.0f)
   { }
 
   Vertex::Vertex(const Vertex& copy) :
     x(copy.x),
     y(copy.y),
-    z(copy.z)
+    z(copy.z),
+    nx(copy.nx),
+    ny(copy.ny),
+    nz(copy.nz),
+    tx(copy.tx),
+    ty(copy.ty),
+    tz(copy.tz),
+    u(copy.u),
+    v(copy.v)
   { }
 }
\ No newline at end of file
@@ -0,0 +1,346 @@
+#include "Hakool/Utils/hkVertexQuantizer.h"
+
+#include <algorithm>
+
+#include "Hakool/Utils/hkVertex.h"
+#include "Hakool/Utils/hkBoundingBox.h"
+#include "Hakool/Utils/hkMultiMesh.h"
+#include "Hakool/Utils/hkMultiMeshLayout.h"
+#include "Hakool/Utils/hkMultiMeshMesh.h"
+#include "Hakool/Utils/hkMultiMeshNode.h"
+#include "Hakool/Utils/hkMultiMeshLod.h"
+#include "Hakool/Utils/hkMultiMeshBatchRange.h"
+#include "Hakool/Utils/hkMultiMeshInstance.h"
+
+namespace hk
+{
+  namespace
+  {
+    /**
+     * Copy an array of the source multimesh to the same array of the
+     * quantized one.
+     */
+    template<typename T>
+    void
+    CopyArray(const T* _source, const uint32& _size, T* _destination)
+    {
+      if (0 != _size)
+        std::copy(_source, _source + _size, _destination);
+    }
+
+    int16
+    FloatToSnorm16(const float& _value)
+    {
+      float clamped = Math::Max(-1.0f, Math::Min(1.0f, _value));
+      return static_cast<int16>(Math::Round(clamped * 32767.0f));
+    }
+
+    float
+    Snorm16ToFloat(const int16& _value)
+    {
+      return Math::Max(-1.0f, static_cast<float>(_value) / 32767.0f);
+    }
+
+    uint16
+    FloatToUnorm16(const float& _value)
+    {
+      float clamped = Math::Max(0.0f, Math::Min(1.0f, _value));
+      return static_cast<uint16>(Math::Round(clamped * 65535.0f));
+    }
+
+    /**
+     * Angle between a unit vector and its decoded octahedral encoding.
+     */
+    float
+    OctahedralError(const Vector3f& _v, const int16& _x, const int16& _y)
+    {
+      float length = _v.magnitude();
+      if (length <= 0.0f)
+        return 0.0f;
+
+      Vector3f decoded = VertexQuantizer::DecodeOctahedral(_x, _y);
+      float cosine = (_v | decoded) / length;
+      return Math::Acos(Math::Max(-1.0f, Math::Min(1.0f, cosine)));
+    }
+  }
+
+  VertexQuantization
+  VertexQuantizer::Quantize
+  (
+    const Vertex* vertices,
+    const uint32& verticesSize,
+    QuantizedVertex* quantizedVertices
+  )
+  {
+    VertexQuantization quantization;
+    if (0 == verticesSize)
+      return quantization;
+
+    BoundingBox box = BoundingBox::FromPositions(&vertices[0].x, verticesSize, sizeof(Vertex));
+    quantization.positionOffset = box.minimum;
+    quantization.positionScale = box.maximum - box.minimum;
+
+    const Vector3f& offset = quantization.positionOffset;
+    const Vector3f& scale = quantization.positionScale;
+    Vector3f invScale
+    (
+      scale.x > 0.0f ? 1.0f / scale.x : 0.0f,
+      scale.y > 0.0f ? 1.0f / scale.y : 0.0f,
+      scale.z > 0.0f ? 1.0f / scale.z : 0.0f
+    );
+
+    for (uint32 i = 0; i < verticesSize; ++i)
+    {
+      const Vertex& vertex = vertices[i];
+      QuantizedVertex& quantized = quantizedVertices[i];
+
+      quantized.px = FloatToUnorm16((vertex.x - offset.x) * invScale.x);
+      quantized.py = FloatToUnorm16((vertex.y - offset.y) * invScale.y);
+      quantized.pz = FloatToUnorm16((vertex.z - offset.z) * invScale.z);
+      quantized.pw = 0;
+
+      Vector3f normal(vertex.nx, vertex.ny, vertex.nz);
+      Vector3f tangent(vertex.tx, vertex.ty, vertex.tz);
+      EncodeOctahedral(normal, quantized.nx, quantized.ny);
+      EncodeOctahedral(tangent, quantized.tx, quantized.ty);
+
+      quantized.u = FloatToHalf(vertex.u);
+      quantized.v = FloatToHalf(vertex.v);
+
+      // Measure the errors against the decoded values.
+      float decodedX = offset.x + scale.x * (static_cast<float>(quantized.px) / 65535.0f);
+      float decodedY = offset.y + scale.y * (static_cast<float>(quantized.py) / 65535.0f);
+      float decodedZ = offset.z + scale.z * (static_cast<float>(quantized.pz) / 65535.0f);
+      quantization.positionError = Math::Max
+      (
+        quantization.positionError,
+        Math::Max
+        (
+          Math::Abs(decodedX - vertex.x),
+          Math::Max(Math::Abs(decodedY - vertex.y), Math::Abs(decodedZ - vertex.z))
+        )
+      );
+
+      quantization.normalError = Math::Max
+      (
+        quantization.normalError,
+        OctahedralError(normal, quantized.nx, quantized.ny)
+      );
+      quantization.tangentError = Math::Max
+      (
+        quantization.tangentError,
+        OctahedralError(tangent, quantized.tx, quantized.ty)
+      );
+      quantization.uvError = Math::Max
+      (
+        quantization.uvError,
+        Math::Max
+        (
+          Math::Abs(HalfToFloat(quantized.u) - vertex.u),
+          Math::Abs(HalfToFloat(quantized.v) - vertex.v)
+        )
+      );
+    }
+
+    return quantization;
+  }
+
+  void
+  VertexQuantizer::Dequantize
+  (
+    const QuantizedVertex* quantizedVertices,
+    const uint32& verticesSize,
+    const VertexQuantization& quantization,
+    Vertex* vertices
+  )
+  {
+    const Vector3f& offset = quantization.positionOffset;
+    const Vector3f& scale = quantization.positionScale;
+
+    for (uint32 i = 0; i < verticesSize; ++i)
+    {
+      const QuantizedVertex& quantized = quantizedVertices[i];
+      Vertex& vertex = vertices[i];
+
+      vertex.x = offset.x + scale.x * (static_cast<float>(quantized.px) / 65535.0f);
+      vertex.y = offset.y + scale.y * (static_cast<float>(quantized.py) / 65535.0f);
+      vertex.z = offset.z + scale.z * (static_cast<float>(quantized.pz) / 65535.0f);
+
+      Vector3f normal = DecodeOctahedral(quantized.nx, quantized.ny);
+      vertex.nx = normal.x;
+      vertex.ny = normal.y;
+      vertex.nz = normal.z;
+
+      Vector3f tangent = DecodeOctahedral(quantized.tx, quantized.ty);
+      vertex.tx = tangent.x;
+      vertex.ty = tangent.y;
+      vertex.tz = tangent.z;
+
+      vertex.u = HalfToFloat(quantized.u);
+      vertex.v = HalfToFloat(quantized.v);
+    }
+  }
+
+  MultiMesh*
+  VertexQuantizer::QuantizeMultiMesh(MultiMesh* pMultiMesh)
+  {
+    // The float vertices are left out of the new arena, so the quantized
+    // multimesh is smaller than the source one.
+    MultiMeshLayout layout;
+    layout.verticesSize = pMultiMesh->getVerticesSize();
+    layout.floatVertices = false;
+    layout.quantizedVertices = true;
+    layout.indicesSize = pMultiMesh->getIndicesSize();
+    layout.meshesSize = pMultiMesh->getMeshesSize();
+    layout.nodesSize = pMultiMesh->getNodesSize();
+    layout.nodeMeshesIndicesSize = pMultiMesh->getNodeMeshesIndicesSize();
+    layout.namesSize = pMultiMesh->getNamesSize();
+    layout.lodsSize = pMultiMesh->getLodsSize();
+    layout.lodIndicesSize = pMultiMesh->getLodIndicesSize();
+    layout.batchRangesSize = pMultiMesh->getBatchRangesSize();
+    layout.instancesSize = pMultiMesh->getInstancesSize();
+    layout.instanceTransformsSize = pMultiMesh->getInstanceTransformsSize();
+
+    MultiMesh* pQuantized = new MultiMesh(layout);
+    CopyArray(pMultiMesh->getIndicesPtr(), layout.indicesSize, pQuantized->getIndicesPtr());
+    CopyArray(pMultiMesh->getMeshesPtr(), layout.meshesSize, pQuantized->getMeshesPtr());
+    CopyArray(pMultiMesh->getNodes(), layout.nodesSize, pQuantized->getNodes());
+    CopyArray
+    (
+      pMultiMesh->getNodeMeshesIndicesPtr(),
+      layout.nodeMeshesIndicesSize,
+      pQuantized->getNodeMeshesIndicesPtr()
+    );
+    CopyArray(pMultiMesh->getNamesPtr(), layout.namesSize, pQuantized->getNamesPtr());
+    CopyArray(pMultiMesh->getLodsPtr(), layout.lodsSize, pQuantized->getLodsPtr());
+    CopyArray(pMultiMesh->getLodIndicesPtr(), layout.lodIndicesSize, pQuantized->getLodIndicesPtr());
+    CopyArray(pMultiMesh->getBatchRangesPtr(), layout.batchRangesSize, pQuantized->getBatchRangesPtr());
+    pQuantized->setBatchSource
+    (
+      pMultiMesh->getBatchSourceNodesSize(),
+      pMultiMesh->getBatchSourceMeshesSize()
+    );
+    CopyArray(pMultiMesh->getInstancesPtr(), layout.instancesSize, pQuantized->getInstancesPtr());
+    CopyArray
+    (
+      pMultiMesh->getInstanceTransformsPtr(),
+      layout.instanceTransformsSize,
+      pQuantized->getInstanceTransformsPtr()
+    );
+
+    QuantizedVertex* quantizedVertices = pQuantized->getQuantizedVerticesPtr();
+    for (uint32 i = 0; i < pQuantized->getMeshesSize(); ++i)
+    {
+      MultiMeshMesh* pMesh = &(pQuantized->getMeshesPtr()[i]);
+      pMesh->quantization = Quantize
+      (
+        pMultiMesh->getVerticesPtr() + pMesh->firstVertexIndex,
+        pMesh->verticesSize,
+        quantizedVertices + pMesh->firstVertexIndex
+      );
+    }
+
+    pQuantized->computeNodesBounds();
+    return pQuantized;
+  }
+
+  void
+  VertexQuantizer::EncodeOctahedral(const Vector3f& _v, int16& _x, int16& _y)
+  {
+    float l1Norm = Math::Abs(_v.x) + Math::Abs(_v.y) + Math::Abs(_v.z);
+    if (l1Norm <= 0.0f)
+    {
+      _x = 0;
+      _y = 0;
+      return;
+    }
+
+    float x = _v.x / l1Norm;
+    float y = _v.y / l1Norm;
+
+    // Fold the lower hemisphere over the diagonals.
+    if (_v.z < 0.0f)
+    {
+      float foldedX = (1.0f - Math::Abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+      float foldedY = (1.0f - Math::Abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+      x = foldedX;
+      y = foldedY;
+    }
+
+    _x = FloatToSnorm16(x);
+    _y = FloatToSnorm16(y);
+  }
+
+  Vector3f
+  VertexQuantizer::DecodeOctahedral(const int16& _x, const int16& _y)
+  {
+    float x = Snorm16ToFloat(_x);
+    float y = Snorm16ToFloat(_y);
+    float z = 1.0f - Math::Abs(x) - Math::Abs(y);
+
+    float t = Math::Max(-z, 0.0f);
+    x += x >= 0.0f ? -t : t;
+    y += y >= 0.0f ? -t : t;
+
+    return Vector3f(x, y, z).getNormalize();
+  }
+
+  uint16
+  VertexQuantizer::FloatToHalf(const float& _value)
+  {
+    uint32 bits;
+    std::memcpy(&bits, &_value, sizeof(float));
+
+    uint32 sign = (bits >> 16) & 0x8000;
+    uint32 absBits = bits & 0x7fffffff;
+
+    // Infinity and NaN.
+    if (absBits >= 0x7f800000)
+      return static_cast<uint16>(sign | 0x7c00 | (absBits > 0x7f800000 ? 0x0200 : 0));
+
+    // Too big, rounds to infinity.
+    if (absBits >= 0x477ff000)
+      return static_cast<uint16>(sign | 0x7c00);
+
+    // Subnormal half, in units of 2^-24.
+    if (absBits < 0x38800000)
+    {
+      float magnitude;
+      std::memcpy(&magnitude, &absBits, sizeof(float));
+      return static_cast<uint16>(sign | static_cast<uint32>(Math::Round(magnitude * 16777216.0f)));
+    }
+
+    // Rebias the exponent and round the mantissa to nearest even.
+    uint32 mantissaOdd = (absBits >> 13) & 1;
+    absBits += 0xc8000fff + mantissaOdd;
+    return static_cast<uint16>(sign | (absBits >> 13));
+  }
+
+  float
+  VertexQuantizer::HalfToFloat(const uint16& _value)
+  {
+    uint32 sign = static_cast<uint32>(_value & 0x8000) << 16;
+    uint32 exponent = (_value >> 10) & 0x1f;
+    uint32 mantissa = _value & 0x03ff;
+
+    uint32 bits;
+    if (0 == exponent)
+    {
+      float magnitude = static_cast<float>(mantissa) / 16777216.0f;
+      std::memcpy(&bits, &magnitude, sizeof(float));
+      bits |= sign;
+    }
+    else if (0x1f == exponent)
+    {
+      bits = sign | 0x7f800000 | (mantissa << 13);
+    }
+    else
+    {
+      bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+
+    float result;
+    std::memcpy(&result, &bits, sizeof(float));
+    return result;
+  }
+}
\ No newline at end of file
@@ -122,6 +122,14 @@ namespace hk
   WindowWin32::present()
   { }
 
+  void
+  WindowWin32::makeContextCurrent()
+  { }
+
+  void
+  WindowWin32::releaseContext()
+  { }
+
   HANDLER 
   WindowWin32::getWindowHandler()
   {
@@ -150,7 +158,7 @@ namespace hk
   }
 
   void 
-  WindowWin32::addObserver(const WindowObserver* pObserver)
+  WindowWin32::addObserver(WindowObserver* pObserver)
   {
   }
 